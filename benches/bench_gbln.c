@@ -0,0 +1,470 @@
+// Copyright (c) 2025 Vivian Burkhard Voss
+// SPDX-License-Identifier: Apache-2.0
+
+/**
+ * GBLN C FFI benchmarks
+ *
+ * - gbln_parse() on small, medium and large MINI and pretty documents
+ * - gbln_object_get() and gbln_array_get() access
+ * - gbln_value_new_*() + gbln_object_insert() build path
+ * - gbln_to_string() / gbln_to_string_pretty()
+ * - gbln_write_io() / gbln_read_io() with and without XZ
+ *
+ * Reports ns/op, MB/s (where an op has a byte size) and allocations/op.
+ * Only the original 0.9 API is used, so the same program runs against every
+ * library in libs/; functions a library does not export are skipped.
+ *
+ * Build and run with benches/run.sh.
+ *
+ * Usage: bench_gbln [filter]
+ *   filter: only run benchmarks whose name contains this string
+ *   GBLN_BENCH_MS: minimum time per benchmark in milliseconds (default 300)
+ */
+
+#define _GNU_SOURCE
+#include "../include/gbln.h"
+#include <dlfcn.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#if defined(__linux__) || defined(__FreeBSD__)
+#define COUNT_ALLOCS 1
+#else
+#define COUNT_ALLOCS 0
+#endif
+
+// ============================================================================
+// Allocation counting
+// ============================================================================
+
+static size_t alloc_count = 0;
+
+#if COUNT_ALLOCS
+// The benchmark interposes the malloc family so that allocations made inside
+// libgbln are counted, forwarding to the next definition. dlsym() may itself
+// allocate while the real functions are being resolved; those requests are
+// served from a small static arena that is never freed.
+
+static void* (*real_malloc)(size_t);
+static void* (*real_calloc)(size_t, size_t);
+static void* (*real_realloc)(void*, size_t);
+static int (*real_posix_memalign)(void**, size_t, size_t);
+static void (*real_free)(void*);
+
+static _Alignas(16) char bootstrap[4096];
+static size_t bootstrap_used = 0;
+static int resolving = 0;
+
+static void resolve(void) {
+    resolving = 1;
+    real_malloc = (void* (*)(size_t))dlsym(RTLD_NEXT, "malloc");
+    real_calloc = (void* (*)(size_t, size_t))dlsym(RTLD_NEXT, "calloc");
+    real_realloc = (void* (*)(void*, size_t))dlsym(RTLD_NEXT, "realloc");
+    real_posix_memalign = (int (*)(void**, size_t, size_t))dlsym(RTLD_NEXT, "posix_memalign");
+    real_free = (void (*)(void*))dlsym(RTLD_NEXT, "free");
+    resolving = 0;
+}
+
+static void* bootstrap_alloc(size_t size) {
+    size = (size + 15) & ~(size_t)15;
+    if (bootstrap_used + size > sizeof(bootstrap)) {
+        return NULL;
+    }
+    void* p = bootstrap + bootstrap_used;
+    bootstrap_used += size;
+    return p;
+}
+
+static int is_bootstrap(const void* p) {
+    return (const char*)p >= bootstrap && (const char*)p < bootstrap + sizeof(bootstrap);
+}
+
+void* malloc(size_t size) {
+    if (!real_malloc) {
+        if (resolving) {
+            return bootstrap_alloc(size);
+        }
+        resolve();
+    }
+    alloc_count++;
+    return real_malloc(size);
+}
+
+void* calloc(size_t n, size_t size) {
+    if (!real_calloc) {
+        if (resolving) {
+            // The arena is static and never reused, so already zeroed
+            return n && size > (size_t)-1 / n ? NULL : bootstrap_alloc(n * size);
+        }
+        resolve();
+    }
+    alloc_count++;
+    return real_calloc(n, size);
+}
+
+void* realloc(void* p, size_t size) {
+    if (!real_realloc) {
+        resolve();
+    }
+    if (is_bootstrap(p)) {
+        void* q = malloc(size);
+        if (q) {
+            size_t room = (size_t)(bootstrap + sizeof(bootstrap) - (char*)p);
+            memcpy(q, p, size < room ? size : room);
+        }
+        return q;
+    }
+    alloc_count++;
+    return real_realloc(p, size);
+}
+
+int posix_memalign(void** out, size_t align, size_t size) {
+    if (!real_posix_memalign) {
+        resolve();
+    }
+    alloc_count++;
+    return real_posix_memalign(out, align, size);
+}
+
+void free(void* p) {
+    if (p == NULL || is_bootstrap(p)) {
+        return;
+    }
+    if (!real_free) {
+        resolve();
+    }
+    real_free(p);
+}
+#endif
+
+// ============================================================================
+// Harness
+// ============================================================================
+
+typedef struct {
+    const char* name;
+    void (*run)(void* ctx);
+    void* ctx;
+    size_t ops;      // Operations per call of `run`
+    size_t bytes;    // Bytes processed per call (0 = no throughput)
+} Bench;
+
+static double now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+
+static double min_ns = 300e6;
+
+static void run_bench(const Bench* b) {
+    // Warm up, then double the batch until it takes a tenth of the budget
+    b->run(b->ctx);
+    size_t batch = 1;
+    for (;;) {
+        double start = now_ns();
+        for (size_t i = 0; i < batch; i++) {
+            b->run(b->ctx);
+        }
+        if (now_ns() - start >= min_ns / 10 || batch >= ((size_t)1 << 40)) {
+            break;
+        }
+        batch *= 2;
+    }
+
+    size_t calls = 0;
+    size_t allocs_before = alloc_count;
+    double start = now_ns();
+    double elapsed;
+    do {
+        for (size_t i = 0; i < batch; i++) {
+            b->run(b->ctx);
+        }
+        calls += batch;
+        elapsed = now_ns() - start;
+    } while (elapsed < min_ns);
+    size_t allocs = alloc_count - allocs_before;
+
+    size_t ops = calls * b->ops;
+    printf("%-28s %10zu %12.1f", b->name, ops, elapsed / (double)ops);
+    if (b->bytes) {
+        printf(" %10.1f", (double)b->bytes * (double)calls / (elapsed / 1e9) / 1e6);
+    } else {
+        printf(" %10s", "-");
+    }
+    if (COUNT_ALLOCS) {
+        printf(" %10.1f\n", (double)allocs / (double)ops);
+    } else {
+        printf(" %10s\n", "n/a");
+    }
+}
+
+static void skip_bench(const char* name, const char* why) {
+    printf("%-28s %10s  (skipped: %s)\n", name, "-", why);
+}
+
+static void check(int ok, const char* what) {
+    if (!ok) {
+        char* msg = gbln_last_error_message();
+        fprintf(stderr, "bench_gbln: %s failed: %s\n", what, msg ? msg : "unknown error");
+        exit(1);
+    }
+}
+
+// ============================================================================
+// Documents
+// ============================================================================
+
+#define RECORD_FIELDS 8
+
+static const char* record_keys[RECORD_FIELDS] = {
+    "id", "name", "email", "age", "score", "active", "tags", "address",
+};
+
+static char* make_records(size_t count) {
+    size_t cap = 256 * count + 16;
+    char* text = malloc(cap);
+    size_t len = 0;
+    text[len++] = '[';
+    for (size_t i = 0; i < count; i++) {
+        len += (size_t)snprintf(text + len, cap - len,
+                                "{id<u32>(%zu)name<s32>(user%zu)email<s64>(user%zu@example.com)"
+                                "age<u8>(%zu)score<f64>(%zu.5)active<b>(%s)tags<s16>[alpha beta]"
+                                "address{city<s32>(Berlin)zip<u32>(10115)}}",
+                                i, i, i, 18 + i % 60, i % 100, i % 2 ? "t" : "f");
+    }
+    text[len++] = ']';
+    text[len] = '\0';
+    return text;
+}
+
+static struct GblnValue* parse_or_die(const char* text) {
+    struct GblnValue* value = NULL;
+    check(gbln_parse(text, &value) == Ok, "gbln_parse");
+    return value;
+}
+
+// ============================================================================
+// Benchmarks
+// ============================================================================
+
+static void bench_parse(void* ctx) {
+    struct GblnValue* value = NULL;
+    gbln_parse((const char*)ctx, &value);
+    gbln_value_free(value);
+}
+
+static void bench_object_get(void* ctx) {
+    const struct GblnValue* record = ctx;
+    for (size_t i = 0; i < RECORD_FIELDS; i++) {
+        if (gbln_object_get(record, record_keys[i]) == NULL) {
+            abort();
+        }
+    }
+}
+
+static void bench_array_get(void* ctx) {
+    const struct GblnValue* array = ctx;
+    size_t len = gbln_array_len(array);
+    for (size_t i = 0; i < len; i++) {
+        const struct GblnValue* id = gbln_object_get(gbln_array_get(array, i), "id");
+        bool ok;
+        gbln_value_as_u32(id, &ok);
+    }
+}
+
+static void insert(struct GblnValue* object, const char* key, struct GblnValue* value) {
+    if (gbln_object_insert(object, key, value) != Ok) {
+        abort();
+    }
+}
+
+static void bench_build(void* ctx) {
+    (void)ctx;
+    struct GblnValue* record = gbln_value_new_object();
+    insert(record, "id", gbln_value_new_u32(42));
+    insert(record, "name", gbln_value_new_str("user42", 32));
+    insert(record, "email", gbln_value_new_str("user42@example.com", 64));
+    insert(record, "age", gbln_value_new_u8(30));
+    insert(record, "score", gbln_value_new_f64(42.5));
+    insert(record, "active", gbln_value_new_bool(true));
+
+    struct GblnValue* tags = gbln_value_new_array();
+    gbln_array_push(tags, gbln_value_new_str("alpha", 16));
+    gbln_array_push(tags, gbln_value_new_str("beta", 16));
+    insert(record, "tags", tags);
+
+    struct GblnValue* address = gbln_value_new_object();
+    insert(address, "city", gbln_value_new_str("Berlin", 32));
+    insert(address, "zip", gbln_value_new_u32(10115));
+    insert(record, "address", address);
+
+    gbln_value_free(record);
+}
+
+static void bench_to_string(void* ctx) {
+    gbln_string_free(gbln_to_string(ctx));
+}
+
+static void bench_to_string_pretty(void* ctx) {
+    gbln_string_free(gbln_to_string_pretty(ctx));
+}
+
+// I/O functions are looked up at run time: older libraries lack them
+static enum GblnErrorCode (*write_io)(const struct GblnValue*, const char*,
+                                      const struct GblnConfig*);
+static enum GblnErrorCode (*read_io)(const char*, struct GblnValue**);
+static struct GblnConfig* (*config_new_io)(void);
+static void (*config_set_compress)(struct GblnConfig*, bool);
+static void (*config_free)(struct GblnConfig*);
+
+typedef struct {
+    const struct GblnValue* value;
+    const char* path;
+    struct GblnConfig* config;
+} IoCtx;
+
+static void bench_write_io(void* ctx) {
+    IoCtx* io = ctx;
+    check(write_io(io->value, io->path, io->config) == Ok, "gbln_write_io");
+}
+
+static void bench_read_io(void* ctx) {
+    IoCtx* io = ctx;
+    struct GblnValue* value = NULL;
+    check(read_io(io->path, &value) == Ok, "gbln_read_io");
+    gbln_value_free(value);
+}
+
+static const char* platform(void) {
+#if defined(__ANDROID__)
+    const char* os = "android";
+#elif defined(__linux__)
+    const char* os = "linux";
+#elif defined(__FreeBSD__)
+    const char* os = "freebsd";
+#elif defined(__APPLE__)
+    const char* os = "macos";
+#else
+    const char* os = "unknown";
+#endif
+#if defined(__x86_64__)
+    const char* arch = "x64";
+#elif defined(__aarch64__)
+    const char* arch = "arm64";
+#else
+    const char* arch = "unknown";
+#endif
+    static char name[32];
+    snprintf(name, sizeof(name), "%s-%s", os, arch);
+    return name;
+}
+
+int main(int argc, char** argv) {
+    const char* filter = argc > 1 ? argv[1] : NULL;
+    const char* ms = getenv("GBLN_BENCH_MS");
+    if (ms && atof(ms) > 0) {
+        min_ns = atof(ms) * 1e6;
+    }
+
+    write_io = (enum GblnErrorCode (*)(const struct GblnValue*, const char*,
+                                       const struct GblnConfig*))dlsym(RTLD_DEFAULT,
+                                                                       "gbln_write_io");
+    read_io = (enum GblnErrorCode (*)(const char*, struct GblnValue**))dlsym(RTLD_DEFAULT,
+                                                                            "gbln_read_io");
+    config_new_io = (struct GblnConfig * (*)(void)) dlsym(RTLD_DEFAULT, "gbln_config_new_io");
+    config_set_compress =
+        (void (*)(struct GblnConfig*, bool))dlsym(RTLD_DEFAULT, "gbln_config_set_compress");
+    config_free = (void (*)(struct GblnConfig*))dlsym(RTLD_DEFAULT, "gbln_config_free");
+    int have_io = write_io && read_io && config_new_io && config_set_compress && config_free;
+
+    // Documents: MINI text as generated, pretty text via the library
+    const size_t sizes[3] = {1, 100, 10000};
+    const char* size_names[3] = {"small", "medium", "large"};
+    char* mini[3];
+    char* pretty[3];
+    struct GblnValue* docs[3];
+    for (int i = 0; i < 3; i++) {
+        mini[i] = make_records(sizes[i]);
+        docs[i] = parse_or_die(mini[i]);
+        pretty[i] = gbln_to_string_pretty(docs[i]);
+        check(pretty[i] != NULL, "gbln_to_string_pretty");
+    }
+    const struct GblnValue* record = gbln_array_get(docs[1], 0);
+
+    char names[12][32];
+    Bench benches[32];
+    size_t n = 0;
+    for (int i = 0; i < 3; i++) {
+        snprintf(names[2 * i], sizeof(names[0]), "parse/mini/%s", size_names[i]);
+        benches[n++] = (Bench){names[2 * i], bench_parse, mini[i], 1, strlen(mini[i])};
+        snprintf(names[2 * i + 1], sizeof(names[0]), "parse/pretty/%s", size_names[i]);
+        benches[n++] = (Bench){names[2 * i + 1], bench_parse, pretty[i], 1, strlen(pretty[i])};
+    }
+    benches[n++] = (Bench){"access/object_get", bench_object_get, (void*)record, RECORD_FIELDS, 0};
+    benches[n++] = (Bench){"access/array_get", bench_array_get, docs[1], sizes[1], 0};
+    benches[n++] = (Bench){"build/record", bench_build, NULL, 1, 0};
+
+    char* out = gbln_to_string(docs[1]);
+    benches[n++] = (Bench){"to_string/medium", bench_to_string, docs[1], 1, strlen(out)};
+    gbln_string_free(out);
+    out = gbln_to_string(docs[2]);
+    benches[n++] = (Bench){"to_string/large", bench_to_string, docs[2], 1, strlen(out)};
+    gbln_string_free(out);
+    benches[n++] = (Bench){"to_string_pretty/medium", bench_to_string_pretty, docs[1], 1,
+                           strlen(pretty[1])};
+
+    // I/O on the medium document, uncompressed and with XZ
+    const char* tmp = getenv("TMPDIR") ? getenv("TMPDIR") : "/tmp";
+    char plain_path[256];
+    char xz_path[256];
+    snprintf(plain_path, sizeof(plain_path), "%s/bench_gbln.io.gbln", tmp);
+    snprintf(xz_path, sizeof(xz_path), "%s/bench_gbln.io.gbln.xz", tmp);
+    IoCtx plain = {docs[1], plain_path, NULL};
+    IoCtx xz = {docs[1], xz_path, NULL};
+    if (have_io) {
+        plain.config = config_new_io();
+        config_set_compress(plain.config, false);
+        xz.config = config_new_io();
+        // Files to read from
+        bench_write_io(&plain);
+        bench_write_io(&xz);
+        size_t bytes = strlen(mini[1]);
+        benches[n++] = (Bench){"io/write/plain", bench_write_io, &plain, 1, bytes};
+        benches[n++] = (Bench){"io/write/xz", bench_write_io, &xz, 1, bytes};
+        benches[n++] = (Bench){"io/read/plain", bench_read_io, &plain, 1, bytes};
+        benches[n++] = (Bench){"io/read/xz", bench_read_io, &xz, 1, bytes};
+    }
+
+    printf("GBLN C FFI benchmarks (%s, %s)\n\n", platform(),
+           COUNT_ALLOCS ? "allocations counted" : "allocations not counted");
+    printf("%-28s %10s %12s %10s %10s\n", "benchmark", "ops", "ns/op", "MB/s", "allocs/op");
+    for (size_t i = 0; i < n; i++) {
+        if (!filter || strstr(benches[i].name, filter)) {
+            run_bench(&benches[i]);
+        }
+    }
+    if (!have_io) {
+        const char* io_names[4] = {"io/write/plain", "io/write/xz", "io/read/plain", "io/read/xz"};
+        for (int i = 0; i < 4; i++) {
+            if (!filter || strstr(io_names[i], filter)) {
+                skip_bench(io_names[i], "not exported by this library");
+            }
+        }
+    }
+
+    if (have_io) {
+        config_free(plain.config);
+        config_free(xz.config);
+        remove(plain_path);
+        remove(xz_path);
+    }
+    for (int i = 0; i < 3; i++) {
+        gbln_value_free(docs[i]);
+        gbln_string_free(pretty[i]);
+        free(mini[i]);
+    }
+    return 0;
+}
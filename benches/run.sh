@@ -0,0 +1,65 @@
+#!/usr/bin/env sh
+#
+# GBLN C FFI - Benchmarks
+#
+# Builds benches/bench_gbln.c against a GBLN C FFI library and runs it.
+#
+# Usage:
+#   benches/run.sh [platform | library-dir] [filter]
+#
+#   platform:    a directory under libs/ (default: this host, e.g. linux-x64)
+#   library-dir: any directory containing libgbln, e.g. target/release
+#   filter:      only run benchmarks whose name contains this string
+#
+# Environment:
+#   CC:            C compiler (default: cc)
+#   GBLN_BENCH_MS: minimum time per benchmark in milliseconds (default: 300)
+#
+# Numbers from different platforms are comparable as long as the same
+# benches/bench_gbln.c is used: it only calls the original 0.9 API.
+#
+
+set -eu
+
+cd "$(dirname "$0")/.."
+
+host_platform() {
+    case "$(uname -s)" in
+        Linux) os=linux ;;
+        FreeBSD) os=freebsd ;;
+        Darwin) os=macos ;;
+        *) os=unknown ;;
+    esac
+    case "$(uname -m)" in
+        x86_64 | amd64) arch=x64 ;;
+        aarch64 | arm64) arch=arm64 ;;
+        *) arch=unknown ;;
+    esac
+    echo "$os-$arch"
+}
+
+target=${1:-$(host_platform)}
+filter=${2:-}
+
+if [ -d "$target" ]; then
+    lib_dir=$target
+elif [ -d "libs/$target" ]; then
+    lib_dir=libs/$target
+else
+    echo "No library for '$target' (expected a directory or one of: $(ls libs | tr '\n' ' '))" >&2
+    exit 1
+fi
+lib_dir=$(cd "$lib_dir" && pwd)
+
+extra_libs=""
+if [ "$(uname -s)" = Linux ]; then
+    extra_libs="-ldl"
+fi
+
+out=${TMPDIR:-/tmp}/bench_gbln
+# shellcheck disable=SC2086
+${CC:-cc} -std=c11 -O2 -Iinclude -o "$out" benches/bench_gbln.c \
+    -L"$lib_dir" -lgbln -Wl,-rpath,"$lib_dir" -lm $extra_libs
+
+echo "Library: $lib_dir"
+"$out" $filter
@@ -14,6 +14,7 @@ fn main() {
         .with_include_guard("GBLN_H")
         .with_pragma_once(true)
         .with_tab_width(4)
+        .with_trailer(include_str!("src/gbln_inline.h"))
         .generate()
         .expect("Unable to generate C header file")
         .write_to_file(output_file);
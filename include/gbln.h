@@ -8,6 +8,32 @@
 #include <stdint.h>
 #include <stdlib.h>
 
+/**
+ * Buckets of each latency histogram
+ *
+ * Bucket `i` counts calls taking `[2^i, 2^(i+1))` nanoseconds; the last
+ * bucket also counts everything slower.
+ */
+#define GBLN_STATS_BUCKETS 32
+
+/**
+ * Compression codec used when `compress` is set
+ */
+typedef enum GblnCodec {
+    /**
+     * XZ (LZMA2): best ratio, the default
+     */
+    CodecXz = 0,
+    /**
+     * Zstandard: fast, good ratio (requires the `zstd` feature)
+     */
+    CodecZstd = 1,
+    /**
+     * LZ4 frame: fastest, lowest ratio (requires the `lz4` feature)
+     */
+    CodecLz4 = 2,
+} GblnCodec;
+
 /**
  * C-compatible error codes
  *
@@ -27,8 +53,30 @@ typedef enum GblnErrorCode {
     ErrorDuplicateKey = 10,
     ErrorNullPointer = 11,
     ErrorIo = 12,
+    ErrorAborted = 13,
+    ErrorBufferTooSmall = 14,
 } GblnErrorCode;
 
+/**
+ * Return code of an event callback
+ */
+typedef enum GblnEventAction {
+    /**
+     * Keep parsing
+     */
+    EventContinue = 0,
+    /**
+     * Skip the object or array just opened, or the value of the key just
+     * reported; no events are delivered for it (including its end event).
+     * Same as `EventContinue` for other callbacks.
+     */
+    EventSkip = 1,
+    /**
+     * Stop parsing; `gbln_parse_events()` returns `GBLN_ERROR_ABORTED`
+     */
+    EventAbort = 2,
+} GblnEventAction;
+
 /**
  * Value type enum for C FFI
  *
@@ -65,11 +113,284 @@ typedef enum GblnValueType {
  */
 typedef struct GblnValue GblnValue;
 
+/**
+ * Arena-backed parsed document
+ *
+ * Owns a parsed value tree whose nodes all live in the document's slabs.
+ * Resetting or freeing the document releases the whole tree at once.
+ */
+typedef struct GblnDocument GblnDocument;
+
+/**
+ * Borrowed byte range
+ */
+typedef struct GblnSlice {
+    const uint8_t *ptr;
+    uintptr_t len;
+} GblnSlice;
+
+/**
+ * Options for `gbln_parse_batch()`
+ */
+typedef struct GblnBatchOptions {
+    /**
+     * Worker threads to use (0 = one per available CPU)
+     */
+    uintptr_t threads;
+    /**
+     * Skip UTF-8 validation (every input MUST already be valid UTF-8)
+     */
+    bool trusted;
+} GblnBatchOptions;
+
 /**
  * Opaque wrapper for GblnConfig
  */
 typedef struct GblnConfig GblnConfig;
 
+/**
+ * Structured description of a parse error
+ *
+ * Read with `gbln_last_error_info()` without allocating. `message` points
+ * to static text and is NOT null-terminated; use `message_len`.
+ */
+typedef struct GblnErrorInfo {
+    enum GblnErrorCode code;
+    /**
+     * Byte offset of the error in the input (0 if not tied to a position,
+     * or for core parser errors, which only carry line and column)
+     */
+    uintptr_t offset;
+    /**
+     * 1-based line of `offset` (0 if unknown)
+     */
+    uintptr_t line;
+    /**
+     * 1-based column of `offset` in bytes (0 if unknown)
+     */
+    uintptr_t column;
+    const char *message;
+    uintptr_t message_len;
+} GblnErrorInfo;
+
+/**
+ * Typed scalar as delivered to an event handler or by `gbln_value_view()`
+ *
+ * `value_type` is the parsed type. The value is stored widened:
+ * - I8..I64 in `int_value`
+ * - U8..U64 in `uint_value`
+ * - F32, F64 in `float_value`
+ * - Bool in `bool_value`
+ * - Str in `str_ptr` / `str_len` (NOT null-terminated, valid only during the
+ *   callback, or for a view as long as the viewed value)
+ * - Object, Array: `value_type` only
+ *
+ * This layout is stable; the `gbln_scalar_*()` inline functions read it
+ * without a call into the library.
+ */
+typedef struct GblnScalar {
+    enum GblnValueType value_type;
+    int64_t int_value;
+    uint64_t uint_value;
+    double float_value;
+    bool bool_value;
+    const char *str_ptr;
+    uintptr_t str_len;
+} GblnScalar;
+
+/**
+ * Event callbacks for `gbln_parse_events()`
+ *
+ * Any callback may be NULL; its events are then ignored (as if it returned
+ * `EventContinue`). Keys are NOT null-terminated and, like string scalars,
+ * are only valid for the duration of the callback.
+ */
+typedef struct GblnEventHandler {
+    enum GblnEventAction (*begin_object)(void *ctx);
+    enum GblnEventAction (*end_object)(void *ctx);
+    enum GblnEventAction (*key)(void *ctx, const char *key, uintptr_t len);
+    enum GblnEventAction (*begin_array)(void *ctx);
+    enum GblnEventAction (*end_array)(void *ctx);
+    enum GblnEventAction (*scalar)(void *ctx, const struct GblnScalar *value);
+} GblnEventHandler;
+
+/**
+ * Cursor over the fields of an object
+ *
+ * Lives on the caller's stack; the contents are private. Set up with
+ * `gbln_object_iter_begin()` and advance with `gbln_object_iter_next()`.
+ * No cleanup is needed.
+ *
+ * # Safety
+ * - Pass it to `gbln_object_iter_begin()` before `gbln_object_iter_next()`;
+ *   until then it is uninitialised storage. `gbln_object_iter_begin()`
+ *   leaves an empty iterator on every error with a non-NULL `it`.
+ */
+typedef struct GblnObjectIter {
+    uint64_t state[8];
+} GblnObjectIter;
+
+/**
+ * Read-only compact index over an object's fields
+ *
+ * Borrows the object it was built from: the object must outlive the index
+ * and must not be modified while the index is in use.
+ */
+typedef struct GblnObjectIndex GblnObjectIndex;
+
+/**
+ * Prepared object key
+ *
+ * Holds a validated copy of the key name and its precomputed hash. Create
+ * once with `gbln_key_intern()` and reuse for any number of lookups. The
+ * hash is only used by `gbln_object_index_get()`.
+ */
+typedef struct GblnKey GblnKey;
+
+/**
+ * Node of a lazy document
+ *
+ * Owned by its document; pointers stay valid until `gbln_lazy_free()`.
+ */
+typedef struct GblnLazyNode GblnLazyNode;
+
+/**
+ * Lazily decoded document
+ *
+ * Borrows its input buffer. Not thread-safe: a document and its nodes must
+ * only be used from one thread at a time.
+ */
+typedef struct GblnLazyDocument GblnLazyDocument;
+
+/**
+ * Reusable parser context
+ *
+ * Owns scratch buffers, a pool of buffers recycled from earlier values and
+ * its own error state. A worker that parses similar messages and hands
+ * finished values back with `gbln_parser_recycle()` stops allocating once
+ * the pools are warm.
+ */
+typedef struct GblnParser GblnParser;
+
+/**
+ * Compiled path query
+ *
+ * Create with `gbln_path_compile()` and reuse for any number of lookups.
+ */
+typedef struct GblnPath GblnPath;
+
+/**
+ * Description of one struct field for `gbln_schema_compile()`
+ */
+typedef struct GblnSchemaField {
+    /**
+     * Object key (null-terminated UTF-8)
+     */
+    const char *name;
+    /**
+     * Scalar type of the field; Object, Array and Null are not allowed
+     */
+    enum GblnValueType value_type;
+    /**
+     * Byte offset of the field in the struct (`offsetof`)
+     */
+    uintptr_t offset;
+    /**
+     * Byte size of the field (`sizeof`); for Str the buffer size
+     */
+    uintptr_t size;
+    /**
+     * Fail decoding if the key is missing
+     */
+    bool required;
+} GblnSchemaField;
+
+/**
+ * Compiled struct layout
+ *
+ * Create with `gbln_schema_compile()`; reusable and safe to share between
+ * threads.
+ */
+typedef struct GblnSchema GblnSchema;
+
+/**
+ * Counters of one instrumented operation
+ */
+typedef struct GblnOpStats {
+    /**
+     * Completed calls, successful or not
+     */
+    uint64_t calls;
+    /**
+     * Bytes parsed, serialised, read or written
+     */
+    uint64_t bytes;
+    /**
+     * Total wall time in nanoseconds
+     */
+    uint64_t total_ns;
+    /**
+     * Latency histogram (see `GBLN_STATS_BUCKETS`)
+     */
+    uint64_t histogram[GBLN_STATS_BUCKETS];
+} GblnOpStats;
+
+/**
+ * Snapshot of all counters
+ *
+ * Operations:
+ * - parse: `gbln_parse()`, `gbln_parse_n()`; bytes are input bytes
+ * - to_string: `gbln_to_string()`, `gbln_to_string_pretty()`,
+ *   `gbln_to_buffer()`; bytes are output bytes
+ * - read_io: `gbln_read_io()`, `gbln_read_io_parallel()`,
+ *   `gbln_read_io_mmap()`; bytes are file bytes
+ * - write_io: `gbln_write_io()`, `gbln_write_io_stream()`; bytes are file
+ *   bytes
+ *
+ * `compress_ns` and `decompress_ns` are time spent inside a codec,
+ * including the file writes or reads it makes; for write_io and read_io the
+ * rest of `total_ns` is (de)serialisation. Single-threaded XZ writes are
+ * done by the core library and are not split. Allocations count every
+ * allocation made by this library while enabled.
+ */
+typedef struct GblnStats {
+    struct GblnOpStats parse;
+    struct GblnOpStats to_string;
+    struct GblnOpStats read_io;
+    struct GblnOpStats write_io;
+    uint64_t compress_ns;
+    uint64_t decompress_ns;
+    uint64_t allocations;
+    uint64_t allocated_bytes;
+} GblnStats;
+
+/**
+ * Incremental parser state
+ *
+ * Input is either a sequence of top-level values, each delivered as it
+ * closes, or a single root array (first token `[`), whose elements are
+ * delivered one by one.
+ */
+typedef struct GblnStream GblnStream;
+
+/**
+ * Callback receiving each complete value of a stream
+ *
+ * Takes ownership of `value`, which must be freed with `gbln_value_free()`.
+ * Return `GBLN_OK` to continue; any other code stops the stream and is
+ * returned from the `gbln_stream_feed()` call that delivered the value.
+ */
+typedef enum GblnErrorCode (*GblnStreamCallback)(void *ctx, struct GblnValue *value);
+
+/**
+ * Callback receiving each chunk of serialised output
+ *
+ * `data` is only valid for the duration of the call. Return `GBLN_OK` to
+ * continue; any other code stops serialisation and is returned from
+ * `gbln_to_writer()`.
+ */
+typedef enum GblnErrorCode (*GblnWriteCallback)(void *ctx, const uint8_t *data, uintptr_t len);
+
 /**
  * Parse GBLN string into a value
  *
@@ -84,6 +405,33 @@ typedef struct GblnConfig GblnConfig;
  */
 enum GblnErrorCode gbln_parse(const char *input, struct GblnValue **out_value);
 
+/**
+ * Parse a length-delimited GBLN buffer into a value
+ *
+ * Unlike `gbln_parse()`, the input does not need to be null-terminated,
+ * so payloads can be parsed straight out of network buffers or mapped files.
+ *
+ * # Parameters
+ * - input: Pointer to the first byte of the GBLN text
+ * - len: Number of bytes to parse
+ * - trusted: Skip UTF-8 validation (input MUST already be valid UTF-8)
+ * - out_value: Pointer to store the result
+ *
+ * # Safety
+ * - `input` must point to at least `len` readable bytes
+ * - If `trusted` is true, the bytes must be valid UTF-8; otherwise behaviour is undefined
+ * - `out_value` must be a valid pointer to store the result
+ * - Caller must free the returned value with `gbln_value_free()`
+ *
+ * # Returns
+ * - `GBLN_OK` on success, with `out_value` set to the parsed value
+ * - Error code on failure, with error details available via `gbln_last_error_message()`
+ */
+enum GblnErrorCode gbln_parse_n(const uint8_t *input,
+                                uintptr_t len,
+                                bool trusted,
+                                struct GblnValue **out_value);
+
 /**
  * Free a GBLN value
  *
@@ -177,179 +525,593 @@ uintptr_t gbln_array_len(const struct GblnValue *value);
 const struct GblnValue *gbln_array_get(const struct GblnValue *value, uintptr_t index);
 
 /**
- * Get i8 value
+ * Create an empty arena-backed document
+ *
+ * # Parameters
+ * - initial_capacity: Size of the first slab in bytes (0 = 64 KiB; ignored
+ *   without the `arena` feature)
  *
  * # Safety
- * - `value` must be a valid GblnValue pointer
- * - `ok` will be set to true if value is i8, false otherwise
+ * Caller must free with `gbln_document_free()`
  */
-int8_t gbln_value_as_i8(const struct GblnValue *value, bool *ok);
+struct GblnDocument *gbln_document_new(uintptr_t initial_capacity);
 
 /**
- * Get i16 value
+ * Pre-allocate a document's slabs
+ *
+ * Makes sure the document's slabs hold at least `bytes` in total, so
+ * parses that fit take no memory from the system. Reserved slabs are kept
+ * across resets like any other. Without the `arena` feature nothing is
+ * reserved.
+ *
+ * # Returns
+ * - true if the slabs now hold `bytes` (always, without the `arena` feature)
+ * - false if `doc` is NULL or the memory could not be allocated
+ *
+ * # Safety
+ * - `doc` must be a valid GblnDocument pointer or NULL
+ * - Must not be called while the document is being parsed into
  */
-int16_t gbln_value_as_i16(const struct GblnValue *value, bool *ok);
+bool gbln_document_reserve(struct GblnDocument *doc, uintptr_t bytes);
 
 /**
- * Get i32 value
+ * Parse a GBLN buffer into an arena-backed document
+ *
+ * Any previously parsed tree in the document is discarded first, so one
+ * document can be reused for a stream of messages without returning its
+ * memory to the system.
+ *
+ * Documents are only arena-backed when the library is built with the
+ * `arena` feature; otherwise the tree is an ordinary heap tree.
+ *
+ * # Parameters
+ * - doc: Document from `gbln_document_new()`
+ * - input: Pointer to the first byte of the GBLN text
+ * - len: Number of bytes to parse
+ * - trusted: Skip UTF-8 validation (input MUST already be valid UTF-8)
+ * - out_root: Receives the root value (may be NULL, see `gbln_document_root()`)
+ *
+ * # Returns
+ * - GBLN_OK on success
+ * - Error code on failure, with error details via `gbln_last_error_message()`
+ *
+ * # Safety
+ * - `input` must point to at least `len` readable bytes
+ * - The root and all values reached from it are valid until the next
+ *   `gbln_document_parse()`, `gbln_document_reset()` or `gbln_document_free()`
+ * - Values owned by a document must NOT be passed to `gbln_value_free()`
+ *   or to functions that modify values
+ * - A document must not be parsed from two threads at the same time
  */
-int32_t gbln_value_as_i32(const struct GblnValue *value, bool *ok);
+enum GblnErrorCode gbln_document_parse(struct GblnDocument *doc,
+                                       const uint8_t *input,
+                                       uintptr_t len,
+                                       bool trusted,
+                                       const struct GblnValue **out_root);
 
 /**
- * Get i64 value
+ * Get the root value of a document
+ *
+ * Returns NULL if the document is empty or the last parse failed.
+ *
+ * # Safety
+ * - `doc` must be a valid GblnDocument pointer
+ * - Returned pointer is valid until the document is parsed into, reset or freed
  */
-int64_t gbln_value_as_i64(const struct GblnValue *value, bool *ok);
+const struct GblnValue *gbln_document_root(const struct GblnDocument *doc);
 
 /**
- * Get u8 value
+ * Discard the document's tree, keeping its slabs for reuse
+ *
+ * With the `arena` feature, cost is independent of the size of the tree.
+ *
+ * # Safety
+ * - `doc` must be a valid GblnDocument pointer or NULL
+ * - All pointers obtained from the document become invalid
  */
-uint8_t gbln_value_as_u8(const struct GblnValue *value, bool *ok);
+void gbln_document_reset(struct GblnDocument *doc);
 
 /**
- * Get u16 value
+ * Free a document and all of its values
+ *
+ * With the `arena` feature, cost is independent of the size of the tree.
+ *
+ * # Safety
+ * - `doc` must be a valid pointer from `gbln_document_new()` or NULL
+ * - Must not be called twice on the same pointer
  */
-uint16_t gbln_value_as_u16(const struct GblnValue *value, bool *ok);
+void gbln_document_free(struct GblnDocument *doc);
 
 /**
- * Get u32 value
+ * Copy an array of i8 values into a C buffer
+ *
+ * # Parameters
+ * - value: Array to copy
+ * - out: Destination buffer (may be NULL if `cap` is 0)
+ * - cap: Capacity of `out` in elements
+ * - n: Set to the number of elements in the array
+ * - widen: Also accept elements that convert to the target type without
+ *   loss (e.g. `<u8>` into `int32_t`, `<f32>` or `<i32>` into `double`)
+ *
+ * # Returns
+ * - GBLN_OK with all `*n` elements copied
+ * - GBLN_ERROR_BUFFER_TOO_SMALL if the array has more than `cap` elements
+ *   (nothing is copied; `*n` is the required capacity)
+ * - GBLN_ERROR_TYPE_MISMATCH if `value` is not an array, or an element is
+ *   of another type; `*n` is then the index of that element and `out` holds
+ *   the elements before it
+ * - GBLN_ERROR_NULL_POINTER if value or n is NULL
+ *
+ * # Safety
+ * - `value` must be a valid GblnValue pointer
+ * - `out` must point to at least `cap` writable elements
  */
-uint32_t gbln_value_as_u32(const struct GblnValue *value, bool *ok);
+enum GblnErrorCode gbln_array_copy_i8(const struct GblnValue *value,
+                                      int8_t *out,
+                                      uintptr_t cap,
+                                      uintptr_t *n,
+                                      bool widen);
 
 /**
- * Get u64 value
+ * Copy an array of i16 values into a C buffer (see `gbln_array_copy_i8()`)
  */
-uint64_t gbln_value_as_u64(const struct GblnValue *value, bool *ok);
+enum GblnErrorCode gbln_array_copy_i16(const struct GblnValue *value,
+                                       int16_t *out,
+                                       uintptr_t cap,
+                                       uintptr_t *n,
+                                       bool widen);
 
 /**
- * Get f32 value
+ * Copy an array of i32 values into a C buffer (see `gbln_array_copy_i8()`)
  */
-float gbln_value_as_f32(const struct GblnValue *value, bool *ok);
+enum GblnErrorCode gbln_array_copy_i32(const struct GblnValue *value,
+                                       int32_t *out,
+                                       uintptr_t cap,
+                                       uintptr_t *n,
+                                       bool widen);
 
 /**
- * Get f64 value
+ * Copy an array of i64 values into a C buffer (see `gbln_array_copy_i8()`)
  */
-double gbln_value_as_f64(const struct GblnValue *value, bool *ok);
+enum GblnErrorCode gbln_array_copy_i64(const struct GblnValue *value,
+                                       int64_t *out,
+                                       uintptr_t cap,
+                                       uintptr_t *n,
+                                       bool widen);
 
 /**
- * Get string value
- *
- * # Safety
- * - Returns a pointer to a null-terminated C string
- * - Caller must free the returned string with `gbln_string_free()`
- * - Returns NULL if value is not a string
+ * Copy an array of u8 values into a C buffer (see `gbln_array_copy_i8()`)
  */
-char *gbln_value_as_string(const struct GblnValue *value, bool *ok);
+enum GblnErrorCode gbln_array_copy_u8(const struct GblnValue *value,
+                                      uint8_t *out,
+                                      uintptr_t cap,
+                                      uintptr_t *n,
+                                      bool widen);
 
 /**
- * Get bool value
+ * Copy an array of u16 values into a C buffer (see `gbln_array_copy_i8()`)
  */
-bool gbln_value_as_bool(const struct GblnValue *value, bool *ok);
+enum GblnErrorCode gbln_array_copy_u16(const struct GblnValue *value,
+                                       uint16_t *out,
+                                       uintptr_t cap,
+                                       uintptr_t *n,
+                                       bool widen);
 
 /**
- * Check if value is null
+ * Copy an array of u32 values into a C buffer (see `gbln_array_copy_i8()`)
  */
-bool gbln_value_is_null(const struct GblnValue *value);
+enum GblnErrorCode gbln_array_copy_u32(const struct GblnValue *value,
+                                       uint32_t *out,
+                                       uintptr_t cap,
+                                       uintptr_t *n,
+                                       bool widen);
 
 /**
- * Create default I/O configuration
+ * Copy an array of u64 values into a C buffer (see `gbln_array_copy_i8()`)
+ */
+enum GblnErrorCode gbln_array_copy_u64(const struct GblnValue *value,
+                                       uint64_t *out,
+                                       uintptr_t cap,
+                                       uintptr_t *n,
+                                       bool widen);
+
+/**
+ * Copy an array of f32 values into a C buffer (see `gbln_array_copy_i8()`)
+ */
+enum GblnErrorCode gbln_array_copy_f32(const struct GblnValue *value,
+                                       float *out,
+                                       uintptr_t cap,
+                                       uintptr_t *n,
+                                       bool widen);
+
+/**
+ * Copy an array of f64 values into a C buffer (see `gbln_array_copy_i8()`)
+ */
+enum GblnErrorCode gbln_array_copy_f64(const struct GblnValue *value,
+                                       double *out,
+                                       uintptr_t cap,
+                                       uintptr_t *n,
+                                       bool widen);
+
+/**
+ * Parse many independent GBLN messages, spread over worker threads
  *
- * Returns configuration for production I/O format:
- * - mini_mode: true
- * - compress: true
- * - compression_level: 6
- * - indent: 2
- * - strip_comments: true
+ * Workers come from a pool started on the first parallel call and kept for
+ * later calls, so thread start-up is paid once per process, not per batch.
+ * The calling thread parses alongside them. Batches under 64 items are
+ * parsed on the calling thread alone.
+ *
+ * # Parameters
+ * - inputs: Array of `n` input byte ranges
+ * - n: Number of inputs
+ * - outs: Array of `n` slots; each receives the parsed value or NULL
+ * - codes: Array of `n` slots; each receives that item's result code
+ * - options: Threads and trust settings (NULL = all CPUs, validate UTF-8)
+ *
+ * # Returns
+ * - GBLN_OK if every item parsed
+ * - Otherwise the code of the lowest-indexed failing item, whose message is
+ *   available via `gbln_last_error_message()` on the calling thread
  *
  * # Safety
- * Caller must free with `gbln_config_free()`
+ * - `inputs`, `outs` and `codes` must each point to `n` elements
+ * - Every input must point to at least `len` readable bytes
+ * - Caller must free every non-NULL value in `outs` with `gbln_value_free()`
  */
-struct GblnConfig *gbln_config_new_io(void);
+enum GblnErrorCode gbln_parse_batch(const struct GblnSlice *inputs,
+                                    uintptr_t n,
+                                    struct GblnValue **outs,
+                                    enum GblnErrorCode *codes,
+                                    const struct GblnBatchOptions *options);
 
 /**
- * Create default source configuration
+ * Serialize GBLN value into the binary format
  *
- * Returns configuration for human-readable source:
- * - mini_mode: false
- * - compress: false
- * - compression_level: 6
- * - indent: 2
- * - strip_comments: false
+ * Every type is preserved exactly. Call with `cap` 0 (and `buf` NULL) to
+ * query the size.
+ *
+ * # Parameters
+ * - value: GBLN value to encode
+ * - buf: Destination buffer (may be NULL if `cap` is 0)
+ * - cap: Size of `buf` in bytes
+ * - written: Set to the size of the encoding
+ *
+ * # Returns
+ * - GBLN_OK on success
+ * - GBLN_ERROR_BUFFER_TOO_SMALL if `cap` is less than `*written`; the
+ *   contents of `buf` are then unspecified
+ * - GBLN_ERROR_NULL_POINTER if value or written is NULL
  *
  * # Safety
- * Caller must free with `gbln_config_free()`
+ * - `value` must be a valid GblnValue pointer
+ * - `buf` must point to at least `cap` writable bytes
  */
-struct GblnConfig *gbln_config_new_source(void);
+enum GblnErrorCode gbln_to_binary(const struct GblnValue *value,
+                                  uint8_t *buf,
+                                  uintptr_t cap,
+                                  uintptr_t *written);
 
 /**
- * Create custom configuration
+ * Decode a binary GBLN document
  *
  * # Parameters
- * - mini_mode: Use MINI GBLN (no whitespace)
- * - compress: Enable XZ compression
- * - compression_level: XZ level (0-9, where 9 is maximum)
- * - indent: Indentation width (0 = no indent)
- * - strip_comments: Remove comments in output
+ * - buf: Encoded bytes, as from `gbln_to_binary()`
+ * - len: Number of bytes
+ * - out_value: Pointer to store the decoded value
+ *
+ * # Returns
+ * - GBLN_OK on success
+ * - GBLN_ERROR_INVALID_SYNTAX if the bytes are not a valid binary document
+ * - GBLN_ERROR_INT_OUT_OF_RANGE if an integer exceeds its type
+ * - GBLN_ERROR_DUPLICATE_KEY if an object repeats a key
+ * - GBLN_ERROR_NULL_POINTER if buf or out_value is NULL
+ * - Error position via `gbln_last_error_info()`
  *
  * # Safety
- * Caller must free with `gbln_config_free()`
+ * - `buf` must point to at least `len` readable bytes
+ * - Caller must free the value with `gbln_value_free()`
  */
-struct GblnConfig *gbln_config_new(bool mini_mode,
-                                   bool compress,
-                                   uint8_t compression_level,
-                                   uintptr_t indent,
-                                   bool strip_comments);
+enum GblnErrorCode gbln_from_binary(const uint8_t *buf,
+                                    uintptr_t len,
+                                    struct GblnValue **out_value);
 
 /**
- * Free configuration
+ * Check whether a codec is compiled into this build
  *
- * # Safety
- * - config must be a valid pointer from gbln_config_new_*() or NULL
- * - Must not be called twice on the same pointer
+ * `codec` is a `GblnCodec` value; values that name no codec are not
+ * supported.
  */
-void gbln_config_free(struct GblnConfig *config);
+bool gbln_codec_supported(uint32_t codec);
 
 /**
- * Get mini_mode setting
+ * Deep copy a value
+ *
+ * The copy is an independent root value, whatever `value` is (a root, a
+ * child pointer, a shared value or a lazy node's value).
+ *
+ * # Safety
+ * - `value` must be a valid GblnValue pointer
+ * - Caller must free the copy with `gbln_value_free()`
+ *
+ * # Returns
+ * - The copy, or NULL if `value` is NULL
  */
-bool gbln_config_get_mini_mode(const struct GblnConfig *config);
+struct GblnValue *gbln_value_clone(const struct GblnValue *value);
 
 /**
- * Get compress setting
+ * Check whether two values are structurally equal
+ *
+ * Types must match exactly and floats compare bit for bit; object field
+ * order does not matter. Does not allocate.
+ *
+ * # Safety
+ * - `a` and `b` must be valid GblnValue pointers
+ *
+ * # Returns
+ * - true if both are NULL or the values are equal
+ * - false otherwise
  */
-bool gbln_config_get_compress(const struct GblnConfig *config);
+bool gbln_value_equals(const struct GblnValue *a, const struct GblnValue *b);
 
 /**
- * Get compression_level setting
+ * Compute a stable 64-bit structural hash of a value
+ *
+ * Equal values (see `gbln_value_equals()`) have equal hashes, independent
+ * of object field order. The hash is the same across runs, processes and
+ * platforms, but is not cryptographic. Does not allocate.
+ *
+ * # Safety
+ * - `value` must be a valid GblnValue pointer
+ *
+ * # Returns
+ * - The hash, or 0 if `value` is NULL
  */
-uint8_t gbln_config_get_compression_level(const struct GblnConfig *config);
+uint64_t gbln_value_hash(const struct GblnValue *value);
 
 /**
- * Get indent setting
+ * Get i8 value
+ *
+ * # Safety
+ * - `value` must be a valid GblnValue pointer
+ * - `ok` will be set to true if value is i8, false otherwise
  */
-uintptr_t gbln_config_get_indent(const struct GblnConfig *config);
+int8_t gbln_value_as_i8(const struct GblnValue *value, bool *ok);
 
 /**
- * Get strip_comments setting
+ * Get i16 value
  */
-bool gbln_config_get_strip_comments(const struct GblnConfig *config);
+int16_t gbln_value_as_i16(const struct GblnValue *value, bool *ok);
 
 /**
- * Set mini_mode setting
+ * Get i32 value
  */
-void gbln_config_set_mini_mode(struct GblnConfig *config, bool value);
+int32_t gbln_value_as_i32(const struct GblnValue *value, bool *ok);
 
 /**
- * Set compress setting
+ * Get i64 value
  */
-void gbln_config_set_compress(struct GblnConfig *config, bool value);
+int64_t gbln_value_as_i64(const struct GblnValue *value, bool *ok);
 
 /**
- * Set compression_level setting (0-9)
+ * Get u8 value
  */
-void gbln_config_set_compression_level(struct GblnConfig *config, uint8_t value);
+uint8_t gbln_value_as_u8(const struct GblnValue *value, bool *ok);
 
 /**
- * Set indent setting
+ * Get u16 value
+ */
+uint16_t gbln_value_as_u16(const struct GblnValue *value, bool *ok);
+
+/**
+ * Get u32 value
+ */
+uint32_t gbln_value_as_u32(const struct GblnValue *value, bool *ok);
+
+/**
+ * Get u64 value
+ */
+uint64_t gbln_value_as_u64(const struct GblnValue *value, bool *ok);
+
+/**
+ * Get f32 value
+ */
+float gbln_value_as_f32(const struct GblnValue *value, bool *ok);
+
+/**
+ * Get f64 value
+ */
+double gbln_value_as_f64(const struct GblnValue *value, bool *ok);
+
+/**
+ * Get string value
+ *
+ * # Safety
+ * - Returns a pointer to a null-terminated C string
+ * - Caller must free the returned string with `gbln_string_free()`
+ * - Returns NULL if value is not a string
+ */
+char *gbln_value_as_string(const struct GblnValue *value, bool *ok);
+
+/**
+ * Get borrowed view of string value
+ *
+ * Zero-copy alternative to `gbln_value_as_string()`: returns a pointer into
+ * the value's own storage instead of allocating a new C string.
+ *
+ * # Safety
+ * - `value` must be a valid GblnValue pointer
+ * - `out_len` receives the length in bytes (may be NULL)
+ * - The returned bytes are UTF-8 and NOT null-terminated; use `out_len`
+ * - Returned pointer is valid as long as the parent value is valid
+ * - Must NOT be freed with `gbln_string_free()`
+ * - Returns NULL if value is not a string
+ */
+const char *gbln_value_as_str(const struct GblnValue *value, uintptr_t *out_len, bool *ok);
+
+/**
+ * Get bool value
+ */
+bool gbln_value_as_bool(const struct GblnValue *value, bool *ok);
+
+/**
+ * Check if value is null
+ */
+bool gbln_value_is_null(const struct GblnValue *value);
+
+/**
+ * Read a value's type and scalar into a caller-owned GblnScalar
+ *
+ * One call instead of `gbln_value_type()` plus a `gbln_value_as_*()`; the
+ * `gbln_scalar_*()` inline functions then read `out` with no further calls.
+ *
+ * # Returns
+ * - true on success
+ * - false if value or out is NULL
+ *
+ * # Safety
+ * - `value` must be a valid GblnValue pointer
+ * - A string view is valid as long as `value` is
+ */
+bool gbln_value_view(const struct GblnValue *value, struct GblnScalar *out);
+
+/**
+ * View the elements of an array into a caller-provided GblnScalar array
+ *
+ * Fills `out` with the first `cap` elements (as by `gbln_value_view()`), so
+ * a loop over the array reads fields inline instead of calling
+ * `gbln_array_get()` and `gbln_value_as_*()` per element.
+ *
+ * # Returns
+ * - The array length (more than `cap` if `out` was too small)
+ * - 0 if value is NULL or not an array
+ *
+ * # Safety
+ * - `value` must be a valid GblnValue pointer
+ * - `out` must point to at least `cap` GblnScalars (may be NULL if `cap` is 0)
+ * - String views are valid as long as `value` is
+ */
+uintptr_t gbln_array_view(const struct GblnValue *value, struct GblnScalar *out, uintptr_t cap);
+
+/**
+ * Create default I/O configuration
+ *
+ * Returns configuration for production I/O format:
+ * - mini_mode: true
+ * - compress: true
+ * - compression_level: 6
+ * - indent: 2
+ * - strip_comments: true
+ * - codec: XZ, threads: 1, binary: false
+ *
+ * # Safety
+ * Caller must free with `gbln_config_free()`
+ */
+struct GblnConfig *gbln_config_new_io(void);
+
+/**
+ * Create default source configuration
+ *
+ * Returns configuration for human-readable source:
+ * - mini_mode: false
+ * - compress: false
+ * - compression_level: 6
+ * - indent: 2
+ * - strip_comments: false
+ * - codec: XZ, threads: 1, binary: false
+ *
+ * # Safety
+ * Caller must free with `gbln_config_free()`
+ */
+struct GblnConfig *gbln_config_new_source(void);
+
+/**
+ * Create custom configuration
+ *
+ * # Parameters
+ * - mini_mode: Use MINI GBLN (no whitespace)
+ * - compress: Enable XZ compression
+ * - compression_level: XZ level (0-9, where 9 is maximum)
+ * - indent: Indentation width (0 = no indent)
+ * - strip_comments: Remove comments in output
+ *
+ * # Safety
+ * Caller must free with `gbln_config_free()`
+ */
+struct GblnConfig *gbln_config_new(bool mini_mode,
+                                   bool compress,
+                                   uint8_t compression_level,
+                                   uintptr_t indent,
+                                   bool strip_comments);
+
+/**
+ * Free configuration
+ *
+ * # Safety
+ * - config must be a valid pointer from gbln_config_new_*() or NULL
+ * - Must not be called twice on the same pointer
+ */
+void gbln_config_free(struct GblnConfig *config);
+
+/**
+ * Get mini_mode setting
+ */
+bool gbln_config_get_mini_mode(const struct GblnConfig *config);
+
+/**
+ * Get compress setting
+ */
+bool gbln_config_get_compress(const struct GblnConfig *config);
+
+/**
+ * Get compression_level setting
+ */
+uint8_t gbln_config_get_compression_level(const struct GblnConfig *config);
+
+/**
+ * Get indent setting
+ */
+uintptr_t gbln_config_get_indent(const struct GblnConfig *config);
+
+/**
+ * Get strip_comments setting
+ */
+bool gbln_config_get_strip_comments(const struct GblnConfig *config);
+
+/**
+ * Get compression threads setting
+ */
+uint32_t gbln_config_get_threads(const struct GblnConfig *config);
+
+/**
+ * Get compression codec setting
+ */
+enum GblnCodec gbln_config_get_codec(const struct GblnConfig *config);
+
+/**
+ * Get binary encoding setting
+ */
+bool gbln_config_get_binary(const struct GblnConfig *config);
+
+/**
+ * Set mini_mode setting
+ */
+void gbln_config_set_mini_mode(struct GblnConfig *config, bool value);
+
+/**
+ * Set compress setting
+ */
+void gbln_config_set_compress(struct GblnConfig *config, bool value);
+
+/**
+ * Set compression_level setting
+ *
+ * Clamped to the codec's range when writing: XZ 0-9, zstd 0-22 (0 = its
+ * default); LZ4 has no levels.
+ */
+void gbln_config_set_compression_level(struct GblnConfig *config, uint8_t value);
+
+/**
+ * Set indent setting
  */
 void gbln_config_set_indent(struct GblnConfig *config, uintptr_t value);
 
@@ -358,6 +1120,140 @@ void gbln_config_set_indent(struct GblnConfig *config, uintptr_t value);
  */
 void gbln_config_set_strip_comments(struct GblnConfig *config, bool value);
 
+/**
+ * Set compression threads setting
+ *
+ * XZ and zstd split the output into blocks compressed in parallel.
+ * 1 = single-threaded (default), 0 = one thread per available CPU.
+ */
+void gbln_config_set_threads(struct GblnConfig *config, uint32_t value);
+
+/**
+ * Set compression codec setting
+ *
+ * Applies when compress is enabled. Codecs other than XZ must be compiled
+ * in (see `gbln_codec_supported()`). compression_level is passed to the
+ * codec as its own level (see `gbln_config_set_compression_level()`).
+ * Readers detect the codec from the file, so nothing needs setting to read.
+ *
+ * # Parameters
+ * - config: Configuration to change
+ * - value: A `GblnCodec` value
+ *
+ * # Returns
+ * - GBLN_OK on success
+ * - GBLN_ERROR_INVALID_SYNTAX if `value` names no codec; the config is
+ *   left unchanged
+ * - GBLN_ERROR_NULL_POINTER if config is NULL
+ */
+enum GblnErrorCode gbln_config_set_codec(struct GblnConfig *config, uint32_t value);
+
+/**
+ * Set binary encoding setting
+ *
+ * Writers emit the compact binary encoding (see `gbln_to_binary()`)
+ * instead of text; mini_mode and indent are then ignored, compression
+ * still applies. Readers detect the encoding from the file.
+ */
+void gbln_config_set_binary(struct GblnConfig *config, bool value);
+
+/**
+ * Compute the patch between two values
+ *
+ * The patch is empty (an array with no operations) if the values are
+ * identical. Applying it to a copy of `old` with `gbln_patch_apply()`
+ * yields a tree equal to `new`. Values of different types, including
+ * integers of different widths, are replaced rather than diffed. Arrays
+ * keep their common prefix and suffix; elements added or dropped between
+ * them cost one `insert` or `remove` each, but moved elements are not
+ * detected.
+ *
+ * # Safety
+ * - `old` and `new` must be valid GblnValue pointers
+ * - `out_patch` must be a valid pointer
+ * - Caller must free `*out_patch` with `gbln_value_free()`
+ *
+ * # Returns
+ * - GBLN_OK on success
+ * - GBLN_ERROR_NULL_POINTER if any pointer is NULL
+ */
+enum GblnErrorCode gbln_diff(const struct GblnValue *old,
+                             const struct GblnValue *new,
+                             struct GblnValue **out_patch);
+
+/**
+ * Apply a patch to a value in place
+ *
+ * Operations are applied in order. Unchanged parts of the tree are not
+ * touched; set values are copied from the patch.
+ *
+ * # Safety
+ * - `value` must be a root value owned by the caller (not a child pointer
+ *   or a shared value)
+ * - `patch` must be a valid GblnValue pointer, such as from `gbln_diff()`
+ *
+ * # Returns
+ * - GBLN_OK on success
+ * - GBLN_ERROR_INVALID_SYNTAX if the patch is malformed
+ * - GBLN_ERROR_TYPE_MISMATCH if an operation's path does not exist in
+ *   `value`
+ * - GBLN_ERROR_NULL_POINTER if any pointer is NULL
+ *
+ * On error, the operations before the failing one remain applied.
+ */
+enum GblnErrorCode gbln_patch_apply(struct GblnValue *value, const struct GblnValue *patch);
+
+/**
+ * Get structured info about the last error on this thread
+ *
+ * Reads the error without allocating or formatting anything. Errors from
+ * the native parsing calls (`gbln_parse_parallel()`, `gbln_parse_events()`,
+ * lazy documents, streams) and invalid UTF-8 input carry a byte offset,
+ * line and column. Errors from the core parser behind `gbln_parse()`,
+ * `gbln_read_io()` and documents carry line and column, with offset 0, and
+ * a static message for their kind; the core's full message is formatted
+ * by `gbln_last_error_message()`. NULL arguments and value building errors
+ * (type mismatch, duplicate key, string too long) have a static code and
+ * message, with offset, line and column 0. I/O failures only have a
+ * formatted message.
+ *
+ * # Returns
+ * - true with `out` filled if the last error has a static code and message
+ * - false if there is no error or it only has a formatted message
+ *
+ * # Safety
+ * - `out` must be a valid pointer
+ */
+bool gbln_last_error_info(struct GblnErrorInfo *out);
+
+/**
+ * Parse a GBLN buffer, reporting its structure to event callbacks
+ *
+ * No value tree is built. Events for a document arrive in order: objects as
+ * `begin_object`, then `key` + value for each field, then `end_object`;
+ * arrays as `begin_array`, elements, `end_array`.
+ *
+ * # Parameters
+ * - buf: Pointer to the first byte of the GBLN text
+ * - len: Number of bytes to parse
+ * - handler: Event callbacks
+ * - ctx: Opaque pointer passed to every callback
+ *
+ * # Returns
+ * - GBLN_OK once the whole document has been reported
+ * - GBLN_ERROR_ABORTED if a callback returned `EventAbort`
+ * - Parse error code on invalid input; events already delivered stand
+ * - Error details via `gbln_last_error_message()`
+ *
+ * # Safety
+ * - `buf` must point to at least `len` readable bytes
+ * - `handler` must be a valid pointer to a GblnEventHandler
+ */
+enum GblnErrorCode gbln_parse_events(const uint8_t *buf,
+                                     uintptr_t len,
+                                     const struct GblnEventHandler *handler,
+                                     void *ctx);
+
 /**
  * Get value type
  *
@@ -406,6 +1302,58 @@ char **gbln_object_keys(const struct GblnValue *value, uintptr_t *out_count);
  */
 void gbln_keys_free(char **keys, uintptr_t count);
 
+/**
+ * Start iterating over the fields of an object
+ *
+ * Fields are visited in unspecified order. The iterator borrows `value`:
+ * it must not be used after `value` is freed or modified.
+ *
+ * ```c
+ * GblnObjectIter it;
+ * const char* key;
+ * size_t key_len;
+ * const GblnValue* field;
+ * gbln_object_iter_begin(object, &it);
+ * while (gbln_object_iter_next(&it, &key, &key_len, &field)) { ... }
+ * ```
+ *
+ * # Safety
+ * - `value` must be a valid GblnValue pointer
+ * - `it` must be a valid pointer
+ *
+ * # Returns
+ * - GBLN_OK on success
+ * - GBLN_ERROR_TYPE_MISMATCH if value is not an object (`it` then yields
+ *   nothing)
+ * - GBLN_ERROR_NULL_POINTER if value or it is NULL (with only `value`
+ *   NULL, `it` also yields nothing)
+ */
+enum GblnErrorCode gbln_object_iter_begin(const struct GblnValue *value, struct GblnObjectIter *it);
+
+/**
+ * Advance an object iterator
+ *
+ * # Parameters
+ * - it: Iterator from `gbln_object_iter_begin()`
+ * - key: Set to the field name (NOT null-terminated, owned by the object)
+ * - key_len: Set to the length of the field name in bytes
+ * - value: Set to the field value (owned by the object)
+ *
+ * # Returns
+ * - true with the next field stored
+ * - false once all fields have been visited (outputs are not touched)
+ *
+ * # Safety
+ * - `it` must have been set up by `gbln_object_iter_begin()`, and its
+ *   object must still be valid and unmodified; an iterator that was never
+ *   passed to `gbln_object_iter_begin()` holds uninitialised storage
+ * - `key`, `key_len` and `value` must be valid pointers
+ */
+bool gbln_object_iter_next(struct GblnObjectIter *it,
+                           const char **key,
+                           uintptr_t *key_len,
+                           const struct GblnValue **value);
+
 /**
  * Create i8 value
  */
@@ -506,8 +1454,114 @@ enum GblnErrorCode gbln_object_insert(struct GblnValue *object,
                                       struct GblnValue *value);
 
 /**
- * Create empty array
- */
+ * Reserve room for at least `additional` more fields
+ *
+ * # Returns
+ * - GBLN_OK on success
+ * - GBLN_ERROR_TYPE_MISMATCH if object is not an Object type
+ * - GBLN_ERROR_NULL_POINTER if object is null
+ */
+enum GblnErrorCode gbln_object_reserve(struct GblnValue *object, uintptr_t additional);
+
+/**
+ * Insert an i8 field into object
+ *
+ * Same as `gbln_object_insert()` with `gbln_value_new_i8()`, but the
+ * value is stored in place without an intermediate boxed value.
+ *
+ * # Returns
+ * - GBLN_OK on success
+ * - GBLN_ERROR_DUPLICATE_KEY if key already exists
+ * - GBLN_ERROR_TYPE_MISMATCH if object is not an Object type
+ * - GBLN_ERROR_NULL_POINTER if object or key is null
+ */
+enum GblnErrorCode gbln_object_insert_i8(struct GblnValue *object, const char *key, int8_t value);
+
+/**
+ * Insert an i16 field into object (see `gbln_object_insert_i8()`)
+ */
+enum GblnErrorCode gbln_object_insert_i16(struct GblnValue *object, const char *key, int16_t value);
+
+/**
+ * Insert an i32 field into object (see `gbln_object_insert_i8()`)
+ */
+enum GblnErrorCode gbln_object_insert_i32(struct GblnValue *object, const char *key, int32_t value);
+
+/**
+ * Insert an i64 field into object (see `gbln_object_insert_i8()`)
+ */
+enum GblnErrorCode gbln_object_insert_i64(struct GblnValue *object, const char *key, int64_t value);
+
+/**
+ * Insert a u8 field into object (see `gbln_object_insert_i8()`)
+ */
+enum GblnErrorCode gbln_object_insert_u8(struct GblnValue *object, const char *key, uint8_t value);
+
+/**
+ * Insert a u16 field into object (see `gbln_object_insert_i8()`)
+ */
+enum GblnErrorCode gbln_object_insert_u16(struct GblnValue *object,
+                                          const char *key,
+                                          uint16_t value);
+
+/**
+ * Insert a u32 field into object (see `gbln_object_insert_i8()`)
+ */
+enum GblnErrorCode gbln_object_insert_u32(struct GblnValue *object,
+                                          const char *key,
+                                          uint32_t value);
+
+/**
+ * Insert a u64 field into object (see `gbln_object_insert_i8()`)
+ */
+enum GblnErrorCode gbln_object_insert_u64(struct GblnValue *object,
+                                          const char *key,
+                                          uint64_t value);
+
+/**
+ * Insert an f32 field into object (see `gbln_object_insert_i8()`)
+ */
+enum GblnErrorCode gbln_object_insert_f32(struct GblnValue *object, const char *key, float value);
+
+/**
+ * Insert an f64 field into object (see `gbln_object_insert_i8()`)
+ */
+enum GblnErrorCode gbln_object_insert_f64(struct GblnValue *object, const char *key, double value);
+
+/**
+ * Insert a bool field into object (see `gbln_object_insert_i8()`)
+ */
+enum GblnErrorCode gbln_object_insert_bool(struct GblnValue *object, const char *key, bool value);
+
+/**
+ * Insert a null field into object (see `gbln_object_insert_i8()`)
+ */
+enum GblnErrorCode gbln_object_insert_null(struct GblnValue *object, const char *key);
+
+/**
+ * Insert a string field into object
+ *
+ * Same as `gbln_object_insert()` with `gbln_value_new_str()`, including
+ * the `max_len` check, without an intermediate boxed value.
+ *
+ * # Returns
+ * - GBLN_OK on success
+ * - GBLN_ERROR_STRING_TOO_LONG if value exceeds max_len characters
+ * - GBLN_ERROR_DUPLICATE_KEY if key already exists
+ * - GBLN_ERROR_TYPE_MISMATCH if object is not an Object type
+ * - GBLN_ERROR_NULL_POINTER if a pointer is null or a string is not UTF-8
+ *
+ * # Safety
+ * - `key` and `value` must be valid null-terminated UTF-8 strings
+ */
+enum GblnErrorCode gbln_object_insert_str(struct GblnValue *object,
+                                          const char *key,
+                                          const char *value,
+                                          uintptr_t max_len);
+
+/**
+ * Create empty array
+ */
 struct GblnValue *gbln_value_new_array(void);
 
 /**
@@ -524,6 +1578,140 @@ struct GblnValue *gbln_value_new_array(void);
  */
 enum GblnErrorCode gbln_array_push(struct GblnValue *array, struct GblnValue *value);
 
+/**
+ * Reserve room for at least `additional` more elements
+ *
+ * # Returns
+ * - GBLN_OK on success
+ * - GBLN_ERROR_TYPE_MISMATCH if array is not an Array type
+ * - GBLN_ERROR_NULL_POINTER if array is null
+ */
+enum GblnErrorCode gbln_array_reserve(struct GblnValue *array, uintptr_t additional);
+
+/**
+ * Create an array of i8 values from a C buffer
+ *
+ * One call and one allocation for the whole array, instead of a
+ * `gbln_value_new_i8()` and `gbln_array_push()` per element.
+ *
+ * # Returns
+ * - GblnValue pointer on success
+ * - NULL if data is NULL and len is not 0
+ *
+ * # Safety
+ * - `data` must point to at least `len` readable elements
+ */
+struct GblnValue *gbln_array_new_from_i8(const int8_t *data, uintptr_t len);
+
+/**
+ * Create an array of i16 values from a C buffer (see `gbln_array_new_from_i8()`)
+ */
+struct GblnValue *gbln_array_new_from_i16(const int16_t *data, uintptr_t len);
+
+/**
+ * Create an array of i32 values from a C buffer (see `gbln_array_new_from_i8()`)
+ */
+struct GblnValue *gbln_array_new_from_i32(const int32_t *data, uintptr_t len);
+
+/**
+ * Create an array of i64 values from a C buffer (see `gbln_array_new_from_i8()`)
+ */
+struct GblnValue *gbln_array_new_from_i64(const int64_t *data, uintptr_t len);
+
+/**
+ * Create an array of u8 values from a C buffer (see `gbln_array_new_from_i8()`)
+ */
+struct GblnValue *gbln_array_new_from_u8(const uint8_t *data, uintptr_t len);
+
+/**
+ * Create an array of u16 values from a C buffer (see `gbln_array_new_from_i8()`)
+ */
+struct GblnValue *gbln_array_new_from_u16(const uint16_t *data, uintptr_t len);
+
+/**
+ * Create an array of u32 values from a C buffer (see `gbln_array_new_from_i8()`)
+ */
+struct GblnValue *gbln_array_new_from_u32(const uint32_t *data, uintptr_t len);
+
+/**
+ * Create an array of u64 values from a C buffer (see `gbln_array_new_from_i8()`)
+ */
+struct GblnValue *gbln_array_new_from_u64(const uint64_t *data, uintptr_t len);
+
+/**
+ * Create an array of f32 values from a C buffer (see `gbln_array_new_from_i8()`)
+ */
+struct GblnValue *gbln_array_new_from_f32(const float *data, uintptr_t len);
+
+/**
+ * Create an array of f64 values from a C buffer (see `gbln_array_new_from_i8()`)
+ */
+struct GblnValue *gbln_array_new_from_f64(const double *data, uintptr_t len);
+
+/**
+ * Create an array of bool values from a C buffer (see `gbln_array_new_from_i8()`)
+ */
+struct GblnValue *gbln_array_new_from_bool(const bool *data, uintptr_t len);
+
+/**
+ * Build a compact index over an object
+ *
+ * # Returns
+ * - GblnObjectIndex pointer on success
+ * - NULL if value is NULL or not an object
+ *
+ * # Safety
+ * - `value` must be a valid GblnValue pointer
+ * - The object must outlive the index and must not be modified while it exists
+ * - Caller must free with `gbln_object_index_free()`
+ */
+struct GblnObjectIndex *gbln_object_index_new(const struct GblnValue *value);
+
+/**
+ * Get number of fields in an object index
+ *
+ * Returns 0 if `index` is NULL.
+ */
+uintptr_t gbln_object_index_len(const struct GblnObjectIndex *index);
+
+/**
+ * Get field from an object index using a prepared key
+ *
+ * # Safety
+ * - `index` must be a valid pointer from `gbln_object_index_new()`
+ * - `key` must be a valid pointer from `gbln_key_intern()`
+ * - Returns NULL if key not found
+ * - Returned pointer is valid as long as the indexed object is valid
+ */
+const struct GblnValue *gbln_object_index_get(const struct GblnObjectIndex *index,
+                                              const struct GblnKey *key);
+
+/**
+ * Get field from an object index using a length-delimited key
+ *
+ * The key does not need to be null-terminated and is compared byte-wise.
+ *
+ * # Safety
+ * - `index` must be a valid pointer from `gbln_object_index_new()`
+ * - `key` must point to at least `len` readable bytes
+ * - Returns NULL if key not found
+ * - Returned pointer is valid as long as the indexed object is valid
+ */
+const struct GblnValue *gbln_object_index_get_n(const struct GblnObjectIndex *index,
+                                                const char *key,
+                                                uintptr_t len);
+
+/**
+ * Free an object index
+ *
+ * Does not affect the indexed object.
+ *
+ * # Safety
+ * - `index` must be a valid pointer from `gbln_object_index_new()` or NULL
+ * - Must not be called twice on the same pointer
+ */
+void gbln_object_index_free(struct GblnObjectIndex *index);
+
 /**
  * Write GBLN value to I/O format file
  *
@@ -536,6 +1724,14 @@ enum GblnErrorCode gbln_array_push(struct GblnValue *array, struct GblnValue *va
  * - `.io.gbln`: MINI GBLN without compression (compress=false, mini_mode=true)
  * - `.gbln`: Pretty-printed source format (mini_mode=false)
  *
+ * # Codecs and Threads
+ * With `gbln_config_set_codec()` or `gbln_config_set_threads()` the text is
+ * compressed with zstd, LZ4 or multi-threaded XZ instead. Those files (and
+ * binary ones) are written piece by piece by the streaming serialiser, as
+ * by `gbln_write_io_stream()`, so the whole text is never held in memory.
+ * Its text is not byte-identical to the default path (object fields are
+ * sorted, hints differ); both read back to an equal value.
+ *
  * # Parameters
  * - value: GBLN value to write
  * - path: File path (null-terminated string)
@@ -543,7 +1739,8 @@ enum GblnErrorCode gbln_array_push(struct GblnValue *array, struct GblnValue *va
  *
  * # Returns
  * - GBLN_OK on success
- * - GBLN_ERROR_IO on file write failure
+ * - GBLN_ERROR_IO on file write failure, or a key that cannot be written on
+ *   the codec and threaded paths
  * - GBLN_ERROR_NULL_POINTER if value or path is NULL
  * - Error details via gbln_last_error_message()
  *
@@ -559,12 +1756,14 @@ enum GblnErrorCode gbln_write_io(const struct GblnValue *value,
 /**
  * Read GBLN file from I/O format
  *
- * This function reads a file and automatically detects if it's XZ compressed.
+ * This function reads a file and automatically detects if it's compressed.
  * The content is then parsed into a GBLN value.
  *
  * # Auto-Detection
- * The function checks for XZ magic bytes (FD 37 7A 58 5A 00) and automatically
- * decompresses if detected.
+ * The function checks for XZ (FD 37 7A 58 5A 00), zstd (28 B5 2F FD) and
+ * LZ4 frame (04 22 4D 18) magic bytes and decompresses if detected.
+ * Content starting with `GBLB` is decoded as the binary encoding (see
+ * `gbln_config_set_binary()`).
  *
  * # Parameters
  * - path: File path (null-terminated string)
@@ -584,4 +1783,866 @@ enum GblnErrorCode gbln_write_io(const struct GblnValue *value,
  */
 enum GblnErrorCode gbln_read_io(const char *path, struct GblnValue **out_value);
 
+/**
+ * Read a GBLN I/O file, parsing a large root array across threads
+ *
+ * Like `gbln_read_io()`, but content that is a single top-level array is
+ * split at element boundaries and parsed in parallel. Compressed files
+ * are first decompressed into memory, then split the same way; binary
+ * files are decoded on the calling thread.
+ *
+ * # Parameters
+ * - path: File path (null-terminated string)
+ * - threads: Worker threads to use (0 = one per available CPU)
+ * - out_value: Pointer to store the parsed value
+ *
+ * # Returns
+ * - GBLN_OK on success, with out_value set to parsed value
+ * - GBLN_ERROR_IO on file read failure
+ * - GBLN_ERROR_NULL_POINTER if path or out_value is NULL
+ * - Parse errors on invalid GBLN content
+ * - Error details via gbln_last_error_message()
+ *
+ * # Safety
+ * - path must be a valid null-terminated UTF-8 string
+ * - out_value must be a valid pointer to store the result
+ * - Caller must free returned value with gbln_value_free()
+ */
+enum GblnErrorCode gbln_read_io_parallel(const char *path,
+                                         uintptr_t threads,
+                                         struct GblnValue **out_value);
+
+/**
+ * Read an uncompressed GBLN I/O file through a read-only memory mapping
+ *
+ * The file is mapped and parsed in place instead of first being copied into
+ * an owned buffer, and its pages are shared with every other process that
+ * maps or reads it. Binary files are decoded straight from the mapping.
+ * Compressed files are read as by `gbln_read_io()`.
+ *
+ * For zero-copy access to the strings themselves, see
+ * `gbln_lazy_open_mmap()`.
+ *
+ * # Parameters
+ * - path: File path (null-terminated string)
+ * - out_value: Pointer to store the parsed value
+ *
+ * # Returns
+ * - GBLN_OK on success, with out_value set to parsed value
+ * - GBLN_ERROR_IO on file open or map failure
+ * - GBLN_ERROR_NULL_POINTER if path or out_value is NULL
+ * - Parse errors on invalid GBLN content
+ * - Error details via gbln_last_error_message()
+ *
+ * # Safety
+ * - path must be a valid null-terminated UTF-8 string
+ * - The file must not be truncated or modified while it is being read
+ * - Caller must free returned value with gbln_value_free()
+ */
+enum GblnErrorCode gbln_read_io_mmap(const char *path, struct GblnValue **out_value);
+
+/**
+ * Write a GBLN value to an I/O format file without an intermediate copy
+ *
+ * Same file format and compression as `gbln_write_io()`, but the serialiser
+ * writes piece by piece straight into the encoder (or the file), so no
+ * serialised text or compressed buffer for the whole document is ever held
+ * in memory. The text itself is not byte-identical to `gbln_write_io()`'s
+ * default path (object fields are sorted, hints differ); it reads back to
+ * an equal value through `gbln_read_io()`.
+ *
+ * # Parameters
+ * - value: GBLN value to write
+ * - path: File path (null-terminated string)
+ * - config: I/O configuration (if NULL, uses default io_format())
+ *
+ * # Returns
+ * - GBLN_OK on success
+ * - GBLN_ERROR_IO on file write failure or a key that cannot be written
+ * - GBLN_ERROR_NULL_POINTER if value or path is NULL
+ * - Error details via gbln_last_error_message()
+ *
+ * # Safety
+ * - value must be a valid GblnValue pointer
+ * - path must be a valid null-terminated UTF-8 string
+ * - config may be NULL (uses default)
+ */
+enum GblnErrorCode gbln_write_io_stream(const struct GblnValue *value,
+                                        const char *path,
+                                        const struct GblnConfig *config);
+
+/**
+ * Read a GBLN I/O file record by record through a fixed-size window
+ *
+ * Compressed files are decompressed on the fly. The decompressed text is
+ * fed to an incremental parser (see `gbln_stream_new()`), which hands each
+ * top-level value, or each element of a root array, to `callback` as soon
+ * as it is complete. Peak memory is one chunk plus the largest record.
+ * Binary files are not streamed; read them with `gbln_read_io()`.
+ *
+ * # Parameters
+ * - path: File path (null-terminated string)
+ * - callback: Receives each value (see `GblnStreamCallback`)
+ * - ctx: Opaque pointer passed to every callback invocation
+ *
+ * # Returns
+ * - GBLN_OK once the whole file has been delivered
+ * - GBLN_ERROR_IO on file read or decompression failure, or binary content
+ * - The parse error, or the callback's code if it stopped the stream
+ * - Error details via gbln_last_error_message()
+ *
+ * # Safety
+ * - path must be a valid null-terminated UTF-8 string
+ */
+enum GblnErrorCode gbln_read_io_stream(const char *path, GblnStreamCallback callback, void *ctx);
+
+/**
+ * Prepare a key handle for repeated lookups
+ *
+ * # Returns
+ * - GblnKey pointer on success
+ * - NULL if `name` is NULL or not valid UTF-8
+ *
+ * # Safety
+ * - `name` must be a valid null-terminated UTF-8 string
+ * - Caller must free with `gbln_key_free()`
+ */
+struct GblnKey *gbln_key_intern(const char *name);
+
+/**
+ * Get the length in bytes of a key handle's name
+ *
+ * Returns 0 if `key` is NULL.
+ */
+uintptr_t gbln_key_len(const struct GblnKey *key);
+
+/**
+ * Get field from object using a prepared key
+ *
+ * Same result as `gbln_object_get()` without re-scanning or re-validating
+ * the key. The object's map still hashes the name; to skip hashing too,
+ * build a `gbln_object_index_new()` and use `gbln_object_index_get()`.
+ *
+ * # Safety
+ * - `value` must be a valid GblnValue pointer
+ * - `key` must be a valid pointer from `gbln_key_intern()`
+ * - Returns NULL if value is not an object or key not found
+ * - Returned pointer is valid as long as the parent value is valid
+ */
+const struct GblnValue *gbln_object_get_key(const struct GblnValue *value,
+                                            const struct GblnKey *key);
+
+/**
+ * Free a key handle
+ *
+ * # Safety
+ * - `key` must be a valid pointer from `gbln_key_intern()` or NULL
+ * - Must not be called twice on the same pointer
+ */
+void gbln_key_free(struct GblnKey *key);
+
+/**
+ * Index a GBLN buffer for lazy access
+ *
+ * Only bracket structure is checked here; values are decoded when accessed.
+ *
+ * # Parameters
+ * - input: Pointer to the first byte of the GBLN text
+ * - len: Number of bytes
+ * - trusted: Skip UTF-8 validation (input MUST already be valid UTF-8)
+ * - out_doc: Pointer to store the document
+ *
+ * # Returns
+ * - GBLN_OK on success, with `out_doc` set
+ * - Error code on failure, with details via `gbln_last_error_message()`
+ *
+ * # Safety
+ * - `input` must point to at least `len` readable bytes that stay valid and
+ *   unchanged until `gbln_lazy_free()`
+ * - Caller must free the document with `gbln_lazy_free()`
+ */
+enum GblnErrorCode gbln_lazy_parse(const uint8_t *input,
+                                   uintptr_t len,
+                                   bool trusted,
+                                   struct GblnLazyDocument **out_doc);
+
+/**
+ * Open a file as a lazy document over a read-only memory mapping
+ *
+ * Like `gbln_lazy_parse()` over the whole file, but the document owns the
+ * mapping: nothing is copied up front, only the pages that are navigated
+ * are read, and `gbln_lazy_str()` returns strings pointing straight into
+ * the mapping. The file must hold uncompressed GBLN text.
+ *
+ * # Parameters
+ * - path: File path (null-terminated string)
+ * - out_doc: Pointer to store the document
+ *
+ * # Returns
+ * - GBLN_OK on success, with `out_doc` set
+ * - GBLN_ERROR_IO if the file cannot be opened or mapped
+ * - Error code on invalid content, with details via `gbln_last_error_message()`
+ *
+ * # Safety
+ * - `path` must be a valid null-terminated UTF-8 string
+ * - The file must not be truncated or modified until `gbln_lazy_free()`
+ * - Caller must free the document with `gbln_lazy_free()`
+ */
+enum GblnErrorCode gbln_lazy_open_mmap(const char *path, struct GblnLazyDocument **out_doc);
+
+/**
+ * Get the root node of a lazy document
+ *
+ * Returns NULL if `doc` is NULL.
+ */
+const struct GblnLazyNode *gbln_lazy_root(const struct GblnLazyDocument *doc);
+
+/**
+ * Get the type of a lazy node
+ *
+ * Objects and arrays are typed without decoding; scalars are decoded.
+ * Returns Null if `node` is NULL or its value fails to decode.
+ */
+enum GblnValueType gbln_lazy_type(const struct GblnLazyNode *node);
+
+/**
+ * Get field from a lazy object node
+ *
+ * Locates the object's fields on first access; field values themselves stay
+ * undecoded.
+ *
+ * # Safety
+ * - `node` must be a valid GblnLazyNode pointer
+ * - `key` must be a valid null-terminated UTF-8 string
+ * - Returns NULL if node is not an object, key not found, or the object is
+ *   malformed (details via `gbln_last_error_message()`)
+ */
+const struct GblnLazyNode *gbln_lazy_object_get(const struct GblnLazyNode *node, const char *key);
+
+/**
+ * Get the length of a lazy array node
+ *
+ * Returns 0 if node is not an array.
+ */
+uintptr_t gbln_lazy_array_len(const struct GblnLazyNode *node);
+
+/**
+ * Get element from a lazy array node
+ *
+ * # Safety
+ * - `node` must be a valid GblnLazyNode pointer
+ * - Returns NULL if node is not an array or index out of bounds
+ */
+const struct GblnLazyNode *gbln_lazy_array_get(const struct GblnLazyNode *node, uintptr_t index);
+
+/**
+ * Get the packed elements of a numeric typed array node
+ *
+ * Typed arrays with a numeric hint (`<f32>[...]`) whose elements are all
+ * plain values are stored as one contiguous buffer of the element type.
+ * This returns that buffer without copying, e.g. as `const float *` for
+ * `out_type` F32.
+ *
+ * # Safety
+ * - `node` must be a valid GblnLazyNode pointer
+ * - `out_type` receives the element type (may be NULL)
+ * - `out_len` receives the number of elements (may be NULL)
+ * - Returns NULL if the node is not a packed array (use
+ *   `gbln_lazy_array_get()` for those)
+ * - Returned pointer is valid until `gbln_lazy_free()`; must NOT be freed
+ */
+const void *gbln_lazy_array_data(const struct GblnLazyNode *node,
+                                 enum GblnValueType *out_type,
+                                 uintptr_t *out_len);
+
+/**
+ * Decode a lazy node into a regular value
+ *
+ * The decoded value is cached in the node, so repeated calls are free. Use
+ * it with every `gbln_value_*` accessor; for objects and arrays the whole
+ * subtree is decoded.
+ *
+ * # Safety
+ * - `node` must be a valid GblnLazyNode pointer
+ * - Returns NULL if the value fails to decode (details via
+ *   `gbln_last_error_message()`)
+ * - Returned pointer is owned by the document and valid until
+ *   `gbln_lazy_free()`; must NOT be freed
+ */
+const struct GblnValue *gbln_lazy_value(const struct GblnLazyNode *node);
+
+/**
+ * Get borrowed view of a lazy string node
+ *
+ * Unescaped strings point straight into the document's input, without
+ * decoding the node; strings with escapes are decoded (and cached) first.
+ *
+ * # Safety
+ * - `node` must be a valid GblnLazyNode pointer
+ * - `out_len` receives the length in bytes (may be NULL)
+ * - The returned bytes are UTF-8 and NOT null-terminated; use `out_len`
+ * - Returned pointer is valid until `gbln_lazy_free()`; must NOT be freed
+ * - Returns NULL if the node is not a string
+ */
+const char *gbln_lazy_str(const struct GblnLazyNode *node, uintptr_t *out_len, bool *ok);
+
+/**
+ * Free a lazy document and all of its nodes and decoded values
+ *
+ * # Safety
+ * - `doc` must be a valid pointer from `gbln_lazy_parse()`, `gbln_lazy_open_mmap()` or NULL
+ * - Must not be called twice on the same pointer
+ */
+void gbln_lazy_free(struct GblnLazyDocument *doc);
+
+/**
+ * Parse a GBLN buffer, splitting a large root array across threads
+ *
+ * When the input is a single top-level array, a fast structural pre-scan
+ * locates element boundaries and the elements are parsed in parallel.
+ * Parsing uses the native grammar, so the value is the one
+ * `gbln_parser_parse()` gives; see src/parser.rs for where that differs
+ * from `gbln_parse_n()`.
+ *
+ * # Parameters
+ * - input: Pointer to the first byte of the GBLN text
+ * - len: Number of bytes to parse
+ * - trusted: Skip UTF-8 validation (input MUST already be valid UTF-8)
+ * - threads: Worker threads to use (0 = one per available CPU)
+ * - out_value: Pointer to store the result
+ *
+ * # Returns
+ * - GBLN_OK on success, with `out_value` set to the parsed value
+ * - Error code on failure, with error details available via `gbln_last_error_message()`
+ *
+ * # Safety
+ * - `input` must point to at least `len` readable bytes
+ * - Caller must free the returned value with `gbln_value_free()`
+ */
+enum GblnErrorCode gbln_parse_parallel(const uint8_t *input,
+                                       uintptr_t len,
+                                       bool trusted,
+                                       uintptr_t threads,
+                                       struct GblnValue **out_value);
+
+/**
+ * Create a reusable parser context
+ *
+ * # Safety
+ * Caller must free with `gbln_parser_free()`
+ */
+struct GblnParser *gbln_parser_new(void);
+
+/**
+ * Parse a GBLN buffer with a reusable parser context
+ *
+ * Errors are recorded in the parser (see `gbln_parser_last_error()`), not in
+ * the thread-local error state, so rejected messages cost no allocation.
+ *
+ * # Parameters
+ * - parser: Parser from `gbln_parser_new()`
+ * - input: Pointer to the first byte of the GBLN text
+ * - len: Number of bytes to parse
+ * - trusted: Skip UTF-8 validation (input MUST already be valid UTF-8)
+ * - out_value: Pointer to store the result
+ *
+ * # Returns
+ * - GBLN_OK on success, with `out_value` set to the parsed value
+ * - Error code on failure
+ *
+ * # Safety
+ * - `input` must point to at least `len` readable bytes
+ * - Caller must free the returned value with `gbln_value_free()` or hand it
+ *   back with `gbln_parser_recycle()`
+ * - A parser must not be used from two threads at the same time
+ */
+enum GblnErrorCode gbln_parser_parse(struct GblnParser *parser,
+                                     const uint8_t *input,
+                                     uintptr_t len,
+                                     bool trusted,
+                                     struct GblnValue **out_value);
+
+/**
+ * Hand a value back to the parser for buffer reuse
+ *
+ * Takes ownership of `value` (like `gbln_value_free()`), keeping its strings,
+ * arrays and objects for later `gbln_parser_parse()` calls.
+ *
+ * # Safety
+ * - `value` must be a root value owned by the caller (not a child pointer)
+ * - Must not be used after this call
+ */
+void gbln_parser_recycle(struct GblnParser *parser, struct GblnValue *value);
+
+/**
+ * Get the last error message of a parser
+ *
+ * Returns NULL if the last parse succeeded.
+ * The returned string is owned by the parser and valid until its next use.
+ * Must NOT be freed with `gbln_string_free()`.
+ */
+const char *gbln_parser_last_error(const struct GblnParser *parser);
+
+/**
+ * Get the byte offset of a parser's last error
+ *
+ * Returns 0 if the last parse succeeded.
+ */
+uintptr_t gbln_parser_last_error_offset(const struct GblnParser *parser);
+
+/**
+ * Get structured info about a parser's last error, without allocating
+ *
+ * # Returns
+ * - true with `out` filled if the last parse failed
+ * - false if it succeeded
+ *
+ * # Safety
+ * - `parser` must be a valid pointer from `gbln_parser_new()`
+ * - `out` must be a valid pointer
+ */
+bool gbln_parser_last_error_info(const struct GblnParser *parser, struct GblnErrorInfo *out);
+
+/**
+ * Free a parser context and its pooled buffers
+ *
+ * # Safety
+ * - `parser` must be a valid pointer from `gbln_parser_new()` or NULL
+ * - Must not be called twice on the same pointer
+ */
+void gbln_parser_free(struct GblnParser *parser);
+
+/**
+ * Compile a path query
+ *
+ * # Returns
+ * - GblnPath pointer on success
+ * - NULL if `expr` is NULL or not a valid path; the position of the error
+ *   is available from `gbln_last_error_info()`
+ *
+ * # Safety
+ * - `expr` must be a valid null-terminated UTF-8 string
+ * - Caller must free with `gbln_path_free()`
+ */
+struct GblnPath *gbln_path_compile(const char *expr);
+
+/**
+ * Resolve a path against a value
+ *
+ * Stores up to `cap` matches in `out`, in document order (object
+ * wildcards in key order). Call with `cap` 0 to count the matches.
+ *
+ * # Parameters
+ * - value: Value to search
+ * - path: Compiled path
+ * - out: Receives pointers to the matching values (may be NULL if `cap` is 0)
+ * - cap: Capacity of `out`
+ *
+ * # Returns
+ * - The total number of matches, which may exceed `cap`
+ * - 0 if value or path is NULL
+ *
+ * # Safety
+ * - `value` must be a valid GblnValue pointer
+ * - `path` must be a valid pointer from `gbln_path_compile()`
+ * - `out` must point to at least `cap` writable pointers
+ * - Returned pointers are valid as long as `value` is valid
+ */
+uintptr_t gbln_path_eval(const struct GblnValue *value,
+                         const struct GblnPath *path,
+                         const struct GblnValue **out,
+                         uintptr_t cap);
+
+/**
+ * Get the first match of a path
+ *
+ * Stops at the first match, so `orders[*].id` does not visit every order.
+ *
+ * # Safety
+ * - `value` must be a valid GblnValue pointer
+ * - `path` must be a valid pointer from `gbln_path_compile()`
+ * - Returns NULL if nothing matches
+ * - Returned pointer is valid as long as `value` is valid
+ */
+const struct GblnValue *gbln_path_get(const struct GblnValue *value, const struct GblnPath *path);
+
+/**
+ * Resolve a path against a lazy node
+ *
+ * As `gbln_path_eval()`, but only the nodes along the matching paths are
+ * scanned; other subtrees of the document are never materialised.
+ *
+ * # Safety
+ * - `node` must be a valid GblnLazyNode pointer
+ * - `path` must be a valid pointer from `gbln_path_compile()`
+ * - `out` must point to at least `cap` writable pointers
+ * - Returned pointers are valid as long as the document is valid
+ */
+uintptr_t gbln_path_eval_lazy(const struct GblnLazyNode *node,
+                              const struct GblnPath *path,
+                              const struct GblnLazyNode **out,
+                              uintptr_t cap);
+
+/**
+ * Free a compiled path
+ *
+ * # Safety
+ * - `path` must be a valid pointer from `gbln_path_compile()` or NULL
+ * - Must not be called twice on the same pointer
+ */
+void gbln_path_free(struct GblnPath *path);
+
+/**
+ * Compile a struct layout for decoding
+ *
+ * # Parameters
+ * - fields: Field descriptions (see `GblnSchemaField`), at most 64
+ * - count: Number of fields
+ * - struct_size: `sizeof` the struct; every field must lie inside it
+ *
+ * # Returns
+ * - GblnSchema pointer on success
+ * - NULL if a field is invalid (bad name, duplicate name, non-scalar
+ *   type, size not matching the type, outside the struct)
+ *
+ * # Safety
+ * - `fields` must point to `count` valid GblnSchemaField values
+ * - Field names are copied; they need not outlive this call
+ * - Caller must free with `gbln_schema_free()`
+ */
+struct GblnSchema *gbln_schema_compile(const struct GblnSchemaField *fields,
+                                       uintptr_t count,
+                                       uintptr_t struct_size);
+
+/**
+ * Decode a GBLN object straight into a C struct
+ *
+ * The document must be an object. Fields named in the schema are written
+ * into `out`; other keys are skipped undecoded. Fields missing from the
+ * document keep their previous contents, so initialise `out` first.
+ *
+ * # Returns
+ * - GBLN_OK on success
+ * - GBLN_ERROR_TYPE_MISMATCH if the document is not an object, a value
+ *   does not match its field's type or a required field is missing
+ * - GBLN_ERROR_INT_OUT_OF_RANGE if an un-hinted integer does not fit
+ * - GBLN_ERROR_STRING_TOO_LONG if a string does not fit its buffer
+ * - GBLN_ERROR_DUPLICATE_KEY if a schema field appears twice
+ * - Parse error code on invalid input
+ * - GBLN_ERROR_NULL_POINTER if buf, schema or out is NULL
+ *
+ * On error, `out` may be partly written; the position of the error is
+ * available from `gbln_last_error_info()`.
+ *
+ * # Safety
+ * - `buf` must point to at least `len` readable bytes
+ * - `schema` must be a valid pointer from `gbln_schema_compile()`
+ * - `out` must point to a writable struct of the schema's layout
+ */
+enum GblnErrorCode gbln_decode_into(const uint8_t *buf,
+                                    uintptr_t len,
+                                    const struct GblnSchema *schema,
+                                    void *out);
+
+/**
+ * Decode a GBLN array of objects straight into an array of C structs
+ *
+ * Element `i` is decoded as by `gbln_decode_into()` into the struct at
+ * `out + i * stride`.
+ *
+ * # Parameters
+ * - buf, len: GBLN text
+ * - schema: Layout of one struct
+ * - out: Destination array (may be NULL if `cap` is 0)
+ * - stride: Bytes between structs (0 = the schema's struct size)
+ * - cap: Number of structs `out` has room for
+ * - n: Set to the number of records in the array
+ *
+ * # Returns
+ * - GBLN_OK with `*n` records decoded
+ * - GBLN_ERROR_BUFFER_TOO_SMALL if the array has more than `cap` records
+ *   (the first `cap` are decoded; `*n` is the required capacity)
+ * - The errors of `gbln_decode_into()`; `*n` is then the number of
+ *   records decoded before the failing one
+ *
+ * # Safety
+ * - `buf` must point to at least `len` readable bytes
+ * - `schema` must be a valid pointer from `gbln_schema_compile()`
+ * - `out` must point to `cap` writable structs `stride` bytes apart
+ */
+enum GblnErrorCode gbln_decode_array_into(const uint8_t *buf,
+                                          uintptr_t len,
+                                          const struct GblnSchema *schema,
+                                          void *out,
+                                          uintptr_t stride,
+                                          uintptr_t cap,
+                                          uintptr_t *n);
+
+/**
+ * Free a compiled schema
+ *
+ * # Safety
+ * - `schema` must be a valid pointer from `gbln_schema_compile()` or NULL
+ * - Must not be called twice on the same pointer
+ */
+void gbln_schema_free(struct GblnSchema *schema);
+
+/**
+ * Turn a value into a shared, reference-counted value
+ *
+ * Takes ownership of `value` without copying the tree and returns it with
+ * a reference count of 1. The returned pointer works with every function
+ * taking a `const GblnValue*`; child pointers from `gbln_object_get()` or
+ * `gbln_array_get()` stay valid as long as the caller holds a reference.
+ *
+ * # Concurrency
+ * - Any number of threads may read a shared value at the same time
+ * - `gbln_value_retain()` and `gbln_value_release()` may be called from
+ *   any thread, concurrently with readers
+ * - Nothing may modify a shared value (no `gbln_object_insert()`, etc.)
+ *
+ * # Safety
+ * - `value` must be a root value owned by the caller (from `gbln_parse()`
+ *   or a builder), not a child pointer or a document's root, or NULL
+ * - `value` must not be used or freed after this call
+ *
+ * # Returns
+ * - Shared value, to be released with `gbln_value_release()`
+ * - NULL if `value` is NULL
+ */
+const struct GblnValue *gbln_value_share(struct GblnValue *value);
+
+/**
+ * Take another reference to a shared value
+ *
+ * # Safety
+ * - `shared` must be a live pointer from `gbln_value_share()` or NULL
+ *
+ * # Returns
+ * - `shared`, now holding one more reference
+ */
+const struct GblnValue *gbln_value_retain(const struct GblnValue *shared);
+
+/**
+ * Release a reference to a shared value
+ *
+ * The tree is freed when the last reference is released; child pointers
+ * obtained through this reference must not be used afterwards.
+ *
+ * # Safety
+ * - `shared` must be a live pointer from `gbln_value_share()` or
+ *   `gbln_value_retain()`, or NULL
+ * - Each reference must be released exactly once
+ */
+void gbln_value_release(const struct GblnValue *shared);
+
+/**
+ * Turn stats recording on or off
+ *
+ * Counters keep their values while recording is off. Recording costs a few
+ * relaxed atomic adds per call into one of 16 shards; threads beyond the
+ * 16th share shards with earlier ones.
+ *
+ * # Returns
+ * - true if this build includes stats (the `stats` feature)
+ * - false otherwise; nothing is ever recorded
+ */
+bool gbln_stats_enable(bool enabled);
+
+/**
+ * Copy the counters of all threads into `out`
+ *
+ * # Returns
+ * - true on success
+ * - false if `out` is NULL or the build has no stats (`out` is then zeroed)
+ *
+ * # Safety
+ * - `out` must point to a writable GblnStats or be NULL
+ */
+bool gbln_stats_snapshot(struct GblnStats *out);
+
+/**
+ * Reset all counters to zero
+ *
+ * Calls that are running while this happens may be partly counted.
+ */
+void gbln_stats_reset(void);
+
+/**
+ * Create an incremental parser
+ *
+ * # Parameters
+ * - callback: Receives each complete value (may be NULL to discard values)
+ * - ctx: Opaque pointer passed to every callback invocation
+ *
+ * # Safety
+ * - Caller must free with `gbln_stream_free()`
+ */
+struct GblnStream *gbln_stream_new(GblnStreamCallback callback, void *ctx);
+
+/**
+ * Feed the next chunk of input to a stream
+ *
+ * Chunks may split the input anywhere, including inside keys, content or
+ * multi-byte UTF-8 sequences. Every value completed by this chunk is
+ * delivered to the callback before the call returns.
+ *
+ * # Returns
+ * - GBLN_OK if the chunk was consumed
+ * - Parse error code if a record is invalid (details via `gbln_last_error_message()`)
+ * - The callback's code if the callback stopped the stream
+ *
+ * After an error the stream keeps returning the same code; free it.
+ *
+ * # Safety
+ * - `stream` must be a valid pointer from `gbln_stream_new()`
+ * - `buf` must point to at least `len` readable bytes
+ */
+enum GblnErrorCode gbln_stream_feed(struct GblnStream *stream, const uint8_t *buf, uintptr_t len);
+
+/**
+ * Signal the end of input
+ *
+ * # Returns
+ * - GBLN_OK if the input ended on a record boundary; the stream can then be
+ *   fed a new input
+ * - GBLN_ERROR_UNEXPECTED_EOF if a record (or the root array) is incomplete
+ * - The sticky error code of a stream that already failed
+ *
+ * # Safety
+ * - `stream` must be a valid pointer from `gbln_stream_new()`
+ */
+enum GblnErrorCode gbln_stream_finish(struct GblnStream *stream);
+
+/**
+ * Free a stream and any partially received record
+ *
+ * # Safety
+ * - `stream` must be a valid pointer from `gbln_stream_new()` or NULL
+ * - Must not be called twice on the same pointer
+ */
+void gbln_stream_free(struct GblnStream *stream);
+
+/**
+ * Serialize GBLN value into a caller-provided buffer
+ *
+ * Writes MINI GBLN followed by a terminating NUL straight into `buf`; no
+ * output string is allocated. Each object still allocates a short list of
+ * its fields to write them in key order. Call with `cap` 0 (and `buf`
+ * NULL) to query the size.
+ *
+ * The text is NOT byte-identical to `gbln_to_string()`'s: object fields
+ * are written in key order, `I64`, untyped strings and `Bool` have no hint,
+ * `Null` is `<n>()`, and strings that would read back as another type get
+ * an `<sN>` hint. `gbln_parse()` reads it back to an equal value.
+ *
+ * # Parameters
+ * - value: GBLN value to serialise
+ * - buf: Destination buffer (may be NULL if `cap` is 0)
+ * - cap: Size of `buf` in bytes
+ * - written: Set to the length of the text, excluding the NUL
+ *
+ * # Returns
+ * - GBLN_OK on success
+ * - GBLN_ERROR_BUFFER_TOO_SMALL if `cap` is less than `*written + 1`; the
+ *   contents of `buf` are then unspecified
+ * - GBLN_ERROR_INVALID_SYNTAX if an object key cannot be written as GBLN
+ * - GBLN_ERROR_NULL_POINTER if value or written is NULL
+ *
+ * # Safety
+ * - `value` must be a valid GblnValue pointer
+ * - `buf` must point to at least `cap` writable bytes
+ */
+enum GblnErrorCode gbln_to_buffer(const struct GblnValue *value,
+                                  char *buf,
+                                  uintptr_t cap,
+                                  uintptr_t *written);
+
+/**
+ * Serialize GBLN value through a write callback
+ *
+ * The serialiser hands its output to `write_fn` in chunks of up to 64 KiB
+ * as it goes, so the whole text is never held in memory. With a config the
+ * layout and compression follow it, as for `gbln_write_io_stream()`. The
+ * text matches `gbln_to_buffer()`, not `gbln_to_string()`.
+ *
+ * # Parameters
+ * - value: GBLN value to serialise
+ * - write_fn: Receives each chunk (see `GblnWriteCallback`)
+ * - ctx: Passed unchanged to every call of `write_fn`
+ * - config: Output configuration (if NULL, MINI GBLN without compression)
+ *
+ * # Returns
+ * - GBLN_OK once all output has been delivered
+ * - The callback's code if it stopped the output
+ * - GBLN_ERROR_INVALID_SYNTAX if an object key cannot be written as GBLN
+ * - GBLN_ERROR_IO if compression fails
+ * - GBLN_ERROR_NULL_POINTER if value or write_fn is NULL
+ *
+ * # Safety
+ * - `value` must be a valid GblnValue pointer
+ * - `config` must be a valid GblnConfig pointer or NULL
+ */
+enum GblnErrorCode gbln_to_writer(const struct GblnValue *value,
+                                  GblnWriteCallback write_fn,
+                                  void *ctx,
+                                  const struct GblnConfig *config);
+
+/*
+ * Inline fast paths
+ *
+ * Appended to gbln.h by build.rs (cbindgen cannot generate these). They read
+ * a GblnScalar filled by `gbln_value_view()` or `gbln_array_view()`, with the
+ * same results as the matching `gbln_value_*()` call on the viewed value.
+ */
+#ifndef GBLN_INLINE_H
+#define GBLN_INLINE_H
+
+static inline enum GblnValueType gbln_scalar_type(const struct GblnScalar *s) {
+    return s->value_type;
+}
+
+static inline bool gbln_scalar_is_null(const struct GblnScalar *s) {
+    return s->value_type == Null;
+}
+
+#define GBLN_SCALAR_AS(NAME, CTYPE, TYPE, FIELD)                                       \
+    static inline CTYPE gbln_scalar_as_##NAME(const struct GblnScalar *s, bool *ok) {  \
+        bool match = s->value_type == TYPE;                                            \
+        if (ok) {                                                                      \
+            *ok = match;                                                               \
+        }                                                                              \
+        return match ? (CTYPE)s->FIELD : (CTYPE)0;                                     \
+    }
+
+GBLN_SCALAR_AS(i8, int8_t, I8, int_value)
+GBLN_SCALAR_AS(i16, int16_t, I16, int_value)
+GBLN_SCALAR_AS(i32, int32_t, I32, int_value)
+GBLN_SCALAR_AS(i64, int64_t, I64, int_value)
+GBLN_SCALAR_AS(u8, uint8_t, U8, uint_value)
+GBLN_SCALAR_AS(u16, uint16_t, U16, uint_value)
+GBLN_SCALAR_AS(u32, uint32_t, U32, uint_value)
+GBLN_SCALAR_AS(u64, uint64_t, U64, uint_value)
+GBLN_SCALAR_AS(f32, float, F32, float_value)
+GBLN_SCALAR_AS(f64, double, F64, float_value)
+GBLN_SCALAR_AS(bool, bool, Bool, bool_value)
+
+#undef GBLN_SCALAR_AS
+
+/* Borrowed string bytes (NOT null-terminated), NULL if not a string */
+static inline const char *gbln_scalar_as_str(const struct GblnScalar *s,
+                                             uintptr_t *out_len,
+                                             bool *ok) {
+    bool match = s->value_type == Str;
+    if (ok) {
+        *ok = match;
+    }
+    if (out_len) {
+        *out_len = match ? s->str_len : 0;
+    }
+    return match ? s->str_ptr : NULL;
+}
+
+#endif  /* GBLN_INLINE_H */
+
 #endif  /* GBLN_H */
@@ -1,6 +1,7 @@
 // Copyright (c) 2025 Vivian Burkhard Voss
 // SPDX-License-Identifier: Apache-2.0
 
+use crate::events::GblnScalar;
 use crate::types::GblnValue;
 use gbln::Value;
 use std::ffi::CString;
@@ -378,6 +379,64 @@ pub extern "C" fn gbln_value_as_string(value: *const GblnValue, ok: *mut bool) -
     }
 }
 
+/// Get borrowed view of string value
+///
+/// Zero-copy alternative to `gbln_value_as_string()`: returns a pointer into
+/// the value's own storage instead of allocating a new C string.
+///
+/// # Safety
+/// - `value` must be a valid GblnValue pointer
+/// - `out_len` receives the length in bytes (may be NULL)
+/// - The returned bytes are UTF-8 and NOT null-terminated; use `out_len`
+/// - Returned pointer is valid as long as the parent value is valid
+/// - Must NOT be freed with `gbln_string_free()`
+/// - Returns NULL if value is not a string
+#[no_mangle]
+pub extern "C" fn gbln_value_as_str(
+    value: *const GblnValue,
+    out_len: *mut usize,
+    ok: *mut bool,
+) -> *const c_char {
+    if !out_len.is_null() {
+        unsafe {
+            *out_len = 0;
+        }
+    }
+
+    if value.is_null() {
+        if !ok.is_null() {
+            unsafe {
+                *ok = false;
+            }
+        }
+        return ptr::null();
+    }
+
+    match unsafe { (*value).inner() } {
+        Value::Str(s) => {
+            if !ok.is_null() {
+                unsafe {
+                    *ok = true;
+                }
+            }
+            if !out_len.is_null() {
+                unsafe {
+                    *out_len = s.len();
+                }
+            }
+            s.as_ptr() as *const c_char
+        }
+        _ => {
+            if !ok.is_null() {
+                unsafe {
+                    *ok = false;
+                }
+            }
+            ptr::null()
+        }
+    }
+}
+
 /// Get bool value
 #[no_mangle]
 pub extern "C" fn gbln_value_as_bool(value: *const GblnValue, ok: *mut bool) -> bool {
@@ -419,3 +478,66 @@ pub extern "C" fn gbln_value_is_null(value: *const GblnValue) -> bool {
 
     matches!(unsafe { (*value).inner() }, Value::Null)
 }
+
+/// Read a value's type and scalar into a caller-owned GblnScalar
+///
+/// One call instead of `gbln_value_type()` plus a `gbln_value_as_*()`; the
+/// `gbln_scalar_*()` inline functions then read `out` with no further calls.
+///
+/// # Returns
+/// - true on success
+/// - false if value or out is NULL
+///
+/// # Safety
+/// - `value` must be a valid GblnValue pointer
+/// - A string view is valid as long as `value` is
+#[no_mangle]
+pub extern "C" fn gbln_value_view(value: *const GblnValue, out: *mut GblnScalar) -> bool {
+    if value.is_null() || out.is_null() {
+        return false;
+    }
+
+    unsafe {
+        *out = GblnScalar::from((*value).inner());
+    }
+    true
+}
+
+/// View the elements of an array into a caller-provided GblnScalar array
+///
+/// Fills `out` with the first `cap` elements (as by `gbln_value_view()`), so
+/// a loop over the array reads fields inline instead of calling
+/// `gbln_array_get()` and `gbln_value_as_*()` per element.
+///
+/// # Returns
+/// - The array length (more than `cap` if `out` was too small)
+/// - 0 if value is NULL or not an array
+///
+/// # Safety
+/// - `value` must be a valid GblnValue pointer
+/// - `out` must point to at least `cap` GblnScalars (may be NULL if `cap` is 0)
+/// - String views are valid as long as `value` is
+#[no_mangle]
+pub extern "C" fn gbln_array_view(
+    value: *const GblnValue,
+    out: *mut GblnScalar,
+    cap: usize,
+) -> usize {
+    if value.is_null() {
+        return 0;
+    }
+
+    match unsafe { (*value).inner() } {
+        Value::Array(items) => {
+            if !out.is_null() {
+                for (i, item) in items.iter().take(cap).enumerate() {
+                    unsafe {
+                        out.add(i).write(GblnScalar::from(item));
+                    }
+                }
+            }
+            items.len()
+        }
+        _ => 0,
+    }
+}
@@ -0,0 +1,608 @@
+// Copyright (c) 2025 Vivian Burkhard Voss
+// SPDX-License-Identifier: Apache-2.0
+
+//! Arena-backed GBLN documents
+//!
+//! The value tree is defined by gbln-rust and allocates every `HashMap`,
+//! `Vec` and `String` through the global allocator. With the `arena`
+//! feature the library therefore installs a global allocator that diverts
+//! allocations made *while a document is parsing* into that document's
+//! slabs. Outside of a parse the allocator forwards straight to the system
+//! allocator.
+//!
+//! A document's tree is never dropped node by node: resetting or freeing
+//! the document simply rewinds or releases its slabs.
+//!
+//! The feature is opt-in because a global allocator applies to the whole
+//! program: every allocation pays a thread-local lookup, and a Rust program
+//! linking the static library cannot install its own. Without it,
+//! documents hold an ordinary heap tree with the same API. The `stats`
+//! feature installs the same allocator, which then only counts.
+
+#[cfg(any(feature = "arena", feature = "stats"))]
+use std::alloc::{GlobalAlloc, Layout, System};
+#[cfg(feature = "arena")]
+use std::cell::Cell;
+#[cfg(feature = "arena")]
+use std::mem;
+use std::ptr;
+
+use crate::error::{set_core_error, set_static_error, GblnErrorCode};
+#[cfg(any(feature = "arena", feature = "stats"))]
+use crate::stats;
+use crate::types::GblnValue;
+
+/// Default size of the first slab (64 KiB)
+#[cfg(feature = "arena")]
+const DEFAULT_SLAB_SIZE: usize = 64 * 1024;
+
+/// Alignment of slab memory
+#[cfg(feature = "arena")]
+const SLAB_ALIGN: usize = 16;
+
+// ============================================================================
+// Global Allocator
+// ============================================================================
+
+#[cfg(feature = "arena")]
+thread_local! {
+    // Arena receiving allocations on this thread (null = system allocator)
+    static ACTIVE: Cell<*mut Arena> = const { Cell::new(ptr::null_mut()) };
+    // Whether this thread's first-use allocations have been made
+    static WARM: Cell<bool> = const { Cell::new(false) };
+}
+
+/// Library allocator: system allocator unless an arena scope is active
+#[cfg(any(feature = "arena", feature = "stats"))]
+pub struct GblnAllocator;
+
+#[cfg(any(feature = "arena", feature = "stats"))]
+#[global_allocator]
+static ALLOCATOR: GblnAllocator = GblnAllocator;
+
+#[cfg(feature = "arena")]
+fn active_arena() -> *mut Arena {
+    ACTIVE.try_with(|a| a.get()).unwrap_or(ptr::null_mut())
+}
+
+#[cfg(all(feature = "stats", not(feature = "arena")))]
+unsafe impl GlobalAlloc for GblnAllocator {
+    unsafe fn alloc(&self, layout: Layout) -> *mut u8 {
+        stats::count_alloc(layout.size());
+        System.alloc(layout)
+    }
+
+    unsafe fn dealloc(&self, ptr: *mut u8, layout: Layout) {
+        System.dealloc(ptr, layout)
+    }
+
+    unsafe fn realloc(&self, ptr: *mut u8, layout: Layout, new_size: usize) -> *mut u8 {
+        stats::count_alloc(new_size);
+        System.realloc(ptr, layout, new_size)
+    }
+}
+
+#[cfg(feature = "arena")]
+unsafe impl GlobalAlloc for GblnAllocator {
+    unsafe fn alloc(&self, layout: Layout) -> *mut u8 {
+        stats::count_alloc(layout.size());
+        let arena = active_arena();
+        if arena.is_null() {
+            System.alloc(layout)
+        } else {
+            (*arena).alloc(layout)
+        }
+    }
+
+    unsafe fn dealloc(&self, ptr: *mut u8, layout: Layout) {
+        let arena = active_arena();
+        if !arena.is_null() && (*arena).contains(ptr) {
+            (*arena).dealloc(ptr);
+        } else {
+            System.dealloc(ptr, layout)
+        }
+    }
+
+    unsafe fn realloc(&self, ptr: *mut u8, layout: Layout, new_size: usize) -> *mut u8 {
+        stats::count_alloc(new_size);
+        let arena = active_arena();
+        if !arena.is_null() && (*arena).contains(ptr) {
+            (*arena).realloc(ptr, layout, new_size)
+        } else {
+            System.realloc(ptr, layout, new_size)
+        }
+    }
+}
+
+/// Has a destructor, so touching it registers this thread's TLS destructors
+#[cfg(feature = "arena")]
+struct TlsProbe;
+
+#[cfg(feature = "arena")]
+impl Drop for TlsProbe {
+    fn drop(&mut self) {}
+}
+
+#[cfg(feature = "arena")]
+thread_local! {
+    static TLS_PROBE: TlsProbe = const { TlsProbe };
+}
+
+/// Make this thread's first-use allocations outside any arena
+///
+/// std and the core parser allocate some state on first use and keep it
+/// for the life of the thread or process: the TLS destructor list, lazily
+/// initialised statics, cached buffers. Made inside a scope, that memory
+/// would end up in a document's slabs and dangle after a reset. Running
+/// one small parse first puts it on the system heap. This runs outside
+/// any arena and creates no slabs; `gbln_document_reserve()` sizes a
+/// document's slabs up front.
+#[cfg(feature = "arena")]
+fn warm_up() {
+    if WARM.with(|w| w.replace(true)) {
+        return;
+    }
+    TLS_PROBE.with(|_| {});
+    drop(gbln::parse(
+        "{a<i8>(1) b[(x) <u32>(2)] c{d(1.5)} e<s8>(y) f<b>(t)}",
+    ));
+    drop(gbln::parse("{a(1"));
+}
+
+/// Routes allocations on the current thread into an arena until dropped
+#[cfg(feature = "arena")]
+struct ArenaScope {
+    previous: *mut Arena,
+}
+
+#[cfg(feature = "arena")]
+impl ArenaScope {
+    fn enter(arena: &mut Arena) -> Self {
+        warm_up();
+        let previous = ACTIVE.with(|a| a.replace(arena as *mut Arena));
+        ArenaScope { previous }
+    }
+}
+
+#[cfg(feature = "arena")]
+impl Drop for ArenaScope {
+    fn drop(&mut self) {
+        ACTIVE.with(|a| a.set(self.previous));
+    }
+}
+
+// ============================================================================
+// Arena
+// ============================================================================
+
+#[cfg(feature = "arena")]
+/// Slab header, stored at the start of each slab's memory
+struct Slab {
+    next: *mut Slab,
+    size: usize,
+    used: usize,
+}
+
+#[cfg(feature = "arena")]
+const HEADER_SIZE: usize = (mem::size_of::<Slab>() + SLAB_ALIGN - 1) & !(SLAB_ALIGN - 1);
+
+#[cfg(feature = "arena")]
+/// Bump allocator over a chain of slabs
+///
+/// Slabs are kept across resets, so a document that is reused for similar
+/// inputs stops allocating from the system once it reaches its high-water mark.
+struct Arena {
+    head: *mut Slab,
+    current: *mut Slab,
+    last: *mut u8,
+    slab_size: usize,
+}
+
+#[cfg(feature = "arena")]
+impl Arena {
+    fn new(slab_size: usize) -> Self {
+        Arena {
+            head: ptr::null_mut(),
+            current: ptr::null_mut(),
+            last: ptr::null_mut(),
+            slab_size: slab_size.max(HEADER_SIZE * 2),
+        }
+    }
+
+    /// Allocate slabs up front until the chain holds at least `bytes`
+    ///
+    /// Returns false if the system allocator refused.
+    fn reserve(&mut self, bytes: usize) -> bool {
+        unsafe {
+            let mut capacity = 0;
+            let mut tail: *mut Slab = ptr::null_mut();
+            let mut slab = self.head;
+            while !slab.is_null() {
+                capacity += (*slab).size - HEADER_SIZE;
+                tail = slab;
+                slab = (*slab).next;
+            }
+            if capacity >= bytes {
+                return true;
+            }
+
+            let slab = Self::new_slab((HEADER_SIZE + bytes - capacity).max(self.slab_size));
+            if slab.is_null() {
+                return false;
+            }
+            if tail.is_null() {
+                self.head = slab;
+            } else {
+                (*tail).next = slab;
+            }
+            // A fresh chain starts in its first slab
+            if self.current.is_null() {
+                self.current = self.head;
+            }
+            true
+        }
+    }
+
+    unsafe fn new_slab(size: usize) -> *mut Slab {
+        let layout = Layout::from_size_align_unchecked(size, SLAB_ALIGN);
+        let slab = System.alloc(layout) as *mut Slab;
+        if !slab.is_null() {
+            slab.write(Slab {
+                next: ptr::null_mut(),
+                size,
+                used: HEADER_SIZE,
+            });
+        }
+        slab
+    }
+
+    /// Try to carve `layout` out of `slab`
+    unsafe fn bump(&mut self, slab: *mut Slab, layout: Layout) -> *mut u8 {
+        let base = slab as usize;
+        let start = (base + (*slab).used + layout.align() - 1) & !(layout.align() - 1);
+        let end = start + layout.size();
+        if end > base + (*slab).size {
+            return ptr::null_mut();
+        }
+        (*slab).used = end - base;
+        self.last = start as *mut u8;
+        start as *mut u8
+    }
+
+    unsafe fn alloc(&mut self, layout: Layout) -> *mut u8 {
+        if !self.current.is_null() {
+            let p = self.bump(self.current, layout);
+            if !p.is_null() {
+                return p;
+            }
+
+            // Reuse the next retained slab if the request fits
+            let next = (*self.current).next;
+            if !next.is_null() {
+                let p = self.bump(next, layout);
+                if !p.is_null() {
+                    self.current = next;
+                    return p;
+                }
+            }
+        }
+
+        // Grow: new slab at least twice the last one and large enough for the request
+        let needed = HEADER_SIZE + layout.size() + layout.align();
+        let size = if self.current.is_null() {
+            self.slab_size.max(needed)
+        } else {
+            ((*self.current).size * 2).max(needed)
+        };
+
+        let slab = Self::new_slab(size);
+        if slab.is_null() {
+            return ptr::null_mut();
+        }
+
+        if self.current.is_null() {
+            (*slab).next = self.head;
+            self.head = slab;
+        } else {
+            (*slab).next = (*self.current).next;
+            (*self.current).next = slab;
+        }
+        self.current = slab;
+        self.bump(slab, layout)
+    }
+
+    unsafe fn dealloc(&mut self, ptr: *mut u8) {
+        // Only the most recent allocation can be given back
+        if ptr == self.last && !self.current.is_null() {
+            (*self.current).used = ptr as usize - self.current as usize;
+            self.last = ptr::null_mut();
+        }
+    }
+
+    unsafe fn realloc(&mut self, ptr: *mut u8, layout: Layout, new_size: usize) -> *mut u8 {
+        // Grow or shrink the most recent allocation in place
+        if ptr == self.last && !self.current.is_null() {
+            let offset = ptr as usize - self.current as usize;
+            if offset + new_size <= (*self.current).size {
+                (*self.current).used = offset + new_size;
+                return ptr;
+            }
+        }
+
+        let new_layout = Layout::from_size_align_unchecked(new_size, layout.align());
+        let new_ptr = self.alloc(new_layout);
+        if !new_ptr.is_null() {
+            ptr::copy_nonoverlapping(ptr, new_ptr, layout.size().min(new_size));
+        }
+        new_ptr
+    }
+
+    unsafe fn contains(&self, ptr: *mut u8) -> bool {
+        let addr = ptr as usize;
+        let mut slab = self.head;
+        while !slab.is_null() {
+            let base = slab as usize;
+            if addr >= base && addr < base + (*slab).size {
+                return true;
+            }
+            slab = (*slab).next;
+        }
+        false
+    }
+
+    /// Rewind every slab, keeping the memory for the next parse
+    fn reset(&mut self) {
+        unsafe {
+            let mut slab = self.head;
+            while !slab.is_null() {
+                (*slab).used = HEADER_SIZE;
+                slab = (*slab).next;
+            }
+        }
+        self.current = self.head;
+        self.last = ptr::null_mut();
+    }
+}
+
+#[cfg(feature = "arena")]
+impl Drop for Arena {
+    fn drop(&mut self) {
+        unsafe {
+            let mut slab = self.head;
+            while !slab.is_null() {
+                let next = (*slab).next;
+                let layout = Layout::from_size_align_unchecked((*slab).size, SLAB_ALIGN);
+                System.dealloc(slab as *mut u8, layout);
+                slab = next;
+            }
+        }
+    }
+}
+
+// ============================================================================
+// Document API
+// ============================================================================
+
+/// Arena-backed parsed document
+///
+/// Owns a parsed value tree whose nodes all live in the document's slabs.
+/// Resetting or freeing the document releases the whole tree at once.
+/// Without the `arena` feature the tree is on the heap and is dropped
+/// normally.
+pub struct GblnDocument {
+    #[cfg(feature = "arena")]
+    arena: Arena,
+    root: Option<GblnValue>,
+}
+
+impl GblnDocument {
+    /// Discard the current tree without walking it
+    #[cfg(feature = "arena")]
+    fn clear(&mut self) {
+        // Tree memory belongs to the arena; dropping nodes would walk the tree
+        if let Some(root) = self.root.take() {
+            mem::forget(root);
+        }
+        self.arena.reset();
+    }
+
+    /// Discard the current tree
+    #[cfg(not(feature = "arena"))]
+    fn clear(&mut self) {
+        self.root = None;
+    }
+}
+
+#[cfg(feature = "arena")]
+impl Drop for GblnDocument {
+    fn drop(&mut self) {
+        if let Some(root) = self.root.take() {
+            mem::forget(root);
+        }
+    }
+}
+
+/// Create an empty arena-backed document
+///
+/// # Parameters
+/// - initial_capacity: Size of the first slab in bytes (0 = 64 KiB; ignored
+///   without the `arena` feature)
+///
+/// # Safety
+/// Caller must free with `gbln_document_free()`
+#[no_mangle]
+pub extern "C" fn gbln_document_new(initial_capacity: usize) -> *mut GblnDocument {
+    #[cfg(feature = "arena")]
+    let arena = Arena::new(if initial_capacity == 0 {
+        DEFAULT_SLAB_SIZE
+    } else {
+        initial_capacity
+    });
+    #[cfg(not(feature = "arena"))]
+    let _ = initial_capacity;
+
+    Box::into_raw(Box::new(GblnDocument {
+        #[cfg(feature = "arena")]
+        arena,
+        root: None,
+    }))
+}
+
+/// Pre-allocate a document's slabs
+///
+/// Makes sure the document's slabs hold at least `bytes` in total, so
+/// parses that fit take no memory from the system. Reserved slabs are kept
+/// across resets like any other. Without the `arena` feature nothing is
+/// reserved.
+///
+/// # Returns
+/// - true if the slabs now hold `bytes` (always, without the `arena` feature)
+/// - false if `doc` is NULL or the memory could not be allocated
+///
+/// # Safety
+/// - `doc` must be a valid GblnDocument pointer or NULL
+/// - Must not be called while the document is being parsed into
+#[no_mangle]
+pub extern "C" fn gbln_document_reserve(doc: *mut GblnDocument, bytes: usize) -> bool {
+    if doc.is_null() {
+        return false;
+    }
+
+    #[cfg(feature = "arena")]
+    return unsafe { (*doc).arena.reserve(bytes) };
+    #[cfg(not(feature = "arena"))]
+    {
+        let _ = bytes;
+        true
+    }
+}
+
+/// Parse a GBLN buffer into an arena-backed document
+///
+/// Any previously parsed tree in the document is discarded first, so one
+/// document can be reused for a stream of messages without returning its
+/// memory to the system.
+///
+/// Documents are only arena-backed when the library is built with the
+/// `arena` feature; otherwise the tree is an ordinary heap tree.
+///
+/// # Parameters
+/// - doc: Document from `gbln_document_new()`
+/// - input: Pointer to the first byte of the GBLN text
+/// - len: Number of bytes to parse
+/// - trusted: Skip UTF-8 validation (input MUST already be valid UTF-8)
+/// - out_root: Receives the root value (may be NULL, see `gbln_document_root()`)
+///
+/// # Returns
+/// - GBLN_OK on success
+/// - Error code on failure, with error details via `gbln_last_error_message()`
+///
+/// # Safety
+/// - `input` must point to at least `len` readable bytes
+/// - The root and all values reached from it are valid until the next
+///   `gbln_document_parse()`, `gbln_document_reset()` or `gbln_document_free()`
+/// - Values owned by a document must NOT be passed to `gbln_value_free()`
+///   or to functions that modify values
+/// - A document must not be parsed from two threads at the same time
+#[no_mangle]
+pub extern "C" fn gbln_document_parse(
+    doc: *mut GblnDocument,
+    input: *const u8,
+    len: usize,
+    trusted: bool,
+    out_root: *mut *const GblnValue,
+) -> GblnErrorCode {
+    if doc.is_null() || input.is_null() {
+        set_static_error(GblnErrorCode::ErrorNullPointer, "Null pointer", None);
+        return GblnErrorCode::ErrorNullPointer;
+    }
+
+    let input_str = match crate::bytes_to_str(input, len, trusted) {
+        Ok(s) => s,
+        Err(code) => return code,
+    };
+
+    let doc = unsafe { &mut *doc };
+    doc.clear();
+
+    #[cfg(feature = "arena")]
+    let result = {
+        let _scope = ArenaScope::enter(&mut doc.arena);
+        gbln::parse(input_str)
+    };
+    #[cfg(not(feature = "arena"))]
+    let result = gbln::parse(input_str);
+
+    match result {
+        Ok(value) => {
+            let root = doc.root.insert(GblnValue::new(value));
+            if !out_root.is_null() {
+                unsafe {
+                    *out_root = root as *const GblnValue;
+                }
+            }
+            GblnErrorCode::Ok
+        }
+        Err(e) => {
+            // Copy the error out of the arena, then abandon the arena-backed one
+            #[cfg(feature = "arena")]
+            let e = {
+                let copy = e.clone();
+                mem::forget(e);
+                copy
+            };
+            set_core_error(e)
+        }
+    }
+}
+
+/// Get the root value of a document
+///
+/// Returns NULL if the document is empty or the last parse failed.
+///
+/// # Safety
+/// - `doc` must be a valid GblnDocument pointer
+/// - Returned pointer is valid until the document is parsed into, reset or freed
+#[no_mangle]
+pub extern "C" fn gbln_document_root(doc: *const GblnDocument) -> *const GblnValue {
+    if doc.is_null() {
+        return ptr::null();
+    }
+
+    match unsafe { &(*doc).root } {
+        Some(root) => root as *const GblnValue,
+        None => ptr::null(),
+    }
+}
+
+/// Discard the document's tree, keeping its slabs for reuse
+///
+/// With the `arena` feature, cost is independent of the size of the tree.
+///
+/// # Safety
+/// - `doc` must be a valid GblnDocument pointer or NULL
+/// - All pointers obtained from the document become invalid
+#[no_mangle]
+pub extern "C" fn gbln_document_reset(doc: *mut GblnDocument) {
+    if !doc.is_null() {
+        unsafe {
+            (*doc).clear();
+        }
+    }
+}
+
+/// Free a document and all of its values
+///
+/// With the `arena` feature, cost is independent of the size of the tree.
+///
+/// # Safety
+/// - `doc` must be a valid pointer from `gbln_document_new()` or NULL
+/// - Must not be called twice on the same pointer
+#[no_mangle]
+pub extern "C" fn gbln_document_free(doc: *mut GblnDocument) {
+    if !doc.is_null() {
+        unsafe {
+            drop(Box::from_raw(doc));
+        }
+    }
+}
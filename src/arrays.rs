@@ -0,0 +1,431 @@
+// Copyright (c) 2025 Vivian Burkhard Voss
+// SPDX-License-Identifier: Apache-2.0
+
+//! Bulk typed-array access
+//!
+//! Copies a whole numeric array into a contiguous C buffer in one call,
+//! instead of one `gbln_array_get()` and one `gbln_value_as_*()` crossing
+//! per element. With `widen`, elements of a narrower type are converted
+//! where that is lossless (`<u8>` into `int32_t`, `<f32>` into `double`).
+
+use gbln::Value;
+
+use crate::error::{set_last_error, set_static_error, GblnErrorCode};
+use crate::types::{GblnValue, GblnValueType};
+
+/// Numeric element type of a bulk copy
+trait Element: Copy {
+    const TYPE: GblnValueType;
+
+    /// The element if it is exactly of this type
+    fn exact(value: &Value) -> Option<Self>;
+
+    /// The element if it converts to this type without loss
+    fn widen(value: &Value) -> Option<Self>;
+}
+
+impl Element for i8 {
+    const TYPE: GblnValueType = GblnValueType::I8;
+
+    fn exact(value: &Value) -> Option<i8> {
+        match value {
+            Value::I8(n) => Some(*n),
+            _ => None,
+        }
+    }
+
+    fn widen(value: &Value) -> Option<i8> {
+        i8::exact(value)
+    }
+}
+
+impl Element for i16 {
+    const TYPE: GblnValueType = GblnValueType::I16;
+
+    fn exact(value: &Value) -> Option<i16> {
+        match value {
+            Value::I16(n) => Some(*n),
+            _ => None,
+        }
+    }
+
+    fn widen(value: &Value) -> Option<i16> {
+        match value {
+            Value::I8(n) => Some((*n).into()),
+            Value::U8(n) => Some((*n).into()),
+            _ => i16::exact(value),
+        }
+    }
+}
+
+impl Element for i32 {
+    const TYPE: GblnValueType = GblnValueType::I32;
+
+    fn exact(value: &Value) -> Option<i32> {
+        match value {
+            Value::I32(n) => Some(*n),
+            _ => None,
+        }
+    }
+
+    fn widen(value: &Value) -> Option<i32> {
+        match value {
+            Value::I8(n) => Some((*n).into()),
+            Value::I16(n) => Some((*n).into()),
+            Value::U8(n) => Some((*n).into()),
+            Value::U16(n) => Some((*n).into()),
+            _ => i32::exact(value),
+        }
+    }
+}
+
+impl Element for i64 {
+    const TYPE: GblnValueType = GblnValueType::I64;
+
+    fn exact(value: &Value) -> Option<i64> {
+        match value {
+            Value::I64(n) => Some(*n),
+            _ => None,
+        }
+    }
+
+    fn widen(value: &Value) -> Option<i64> {
+        match value {
+            Value::I8(n) => Some((*n).into()),
+            Value::I16(n) => Some((*n).into()),
+            Value::I32(n) => Some((*n).into()),
+            Value::U8(n) => Some((*n).into()),
+            Value::U16(n) => Some((*n).into()),
+            Value::U32(n) => Some((*n).into()),
+            _ => i64::exact(value),
+        }
+    }
+}
+
+impl Element for u8 {
+    const TYPE: GblnValueType = GblnValueType::U8;
+
+    fn exact(value: &Value) -> Option<u8> {
+        match value {
+            Value::U8(n) => Some(*n),
+            _ => None,
+        }
+    }
+
+    fn widen(value: &Value) -> Option<u8> {
+        u8::exact(value)
+    }
+}
+
+impl Element for u16 {
+    const TYPE: GblnValueType = GblnValueType::U16;
+
+    fn exact(value: &Value) -> Option<u16> {
+        match value {
+            Value::U16(n) => Some(*n),
+            _ => None,
+        }
+    }
+
+    fn widen(value: &Value) -> Option<u16> {
+        match value {
+            Value::U8(n) => Some((*n).into()),
+            _ => u16::exact(value),
+        }
+    }
+}
+
+impl Element for u32 {
+    const TYPE: GblnValueType = GblnValueType::U32;
+
+    fn exact(value: &Value) -> Option<u32> {
+        match value {
+            Value::U32(n) => Some(*n),
+            _ => None,
+        }
+    }
+
+    fn widen(value: &Value) -> Option<u32> {
+        match value {
+            Value::U8(n) => Some((*n).into()),
+            Value::U16(n) => Some((*n).into()),
+            _ => u32::exact(value),
+        }
+    }
+}
+
+impl Element for u64 {
+    const TYPE: GblnValueType = GblnValueType::U64;
+
+    fn exact(value: &Value) -> Option<u64> {
+        match value {
+            Value::U64(n) => Some(*n),
+            _ => None,
+        }
+    }
+
+    fn widen(value: &Value) -> Option<u64> {
+        match value {
+            Value::U8(n) => Some((*n).into()),
+            Value::U16(n) => Some((*n).into()),
+            Value::U32(n) => Some((*n).into()),
+            _ => u64::exact(value),
+        }
+    }
+}
+
+impl Element for f32 {
+    const TYPE: GblnValueType = GblnValueType::F32;
+
+    fn exact(value: &Value) -> Option<f32> {
+        match value {
+            Value::F32(n) => Some(*n),
+            _ => None,
+        }
+    }
+
+    fn widen(value: &Value) -> Option<f32> {
+        match value {
+            Value::I8(n) => Some((*n).into()),
+            Value::I16(n) => Some((*n).into()),
+            Value::U8(n) => Some((*n).into()),
+            Value::U16(n) => Some((*n).into()),
+            _ => f32::exact(value),
+        }
+    }
+}
+
+impl Element for f64 {
+    const TYPE: GblnValueType = GblnValueType::F64;
+
+    fn exact(value: &Value) -> Option<f64> {
+        match value {
+            Value::F64(n) => Some(*n),
+            _ => None,
+        }
+    }
+
+    fn widen(value: &Value) -> Option<f64> {
+        match value {
+            Value::I8(n) => Some((*n).into()),
+            Value::I16(n) => Some((*n).into()),
+            Value::I32(n) => Some((*n).into()),
+            Value::U8(n) => Some((*n).into()),
+            Value::U16(n) => Some((*n).into()),
+            Value::U32(n) => Some((*n).into()),
+            Value::F32(n) => Some((*n).into()),
+            _ => f64::exact(value),
+        }
+    }
+}
+
+/// Copy the elements of array `value` into `out[..cap]`
+fn copy_array<T: Element>(
+    value: *const GblnValue,
+    out: *mut T,
+    cap: usize,
+    n: *mut usize,
+    widen: bool,
+) -> GblnErrorCode {
+    if value.is_null() || n.is_null() || (out.is_null() && cap != 0) {
+        set_static_error(GblnErrorCode::ErrorNullPointer, "Null pointer", None);
+        return GblnErrorCode::ErrorNullPointer;
+    }
+
+    let items = match unsafe { (*value).inner() } {
+        Value::Array(items) => items,
+        other => {
+            unsafe {
+                *n = 0;
+            }
+            set_last_error(
+                format!("Expected Array, found {:?}", GblnValueType::from(other)),
+                None,
+            );
+            return GblnErrorCode::ErrorTypeMismatch;
+        }
+    };
+
+    unsafe {
+        *n = items.len();
+    }
+    if items.len() > cap {
+        set_last_error(
+            format!(
+                "Buffer too small: {} elements needed, {} given",
+                items.len(),
+                cap
+            ),
+            None,
+        );
+        return GblnErrorCode::ErrorBufferTooSmall;
+    }
+    if items.is_empty() {
+        return GblnErrorCode::Ok;
+    }
+
+    let out = unsafe { std::slice::from_raw_parts_mut(out, items.len()) };
+    let convert = if widen { T::widen } else { T::exact };
+    for (i, (slot, item)) in out.iter_mut().zip(items).enumerate() {
+        match convert(item) {
+            Some(x) => *slot = x,
+            None => {
+                unsafe {
+                    *n = i;
+                }
+                set_last_error(
+                    format!(
+                        "Element {} is {:?}, not {:?}",
+                        i,
+                        GblnValueType::from(item),
+                        T::TYPE
+                    ),
+                    None,
+                );
+                return GblnErrorCode::ErrorTypeMismatch;
+            }
+        }
+    }
+    GblnErrorCode::Ok
+}
+
+/// Copy an array of i8 values into a C buffer
+///
+/// # Parameters
+/// - value: Array to copy
+/// - out: Destination buffer (may be NULL if `cap` is 0)
+/// - cap: Capacity of `out` in elements
+/// - n: Set to the number of elements in the array
+/// - widen: Also accept elements that convert to the target type without
+///   loss (e.g. `<u8>` into `int32_t`, `<f32>` or `<i32>` into `double`)
+///
+/// # Returns
+/// - GBLN_OK with all `*n` elements copied
+/// - GBLN_ERROR_BUFFER_TOO_SMALL if the array has more than `cap` elements
+///   (nothing is copied; `*n` is the required capacity)
+/// - GBLN_ERROR_TYPE_MISMATCH if `value` is not an array, or an element is
+///   of another type; `*n` is then the index of that element and `out` holds
+///   the elements before it
+/// - GBLN_ERROR_NULL_POINTER if value or n is NULL
+///
+/// # Safety
+/// - `value` must be a valid GblnValue pointer
+/// - `out` must point to at least `cap` writable elements
+#[no_mangle]
+pub extern "C" fn gbln_array_copy_i8(
+    value: *const GblnValue,
+    out: *mut i8,
+    cap: usize,
+    n: *mut usize,
+    widen: bool,
+) -> GblnErrorCode {
+    copy_array(value, out, cap, n, widen)
+}
+
+/// Copy an array of i16 values into a C buffer (see `gbln_array_copy_i8()`)
+#[no_mangle]
+pub extern "C" fn gbln_array_copy_i16(
+    value: *const GblnValue,
+    out: *mut i16,
+    cap: usize,
+    n: *mut usize,
+    widen: bool,
+) -> GblnErrorCode {
+    copy_array(value, out, cap, n, widen)
+}
+
+/// Copy an array of i32 values into a C buffer (see `gbln_array_copy_i8()`)
+#[no_mangle]
+pub extern "C" fn gbln_array_copy_i32(
+    value: *const GblnValue,
+    out: *mut i32,
+    cap: usize,
+    n: *mut usize,
+    widen: bool,
+) -> GblnErrorCode {
+    copy_array(value, out, cap, n, widen)
+}
+
+/// Copy an array of i64 values into a C buffer (see `gbln_array_copy_i8()`)
+#[no_mangle]
+pub extern "C" fn gbln_array_copy_i64(
+    value: *const GblnValue,
+    out: *mut i64,
+    cap: usize,
+    n: *mut usize,
+    widen: bool,
+) -> GblnErrorCode {
+    copy_array(value, out, cap, n, widen)
+}
+
+/// Copy an array of u8 values into a C buffer (see `gbln_array_copy_i8()`)
+#[no_mangle]
+pub extern "C" fn gbln_array_copy_u8(
+    value: *const GblnValue,
+    out: *mut u8,
+    cap: usize,
+    n: *mut usize,
+    widen: bool,
+) -> GblnErrorCode {
+    copy_array(value, out, cap, n, widen)
+}
+
+/// Copy an array of u16 values into a C buffer (see `gbln_array_copy_i8()`)
+#[no_mangle]
+pub extern "C" fn gbln_array_copy_u16(
+    value: *const GblnValue,
+    out: *mut u16,
+    cap: usize,
+    n: *mut usize,
+    widen: bool,
+) -> GblnErrorCode {
+    copy_array(value, out, cap, n, widen)
+}
+
+/// Copy an array of u32 values into a C buffer (see `gbln_array_copy_i8()`)
+#[no_mangle]
+pub extern "C" fn gbln_array_copy_u32(
+    value: *const GblnValue,
+    out: *mut u32,
+    cap: usize,
+    n: *mut usize,
+    widen: bool,
+) -> GblnErrorCode {
+    copy_array(value, out, cap, n, widen)
+}
+
+/// Copy an array of u64 values into a C buffer (see `gbln_array_copy_i8()`)
+#[no_mangle]
+pub extern "C" fn gbln_array_copy_u64(
+    value: *const GblnValue,
+    out: *mut u64,
+    cap: usize,
+    n: *mut usize,
+    widen: bool,
+) -> GblnErrorCode {
+    copy_array(value, out, cap, n, widen)
+}
+
+/// Copy an array of f32 values into a C buffer (see `gbln_array_copy_i8()`)
+#[no_mangle]
+pub extern "C" fn gbln_array_copy_f32(
+    value: *const GblnValue,
+    out: *mut f32,
+    cap: usize,
+    n: *mut usize,
+    widen: bool,
+) -> GblnErrorCode {
+    copy_array(value, out, cap, n, widen)
+}
+
+/// Copy an array of f64 values into a C buffer (see `gbln_array_copy_i8()`)
+#[no_mangle]
+pub extern "C" fn gbln_array_copy_f64(
+    value: *const GblnValue,
+    out: *mut f64,
+    cap: usize,
+    n: *mut usize,
+    widen: bool,
+) -> GblnErrorCode {
+    copy_array(value, out, cap, n, widen)
+}
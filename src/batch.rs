@@ -0,0 +1,403 @@
+// Copyright (c) 2025 Vivian Burkhard Voss
+// SPDX-License-Identifier: Apache-2.0
+
+//! Batch parsing across threads
+//!
+//! `gbln_parse_batch()` parses many independent messages in one call. Items
+//! are handed out in small chunks from a shared atomic cursor, so workers
+//! that draw cheap messages simply come back for more and uneven batches
+//! stay balanced. Each worker owns a `GblnParser` and reuses its buffers
+//! across the items it parses.
+//!
+//! Helpers come from one process-wide pool, started on first use and grown
+//! to the largest thread count requested. Its threads stay parked between
+//! calls, so a loop that parses one batch per poll does not pay thread
+//! start-up on every call.
+
+use std::any::Any;
+use std::collections::VecDeque;
+use std::panic::{self, AssertUnwindSafe};
+use std::sync::atomic::{AtomicUsize, Ordering};
+use std::sync::{Condvar, Mutex, MutexGuard, OnceLock, PoisonError};
+use std::thread;
+
+use crate::error::{set_last_error, set_static_error, GblnErrorCode};
+use crate::parser::{GblnParser, ParseError};
+use crate::types::GblnValue;
+
+/// Batches smaller than this are parsed on the calling thread
+const PARALLEL_MIN_ITEMS: usize = 64;
+
+/// Borrowed byte range
+#[repr(C)]
+#[derive(Debug, Copy, Clone)]
+pub struct GblnSlice {
+    pub ptr: *const u8,
+    pub len: usize,
+}
+
+// Workers only read the ranges they are handed
+unsafe impl Sync for GblnSlice {}
+
+/// Options for `gbln_parse_batch()`
+#[repr(C)]
+#[derive(Debug, Copy, Clone, Default)]
+pub struct GblnBatchOptions {
+    /// Worker threads to use (0 = one per available CPU)
+    pub threads: usize,
+    /// Skip UTF-8 validation (every input MUST already be valid UTF-8)
+    pub trusted: bool,
+}
+
+/// Pointer that may be shared between workers writing disjoint elements
+pub(crate) struct SharedPtr<T>(pub *mut T);
+
+// Copy whatever `T` is, unlike the derived impls
+impl<T> Clone for SharedPtr<T> {
+    fn clone(&self) -> Self {
+        *self
+    }
+}
+
+impl<T> Copy for SharedPtr<T> {}
+
+unsafe impl<T> Send for SharedPtr<T> {}
+unsafe impl<T> Sync for SharedPtr<T> {}
+
+impl<T> SharedPtr<T> {
+    /// Pointer to element `i`
+    #[inline]
+    pub(crate) fn at(&self, i: usize) -> *mut T {
+        unsafe { self.0.add(i) }
+    }
+}
+
+/// Number of threads to use for `len` work items
+pub(crate) fn worker_count(requested: usize, len: usize, min_items: usize) -> usize {
+    let available = if requested == 0 {
+        thread::available_parallelism().map_or(1, |n| n.get())
+    } else {
+        requested
+    };
+    available.min(len / min_items.max(1)).max(1)
+}
+
+/// Job queued on the pool, tagged with the call that queued it
+struct Job {
+    call: usize,
+    run: Box<dyn FnOnce() + Send + 'static>,
+}
+
+/// Process-wide helper threads
+struct Pool {
+    queue: Mutex<VecDeque<Job>>,
+    ready: Condvar,
+    /// Helper threads started so far
+    helpers: Mutex<usize>,
+}
+
+static POOL: OnceLock<Pool> = OnceLock::new();
+
+/// Lock `mutex`, ignoring poisoning (jobs never panic while holding a lock)
+fn lock<T>(mutex: &Mutex<T>) -> MutexGuard<'_, T> {
+    mutex.lock().unwrap_or_else(PoisonError::into_inner)
+}
+
+impl Pool {
+    fn get() -> &'static Pool {
+        POOL.get_or_init(|| Pool {
+            queue: Mutex::new(VecDeque::new()),
+            ready: Condvar::new(),
+            helpers: Mutex::new(0),
+        })
+    }
+
+    /// Start helpers until there are at least `n`
+    fn grow(&'static self, n: usize) {
+        let mut helpers = lock(&self.helpers);
+        while *helpers < n {
+            let spawned = thread::Builder::new()
+                .name("gbln-worker".to_string())
+                .spawn(move || self.serve());
+            if spawned.is_err() {
+                // Calls still finish: the caller runs whatever is not picked up
+                break;
+            }
+            *helpers += 1;
+        }
+    }
+
+    fn serve(&self) {
+        loop {
+            let job = {
+                let mut queue = lock(&self.queue);
+                loop {
+                    match queue.pop_front() {
+                        Some(job) => break job,
+                        None => {
+                            queue = self
+                                .ready
+                                .wait(queue)
+                                .unwrap_or_else(PoisonError::into_inner)
+                        }
+                    }
+                }
+            };
+            (job.run)();
+        }
+    }
+
+    fn submit(&self, jobs: impl Iterator<Item = Job>) {
+        lock(&self.queue).extend(jobs);
+        self.ready.notify_all();
+    }
+
+    /// Take back the jobs of `call` no helper has started; returns how many
+    fn cancel(&self, call: usize) -> usize {
+        let mut queue = lock(&self.queue);
+        let before = queue.len();
+        queue.retain(|job| job.call != call);
+        before - queue.len()
+    }
+}
+
+/// State shared by the threads working on one `for_each_parallel()` call
+struct Call<'a, S, I, F> {
+    len: usize,
+    chunk: usize,
+    cursor: AtomicUsize,
+    init: &'a I,
+    work: &'a F,
+    states: Mutex<Vec<S>>,
+    panic: Mutex<Option<Box<dyn Any + Send>>>,
+    /// Queued or running helper jobs
+    pending: Mutex<usize>,
+    done: Condvar,
+}
+
+impl<S, I, F> Call<'_, S, I, F>
+where
+    I: Fn() -> S,
+    F: Fn(&mut S, usize),
+{
+    /// Take chunks from the cursor until none are left
+    fn run(&self) {
+        let result = panic::catch_unwind(AssertUnwindSafe(|| {
+            let mut state = (self.init)();
+            loop {
+                let start = self.cursor.fetch_add(self.chunk, Ordering::Relaxed);
+                if start >= self.len {
+                    return state;
+                }
+                for i in start..(start + self.chunk).min(self.len) {
+                    (self.work)(&mut state, i);
+                }
+            }
+        }));
+        match result {
+            Ok(state) => lock(&self.states).push(state),
+            Err(payload) => {
+                // Stop the other threads early; the first panic is re-raised
+                self.cursor.store(self.len, Ordering::Relaxed);
+                lock(&self.panic).get_or_insert(payload);
+            }
+        }
+    }
+
+    /// Mark `n` helper jobs as finished or cancelled
+    fn release(&self, n: usize) {
+        let mut pending = lock(&self.pending);
+        *pending -= n;
+        if *pending == 0 {
+            self.done.notify_all();
+        }
+    }
+}
+
+/// Run `work(state, index)` for every index in `0..len` on up to `threads` threads
+///
+/// The calling thread works alongside up to `threads - 1` pool helpers.
+/// Every thread taking part gets its own state from `init`; the states are
+/// returned when all items are done. Jobs no helper has picked up by the
+/// time the caller runs out of work are taken back, so a call never waits
+/// on a busy pool (including when called from a pool thread).
+pub(crate) fn for_each_parallel<S, I, F>(len: usize, threads: usize, init: I, work: F) -> Vec<S>
+where
+    S: Send,
+    I: Fn() -> S + Sync,
+    F: Fn(&mut S, usize) + Sync,
+{
+    if threads <= 1 {
+        let mut state = init();
+        for i in 0..len {
+            work(&mut state, i);
+        }
+        return vec![state];
+    }
+
+    let helpers = threads - 1;
+    let call = Call {
+        len,
+        chunk: (len / (threads * 8)).clamp(1, 64),
+        cursor: AtomicUsize::new(0),
+        init: &init,
+        work: &work,
+        states: Mutex::new(Vec::with_capacity(threads)),
+        panic: Mutex::new(None),
+        pending: Mutex::new(helpers),
+        done: Condvar::new(),
+    };
+    let id = &call as *const _ as usize;
+    let shared = SharedPtr(&call as *const Call<S, I, F> as *mut Call<S, I, F>);
+
+    let pool = Pool::get();
+    pool.grow(helpers);
+    pool.submit(
+        (0..helpers).map(|_| {
+            let job: Box<dyn FnOnce() + Send + '_> = Box::new(move || {
+                let call = unsafe { &*shared.at(0) };
+                call.run();
+                call.release(1);
+            });
+            // SAFETY: `call` outlives every job: each one either runs to
+            // `release()` or is cancelled below before this function returns
+            let run = unsafe {
+                std::mem::transmute::<
+                    Box<dyn FnOnce() + Send + '_>,
+                    Box<dyn FnOnce() + Send + 'static>,
+                >(job)
+            };
+            Job { call: id, run }
+        }),
+    );
+
+    call.run();
+    call.release(pool.cancel(id));
+    let mut pending = lock(&call.pending);
+    while *pending > 0 {
+        pending = call
+            .done
+            .wait(pending)
+            .unwrap_or_else(PoisonError::into_inner);
+    }
+    drop(pending);
+
+    if let Some(payload) = lock(&call.panic).take() {
+        panic::resume_unwind(payload);
+    }
+    call.states
+        .into_inner()
+        .unwrap_or_else(PoisonError::into_inner)
+}
+
+/// Per-worker batch state
+struct Worker {
+    parser: GblnParser,
+    /// First failing item seen by this worker
+    first_error: Option<(usize, ParseError)>,
+}
+
+/// Parse many independent GBLN messages, spread over worker threads
+///
+/// Workers come from a pool started on the first parallel call and kept for
+/// later calls, so thread start-up is paid once per process, not per batch.
+/// The calling thread parses alongside them. Batches under 64 items are
+/// parsed on the calling thread alone.
+///
+/// # Parameters
+/// - inputs: Array of `n` input byte ranges
+/// - n: Number of inputs
+/// - outs: Array of `n` slots; each receives the parsed value or NULL
+/// - codes: Array of `n` slots; each receives that item's result code
+/// - options: Threads and trust settings (NULL = all CPUs, validate UTF-8)
+///
+/// # Returns
+/// - GBLN_OK if every item parsed
+/// - Otherwise the code of the lowest-indexed failing item, whose message is
+///   available via `gbln_last_error_message()` on the calling thread
+///
+/// # Safety
+/// - `inputs`, `outs` and `codes` must each point to `n` elements
+/// - Every input must point to at least `len` readable bytes
+/// - Caller must free every non-NULL value in `outs` with `gbln_value_free()`
+#[no_mangle]
+pub extern "C" fn gbln_parse_batch(
+    inputs: *const GblnSlice,
+    n: usize,
+    outs: *mut *mut GblnValue,
+    codes: *mut GblnErrorCode,
+    options: *const GblnBatchOptions,
+) -> GblnErrorCode {
+    if n == 0 {
+        return GblnErrorCode::Ok;
+    }
+    if inputs.is_null() || outs.is_null() || codes.is_null() {
+        set_static_error(GblnErrorCode::ErrorNullPointer, "Null pointer", None);
+        return GblnErrorCode::ErrorNullPointer;
+    }
+
+    let options = if options.is_null() {
+        GblnBatchOptions::default()
+    } else {
+        unsafe { *options }
+    };
+    let inputs = unsafe { std::slice::from_raw_parts(inputs, n) };
+    let outs = SharedPtr(outs);
+    let codes = SharedPtr(codes);
+    let threads = worker_count(options.threads, n, PARALLEL_MIN_ITEMS);
+
+    let workers = for_each_parallel(
+        n,
+        threads,
+        || Worker {
+            parser: GblnParser::new(),
+            first_error: None,
+        },
+        |worker, i| {
+            let input = inputs[i];
+            let result = if input.ptr.is_null() {
+                Err(ParseError {
+                    code: GblnErrorCode::ErrorNullPointer,
+                    offset: 0,
+                    message: "Null input pointer",
+                })
+            } else {
+                let bytes = unsafe { std::slice::from_raw_parts(input.ptr, input.len) };
+                worker.parser.parse_value(bytes, options.trusted)
+            };
+
+            let (value, code) = match result {
+                Ok(value) => (
+                    Box::into_raw(Box::new(GblnValue::new(value))),
+                    GblnErrorCode::Ok,
+                ),
+                Err(e) => {
+                    if worker.first_error.is_none_or(|(first, _)| i < first) {
+                        worker.first_error = Some((i, e));
+                    }
+                    (std::ptr::null_mut(), e.code)
+                }
+            };
+            // Each index is written by exactly one worker
+            unsafe {
+                *outs.at(i) = value;
+                *codes.at(i) = code;
+            }
+        },
+    );
+
+    match workers
+        .iter()
+        .filter_map(|w| w.first_error)
+        .min_by_key(|(i, _)| *i)
+    {
+        None => GblnErrorCode::Ok,
+        Some((i, e)) => {
+            set_last_error(
+                format!("Batch item {}: {} at byte {}", i, e.message, e.offset),
+                None,
+            );
+            e.code
+        }
+    }
+}
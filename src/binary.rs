@@ -0,0 +1,378 @@
+// Copyright (c) 2025 Vivian Burkhard Voss
+// SPDX-License-Identifier: Apache-2.0
+
+//! Compact binary encoding of the value tree
+//!
+//! For IPC and caches between processes that already agree on GBLN: no
+//! tokenising, no number parsing, and every type is kept exactly. A binary
+//! document is the magic `GBLB`, a version byte and one value:
+//!
+//! ```text
+//! value := tag payload            tag = GblnValueType (1 byte)
+//!   I8, U8, Bool                  1 byte
+//!   I16, I32, I64                 zigzag varint
+//!   U16, U32, U64                 varint (LEB128)
+//!   F32, F64                      4 / 8 bytes little-endian
+//!   Null                          nothing
+//!   Str                           varint length, UTF-8 bytes
+//!   Array                         varint count, values
+//!   Object                        varint count, (varint length, key, value)*
+//! ```
+//!
+//! Object fields are written in key order, so equal trees encode to equal
+//! bytes. Strings and keys are stored as raw length-prefixed UTF-8, so a
+//! reader can borrow them straight from the buffer.
+
+use std::collections::HashMap;
+use std::io::{self, Write};
+
+use gbln::Value;
+
+use crate::error::{set_last_error, set_parse_error, set_static_error, GblnErrorCode};
+use crate::parser::{ParseError, MAX_DEPTH};
+use crate::types::{GblnValue, GblnValueType};
+use crate::writer::SliceWriter;
+
+/// Magic bytes of a binary document
+pub(crate) const BINARY_MAGIC: [u8; 4] = *b"GBLB";
+
+/// Current format version
+const VERSION: u8 = 1;
+
+/// Whether `bytes` start like a binary document
+pub(crate) fn is_binary(bytes: &[u8]) -> bool {
+    bytes.starts_with(&BINARY_MAGIC)
+}
+
+// ============================================================================
+// Encoding
+// ============================================================================
+
+fn varint<W: Write>(out: &mut W, mut n: u64) -> io::Result<()> {
+    let mut buf = [0u8; 10];
+    let mut len = 0;
+    while n >= 0x80 {
+        buf[len] = n as u8 | 0x80;
+        n >>= 7;
+        len += 1;
+    }
+    buf[len] = n as u8;
+    out.write_all(&buf[..=len])
+}
+
+fn zigzag<W: Write>(out: &mut W, n: i64) -> io::Result<()> {
+    varint(out, ((n << 1) ^ (n >> 63)) as u64)
+}
+
+fn bytes<W: Write>(out: &mut W, data: &[u8]) -> io::Result<()> {
+    varint(out, data.len() as u64)?;
+    out.write_all(data)
+}
+
+fn value<W: Write>(out: &mut W, v: &Value) -> io::Result<()> {
+    out.write_all(&[GblnValueType::from(v) as u8])?;
+    match v {
+        Value::I8(n) => out.write_all(&n.to_le_bytes()),
+        Value::I16(n) => zigzag(out, i64::from(*n)),
+        Value::I32(n) => zigzag(out, i64::from(*n)),
+        Value::I64(n) => zigzag(out, *n),
+        Value::U8(n) => out.write_all(&[*n]),
+        Value::U16(n) => varint(out, u64::from(*n)),
+        Value::U32(n) => varint(out, u64::from(*n)),
+        Value::U64(n) => varint(out, *n),
+        Value::F32(n) => out.write_all(&n.to_le_bytes()),
+        Value::F64(n) => out.write_all(&n.to_le_bytes()),
+        Value::Bool(b) => out.write_all(&[u8::from(*b)]),
+        Value::Null => Ok(()),
+        Value::Str(s) => bytes(out, s.as_bytes()),
+        Value::Array(items) => {
+            varint(out, items.len() as u64)?;
+            items.iter().try_for_each(|item| value(out, item))
+        }
+        Value::Object(map) => {
+            let mut fields: Vec<_> = map.iter().collect();
+            fields.sort_unstable_by(|a, b| a.0.cmp(b.0));
+
+            varint(out, fields.len() as u64)?;
+            for (key, field) in fields {
+                bytes(out, key.as_bytes())?;
+                value(out, field)?;
+            }
+            Ok(())
+        }
+    }
+}
+
+/// Write `v` as a binary document
+pub(crate) fn write_binary<W: Write>(out: &mut W, v: &Value) -> io::Result<()> {
+    out.write_all(&BINARY_MAGIC)?;
+    out.write_all(&[VERSION])?;
+    value(out, v)
+}
+
+// ============================================================================
+// Decoding
+// ============================================================================
+
+fn invalid(offset: usize, message: &'static str) -> ParseError {
+    ParseError {
+        code: GblnErrorCode::ErrorInvalidSyntax,
+        offset,
+        message,
+    }
+}
+
+struct Reader<'a> {
+    input: &'a [u8],
+    pos: usize,
+}
+
+impl<'a> Reader<'a> {
+    fn take(&mut self, n: usize) -> Result<&'a [u8], ParseError> {
+        let end = self
+            .pos
+            .checked_add(n)
+            .filter(|&end| end <= self.input.len())
+            .ok_or(invalid(self.pos, "Truncated binary value"))?;
+        let data = &self.input[self.pos..end];
+        self.pos = end;
+        Ok(data)
+    }
+
+    fn array<const N: usize>(&mut self) -> Result<[u8; N], ParseError> {
+        let mut out = [0u8; N];
+        out.copy_from_slice(self.take(N)?);
+        Ok(out)
+    }
+
+    fn varint(&mut self) -> Result<u64, ParseError> {
+        let start = self.pos;
+        let mut n = 0u64;
+        for shift in (0..64).step_by(7) {
+            let [b] = self.array::<1>()?;
+            n |= u64::from(b & 0x7F) << shift;
+            if b & 0x80 == 0 {
+                // The tenth byte may only hold the top bit
+                if shift == 63 && b > 1 {
+                    break;
+                }
+                return Ok(n);
+            }
+        }
+        Err(invalid(start, "Invalid varint"))
+    }
+
+    fn zigzag(&mut self) -> Result<i64, ParseError> {
+        let n = self.varint()?;
+        Ok((n >> 1) as i64 ^ -((n & 1) as i64))
+    }
+
+    /// Element count, bounded by the bytes left (every element takes one)
+    fn count(&mut self) -> Result<usize, ParseError> {
+        let start = self.pos;
+        let n = self.varint()?;
+        usize::try_from(n)
+            .ok()
+            .filter(|&n| n <= self.input.len() - self.pos)
+            .ok_or(invalid(start, "Truncated binary value"))
+    }
+
+    fn str(&mut self) -> Result<&'a str, ParseError> {
+        let start = self.pos;
+        let len = self.count()?;
+        std::str::from_utf8(self.take(len)?).map_err(|_| invalid(start, "Invalid UTF-8 in string"))
+    }
+
+    fn int<T: TryFrom<i64>>(&mut self) -> Result<T, ParseError> {
+        let start = self.pos;
+        T::try_from(self.zigzag()?).map_err(|_| ParseError {
+            code: GblnErrorCode::ErrorIntOutOfRange,
+            offset: start,
+            message: "Integer out of range for its type",
+        })
+    }
+
+    fn uint<T: TryFrom<u64>>(&mut self) -> Result<T, ParseError> {
+        let start = self.pos;
+        T::try_from(self.varint()?).map_err(|_| ParseError {
+            code: GblnErrorCode::ErrorIntOutOfRange,
+            offset: start,
+            message: "Integer out of range for its type",
+        })
+    }
+
+    fn value(&mut self, depth: usize) -> Result<Value, ParseError> {
+        let start = self.pos;
+        let [tag] = self.array::<1>()?;
+        Ok(match tag {
+            0 => Value::I8(i8::from_le_bytes(self.array()?)),
+            1 => Value::I16(self.int()?),
+            2 => Value::I32(self.int()?),
+            3 => Value::I64(self.zigzag()?),
+            4 => Value::U8(self.array::<1>()?[0]),
+            5 => Value::U16(self.uint()?),
+            6 => Value::U32(self.uint()?),
+            7 => Value::U64(self.varint()?),
+            8 => Value::F32(f32::from_le_bytes(self.array()?)),
+            9 => Value::F64(f64::from_le_bytes(self.array()?)),
+            10 => Value::Str(self.str()?.to_string()),
+            11 => match self.array::<1>()? {
+                [0] => Value::Bool(false),
+                [1] => Value::Bool(true),
+                _ => return Err(invalid(start + 1, "Invalid bool")),
+            },
+            12 => Value::Null,
+            13 | 14 if depth >= MAX_DEPTH => {
+                return Err(invalid(start, "Maximum nesting depth exceeded"))
+            }
+            13 => {
+                let count = self.count()?;
+                let mut map = HashMap::with_capacity(count);
+                for _ in 0..count {
+                    let at = self.pos;
+                    let key = self.str()?;
+                    let field = self.value(depth + 1)?;
+                    if map.insert(key.to_string(), field).is_some() {
+                        return Err(ParseError {
+                            code: GblnErrorCode::ErrorDuplicateKey,
+                            offset: at,
+                            message: "Duplicate key",
+                        });
+                    }
+                }
+                Value::Object(map)
+            }
+            14 => {
+                let count = self.count()?;
+                let mut items = Vec::with_capacity(count);
+                for _ in 0..count {
+                    items.push(self.value(depth + 1)?);
+                }
+                Value::Array(items)
+            }
+            _ => return Err(invalid(start, "Invalid type tag")),
+        })
+    }
+}
+
+/// Decode a binary document
+pub(crate) fn read_binary(input: &[u8]) -> Result<Value, ParseError> {
+    if !is_binary(input) {
+        return Err(invalid(0, "Not a GBLN binary document"));
+    }
+    if input.get(BINARY_MAGIC.len()) != Some(&VERSION) {
+        return Err(invalid(BINARY_MAGIC.len(), "Unsupported binary version"));
+    }
+
+    let mut reader = Reader {
+        input,
+        pos: BINARY_MAGIC.len() + 1,
+    };
+    let value = reader.value(0)?;
+    if reader.pos != input.len() {
+        return Err(invalid(reader.pos, "Trailing bytes after binary value"));
+    }
+    Ok(value)
+}
+
+/// Decode a binary document into a new GblnValue, recording any error
+pub(crate) fn store_binary(input: &[u8], out_value: *mut *mut GblnValue) -> GblnErrorCode {
+    match read_binary(input) {
+        Ok(value) => {
+            unsafe {
+                *out_value = Box::into_raw(Box::new(GblnValue::new(value)));
+            }
+            GblnErrorCode::Ok
+        }
+        Err(e) => {
+            set_parse_error(e, Some(input));
+            e.code
+        }
+    }
+}
+
+/// Serialize GBLN value into the binary format
+///
+/// Every type is preserved exactly. Call with `cap` 0 (and `buf` NULL) to
+/// query the size.
+///
+/// # Parameters
+/// - value: GBLN value to encode
+/// - buf: Destination buffer (may be NULL if `cap` is 0)
+/// - cap: Size of `buf` in bytes
+/// - written: Set to the size of the encoding
+///
+/// # Returns
+/// - GBLN_OK on success
+/// - GBLN_ERROR_BUFFER_TOO_SMALL if `cap` is less than `*written`; the
+///   contents of `buf` are then unspecified
+/// - GBLN_ERROR_NULL_POINTER if value or written is NULL
+///
+/// # Safety
+/// - `value` must be a valid GblnValue pointer
+/// - `buf` must point to at least `cap` writable bytes
+#[no_mangle]
+pub extern "C" fn gbln_to_binary(
+    value: *const GblnValue,
+    buf: *mut u8,
+    cap: usize,
+    written: *mut usize,
+) -> GblnErrorCode {
+    if value.is_null() || written.is_null() || (buf.is_null() && cap != 0) {
+        set_static_error(GblnErrorCode::ErrorNullPointer, "Null pointer", None);
+        return GblnErrorCode::ErrorNullPointer;
+    }
+
+    let buf = if cap == 0 {
+        &mut [][..]
+    } else {
+        unsafe { std::slice::from_raw_parts_mut(buf, cap) }
+    };
+    let mut out = SliceWriter { buf, len: 0 };
+    // Writing into a slice cannot fail
+    let _ = write_binary(&mut out, unsafe { (*value).inner() });
+
+    unsafe {
+        *written = out.len;
+    }
+    if out.len > cap {
+        set_last_error(
+            format!("Buffer too small: {} bytes needed, {} given", out.len, cap),
+            None,
+        );
+        return GblnErrorCode::ErrorBufferTooSmall;
+    }
+    GblnErrorCode::Ok
+}
+
+/// Decode a binary GBLN document
+///
+/// # Parameters
+/// - buf: Encoded bytes, as from `gbln_to_binary()`
+/// - len: Number of bytes
+/// - out_value: Pointer to store the decoded value
+///
+/// # Returns
+/// - GBLN_OK on success
+/// - GBLN_ERROR_INVALID_SYNTAX if the bytes are not a valid binary document
+/// - GBLN_ERROR_INT_OUT_OF_RANGE if an integer exceeds its type
+/// - GBLN_ERROR_DUPLICATE_KEY if an object repeats a key
+/// - GBLN_ERROR_NULL_POINTER if buf or out_value is NULL
+/// - Error position via `gbln_last_error_info()`
+///
+/// # Safety
+/// - `buf` must point to at least `len` readable bytes
+/// - Caller must free the value with `gbln_value_free()`
+#[no_mangle]
+pub extern "C" fn gbln_from_binary(
+    buf: *const u8,
+    len: usize,
+    out_value: *mut *mut GblnValue,
+) -> GblnErrorCode {
+    if buf.is_null() || out_value.is_null() {
+        set_static_error(GblnErrorCode::ErrorNullPointer, "Null pointer", None);
+        return GblnErrorCode::ErrorNullPointer;
+    }
+
+    store_binary(unsafe { std::slice::from_raw_parts(buf, len) }, out_value)
+}
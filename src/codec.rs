@@ -0,0 +1,253 @@
+// Copyright (c) 2025 Vivian Burkhard Voss
+// SPDX-License-Identifier: Apache-2.0
+
+//! Compression codecs for the I/O format
+//!
+//! XZ is always available and can compress with several threads. zstd and
+//! LZ4 trade ratio for speed and are compiled in with the `zstd` and `lz4`
+//! features. Readers pick the codec from the file's magic bytes, so any
+//! supported file can be read without knowing how it was written.
+
+use std::io::{self, BufRead, Read, Write};
+
+use xz2::read::XzDecoder;
+use xz2::stream::{Check, MtStreamBuilder};
+use xz2::write::XzEncoder;
+
+use crate::config::GblnConfig;
+
+/// Compression codec used when `compress` is set
+#[repr(C)]
+#[derive(Debug, Clone, Copy, PartialEq, Eq)]
+pub enum GblnCodec {
+    /// XZ (LZMA2): best ratio, the default
+    CodecXz = 0,
+    /// Zstandard: fast, good ratio (requires the `zstd` feature)
+    CodecZstd = 1,
+    /// LZ4 frame: fastest, lowest ratio (requires the `lz4` feature)
+    CodecLz4 = 2,
+}
+
+impl GblnCodec {
+    /// Codec with the C value `value`, if it names one
+    pub(crate) fn from_u32(value: u32) -> Option<GblnCodec> {
+        Some(match value {
+            0 => GblnCodec::CodecXz,
+            1 => GblnCodec::CodecZstd,
+            2 => GblnCodec::CodecLz4,
+            _ => return None,
+        })
+    }
+
+    /// Highest compression level the codec accepts
+    fn max_level(self) -> u8 {
+        match self {
+            GblnCodec::CodecXz => 9,
+            GblnCodec::CodecZstd => 22,
+            // Has no levels
+            GblnCodec::CodecLz4 => 0,
+        }
+    }
+}
+
+/// XZ stream header magic
+pub(crate) const XZ_MAGIC: [u8; 6] = [0xFD, 0x37, 0x7A, 0x58, 0x5A, 0x00];
+
+/// Zstandard frame magic
+const ZSTD_MAGIC: [u8; 4] = [0x28, 0xB5, 0x2F, 0xFD];
+
+/// LZ4 frame magic
+const LZ4_MAGIC: [u8; 4] = [0x04, 0x22, 0x4D, 0x18];
+
+/// Codec whose magic bytes start `head`, if any
+pub(crate) fn sniff(head: &[u8]) -> Option<GblnCodec> {
+    if head.starts_with(&XZ_MAGIC) {
+        Some(GblnCodec::CodecXz)
+    } else if head.starts_with(&ZSTD_MAGIC) {
+        Some(GblnCodec::CodecZstd)
+    } else if head.starts_with(&LZ4_MAGIC) {
+        Some(GblnCodec::CodecLz4)
+    } else {
+        None
+    }
+}
+
+fn unsupported(codec: GblnCodec) -> io::Error {
+    io::Error::new(
+        io::ErrorKind::Unsupported,
+        format!("{:?} support is not compiled in", codec),
+    )
+}
+
+/// Compression requested by a config
+#[derive(Debug, Clone, Copy)]
+pub(crate) struct Compression {
+    pub codec: GblnCodec,
+    pub level: u32,
+    /// Encoder threads (0 = one per available CPU)
+    pub threads: u32,
+}
+
+impl Compression {
+    /// Compression for `config`, or `None` if it does not compress
+    pub(crate) fn of(config: &GblnConfig) -> Option<Compression> {
+        if !config.inner.compress {
+            return None;
+        }
+        Some(Compression {
+            codec: config.codec,
+            level: u32::from(config.inner.compression_level.min(config.codec.max_level())),
+            threads: config.threads,
+        })
+    }
+
+    fn threads(&self) -> u32 {
+        match self.threads {
+            0 => std::thread::available_parallelism().map_or(1, |n| n.get() as u32),
+            n => n,
+        }
+    }
+}
+
+/// Compressing writer for any supported codec
+pub(crate) enum Encoder<W: Write> {
+    Plain(W),
+    Xz(XzEncoder<W>),
+    #[cfg(feature = "zstd")]
+    Zstd(zstd::stream::write::Encoder<'static, W>),
+    #[cfg(feature = "lz4")]
+    Lz4(lz4_flex::frame::FrameEncoder<W>),
+}
+
+impl<W: Write> Encoder<W> {
+    /// Wrap `out` in the encoder for `compression` (`None` writes plain text)
+    pub(crate) fn new(out: W, compression: Option<Compression>) -> io::Result<Self> {
+        let Some(c) = compression else {
+            return Ok(Encoder::Plain(out));
+        };
+
+        match c.codec {
+            GblnCodec::CodecXz if c.threads() > 1 => {
+                let stream = MtStreamBuilder::new()
+                    .threads(c.threads())
+                    .preset(c.level)
+                    .check(Check::Crc64)
+                    .encoder()
+                    .map_err(io::Error::from)?;
+                Ok(Encoder::Xz(XzEncoder::new_stream(out, stream)))
+            }
+            GblnCodec::CodecXz => Ok(Encoder::Xz(XzEncoder::new(out, c.level))),
+            #[cfg(feature = "zstd")]
+            GblnCodec::CodecZstd => {
+                let mut encoder = zstd::stream::write::Encoder::new(out, c.level as i32)?;
+                if c.threads() > 1 {
+                    encoder.multithread(c.threads())?;
+                }
+                Ok(Encoder::Zstd(encoder))
+            }
+            #[cfg(feature = "lz4")]
+            GblnCodec::CodecLz4 => Ok(Encoder::Lz4(lz4_flex::frame::FrameEncoder::new(out))),
+            #[allow(unreachable_patterns)]
+            codec => Err(unsupported(codec)),
+        }
+    }
+
+    /// Write the codec trailer and return the underlying writer
+    pub(crate) fn finish(self) -> io::Result<W> {
+        match self {
+            Encoder::Plain(w) => Ok(w),
+            Encoder::Xz(e) => e.finish(),
+            #[cfg(feature = "zstd")]
+            Encoder::Zstd(e) => e.finish(),
+            #[cfg(feature = "lz4")]
+            Encoder::Lz4(e) => e.finish().map_err(io::Error::other),
+        }
+    }
+}
+
+impl<W: Write> Write for Encoder<W> {
+    fn write(&mut self, buf: &[u8]) -> io::Result<usize> {
+        match self {
+            Encoder::Plain(w) => w.write(buf),
+            Encoder::Xz(e) => e.write(buf),
+            #[cfg(feature = "zstd")]
+            Encoder::Zstd(e) => e.write(buf),
+            #[cfg(feature = "lz4")]
+            Encoder::Lz4(e) => e.write(buf),
+        }
+    }
+
+    fn flush(&mut self) -> io::Result<()> {
+        match self {
+            Encoder::Plain(w) => w.flush(),
+            Encoder::Xz(e) => e.flush(),
+            #[cfg(feature = "zstd")]
+            Encoder::Zstd(e) => e.flush(),
+            #[cfg(feature = "lz4")]
+            Encoder::Lz4(e) => e.flush(),
+        }
+    }
+}
+
+/// Decompressing reader, codec chosen by magic bytes
+pub(crate) enum Decoder<R: BufRead> {
+    Plain(R),
+    Xz(XzDecoder<R>),
+    #[cfg(feature = "zstd")]
+    Zstd(zstd::stream::read::Decoder<'static, R>),
+    #[cfg(feature = "lz4")]
+    Lz4(lz4_flex::frame::FrameDecoder<R>),
+}
+
+impl<R: BufRead> Decoder<R> {
+    /// Wrap `reader` in the decoder its first bytes call for
+    pub(crate) fn sniff(mut reader: R) -> io::Result<Self> {
+        let codec = sniff(reader.fill_buf()?);
+        match codec {
+            None => Ok(Decoder::Plain(reader)),
+            Some(GblnCodec::CodecXz) => Ok(Decoder::Xz(XzDecoder::new(reader))),
+            #[cfg(feature = "zstd")]
+            Some(GblnCodec::CodecZstd) => Ok(Decoder::Zstd(
+                zstd::stream::read::Decoder::with_buffer(reader)?,
+            )),
+            #[cfg(feature = "lz4")]
+            Some(GblnCodec::CodecLz4) => {
+                Ok(Decoder::Lz4(lz4_flex::frame::FrameDecoder::new(reader)))
+            }
+            #[allow(unreachable_patterns)]
+            Some(codec) => Err(unsupported(codec)),
+        }
+    }
+
+    /// Whether the input is compressed
+    pub(crate) fn compressed(&self) -> bool {
+        !matches!(self, Decoder::Plain(_))
+    }
+}
+
+impl<R: BufRead> Read for Decoder<R> {
+    fn read(&mut self, buf: &mut [u8]) -> io::Result<usize> {
+        match self {
+            Decoder::Plain(r) => r.read(buf),
+            Decoder::Xz(d) => d.read(buf),
+            #[cfg(feature = "zstd")]
+            Decoder::Zstd(d) => d.read(buf),
+            #[cfg(feature = "lz4")]
+            Decoder::Lz4(d) => d.read(buf),
+        }
+    }
+}
+
+/// Check whether a codec is compiled into this build
+///
+/// `codec` is a `GblnCodec` value; values that name no codec are not
+/// supported.
+#[no_mangle]
+pub extern "C" fn gbln_codec_supported(codec: u32) -> bool {
+    match GblnCodec::from_u32(codec) {
+        Some(GblnCodec::CodecXz) => true,
+        Some(GblnCodec::CodecZstd) => cfg!(feature = "zstd"),
+        Some(GblnCodec::CodecLz4) => cfg!(feature = "lz4"),
+        None => false,
+    }
+}
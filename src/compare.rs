@@ -0,0 +1,145 @@
+// Copyright (c) 2025 Vivian Burkhard Voss
+// SPDX-License-Identifier: Apache-2.0
+
+//! Deep clone, equality and structural hashing
+//!
+//! Equality and hash agree with each other and walk the tree once without
+//! allocating. Two values are equal when they have the same types and
+//! contents:
+//!
+//! - numbers must have the same type: `<u8>(1)` is not `<i64>(1)`
+//! - floats compare bit for bit, so NaN equals itself and `0.0` is not
+//!   `-0.0`
+//! - objects compare as maps, whatever their field order
+//!
+//! The hash is stable across runs and platforms, so it can key persistent
+//! caches. Object fields are combined commutatively, so it does not depend
+//! on `HashMap` iteration order.
+
+use gbln::Value;
+
+use crate::hash::{finish, hash_bytes, mix};
+use crate::types::GblnValue;
+
+/// Whether two trees are equal (see module docs)
+pub(crate) fn same(a: &Value, b: &Value) -> bool {
+    match (a, b) {
+        (Value::Object(a), Value::Object(b)) => {
+            a.len() == b.len()
+                && a.iter()
+                    .all(|(key, x)| b.get(key).is_some_and(|y| same(x, y)))
+        }
+        (Value::Array(a), Value::Array(b)) => {
+            a.len() == b.len() && a.iter().zip(b).all(|(x, y)| same(x, y))
+        }
+        (Value::I8(a), Value::I8(b)) => a == b,
+        (Value::I16(a), Value::I16(b)) => a == b,
+        (Value::I32(a), Value::I32(b)) => a == b,
+        (Value::I64(a), Value::I64(b)) => a == b,
+        (Value::U8(a), Value::U8(b)) => a == b,
+        (Value::U16(a), Value::U16(b)) => a == b,
+        (Value::U32(a), Value::U32(b)) => a == b,
+        (Value::U64(a), Value::U64(b)) => a == b,
+        (Value::F32(a), Value::F32(b)) => a.to_bits() == b.to_bits(),
+        (Value::F64(a), Value::F64(b)) => a.to_bits() == b.to_bits(),
+        (Value::Str(a), Value::Str(b)) => a == b,
+        (Value::Bool(a), Value::Bool(b)) => a == b,
+        (Value::Null, Value::Null) => true,
+        _ => false,
+    }
+}
+
+/// Structural hash of a tree, consistent with `same`
+pub(crate) fn hash_value(value: &Value) -> u64 {
+    // Each type has its own tag so `<u8>(1)` and `<i64>(1)` differ
+    let (tag, payload) = match value {
+        Value::I8(n) => (0, *n as u64),
+        Value::I16(n) => (1, *n as u64),
+        Value::I32(n) => (2, *n as u64),
+        Value::I64(n) => (3, *n as u64),
+        Value::U8(n) => (4, u64::from(*n)),
+        Value::U16(n) => (5, u64::from(*n)),
+        Value::U32(n) => (6, u64::from(*n)),
+        Value::U64(n) => (7, *n),
+        Value::F32(n) => (8, u64::from(n.to_bits())),
+        Value::F64(n) => (9, n.to_bits()),
+        Value::Str(s) => (10, hash_bytes(s.as_bytes())),
+        Value::Bool(b) => (11, u64::from(*b)),
+        Value::Null => (12, 0),
+        Value::Object(map) => {
+            let fields = map.iter().fold(0u64, |sum, (key, value)| {
+                let field = mix(hash_bytes(key.as_bytes()), hash_value(value));
+                sum.wrapping_add(finish(field))
+            });
+            (13, mix(fields, map.len() as u64))
+        }
+        Value::Array(items) => {
+            let h = items.iter().fold(mix(0, items.len() as u64), |h, item| {
+                mix(h, hash_value(item))
+            });
+            (14, h)
+        }
+    };
+    finish(mix(tag, payload))
+}
+
+/// Deep copy a value
+///
+/// The copy is an independent root value, whatever `value` is (a root, a
+/// child pointer, a shared value or a lazy node's value).
+///
+/// # Safety
+/// - `value` must be a valid GblnValue pointer
+/// - Caller must free the copy with `gbln_value_free()`
+///
+/// # Returns
+/// - The copy, or NULL if `value` is NULL
+#[no_mangle]
+pub extern "C" fn gbln_value_clone(value: *const GblnValue) -> *mut GblnValue {
+    if value.is_null() {
+        return std::ptr::null_mut();
+    }
+
+    let copy = unsafe { (*value).inner() }.clone();
+    Box::into_raw(Box::new(GblnValue::new(copy)))
+}
+
+/// Check whether two values are structurally equal
+///
+/// Types must match exactly and floats compare bit for bit; object field
+/// order does not matter. Does not allocate.
+///
+/// # Safety
+/// - `a` and `b` must be valid GblnValue pointers
+///
+/// # Returns
+/// - true if both are NULL or the values are equal
+/// - false otherwise
+#[no_mangle]
+pub extern "C" fn gbln_value_equals(a: *const GblnValue, b: *const GblnValue) -> bool {
+    match unsafe { (a.as_ref(), b.as_ref()) } {
+        (Some(a), Some(b)) => std::ptr::eq(a, b) || same(a.inner(), b.inner()),
+        (None, None) => true,
+        _ => false,
+    }
+}
+
+/// Compute a stable 64-bit structural hash of a value
+///
+/// Equal values (see `gbln_value_equals()`) have equal hashes, independent
+/// of object field order. The hash is the same across runs, processes and
+/// platforms, but is not cryptographic. Does not allocate.
+///
+/// # Safety
+/// - `value` must be a valid GblnValue pointer
+///
+/// # Returns
+/// - The hash, or 0 if `value` is NULL
+#[no_mangle]
+pub extern "C" fn gbln_value_hash(value: *const GblnValue) -> u64 {
+    if value.is_null() {
+        return 0;
+    }
+
+    hash_value(unsafe { (*value).inner() })
+}
@@ -7,10 +7,36 @@
 
 use gbln::GblnConfig as RustConfig;
 
+use crate::codec::GblnCodec;
+use crate::error::{set_static_error, GblnErrorCode};
+
 /// Opaque wrapper for GblnConfig
 #[repr(C)]
 pub struct GblnConfig {
     pub(crate) inner: RustConfig,
+    /// Compression threads (0 = one per available CPU)
+    pub(crate) threads: u32,
+    pub(crate) codec: GblnCodec,
+    /// Write the binary encoding instead of text
+    pub(crate) binary: bool,
+}
+
+impl GblnConfig {
+    /// Wrap a core config with single-threaded XZ compression of text
+    pub(crate) fn new(inner: RustConfig) -> Self {
+        GblnConfig {
+            inner,
+            threads: 1,
+            codec: GblnCodec::CodecXz,
+            binary: false,
+        }
+    }
+
+    /// True if the core writer can handle this config on its own
+    pub(crate) fn is_core(&self) -> bool {
+        !self.binary
+            && (!self.inner.compress || (self.codec == GblnCodec::CodecXz && self.threads == 1))
+    }
 }
 
 /// Create default I/O configuration
@@ -21,14 +47,13 @@ pub struct GblnConfig {
 /// - compression_level: 6
 /// - indent: 2
 /// - strip_comments: true
+/// - codec: XZ, threads: 1, binary: false
 ///
 /// # Safety
 /// Caller must free with `gbln_config_free()`
 #[no_mangle]
 pub extern "C" fn gbln_config_new_io() -> *mut GblnConfig {
-    let config = Box::new(GblnConfig {
-        inner: RustConfig::io_format(),
-    });
+    let config = Box::new(GblnConfig::new(RustConfig::io_format()));
     Box::into_raw(config)
 }
 
@@ -40,14 +65,13 @@ pub extern "C" fn gbln_config_new_io() -> *mut GblnConfig {
 /// - compression_level: 6
 /// - indent: 2
 /// - strip_comments: false
+/// - codec: XZ, threads: 1, binary: false
 ///
 /// # Safety
 /// Caller must free with `gbln_config_free()`
 #[no_mangle]
 pub extern "C" fn gbln_config_new_source() -> *mut GblnConfig {
-    let config = Box::new(GblnConfig {
-        inner: RustConfig::development(),
-    });
+    let config = Box::new(GblnConfig::new(RustConfig::development()));
     Box::into_raw(config)
 }
 
@@ -70,15 +94,13 @@ pub extern "C" fn gbln_config_new(
     indent: usize,
     strip_comments: bool,
 ) -> *mut GblnConfig {
-    let config = Box::new(GblnConfig {
-        inner: RustConfig {
-            mini_mode,
-            compress,
-            compression_level,
-            indent,
-            strip_comments,
-        },
-    });
+    let config = Box::new(GblnConfig::new(RustConfig {
+        mini_mode,
+        compress,
+        compression_level,
+        indent,
+        strip_comments,
+    }));
     Box::into_raw(config)
 }
 
@@ -143,6 +165,33 @@ pub extern "C" fn gbln_config_get_strip_comments(config: *const GblnConfig) -> b
     unsafe { (*config).inner.strip_comments }
 }
 
+/// Get compression threads setting
+#[no_mangle]
+pub extern "C" fn gbln_config_get_threads(config: *const GblnConfig) -> u32 {
+    if config.is_null() {
+        return 1;
+    }
+    unsafe { (*config).threads }
+}
+
+/// Get compression codec setting
+#[no_mangle]
+pub extern "C" fn gbln_config_get_codec(config: *const GblnConfig) -> GblnCodec {
+    if config.is_null() {
+        return GblnCodec::CodecXz;
+    }
+    unsafe { (*config).codec }
+}
+
+/// Get binary encoding setting
+#[no_mangle]
+pub extern "C" fn gbln_config_get_binary(config: *const GblnConfig) -> bool {
+    if config.is_null() {
+        return false;
+    }
+    unsafe { (*config).binary }
+}
+
 // Setters
 
 /// Set mini_mode setting
@@ -165,7 +214,10 @@ pub extern "C" fn gbln_config_set_compress(config: *mut GblnConfig, value: bool)
     }
 }
 
-/// Set compression_level setting (0-9)
+/// Set compression_level setting
+///
+/// Clamped to the codec's range when writing: XZ 0-9, zstd 0-22 (0 = its
+/// default); LZ4 has no levels.
 #[no_mangle]
 pub extern "C" fn gbln_config_set_compression_level(config: *mut GblnConfig, value: u8) {
     if !config.is_null() {
@@ -194,3 +246,63 @@ pub extern "C" fn gbln_config_set_strip_comments(config: *mut GblnConfig, value:
         }
     }
 }
+
+/// Set compression threads setting
+///
+/// XZ and zstd split the output into blocks compressed in parallel.
+/// 1 = single-threaded (default), 0 = one thread per available CPU.
+#[no_mangle]
+pub extern "C" fn gbln_config_set_threads(config: *mut GblnConfig, value: u32) {
+    if !config.is_null() {
+        unsafe {
+            (*config).threads = value;
+        }
+    }
+}
+
+/// Set compression codec setting
+///
+/// Applies when compress is enabled. Codecs other than XZ must be compiled
+/// in (see `gbln_codec_supported()`). compression_level is passed to the
+/// codec as its own level (see `gbln_config_set_compression_level()`).
+/// Readers detect the codec from the file, so nothing needs setting to read.
+///
+/// # Parameters
+/// - config: Configuration to change
+/// - value: A `GblnCodec` value
+///
+/// # Returns
+/// - GBLN_OK on success
+/// - GBLN_ERROR_INVALID_SYNTAX if `value` names no codec; the config is
+///   left unchanged
+/// - GBLN_ERROR_NULL_POINTER if config is NULL
+#[no_mangle]
+pub extern "C" fn gbln_config_set_codec(config: *mut GblnConfig, value: u32) -> GblnErrorCode {
+    if config.is_null() {
+        set_static_error(GblnErrorCode::ErrorNullPointer, "Null pointer", None);
+        return GblnErrorCode::ErrorNullPointer;
+    }
+    let Some(codec) = GblnCodec::from_u32(value) else {
+        set_static_error(GblnErrorCode::ErrorInvalidSyntax, "Unknown codec", None);
+        return GblnErrorCode::ErrorInvalidSyntax;
+    };
+
+    unsafe {
+        (*config).codec = codec;
+    }
+    GblnErrorCode::Ok
+}
+
+/// Set binary encoding setting
+///
+/// Writers emit the compact binary encoding (see `gbln_to_binary()`)
+/// instead of text; mini_mode and indent are then ignored, compression
+/// still applies. Readers detect the encoding from the file.
+#[no_mangle]
+pub extern "C" fn gbln_config_set_binary(config: *mut GblnConfig, value: bool) {
+    if !config.is_null() {
+        unsafe {
+            (*config).binary = value;
+        }
+    }
+}
@@ -0,0 +1,338 @@
+// Copyright (c) 2025 Vivian Burkhard Voss
+// SPDX-License-Identifier: Apache-2.0
+
+//! Structural diff and patch
+//!
+//! `gbln_diff()` compares two trees and describes the changes as a patch,
+//! itself a GBLN value, so it can be written, sent and read back like any
+//! other document. `gbln_patch_apply()` replays it on a tree in place,
+//! touching only the changed parts.
+//!
+//! A patch is an array of operations, applied in order:
+//!
+//! ```text
+//! [
+//!   {op(remove) path[users alice]}
+//!   {op(set) path[users bob age] value<u8>(31)}
+//!   {op(set) path[tags (2)] value(new)}
+//!   {op(insert) path[queue (0)] value(first)}
+//!   {op(truncate) path[log] len(10)}
+//! ]
+//! ```
+//!
+//! - `path` lists the steps from the root: strings are object keys,
+//!   integers are array indices
+//! - `set` replaces or adds an object field, replaces an array element or,
+//!   at index `len`, appends one; with an empty path it replaces the root
+//! - `insert` puts an array element at an index, shifting the rest up
+//! - `remove` deletes an object field or array element
+//! - `truncate` shortens an array to `len` elements
+//!
+//! Arrays are diffed after stripping their common prefix and suffix. The
+//! middle runs are paired element by element and the rest is inserted or
+//! removed, so adding or dropping elements anywhere costs one operation
+//! each. Elements that moved are not detected and are diffed as changes.
+
+use std::collections::HashMap;
+
+use gbln::Value;
+
+use crate::compare::same;
+use crate::error::{set_last_error, set_static_error, GblnErrorCode};
+use crate::types::GblnValue;
+
+/// Patch under construction
+struct Diff {
+    path: Vec<Value>,
+    ops: Vec<Value>,
+}
+
+impl Diff {
+    fn op(&mut self, kind: &str, extra: Option<(&str, Value)>) {
+        let mut op = HashMap::with_capacity(3);
+        op.insert("op".to_string(), Value::Str(kind.to_string()));
+        op.insert("path".to_string(), Value::Array(self.path.clone()));
+        if let Some((key, value)) = extra {
+            op.insert(key.to_string(), value);
+        }
+        self.ops.push(Value::Object(op));
+    }
+
+    fn at<F: FnOnce(&mut Diff)>(&mut self, step: Value, f: F) {
+        self.path.push(step);
+        f(self);
+        self.path.pop();
+    }
+
+    fn value(&mut self, old: &Value, new: &Value) {
+        match (old, new) {
+            (Value::Object(old), Value::Object(new)) => {
+                let mut removed: Vec<_> = old.keys().filter(|k| !new.contains_key(*k)).collect();
+                removed.sort_unstable();
+                for key in removed {
+                    self.at(Value::Str(key.clone()), |d| d.op("remove", None));
+                }
+
+                let mut fields: Vec<_> = new.iter().collect();
+                fields.sort_unstable_by(|a, b| a.0.cmp(b.0));
+                for (key, value) in fields {
+                    self.at(Value::Str(key.clone()), |d| match old.get(key) {
+                        Some(prev) => d.value(prev, value),
+                        None => d.op("set", Some(("value", value.clone()))),
+                    });
+                }
+            }
+            (Value::Array(old), Value::Array(new)) => self.array(old, new),
+            _ if same(old, new) => {}
+            _ => self.op("set", Some(("value", new.clone()))),
+        }
+    }
+}
+
+impl Diff {
+    fn array(&mut self, old: &[Value], new: &[Value]) {
+        let prefix = old.iter().zip(new).take_while(|(a, b)| same(a, b)).count();
+        let suffix = old[prefix..]
+            .iter()
+            .rev()
+            .zip(new[prefix..].iter().rev())
+            .take_while(|(a, b)| same(a, b))
+            .count();
+        let old_mid = &old[prefix..old.len() - suffix];
+        let new_mid = &new[prefix..new.len() - suffix];
+
+        // Pair the middle runs, then insert or remove what is left over
+        let paired = old_mid.len().min(new_mid.len());
+        for (i, (prev, value)) in old_mid.iter().zip(new_mid).enumerate() {
+            self.at(Value::I64((prefix + i) as i64), |d| d.value(prev, value));
+        }
+        let at = prefix + paired;
+        for (i, value) in new_mid[paired..].iter().enumerate() {
+            self.at(Value::I64((at + i) as i64), |d| {
+                d.op("insert", Some(("value", value.clone())))
+            });
+        }
+        if old_mid.len() > paired {
+            if suffix == 0 {
+                self.op("truncate", Some(("len", Value::I64(at as i64))));
+            } else {
+                for _ in paired..old_mid.len() {
+                    self.at(Value::I64(at as i64), |d| d.op("remove", None));
+                }
+            }
+        }
+    }
+}
+
+/// Patch turning `old` into `new`
+pub(crate) fn diff(old: &Value, new: &Value) -> Value {
+    let mut d = Diff {
+        path: Vec::new(),
+        ops: Vec::new(),
+    };
+    d.value(old, new);
+    Value::Array(d.ops)
+}
+
+/// Array index or length in a patch
+fn index(value: &Value) -> Option<usize> {
+    let n = match *value {
+        Value::I8(n) => i64::from(n),
+        Value::I16(n) => i64::from(n),
+        Value::I32(n) => i64::from(n),
+        Value::I64(n) => n,
+        Value::U8(n) => i64::from(n),
+        Value::U16(n) => i64::from(n),
+        Value::U32(n) => i64::from(n),
+        Value::U64(n) => return usize::try_from(n).ok(),
+        _ => return None,
+    };
+    usize::try_from(n).ok()
+}
+
+/// Failure of one patch operation
+struct PatchError {
+    code: GblnErrorCode,
+    message: String,
+}
+
+fn malformed(message: &str) -> PatchError {
+    PatchError {
+        code: GblnErrorCode::ErrorInvalidSyntax,
+        message: message.to_string(),
+    }
+}
+
+fn not_found(step: usize) -> PatchError {
+    PatchError {
+        code: GblnErrorCode::ErrorTypeMismatch,
+        message: format!("Path step {} not found in target", step),
+    }
+}
+
+/// Value reached by following `path` from `root`
+fn walk<'v>(root: &'v mut Value, path: &[Value]) -> Result<&'v mut Value, PatchError> {
+    let mut node = root;
+    for (i, step) in path.iter().enumerate() {
+        node = match (step, node) {
+            (Value::Str(key), Value::Object(map)) => map.get_mut(key),
+            (step, Value::Array(items)) => index(step).and_then(|n| items.get_mut(n)),
+            _ => None,
+        }
+        .ok_or_else(|| not_found(i))?;
+    }
+    Ok(node)
+}
+
+/// Apply one operation to `root`
+fn apply_op(root: &mut Value, op: &Value) -> Result<(), PatchError> {
+    let Value::Object(op) = op else {
+        return Err(malformed("Operation is not an object"));
+    };
+    let Some(Value::Str(kind)) = op.get("op") else {
+        return Err(malformed("Missing op"));
+    };
+    let Some(Value::Array(path)) = op.get("path") else {
+        return Err(malformed("Missing path"));
+    };
+
+    match kind.as_str() {
+        "set" => {
+            let value = op.get("value").ok_or_else(|| malformed("Missing value"))?;
+            let Some((last, parent)) = path.split_last() else {
+                *root = value.clone();
+                return Ok(());
+            };
+            match (last, walk(root, parent)?) {
+                (Value::Str(key), Value::Object(map)) => {
+                    map.insert(key.clone(), value.clone());
+                }
+                (step, Value::Array(items)) => match index(step) {
+                    Some(n) if n < items.len() => items[n] = value.clone(),
+                    Some(n) if n == items.len() => items.push(value.clone()),
+                    _ => return Err(not_found(parent.len())),
+                },
+                _ => return Err(not_found(parent.len())),
+            }
+        }
+        "insert" => {
+            let value = op.get("value").ok_or_else(|| malformed("Missing value"))?;
+            let (last, parent) = path
+                .split_last()
+                .ok_or_else(|| malformed("Cannot insert at the root"))?;
+            match (index(last), walk(root, parent)?) {
+                (Some(n), Value::Array(items)) if n <= items.len() => {
+                    items.insert(n, value.clone())
+                }
+                _ => return Err(not_found(parent.len())),
+            }
+        }
+        "remove" => {
+            let (last, parent) = path
+                .split_last()
+                .ok_or_else(|| malformed("Cannot remove the root"))?;
+            let removed = match (last, walk(root, parent)?) {
+                (Value::Str(key), Value::Object(map)) => map.remove(key.as_str()),
+                (step, Value::Array(items)) => match index(step) {
+                    Some(n) if n < items.len() => Some(items.remove(n)),
+                    _ => None,
+                },
+                _ => None,
+            };
+            if removed.is_none() {
+                return Err(not_found(parent.len()));
+            }
+        }
+        "truncate" => {
+            let len = op
+                .get("len")
+                .and_then(index)
+                .ok_or_else(|| malformed("Missing len"))?;
+            match walk(root, path)? {
+                Value::Array(items) => items.truncate(len),
+                _ => return Err(not_found(path.len())),
+            }
+        }
+        _ => return Err(malformed("Unknown op")),
+    }
+    Ok(())
+}
+
+/// Compute the patch between two values
+///
+/// The patch is empty (an array with no operations) if the values are
+/// identical. Applying it to a copy of `old` with `gbln_patch_apply()`
+/// yields a tree equal to `new`. Values of different types, including
+/// integers of different widths, are replaced rather than diffed. Arrays
+/// keep their common prefix and suffix; elements added or dropped between
+/// them cost one `insert` or `remove` each, but moved elements are not
+/// detected.
+///
+/// # Safety
+/// - `old` and `new` must be valid GblnValue pointers
+/// - `out_patch` must be a valid pointer
+/// - Caller must free `*out_patch` with `gbln_value_free()`
+///
+/// # Returns
+/// - GBLN_OK on success
+/// - GBLN_ERROR_NULL_POINTER if any pointer is NULL
+#[no_mangle]
+pub extern "C" fn gbln_diff(
+    old: *const GblnValue,
+    new: *const GblnValue,
+    out_patch: *mut *mut GblnValue,
+) -> GblnErrorCode {
+    if old.is_null() || new.is_null() || out_patch.is_null() {
+        set_static_error(GblnErrorCode::ErrorNullPointer, "Null pointer", None);
+        return GblnErrorCode::ErrorNullPointer;
+    }
+
+    let patch = diff(unsafe { (*old).inner() }, unsafe { (*new).inner() });
+    unsafe {
+        *out_patch = Box::into_raw(Box::new(GblnValue::new(patch)));
+    }
+    GblnErrorCode::Ok
+}
+
+/// Apply a patch to a value in place
+///
+/// Operations are applied in order. Unchanged parts of the tree are not
+/// touched; set values are copied from the patch.
+///
+/// # Safety
+/// - `value` must be a root value owned by the caller (not a child pointer
+///   or a shared value)
+/// - `patch` must be a valid GblnValue pointer, such as from `gbln_diff()`
+///
+/// # Returns
+/// - GBLN_OK on success
+/// - GBLN_ERROR_INVALID_SYNTAX if the patch is malformed
+/// - GBLN_ERROR_TYPE_MISMATCH if an operation's path does not exist in
+///   `value`
+/// - GBLN_ERROR_NULL_POINTER if any pointer is NULL
+///
+/// On error, the operations before the failing one remain applied.
+#[no_mangle]
+pub extern "C" fn gbln_patch_apply(
+    value: *mut GblnValue,
+    patch: *const GblnValue,
+) -> GblnErrorCode {
+    if value.is_null() || patch.is_null() {
+        set_static_error(GblnErrorCode::ErrorNullPointer, "Null pointer", None);
+        return GblnErrorCode::ErrorNullPointer;
+    }
+
+    let Value::Array(ops) = (unsafe { (*patch).inner() }) else {
+        set_last_error("Patch is not an array of operations".to_string(), None);
+        return GblnErrorCode::ErrorInvalidSyntax;
+    };
+
+    let root = unsafe { (*value).inner_mut() };
+    for (i, op) in ops.iter().enumerate() {
+        if let Err(e) = apply_op(root, op) {
+            set_last_error(format!("Patch op {}: {}", i, e.message), None);
+            return e.code;
+        }
+    }
+    GblnErrorCode::Ok
+}
@@ -3,6 +3,11 @@
 
 use gbln::ErrorKind;
 use std::cell::RefCell;
+use std::ffi::CString;
+use std::os::raw::c_char;
+
+use crate::parser::ParseError;
+use crate::simd::{self, NEWLINE};
 
 /// C-compatible error codes
 ///
@@ -23,26 +28,257 @@ pub enum GblnErrorCode {
     ErrorDuplicateKey = 10,
     ErrorNullPointer = 11,
     ErrorIo = 12,
+    ErrorAborted = 13,
+    ErrorBufferTooSmall = 14,
+}
+
+/// Structured description of a parse error
+///
+/// Read with `gbln_last_error_info()` without allocating. `message` points
+/// to static text and is NOT null-terminated; use `message_len`.
+#[repr(C)]
+#[derive(Debug, Clone, Copy)]
+pub struct GblnErrorInfo {
+    pub code: GblnErrorCode,
+    /// Byte offset of the error in the input (0 if not tied to a position,
+    /// or for core parser errors, which only carry line and column)
+    pub offset: usize,
+    /// 1-based line of `offset` (0 if unknown)
+    pub line: usize,
+    /// 1-based column of `offset` in bytes (0 if unknown)
+    pub column: usize,
+    pub message: *const c_char,
+    pub message_len: usize,
+}
+
+/// Error with a static message, kept unformatted until it is requested
+#[derive(Debug, Clone, Copy)]
+pub(crate) struct PositionedError {
+    code: GblnErrorCode,
+    /// False for errors not tied to a position in an input
+    located: bool,
+    offset: usize,
+    line: usize,
+    column: usize,
+    message: &'static str,
+    suggestion: Option<&'static str>,
+}
+
+impl PositionedError {
+    /// Locate `e` in `input`; `None` leaves line and column unknown
+    pub(crate) fn new(e: ParseError, input: Option<&[u8]>) -> PositionedError {
+        let (line, column) = match input {
+            Some(input) => {
+                // One pass over the newlines before the error
+                let before = &input[..e.offset.min(input.len())];
+                let mut line = 1;
+                let mut line_start = 0;
+                let mut i = simd::find(before, 0, &NEWLINE);
+                while i < before.len() {
+                    line += 1;
+                    line_start = i + 1;
+                    i = simd::find(before, line_start, &NEWLINE);
+                }
+                (line, before.len() - line_start + 1)
+            }
+            None => (0, 0),
+        };
+        PositionedError {
+            code: e.code,
+            located: true,
+            offset: e.offset,
+            line,
+            column,
+            message: e.message,
+            suggestion: None,
+        }
+    }
+
+    /// Error without a position, such as a NULL argument
+    pub(crate) fn unlocated(
+        code: GblnErrorCode,
+        message: &'static str,
+        suggestion: Option<&'static str>,
+    ) -> PositionedError {
+        PositionedError {
+            code,
+            located: false,
+            offset: 0,
+            line: 0,
+            column: 0,
+            message,
+            suggestion,
+        }
+    }
+
+    pub(crate) fn info(&self) -> GblnErrorInfo {
+        GblnErrorInfo {
+            code: self.code,
+            offset: self.offset,
+            line: self.line,
+            column: self.column,
+            message: self.message.as_ptr() as *const c_char,
+            message_len: self.message.len(),
+        }
+    }
+
+    pub(crate) fn write_message(&self, out: &mut impl std::fmt::Write) {
+        let _ = if self.located {
+            write!(out, "{} at byte {}", self.message, self.offset)
+        } else {
+            out.write_str(self.message)
+        };
+    }
+}
+
+enum LastError {
+    /// Message formatted when the error was raised
+    Message(String, Option<String>),
+    /// Static error, formatted on request
+    Positioned(PositionedError),
+    /// Core parser error, formatted on request
+    Core(gbln::Error),
 }
 
 // Thread-local error storage
 //
-// Stores the last error message and optional suggestion.
-// This allows C code to retrieve error details after a failed operation.
+// Stores the last error message and optional suggestion, or an unformatted
+// parse error. This allows C code to retrieve error details after a failed
+// operation.
 thread_local! {
-    static LAST_ERROR: RefCell<Option<(String, Option<String>)>> = RefCell::new(None);
+    static LAST_ERROR: RefCell<Option<LastError>> = const { RefCell::new(None) };
 }
 
 /// Set the last error message and optional suggestion
 pub fn set_last_error(msg: String, suggestion: Option<String>) {
     LAST_ERROR.with(|e| {
-        *e.borrow_mut() = Some((msg, suggestion));
+        *e.borrow_mut() = Some(LastError::Message(msg, suggestion));
+    });
+}
+
+/// Record a parse error without formatting it
+///
+/// `input` is the buffer `e.offset` refers to, for line and column.
+pub(crate) fn set_parse_error(e: ParseError, input: Option<&[u8]>) {
+    let error = PositionedError::new(e, input);
+    LAST_ERROR.with(|e| {
+        *e.borrow_mut() = Some(LastError::Positioned(error));
+    });
+}
+
+/// Record a core parser error without formatting it, returning its code
+pub(crate) fn set_core_error(e: gbln::Error) -> GblnErrorCode {
+    let code = map_error_kind(&e.kind);
+    LAST_ERROR.with(|slot| {
+        *slot.borrow_mut() = Some(LastError::Core(e));
+    });
+    code
+}
+
+/// Record an error with a static message and no position
+///
+/// Like [`set_parse_error`], nothing is allocated and the error is readable
+/// with `gbln_last_error_info()`.
+pub(crate) fn set_static_error(
+    code: GblnErrorCode,
+    message: &'static str,
+    suggestion: Option<&'static str>,
+) {
+    let error = PositionedError::unlocated(code, message, suggestion);
+    LAST_ERROR.with(|e| {
+        *e.borrow_mut() = Some(LastError::Positioned(error));
     });
 }
 
 /// Get the last error message and suggestion
 pub fn get_last_error() -> Option<(String, Option<String>)> {
-    LAST_ERROR.with(|e| e.borrow().clone())
+    LAST_ERROR.with(|e| match &*e.borrow() {
+        None => None,
+        Some(LastError::Message(msg, suggestion)) => Some((msg.clone(), suggestion.clone())),
+        Some(LastError::Positioned(error)) => {
+            let mut msg = String::new();
+            error.write_message(&mut msg);
+            Some((msg, error.suggestion.map(str::to_string)))
+        }
+        Some(LastError::Core(error)) => Some((error.to_string(), error.suggestion.clone())),
+    })
+}
+
+/// Last error message as a new C string
+pub(crate) fn last_error_c_message() -> Option<CString> {
+    LAST_ERROR.with(|e| match &*e.borrow() {
+        None => None,
+        Some(LastError::Message(msg, _)) => CString::new(msg.as_str()).ok(),
+        Some(LastError::Positioned(error)) => {
+            let mut msg = String::new();
+            error.write_message(&mut msg);
+            CString::new(msg).ok()
+        }
+        Some(LastError::Core(error)) => CString::new(error.to_string()).ok(),
+    })
+}
+
+/// Last error suggestion as a new C string
+pub(crate) fn last_error_c_suggestion() -> Option<CString> {
+    LAST_ERROR.with(|e| match &*e.borrow() {
+        Some(LastError::Message(_, Some(suggestion))) => CString::new(suggestion.as_str()).ok(),
+        Some(LastError::Positioned(error)) => error.suggestion.and_then(|s| CString::new(s).ok()),
+        Some(LastError::Core(error)) => error
+            .suggestion
+            .as_deref()
+            .and_then(|s| CString::new(s).ok()),
+        _ => None,
+    })
+}
+
+/// Get structured info about the last error on this thread
+///
+/// Reads the error without allocating or formatting anything. Errors from
+/// the native parsing calls (`gbln_parse_parallel()`, `gbln_parse_events()`,
+/// lazy documents, streams) and invalid UTF-8 input carry a byte offset,
+/// line and column. Errors from the core parser behind `gbln_parse()`,
+/// `gbln_read_io()` and documents carry line and column, with offset 0, and
+/// a static message for their kind; the core's full message is formatted
+/// by `gbln_last_error_message()`. NULL arguments and value building errors
+/// (type mismatch, duplicate key, string too long) have a static code and
+/// message, with offset, line and column 0. I/O failures only have a
+/// formatted message.
+///
+/// # Returns
+/// - true with `out` filled if the last error has a static code and message
+/// - false if there is no error or it only has a formatted message
+///
+/// # Safety
+/// - `out` must be a valid pointer
+#[no_mangle]
+pub extern "C" fn gbln_last_error_info(out: *mut GblnErrorInfo) -> bool {
+    if out.is_null() {
+        return false;
+    }
+
+    LAST_ERROR.with(|e| match &*e.borrow() {
+        Some(LastError::Positioned(error)) => {
+            unsafe {
+                *out = error.info();
+            }
+            true
+        }
+        Some(LastError::Core(error)) => {
+            let message = kind_message(&error.kind);
+            unsafe {
+                *out = GblnErrorInfo {
+                    code: map_error_kind(&error.kind),
+                    offset: 0,
+                    line: error.line,
+                    column: error.column,
+                    message: message.as_ptr() as *const c_char,
+                    message_len: message.len(),
+                };
+            }
+            true
+        }
+        None | Some(LastError::Message(..)) => false,
+    })
 }
 
 /// Map Rust ErrorKind to C error code
@@ -61,3 +297,20 @@ pub fn map_error_kind(kind: &ErrorKind) -> GblnErrorCode {
         ErrorKind::IoError => GblnErrorCode::ErrorIo,
     }
 }
+
+/// Static description of a core error kind
+fn kind_message(kind: &ErrorKind) -> &'static str {
+    match kind {
+        ErrorKind::UnexpectedCharacter => "Unexpected character",
+        ErrorKind::UnterminatedString => "Unterminated string",
+        ErrorKind::UnexpectedToken => "Unexpected token",
+        ErrorKind::UnexpectedEof => "Unexpected end of input",
+        ErrorKind::InvalidSyntax => "Invalid syntax",
+        ErrorKind::IntegerOutOfRange => "Integer out of range",
+        ErrorKind::StringTooLong => "String exceeds type hint length",
+        ErrorKind::TypeMismatch => "Value does not match type hint",
+        ErrorKind::InvalidTypeHint => "Unknown type hint",
+        ErrorKind::DuplicateKey => "Duplicate key",
+        ErrorKind::IoError => "I/O error",
+    }
+}
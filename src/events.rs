@@ -0,0 +1,282 @@
+// Copyright (c) 2025 Vivian Burkhard Voss
+// SPDX-License-Identifier: Apache-2.0
+
+//! Event-driven (SAX-style) parsing
+//!
+//! Reports the structure of a document through C callbacks without building
+//! a `Value` tree. Handlers can skip subtrees they are not interested in;
+//! skipped subtrees are bracket-matched, not decoded.
+
+use std::os::raw::{c_char, c_void};
+use std::ptr;
+
+use gbln::Value;
+
+use crate::error::{set_parse_error, set_static_error, GblnErrorCode};
+use crate::parser::{Flow, Handler, ParseError, Parser, Scalar};
+use crate::types::GblnValueType;
+
+/// Return code of an event callback
+#[repr(C)]
+#[derive(Debug, Copy, Clone, PartialEq, Eq)]
+pub enum GblnEventAction {
+    /// Keep parsing
+    EventContinue = 0,
+    /// Skip the object or array just opened, or the value of the key just
+    /// reported; no events are delivered for it (including its end event).
+    /// Same as `EventContinue` for other callbacks.
+    EventSkip = 1,
+    /// Stop parsing; `gbln_parse_events()` returns `GBLN_ERROR_ABORTED`
+    EventAbort = 2,
+}
+
+/// Typed scalar as delivered to an event handler or by `gbln_value_view()`
+///
+/// `value_type` is the parsed type. The value is stored widened:
+/// - I8..I64 in `int_value`
+/// - U8..U64 in `uint_value`
+/// - F32, F64 in `float_value`
+/// - Bool in `bool_value`
+/// - Str in `str_ptr` / `str_len` (NOT null-terminated, valid only during the
+///   callback, or for a view as long as the viewed value)
+/// - Object, Array: `value_type` only
+///
+/// This layout is stable; the `gbln_scalar_*()` inline functions read it
+/// without a call into the library.
+#[repr(C)]
+#[derive(Debug, Copy, Clone)]
+pub struct GblnScalar {
+    pub value_type: GblnValueType,
+    pub int_value: i64,
+    pub uint_value: u64,
+    pub float_value: f64,
+    pub bool_value: bool,
+    pub str_ptr: *const c_char,
+    pub str_len: usize,
+}
+
+impl GblnScalar {
+    fn new(value_type: GblnValueType) -> Self {
+        GblnScalar {
+            value_type,
+            int_value: 0,
+            uint_value: 0,
+            float_value: 0.0,
+            bool_value: false,
+            str_ptr: ptr::null(),
+            str_len: 0,
+        }
+    }
+
+    fn int(value_type: GblnValueType, n: i64) -> Self {
+        GblnScalar {
+            int_value: n,
+            ..GblnScalar::new(value_type)
+        }
+    }
+
+    fn uint(value_type: GblnValueType, n: u64) -> Self {
+        GblnScalar {
+            uint_value: n,
+            ..GblnScalar::new(value_type)
+        }
+    }
+
+    fn float(value_type: GblnValueType, f: f64) -> Self {
+        GblnScalar {
+            float_value: f,
+            ..GblnScalar::new(value_type)
+        }
+    }
+}
+
+impl From<Scalar<'_>> for GblnScalar {
+    fn from(value: Scalar<'_>) -> Self {
+        match value {
+            Scalar::I8(n) => GblnScalar::int(GblnValueType::I8, n as i64),
+            Scalar::I16(n) => GblnScalar::int(GblnValueType::I16, n as i64),
+            Scalar::I32(n) => GblnScalar::int(GblnValueType::I32, n as i64),
+            Scalar::I64(n) => GblnScalar::int(GblnValueType::I64, n),
+            Scalar::U8(n) => GblnScalar::uint(GblnValueType::U8, n as u64),
+            Scalar::U16(n) => GblnScalar::uint(GblnValueType::U16, n as u64),
+            Scalar::U32(n) => GblnScalar::uint(GblnValueType::U32, n as u64),
+            Scalar::U64(n) => GblnScalar::uint(GblnValueType::U64, n),
+            Scalar::F32(f) => GblnScalar::float(GblnValueType::F32, f as f64),
+            Scalar::F64(f) => GblnScalar::float(GblnValueType::F64, f),
+            Scalar::Str(s) => GblnScalar {
+                str_ptr: s.as_ptr() as *const c_char,
+                str_len: s.len(),
+                ..GblnScalar::new(GblnValueType::Str)
+            },
+            Scalar::Bool(b) => GblnScalar {
+                bool_value: b,
+                ..GblnScalar::new(GblnValueType::Bool)
+            },
+            Scalar::Null => GblnScalar::new(GblnValueType::Null),
+        }
+    }
+}
+
+impl From<&Value> for GblnScalar {
+    fn from(value: &Value) -> Self {
+        match value {
+            Value::I8(n) => GblnScalar::int(GblnValueType::I8, *n as i64),
+            Value::I16(n) => GblnScalar::int(GblnValueType::I16, *n as i64),
+            Value::I32(n) => GblnScalar::int(GblnValueType::I32, *n as i64),
+            Value::I64(n) => GblnScalar::int(GblnValueType::I64, *n),
+            Value::U8(n) => GblnScalar::uint(GblnValueType::U8, *n as u64),
+            Value::U16(n) => GblnScalar::uint(GblnValueType::U16, *n as u64),
+            Value::U32(n) => GblnScalar::uint(GblnValueType::U32, *n as u64),
+            Value::U64(n) => GblnScalar::uint(GblnValueType::U64, *n),
+            Value::F32(f) => GblnScalar::float(GblnValueType::F32, *f as f64),
+            Value::F64(f) => GblnScalar::float(GblnValueType::F64, *f),
+            Value::Str(s) => GblnScalar {
+                str_ptr: s.as_ptr() as *const c_char,
+                str_len: s.len(),
+                ..GblnScalar::new(GblnValueType::Str)
+            },
+            Value::Bool(b) => GblnScalar {
+                bool_value: *b,
+                ..GblnScalar::new(GblnValueType::Bool)
+            },
+            Value::Null => GblnScalar::new(GblnValueType::Null),
+            Value::Object(_) => GblnScalar::new(GblnValueType::Object),
+            Value::Array(_) => GblnScalar::new(GblnValueType::Array),
+        }
+    }
+}
+
+/// Event callbacks for `gbln_parse_events()`
+///
+/// Any callback may be NULL; its events are then ignored (as if it returned
+/// `EventContinue`). Keys are NOT null-terminated and, like string scalars,
+/// are only valid for the duration of the callback.
+#[repr(C)]
+pub struct GblnEventHandler {
+    pub begin_object: Option<extern "C" fn(ctx: *mut c_void) -> GblnEventAction>,
+    pub end_object: Option<extern "C" fn(ctx: *mut c_void) -> GblnEventAction>,
+    pub key:
+        Option<extern "C" fn(ctx: *mut c_void, key: *const c_char, len: usize) -> GblnEventAction>,
+    pub begin_array: Option<extern "C" fn(ctx: *mut c_void) -> GblnEventAction>,
+    pub end_array: Option<extern "C" fn(ctx: *mut c_void) -> GblnEventAction>,
+    pub scalar:
+        Option<extern "C" fn(ctx: *mut c_void, value: *const GblnScalar) -> GblnEventAction>,
+}
+
+/// Adapts C callbacks to the parser's handler interface
+struct CallbackHandler<'h> {
+    handler: &'h GblnEventHandler,
+    ctx: *mut c_void,
+}
+
+fn flow(action: GblnEventAction, offset: usize) -> Result<Flow, ParseError> {
+    match action {
+        GblnEventAction::EventContinue => Ok(Flow::Continue),
+        GblnEventAction::EventSkip => Ok(Flow::Skip),
+        GblnEventAction::EventAbort => Err(ParseError {
+            code: GblnErrorCode::ErrorAborted,
+            offset,
+            message: "Aborted by event handler",
+        }),
+    }
+}
+
+impl CallbackHandler<'_> {
+    fn call(
+        &self,
+        callback: Option<extern "C" fn(*mut c_void) -> GblnEventAction>,
+        offset: usize,
+    ) -> Result<Flow, ParseError> {
+        match callback {
+            Some(callback) => flow(callback(self.ctx), offset),
+            None => Ok(Flow::Continue),
+        }
+    }
+}
+
+impl Handler for CallbackHandler<'_> {
+    fn begin_object(&mut self, offset: usize) -> Result<Flow, ParseError> {
+        self.call(self.handler.begin_object, offset)
+    }
+
+    fn key(&mut self, key: &str, offset: usize) -> Result<Flow, ParseError> {
+        match self.handler.key {
+            Some(callback) => flow(
+                callback(self.ctx, key.as_ptr() as *const c_char, key.len()),
+                offset,
+            ),
+            None => Ok(Flow::Continue),
+        }
+    }
+
+    fn end_object(&mut self, offset: usize) -> Result<(), ParseError> {
+        self.call(self.handler.end_object, offset).map(|_| ())
+    }
+
+    fn begin_array(&mut self, offset: usize) -> Result<Flow, ParseError> {
+        self.call(self.handler.begin_array, offset)
+    }
+
+    fn end_array(&mut self, offset: usize) -> Result<(), ParseError> {
+        self.call(self.handler.end_array, offset).map(|_| ())
+    }
+
+    fn scalar(&mut self, value: Scalar<'_>, offset: usize) -> Result<(), ParseError> {
+        match self.handler.scalar {
+            Some(callback) => {
+                let scalar = GblnScalar::from(value);
+                flow(callback(self.ctx, &scalar), offset).map(|_| ())
+            }
+            None => Ok(()),
+        }
+    }
+}
+
+/// Parse a GBLN buffer, reporting its structure to event callbacks
+///
+/// No value tree is built. Events for a document arrive in order: objects as
+/// `begin_object`, then `key` + value for each field, then `end_object`;
+/// arrays as `begin_array`, elements, `end_array`.
+///
+/// # Parameters
+/// - buf: Pointer to the first byte of the GBLN text
+/// - len: Number of bytes to parse
+/// - handler: Event callbacks
+/// - ctx: Opaque pointer passed to every callback
+///
+/// # Returns
+/// - GBLN_OK once the whole document has been reported
+/// - GBLN_ERROR_ABORTED if a callback returned `EventAbort`
+/// - Parse error code on invalid input; events already delivered stand
+/// - Error details via `gbln_last_error_message()`
+///
+/// # Safety
+/// - `buf` must point to at least `len` readable bytes
+/// - `handler` must be a valid pointer to a GblnEventHandler
+#[no_mangle]
+pub extern "C" fn gbln_parse_events(
+    buf: *const u8,
+    len: usize,
+    handler: *const GblnEventHandler,
+    ctx: *mut c_void,
+) -> GblnErrorCode {
+    if buf.is_null() || handler.is_null() {
+        set_static_error(GblnErrorCode::ErrorNullPointer, "Null pointer", None);
+        return GblnErrorCode::ErrorNullPointer;
+    }
+
+    let input = unsafe { std::slice::from_raw_parts(buf, len) };
+    let mut callbacks = CallbackHandler {
+        handler: unsafe { &*handler },
+        ctx,
+    };
+    let mut text = String::new();
+
+    match Parser::new(input, false, &mut text).parse_document(&mut callbacks) {
+        Ok(()) => GblnErrorCode::Ok,
+        Err(e) => {
+            set_parse_error(e, Some(input));
+            e.code
+        }
+    }
+}
@@ -5,12 +5,14 @@
 ///!
 ///! These functions provide:
 ///! - Type introspection (`gbln_value_type`)
-///! - Object iteration (`gbln_object_keys`, `gbln_object_len`)
+///! - Object iteration (`gbln_object_iter_*`, `gbln_object_keys`, `gbln_object_len`)
 ///! - Value construction (`gbln_value_new_*`)
 ///! - Object/array building (`gbln_object_insert`, `gbln_array_push`)
-use crate::error::{set_last_error, GblnErrorCode};
+///! - Bulk building (`gbln_object_insert_*`, `gbln_array_new_from_*`, `*_reserve`)
+use crate::error::{set_static_error, GblnErrorCode};
 use crate::types::{GblnValue, GblnValueType};
 use gbln::Value;
+use std::collections::hash_map::{self, Entry};
 use std::collections::HashMap;
 use std::ffi::{CStr, CString};
 use std::os::raw::c_char;
@@ -64,6 +66,9 @@ pub extern "C" fn gbln_object_len(value: *const GblnValue) -> usize {
 /// Returns array of null-terminated C strings.
 /// Caller must free with `gbln_keys_free()`.
 ///
+/// Allocates every key; `gbln_object_iter_begin()` visits keys and values
+/// without allocating.
+///
 /// Returns NULL if value is not an object.
 ///
 /// # Safety
@@ -139,6 +144,138 @@ pub extern "C" fn gbln_keys_free(keys: *mut *mut c_char, count: usize) {
     }
 }
 
+/// Cursor over the fields of an object
+///
+/// Lives on the caller's stack; the contents are private. Set up with
+/// `gbln_object_iter_begin()` and advance with `gbln_object_iter_next()`.
+/// No cleanup is needed.
+///
+/// # Safety
+/// - Pass it to `gbln_object_iter_begin()` before `gbln_object_iter_next()`;
+///   until then it is uninitialised storage. `gbln_object_iter_begin()`
+///   leaves an empty iterator on every error with a non-NULL `it`.
+#[repr(C)]
+pub struct GblnObjectIter {
+    state: [u64; 8],
+}
+
+type FieldIter = hash_map::Iter<'static, String, Value>;
+
+// The field iterator must fit the C-visible storage
+const _: () = assert!(std::mem::size_of::<FieldIter>() <= std::mem::size_of::<GblnObjectIter>());
+const _: () = assert!(std::mem::align_of::<FieldIter>() <= std::mem::align_of::<GblnObjectIter>());
+
+/// Start iterating over the fields of an object
+///
+/// Fields are visited in unspecified order. The iterator borrows `value`:
+/// it must not be used after `value` is freed or modified.
+///
+/// ```c
+/// GblnObjectIter it;
+/// const char* key;
+/// size_t key_len;
+/// const GblnValue* field;
+/// gbln_object_iter_begin(object, &it);
+/// while (gbln_object_iter_next(&it, &key, &key_len, &field)) { ... }
+/// ```
+///
+/// # Safety
+/// - `value` must be a valid GblnValue pointer
+/// - `it` must be a valid pointer
+///
+/// # Returns
+/// - GBLN_OK on success
+/// - GBLN_ERROR_TYPE_MISMATCH if value is not an object (`it` then yields
+///   nothing)
+/// - GBLN_ERROR_NULL_POINTER if value or it is NULL (with only `value`
+///   NULL, `it` also yields nothing)
+#[no_mangle]
+pub extern "C" fn gbln_object_iter_begin(
+    value: *const GblnValue,
+    it: *mut GblnObjectIter,
+) -> GblnErrorCode {
+    if it.is_null() {
+        set_static_error(GblnErrorCode::ErrorNullPointer, "Null pointer", None);
+        return GblnErrorCode::ErrorNullPointer;
+    }
+    if value.is_null() {
+        // Leave an iterator that yields nothing
+        unsafe {
+            ptr::write(
+                (*it).state.as_mut_ptr() as *mut FieldIter,
+                FieldIter::default(),
+            );
+        }
+        set_static_error(GblnErrorCode::ErrorNullPointer, "Null pointer", None);
+        return GblnErrorCode::ErrorNullPointer;
+    }
+
+    let (fields, code): (FieldIter, _) = match unsafe { (*value).inner() } {
+        // Outliving `value` is ruled out by the caller (see Safety)
+        Value::Object(map) => (
+            unsafe {
+                std::mem::transmute::<hash_map::Iter<'_, String, Value>, FieldIter>(map.iter())
+            },
+            GblnErrorCode::Ok,
+        ),
+        _ => {
+            set_static_error(
+                GblnErrorCode::ErrorTypeMismatch,
+                "Value is not an object",
+                None,
+            );
+            (FieldIter::default(), GblnErrorCode::ErrorTypeMismatch)
+        }
+    };
+
+    unsafe {
+        ptr::write((*it).state.as_mut_ptr() as *mut FieldIter, fields);
+    }
+    code
+}
+
+/// Advance an object iterator
+///
+/// # Parameters
+/// - it: Iterator from `gbln_object_iter_begin()`
+/// - key: Set to the field name (NOT null-terminated, owned by the object)
+/// - key_len: Set to the length of the field name in bytes
+/// - value: Set to the field value (owned by the object)
+///
+/// # Returns
+/// - true with the next field stored
+/// - false once all fields have been visited (outputs are not touched)
+///
+/// # Safety
+/// - `it` must have been set up by `gbln_object_iter_begin()`, and its
+///   object must still be valid and unmodified; an iterator that was never
+///   passed to `gbln_object_iter_begin()` holds uninitialised storage
+/// - `key`, `key_len` and `value` must be valid pointers
+#[no_mangle]
+pub extern "C" fn gbln_object_iter_next(
+    it: *mut GblnObjectIter,
+    key: *mut *const c_char,
+    key_len: *mut usize,
+    value: *mut *const GblnValue,
+) -> bool {
+    if it.is_null() || key.is_null() || key_len.is_null() || value.is_null() {
+        return false;
+    }
+
+    let fields = unsafe { &mut *((*it).state.as_mut_ptr() as *mut FieldIter) };
+    match fields.next() {
+        Some((name, field)) => {
+            unsafe {
+                *key = name.as_ptr() as *const c_char;
+                *key_len = name.len();
+                *value = field as *const Value as *const GblnValue;
+            }
+            true
+        }
+        None => false,
+    }
+}
+
 // ============================================================================
 // Value Constructors - Integers
 // ============================================================================
@@ -225,17 +362,29 @@ pub extern "C" fn gbln_value_new_f64(value: f64) -> *mut GblnValue {
 /// - `value` must be a valid null-terminated UTF-8 string
 #[no_mangle]
 pub extern "C" fn gbln_value_new_str(value: *const c_char, max_len: usize) -> *mut GblnValue {
+    match new_str(value, max_len) {
+        Ok(s) => Box::into_raw(Box::new(GblnValue::new(Value::Str(s)))),
+        Err(_) => ptr::null_mut(),
+    }
+}
+
+/// Copy a C string of at most `max_len` characters
+fn new_str(value: *const c_char, max_len: usize) -> Result<String, GblnErrorCode> {
     if value.is_null() {
-        set_last_error("Null pointer for string value".to_string(), None);
-        return ptr::null_mut();
+        set_static_error(
+            GblnErrorCode::ErrorNullPointer,
+            "Null pointer for string value",
+            None,
+        );
+        return Err(GblnErrorCode::ErrorNullPointer);
     }
 
     let value_str = unsafe {
         match CStr::from_ptr(value).to_str() {
             Ok(s) => s,
-            Err(e) => {
-                set_last_error(format!("Invalid UTF-8: {}", e), None);
-                return ptr::null_mut();
+            Err(_) => {
+                set_static_error(GblnErrorCode::ErrorNullPointer, "Invalid UTF-8", None);
+                return Err(GblnErrorCode::ErrorNullPointer);
             }
         }
     };
@@ -243,17 +392,15 @@ pub extern "C" fn gbln_value_new_str(value: *const c_char, max_len: usize) -> *m
     // Check length (character count, not bytes)
     let char_count = value_str.chars().count();
     if char_count > max_len {
-        set_last_error(
-            format!("String too long: {} chars (max: {})", char_count, max_len),
-            Some(format!(
-                "Use a larger string type (s{} or larger)",
-                max_len * 2
-            )),
+        set_static_error(
+            GblnErrorCode::ErrorStringTooLong,
+            "String too long for max_len",
+            Some("Use a larger string type"),
         );
-        return ptr::null_mut();
+        return Err(GblnErrorCode::ErrorStringTooLong);
     }
 
-    Box::into_raw(Box::new(GblnValue::new(Value::Str(value_str.to_string()))))
+    Ok(value_str.to_string())
 }
 
 /// Create boolean value
@@ -278,6 +425,57 @@ pub extern "C" fn gbln_value_new_object() -> *mut GblnValue {
     Box::into_raw(Box::new(GblnValue::new(Value::Object(HashMap::new()))))
 }
 
+/// Map of `object`, or the error code for a non-object
+fn object_map<'v>(object: *mut GblnValue) -> Result<&'v mut HashMap<String, Value>, GblnErrorCode> {
+    match unsafe { (*object).inner_mut() } {
+        Value::Object(map) => Ok(map),
+        _ => {
+            set_static_error(
+                GblnErrorCode::ErrorTypeMismatch,
+                "Value is not an object",
+                Some("Use gbln_value_new_object() to create an object"),
+            );
+            Err(GblnErrorCode::ErrorTypeMismatch)
+        }
+    }
+}
+
+/// Key of an insert as UTF-8
+fn field_key<'k>(key: *const c_char) -> Result<&'k str, GblnErrorCode> {
+    unsafe {
+        CStr::from_ptr(key).to_str().map_err(|_| {
+            set_static_error(
+                GblnErrorCode::ErrorNullPointer,
+                "Invalid UTF-8 in key",
+                None,
+            );
+            GblnErrorCode::ErrorNullPointer
+        })
+    }
+}
+
+/// Insert `value` under `key`, hashing the key once
+fn insert_field(object: *mut GblnValue, key_str: &str, value: Value) -> GblnErrorCode {
+    let map = match object_map(object) {
+        Ok(map) => map,
+        Err(code) => return code,
+    };
+    match map.entry(key_str.to_string()) {
+        Entry::Occupied(_) => {
+            set_static_error(
+                GblnErrorCode::ErrorDuplicateKey,
+                "Duplicate key",
+                Some("Use a different key name"),
+            );
+            GblnErrorCode::ErrorDuplicateKey
+        }
+        Entry::Vacant(entry) => {
+            entry.insert(value);
+            GblnErrorCode::Ok
+        }
+    }
+}
+
 /// Insert field into object
 ///
 /// # Safety
@@ -297,56 +495,223 @@ pub extern "C" fn gbln_object_insert(
     value: *mut GblnValue,
 ) -> GblnErrorCode {
     if object.is_null() || key.is_null() || value.is_null() {
-        set_last_error("Null pointer in object_insert".to_string(), None);
+        set_static_error(
+            GblnErrorCode::ErrorNullPointer,
+            "Null pointer in object_insert",
+            None,
+        );
         return GblnErrorCode::ErrorNullPointer;
     }
 
-    let key_str = unsafe {
-        match CStr::from_ptr(key).to_str() {
-            Ok(s) => s.to_string(),
-            Err(e) => {
-                set_last_error(format!("Invalid UTF-8 in key: {}", e), None);
-                return GblnErrorCode::ErrorNullPointer;
-            }
-        }
+    let key_str = match field_key(key) {
+        Ok(s) => s,
+        Err(code) => return code,
     };
 
     // Take ownership of value
-    let value_box = unsafe { Box::from_raw(value) };
-    let value_inner = value_box.into_inner();
-
-    // Get mutable reference to object
-    let object_ref = unsafe { &mut *object };
-
-    match object_ref.inner() {
-        Value::Object(_) => {
-            // We need to get mutable access to the inner HashMap
-            // This requires unsafe access to the inner field
-            let inner_ptr = object_ref as *mut GblnValue as *mut Value;
-            let inner_ref = unsafe { &mut *inner_ptr };
-
-            if let Value::Object(ref mut map) = inner_ref {
-                if map.contains_key(&key_str) {
-                    set_last_error(
-                        format!("Duplicate key: {}", key_str),
-                        Some("Use a different key name".to_string()),
-                    );
-                    return GblnErrorCode::ErrorDuplicateKey;
-                }
-
-                map.insert(key_str, value_inner);
-                GblnErrorCode::Ok
-            } else {
-                unreachable!()
-            }
-        }
-        _ => {
-            set_last_error(
-                "Value is not an object".to_string(),
-                Some("Use gbln_value_new_object() to create an object".to_string()),
-            );
-            GblnErrorCode::ErrorTypeMismatch
+    let value_inner = unsafe { Box::from_raw(value) }.into_inner();
+    insert_field(object, key_str, value_inner)
+}
+
+/// Insert a value built in place, without taking ownership of anything
+fn insert_new(object: *mut GblnValue, key: *const c_char, value: Value) -> GblnErrorCode {
+    if object.is_null() || key.is_null() {
+        set_static_error(
+            GblnErrorCode::ErrorNullPointer,
+            "Null pointer in object_insert",
+            None,
+        );
+        return GblnErrorCode::ErrorNullPointer;
+    }
+
+    match field_key(key) {
+        Ok(key_str) => insert_field(object, key_str, value),
+        Err(code) => code,
+    }
+}
+
+/// Reserve room for at least `additional` more fields
+///
+/// # Returns
+/// - GBLN_OK on success
+/// - GBLN_ERROR_TYPE_MISMATCH if object is not an Object type
+/// - GBLN_ERROR_NULL_POINTER if object is null
+#[no_mangle]
+pub extern "C" fn gbln_object_reserve(object: *mut GblnValue, additional: usize) -> GblnErrorCode {
+    if object.is_null() {
+        set_static_error(
+            GblnErrorCode::ErrorNullPointer,
+            "Null pointer in object_reserve",
+            None,
+        );
+        return GblnErrorCode::ErrorNullPointer;
+    }
+
+    match object_map(object) {
+        Ok(map) => {
+            map.reserve(additional);
+            GblnErrorCode::Ok
         }
+        Err(code) => code,
+    }
+}
+
+// ============================================================================
+// Object Building - In-Place Setters
+// ============================================================================
+
+/// Insert an i8 field into object
+///
+/// Same as `gbln_object_insert()` with `gbln_value_new_i8()`, but the
+/// value is stored in place without an intermediate boxed value.
+///
+/// # Returns
+/// - GBLN_OK on success
+/// - GBLN_ERROR_DUPLICATE_KEY if key already exists
+/// - GBLN_ERROR_TYPE_MISMATCH if object is not an Object type
+/// - GBLN_ERROR_NULL_POINTER if object or key is null
+#[no_mangle]
+pub extern "C" fn gbln_object_insert_i8(
+    object: *mut GblnValue,
+    key: *const c_char,
+    value: i8,
+) -> GblnErrorCode {
+    insert_new(object, key, Value::I8(value))
+}
+
+/// Insert an i16 field into object (see `gbln_object_insert_i8()`)
+#[no_mangle]
+pub extern "C" fn gbln_object_insert_i16(
+    object: *mut GblnValue,
+    key: *const c_char,
+    value: i16,
+) -> GblnErrorCode {
+    insert_new(object, key, Value::I16(value))
+}
+
+/// Insert an i32 field into object (see `gbln_object_insert_i8()`)
+#[no_mangle]
+pub extern "C" fn gbln_object_insert_i32(
+    object: *mut GblnValue,
+    key: *const c_char,
+    value: i32,
+) -> GblnErrorCode {
+    insert_new(object, key, Value::I32(value))
+}
+
+/// Insert an i64 field into object (see `gbln_object_insert_i8()`)
+#[no_mangle]
+pub extern "C" fn gbln_object_insert_i64(
+    object: *mut GblnValue,
+    key: *const c_char,
+    value: i64,
+) -> GblnErrorCode {
+    insert_new(object, key, Value::I64(value))
+}
+
+/// Insert a u8 field into object (see `gbln_object_insert_i8()`)
+#[no_mangle]
+pub extern "C" fn gbln_object_insert_u8(
+    object: *mut GblnValue,
+    key: *const c_char,
+    value: u8,
+) -> GblnErrorCode {
+    insert_new(object, key, Value::U8(value))
+}
+
+/// Insert a u16 field into object (see `gbln_object_insert_i8()`)
+#[no_mangle]
+pub extern "C" fn gbln_object_insert_u16(
+    object: *mut GblnValue,
+    key: *const c_char,
+    value: u16,
+) -> GblnErrorCode {
+    insert_new(object, key, Value::U16(value))
+}
+
+/// Insert a u32 field into object (see `gbln_object_insert_i8()`)
+#[no_mangle]
+pub extern "C" fn gbln_object_insert_u32(
+    object: *mut GblnValue,
+    key: *const c_char,
+    value: u32,
+) -> GblnErrorCode {
+    insert_new(object, key, Value::U32(value))
+}
+
+/// Insert a u64 field into object (see `gbln_object_insert_i8()`)
+#[no_mangle]
+pub extern "C" fn gbln_object_insert_u64(
+    object: *mut GblnValue,
+    key: *const c_char,
+    value: u64,
+) -> GblnErrorCode {
+    insert_new(object, key, Value::U64(value))
+}
+
+/// Insert an f32 field into object (see `gbln_object_insert_i8()`)
+#[no_mangle]
+pub extern "C" fn gbln_object_insert_f32(
+    object: *mut GblnValue,
+    key: *const c_char,
+    value: f32,
+) -> GblnErrorCode {
+    insert_new(object, key, Value::F32(value))
+}
+
+/// Insert an f64 field into object (see `gbln_object_insert_i8()`)
+#[no_mangle]
+pub extern "C" fn gbln_object_insert_f64(
+    object: *mut GblnValue,
+    key: *const c_char,
+    value: f64,
+) -> GblnErrorCode {
+    insert_new(object, key, Value::F64(value))
+}
+
+/// Insert a bool field into object (see `gbln_object_insert_i8()`)
+#[no_mangle]
+pub extern "C" fn gbln_object_insert_bool(
+    object: *mut GblnValue,
+    key: *const c_char,
+    value: bool,
+) -> GblnErrorCode {
+    insert_new(object, key, Value::Bool(value))
+}
+
+/// Insert a null field into object (see `gbln_object_insert_i8()`)
+#[no_mangle]
+pub extern "C" fn gbln_object_insert_null(
+    object: *mut GblnValue,
+    key: *const c_char,
+) -> GblnErrorCode {
+    insert_new(object, key, Value::Null)
+}
+
+/// Insert a string field into object
+///
+/// Same as `gbln_object_insert()` with `gbln_value_new_str()`, including
+/// the `max_len` check, without an intermediate boxed value.
+///
+/// # Returns
+/// - GBLN_OK on success
+/// - GBLN_ERROR_STRING_TOO_LONG if value exceeds max_len characters
+/// - GBLN_ERROR_DUPLICATE_KEY if key already exists
+/// - GBLN_ERROR_TYPE_MISMATCH if object is not an Object type
+/// - GBLN_ERROR_NULL_POINTER if a pointer is null or a string is not UTF-8
+///
+/// # Safety
+/// - `key` and `value` must be valid null-terminated UTF-8 strings
+#[no_mangle]
+pub extern "C" fn gbln_object_insert_str(
+    object: *mut GblnValue,
+    key: *const c_char,
+    value: *const c_char,
+    max_len: usize,
+) -> GblnErrorCode {
+    match new_str(value, max_len) {
+        Ok(s) => insert_new(object, key, Value::Str(s)),
+        Err(code) => code,
     }
 }
 
@@ -360,6 +725,21 @@ pub extern "C" fn gbln_value_new_array() -> *mut GblnValue {
     Box::into_raw(Box::new(GblnValue::new(Value::Array(Vec::new()))))
 }
 
+/// Elements of `array`, or the error code for a non-array
+fn array_vec<'v>(array: *mut GblnValue) -> Result<&'v mut Vec<Value>, GblnErrorCode> {
+    match unsafe { (*array).inner_mut() } {
+        Value::Array(vec) => Ok(vec),
+        _ => {
+            set_static_error(
+                GblnErrorCode::ErrorTypeMismatch,
+                "Value is not an array",
+                Some("Use gbln_value_new_array() to create an array"),
+            );
+            Err(GblnErrorCode::ErrorTypeMismatch)
+        }
+    }
+}
+
 /// Push value to array
 ///
 /// # Safety
@@ -373,36 +753,148 @@ pub extern "C" fn gbln_value_new_array() -> *mut GblnValue {
 #[no_mangle]
 pub extern "C" fn gbln_array_push(array: *mut GblnValue, value: *mut GblnValue) -> GblnErrorCode {
     if array.is_null() || value.is_null() {
-        set_last_error("Null pointer in array_push".to_string(), None);
+        set_static_error(
+            GblnErrorCode::ErrorNullPointer,
+            "Null pointer in array_push",
+            None,
+        );
         return GblnErrorCode::ErrorNullPointer;
     }
 
     // Take ownership of value
-    let value_box = unsafe { Box::from_raw(value) };
-    let value_inner = value_box.into_inner();
-
-    // Get mutable reference to array
-    let array_ref = unsafe { &mut *array };
-
-    match array_ref.inner() {
-        Value::Array(_) => {
-            // Get mutable access to the inner Vec
-            let inner_ptr = array_ref as *mut GblnValue as *mut Value;
-            let inner_ref = unsafe { &mut *inner_ptr };
-
-            if let Value::Array(ref mut vec) = inner_ref {
-                vec.push(value_inner);
-                GblnErrorCode::Ok
-            } else {
-                unreachable!()
-            }
+    let value_inner = unsafe { Box::from_raw(value) }.into_inner();
+
+    match array_vec(array) {
+        Ok(vec) => {
+            vec.push(value_inner);
+            GblnErrorCode::Ok
         }
-        _ => {
-            set_last_error(
-                "Value is not an array".to_string(),
-                Some("Use gbln_value_new_array() to create an array".to_string()),
-            );
-            GblnErrorCode::ErrorTypeMismatch
+        Err(code) => code,
+    }
+}
+
+/// Reserve room for at least `additional` more elements
+///
+/// # Returns
+/// - GBLN_OK on success
+/// - GBLN_ERROR_TYPE_MISMATCH if array is not an Array type
+/// - GBLN_ERROR_NULL_POINTER if array is null
+#[no_mangle]
+pub extern "C" fn gbln_array_reserve(array: *mut GblnValue, additional: usize) -> GblnErrorCode {
+    if array.is_null() {
+        set_static_error(
+            GblnErrorCode::ErrorNullPointer,
+            "Null pointer in array_reserve",
+            None,
+        );
+        return GblnErrorCode::ErrorNullPointer;
+    }
+
+    match array_vec(array) {
+        Ok(vec) => {
+            vec.reserve(additional);
+            GblnErrorCode::Ok
         }
+        Err(code) => code,
+    }
+}
+
+// ============================================================================
+// Array Building - From C Buffers
+// ============================================================================
+
+/// Array holding `len` elements read from `data`
+fn array_from<T: Copy>(data: *const T, len: usize, element: fn(T) -> Value) -> *mut GblnValue {
+    if data.is_null() && len != 0 {
+        set_static_error(
+            GblnErrorCode::ErrorNullPointer,
+            "Null pointer in array_new_from",
+            None,
+        );
+        return ptr::null_mut();
     }
+
+    let items = if len == 0 {
+        Vec::new()
+    } else {
+        let data = unsafe { std::slice::from_raw_parts(data, len) };
+        data.iter().map(|&x| element(x)).collect()
+    };
+    Box::into_raw(Box::new(GblnValue::new(Value::Array(items))))
+}
+
+/// Create an array of i8 values from a C buffer
+///
+/// One call and one allocation for the whole array, instead of a
+/// `gbln_value_new_i8()` and `gbln_array_push()` per element.
+///
+/// # Returns
+/// - GblnValue pointer on success
+/// - NULL if data is NULL and len is not 0
+///
+/// # Safety
+/// - `data` must point to at least `len` readable elements
+#[no_mangle]
+pub extern "C" fn gbln_array_new_from_i8(data: *const i8, len: usize) -> *mut GblnValue {
+    array_from(data, len, Value::I8)
+}
+
+/// Create an array of i16 values from a C buffer (see `gbln_array_new_from_i8()`)
+#[no_mangle]
+pub extern "C" fn gbln_array_new_from_i16(data: *const i16, len: usize) -> *mut GblnValue {
+    array_from(data, len, Value::I16)
+}
+
+/// Create an array of i32 values from a C buffer (see `gbln_array_new_from_i8()`)
+#[no_mangle]
+pub extern "C" fn gbln_array_new_from_i32(data: *const i32, len: usize) -> *mut GblnValue {
+    array_from(data, len, Value::I32)
+}
+
+/// Create an array of i64 values from a C buffer (see `gbln_array_new_from_i8()`)
+#[no_mangle]
+pub extern "C" fn gbln_array_new_from_i64(data: *const i64, len: usize) -> *mut GblnValue {
+    array_from(data, len, Value::I64)
+}
+
+/// Create an array of u8 values from a C buffer (see `gbln_array_new_from_i8()`)
+#[no_mangle]
+pub extern "C" fn gbln_array_new_from_u8(data: *const u8, len: usize) -> *mut GblnValue {
+    array_from(data, len, Value::U8)
+}
+
+/// Create an array of u16 values from a C buffer (see `gbln_array_new_from_i8()`)
+#[no_mangle]
+pub extern "C" fn gbln_array_new_from_u16(data: *const u16, len: usize) -> *mut GblnValue {
+    array_from(data, len, Value::U16)
+}
+
+/// Create an array of u32 values from a C buffer (see `gbln_array_new_from_i8()`)
+#[no_mangle]
+pub extern "C" fn gbln_array_new_from_u32(data: *const u32, len: usize) -> *mut GblnValue {
+    array_from(data, len, Value::U32)
+}
+
+/// Create an array of u64 values from a C buffer (see `gbln_array_new_from_i8()`)
+#[no_mangle]
+pub extern "C" fn gbln_array_new_from_u64(data: *const u64, len: usize) -> *mut GblnValue {
+    array_from(data, len, Value::U64)
+}
+
+/// Create an array of f32 values from a C buffer (see `gbln_array_new_from_i8()`)
+#[no_mangle]
+pub extern "C" fn gbln_array_new_from_f32(data: *const f32, len: usize) -> *mut GblnValue {
+    array_from(data, len, Value::F32)
+}
+
+/// Create an array of f64 values from a C buffer (see `gbln_array_new_from_i8()`)
+#[no_mangle]
+pub extern "C" fn gbln_array_new_from_f64(data: *const f64, len: usize) -> *mut GblnValue {
+    array_from(data, len, Value::F64)
+}
+
+/// Create an array of bool values from a C buffer (see `gbln_array_new_from_i8()`)
+#[no_mangle]
+pub extern "C" fn gbln_array_new_from_bool(data: *const bool, len: usize) -> *mut GblnValue {
+    array_from(data, len, Value::Bool)
 }
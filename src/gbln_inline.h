@@ -0,0 +1,56 @@
+/*
+ * Inline fast paths
+ *
+ * Appended to gbln.h by build.rs (cbindgen cannot generate these). They read
+ * a GblnScalar filled by `gbln_value_view()` or `gbln_array_view()`, with the
+ * same results as the matching `gbln_value_*()` call on the viewed value.
+ */
+#ifndef GBLN_INLINE_H
+#define GBLN_INLINE_H
+
+static inline enum GblnValueType gbln_scalar_type(const struct GblnScalar *s) {
+    return s->value_type;
+}
+
+static inline bool gbln_scalar_is_null(const struct GblnScalar *s) {
+    return s->value_type == Null;
+}
+
+#define GBLN_SCALAR_AS(NAME, CTYPE, TYPE, FIELD)                                       \
+    static inline CTYPE gbln_scalar_as_##NAME(const struct GblnScalar *s, bool *ok) {  \
+        bool match = s->value_type == TYPE;                                            \
+        if (ok) {                                                                      \
+            *ok = match;                                                               \
+        }                                                                              \
+        return match ? (CTYPE)s->FIELD : (CTYPE)0;                                     \
+    }
+
+GBLN_SCALAR_AS(i8, int8_t, I8, int_value)
+GBLN_SCALAR_AS(i16, int16_t, I16, int_value)
+GBLN_SCALAR_AS(i32, int32_t, I32, int_value)
+GBLN_SCALAR_AS(i64, int64_t, I64, int_value)
+GBLN_SCALAR_AS(u8, uint8_t, U8, uint_value)
+GBLN_SCALAR_AS(u16, uint16_t, U16, uint_value)
+GBLN_SCALAR_AS(u32, uint32_t, U32, uint_value)
+GBLN_SCALAR_AS(u64, uint64_t, U64, uint_value)
+GBLN_SCALAR_AS(f32, float, F32, float_value)
+GBLN_SCALAR_AS(f64, double, F64, float_value)
+GBLN_SCALAR_AS(bool, bool, Bool, bool_value)
+
+#undef GBLN_SCALAR_AS
+
+/* Borrowed string bytes (NOT null-terminated), NULL if not a string */
+static inline const char *gbln_scalar_as_str(const struct GblnScalar *s,
+                                             uintptr_t *out_len,
+                                             bool *ok) {
+    bool match = s->value_type == Str;
+    if (ok) {
+        *ok = match;
+    }
+    if (out_len) {
+        *out_len = match ? s->str_len : 0;
+    }
+    return match ? s->str_ptr : NULL;
+}
+
+#endif  /* GBLN_INLINE_H */
@@ -0,0 +1,176 @@
+// Copyright (c) 2025 Vivian Burkhard Voss
+// SPDX-License-Identifier: Apache-2.0
+
+//! Compact object index
+//!
+//! `Value::Object` is owned by gbln-rust as a SipHash `HashMap`, so its layout
+//! cannot change here. A `GblnObjectIndex` is a flat read-only view over one
+//! object: fast hashes in one contiguous array, scanned linearly for small
+//! objects and binary-searched above `LINEAR_LIMIT` fields. Build it once for
+//! objects that are read many times.
+
+use std::collections::HashMap;
+use std::os::raw::c_char;
+use std::ptr;
+use std::slice;
+
+use crate::hash::hash_bytes;
+use crate::key::GblnKey;
+use crate::types::GblnValue;
+use gbln::Value;
+
+/// Objects up to this many fields are probed with a linear hash scan
+const LINEAR_LIMIT: usize = 16;
+
+/// Read-only compact index over an object's fields
+///
+/// Borrows the object it was built from: the object must outlive the index
+/// and must not be modified while the index is in use.
+pub struct GblnObjectIndex {
+    /// Field hashes, sorted ascending
+    hashes: Box<[u64]>,
+    /// Key and value of each field, in the same order as `hashes`
+    entries: Box<[(*const str, *const Value)]>,
+}
+
+impl GblnObjectIndex {
+    fn build(map: &HashMap<String, Value>) -> Self {
+        let mut fields: Vec<(u64, *const str, *const Value)> = map
+            .iter()
+            .map(|(k, v)| {
+                (
+                    hash_bytes(k.as_bytes()),
+                    k.as_str() as *const str,
+                    v as *const Value,
+                )
+            })
+            .collect();
+        fields.sort_unstable_by_key(|f| f.0);
+
+        GblnObjectIndex {
+            hashes: fields.iter().map(|f| f.0).collect(),
+            entries: fields.iter().map(|f| (f.1, f.2)).collect(),
+        }
+    }
+
+    fn find(&self, hash: u64, key: &[u8]) -> *const GblnValue {
+        let start = if self.hashes.len() <= LINEAR_LIMIT {
+            match self.hashes.iter().position(|&h| h >= hash) {
+                Some(i) => i,
+                None => return ptr::null(),
+            }
+        } else {
+            self.hashes.partition_point(|&h| h < hash)
+        };
+
+        for i in start..self.hashes.len() {
+            if self.hashes[i] != hash {
+                break;
+            }
+            let (k, v) = self.entries[i];
+            if unsafe { (*k).as_bytes() } == key {
+                return v as *const GblnValue;
+            }
+        }
+
+        ptr::null()
+    }
+}
+
+/// Build a compact index over an object
+///
+/// # Returns
+/// - GblnObjectIndex pointer on success
+/// - NULL if value is NULL or not an object
+///
+/// # Safety
+/// - `value` must be a valid GblnValue pointer
+/// - The object must outlive the index and must not be modified while it exists
+/// - Caller must free with `gbln_object_index_free()`
+#[no_mangle]
+pub extern "C" fn gbln_object_index_new(value: *const GblnValue) -> *mut GblnObjectIndex {
+    if value.is_null() {
+        return ptr::null_mut();
+    }
+
+    match unsafe { (*value).inner() } {
+        Value::Object(map) => Box::into_raw(Box::new(GblnObjectIndex::build(map))),
+        _ => ptr::null_mut(),
+    }
+}
+
+/// Get number of fields in an object index
+///
+/// Returns 0 if `index` is NULL.
+#[no_mangle]
+pub extern "C" fn gbln_object_index_len(index: *const GblnObjectIndex) -> usize {
+    if index.is_null() {
+        return 0;
+    }
+
+    unsafe { (&*index).hashes.len() }
+}
+
+/// Get field from an object index using a prepared key
+///
+/// # Safety
+/// - `index` must be a valid pointer from `gbln_object_index_new()`
+/// - `key` must be a valid pointer from `gbln_key_intern()`
+/// - Returns NULL if key not found
+/// - Returned pointer is valid as long as the indexed object is valid
+#[no_mangle]
+pub extern "C" fn gbln_object_index_get(
+    index: *const GblnObjectIndex,
+    key: *const GblnKey,
+) -> *const GblnValue {
+    if index.is_null() || key.is_null() {
+        return ptr::null();
+    }
+
+    let key = unsafe { &*key };
+    unsafe { (*index).find(key.hash(), key.as_str().as_bytes()) }
+}
+
+/// Get field from an object index using a length-delimited key
+///
+/// The key does not need to be null-terminated and is compared byte-wise.
+///
+/// # Safety
+/// - `index` must be a valid pointer from `gbln_object_index_new()`
+/// - `key` must point to at least `len` readable bytes
+/// - Returns NULL if key not found
+/// - Returned pointer is valid as long as the indexed object is valid
+#[no_mangle]
+pub extern "C" fn gbln_object_index_get_n(
+    index: *const GblnObjectIndex,
+    key: *const c_char,
+    len: usize,
+) -> *const GblnValue {
+    if index.is_null() || (key.is_null() && len != 0) {
+        return ptr::null();
+    }
+
+    let bytes: &[u8] = if len == 0 {
+        &[]
+    } else {
+        unsafe { slice::from_raw_parts(key as *const u8, len) }
+    };
+
+    unsafe { (*index).find(hash_bytes(bytes), bytes) }
+}
+
+/// Free an object index
+///
+/// Does not affect the indexed object.
+///
+/// # Safety
+/// - `index` must be a valid pointer from `gbln_object_index_new()` or NULL
+/// - Must not be called twice on the same pointer
+#[no_mangle]
+pub extern "C" fn gbln_object_index_free(index: *mut GblnObjectIndex) {
+    if !index.is_null() {
+        unsafe {
+            drop(Box::from_raw(index));
+        }
+    }
+}
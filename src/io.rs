@@ -7,14 +7,27 @@
 //! GBLN I/O format files (.io.gbln.xz)
 
 use std::ffi::CStr;
-use std::os::raw::c_char;
+use std::fs::File;
+use std::io::{BufReader, BufWriter, Read, Write};
+use std::os::raw::{c_char, c_void};
 use std::path::Path;
 
+use crate::binary::{is_binary, store_binary, write_binary};
+use crate::codec::{self, Compression, Decoder, Encoder};
 use crate::config::GblnConfig;
-use crate::error::{set_last_error, GblnErrorCode};
+use crate::error::{set_core_error, set_last_error, set_static_error, GblnErrorCode};
+use crate::mmap::Mapping;
+use crate::parallel::{parse_parallel, store_result};
+use crate::parser::GblnParser;
+use crate::stats::{Op, Phase, Timed, Timer};
+use crate::stream::{GblnStream, GblnStreamCallback};
 use crate::types::GblnValue;
+use crate::writer::{write_value, Style};
 use gbln::{read_io as rust_read_io, write_io as rust_write_io};
 
+/// Chunk size of the streaming read and write paths
+pub(crate) const STREAM_CHUNK: usize = 64 * 1024;
+
 /// Write GBLN value to I/O format file
 ///
 /// This function serialises the value according to the configuration and writes
@@ -26,6 +39,14 @@ use gbln::{read_io as rust_read_io, write_io as rust_write_io};
 /// - `.io.gbln`: MINI GBLN without compression (compress=false, mini_mode=true)
 /// - `.gbln`: Pretty-printed source format (mini_mode=false)
 ///
+/// # Codecs and Threads
+/// With `gbln_config_set_codec()` or `gbln_config_set_threads()` the text is
+/// compressed with zstd, LZ4 or multi-threaded XZ instead. Those files (and
+/// binary ones) are written piece by piece by the streaming serialiser, as
+/// by `gbln_write_io_stream()`, so the whole text is never held in memory.
+/// Its text is not byte-identical to the default path (object fields are
+/// sorted, hints differ); both read back to an equal value.
+///
 /// # Parameters
 /// - value: GBLN value to write
 /// - path: File path (null-terminated string)
@@ -33,7 +54,8 @@ use gbln::{read_io as rust_read_io, write_io as rust_write_io};
 ///
 /// # Returns
 /// - GBLN_OK on success
-/// - GBLN_ERROR_IO on file write failure
+/// - GBLN_ERROR_IO on file write failure, or a key that cannot be written on
+///   the codec and threaded paths
 /// - GBLN_ERROR_NULL_POINTER if value or path is NULL
 /// - Error details via gbln_last_error_message()
 ///
@@ -49,12 +71,12 @@ pub extern "C" fn gbln_write_io(
 ) -> GblnErrorCode {
     // Validate pointers
     if value.is_null() {
-        set_last_error("Null value pointer".to_string(), None);
+        set_static_error(GblnErrorCode::ErrorNullPointer, "Null value pointer", None);
         return GblnErrorCode::ErrorNullPointer;
     }
 
     if path.is_null() {
-        set_last_error("Null path pointer".to_string(), None);
+        set_static_error(GblnErrorCode::ErrorNullPointer, "Null path pointer", None);
         return GblnErrorCode::ErrorNullPointer;
     }
 
@@ -62,29 +84,41 @@ pub extern "C" fn gbln_write_io(
     let path_str = unsafe {
         match CStr::from_ptr(path).to_str() {
             Ok(s) => s,
-            Err(e) => {
-                set_last_error(format!("Invalid UTF-8 in path: {}", e), None);
+            Err(_) => {
+                set_static_error(GblnErrorCode::ErrorIo, "Invalid UTF-8 in path", None);
                 return GblnErrorCode::ErrorIo;
             }
         }
     };
 
+    let timer = Timer::start(Op::WriteIo);
+    let code = write_file(unsafe { &*value }, path_str, unsafe { config.as_ref() });
+    timer.finish_with(|| file_len(path_str));
+    code
+}
+
+/// Write `value` to `path` as configured (no config = io_format())
+fn write_file(value: &GblnValue, path_str: &str, config: Option<&GblnConfig>) -> GblnErrorCode {
+    // Other codecs and threaded XZ
+    if let Some(config) = config.filter(|c| !c.is_core()) {
+        return write_encoded(value, path_str, config);
+    }
+
     // Get config (or use default)
-    let rust_config = if config.is_null() {
-        gbln::GblnConfig::io_format()
-    } else {
-        unsafe { (*config).inner.clone() }
+    let rust_config = match config {
+        Some(config) => config.inner.clone(),
+        None => gbln::GblnConfig::io_format(),
     };
 
     // Get value
-    let rust_value = unsafe { (*value).inner() };
+    let rust_value = value.inner();
 
     // Write to file
     match rust_write_io(rust_value, Path::new(path_str), &rust_config) {
         Ok(()) => GblnErrorCode::Ok,
         Err(e) => {
-            let suggestion = e.suggestion.clone();
-            set_last_error(e.to_string(), suggestion);
+            // Write failures are reported as I/O errors whatever their kind
+            set_core_error(e);
             GblnErrorCode::ErrorIo
         }
     }
@@ -92,12 +126,14 @@ pub extern "C" fn gbln_write_io(
 
 /// Read GBLN file from I/O format
 ///
-/// This function reads a file and automatically detects if it's XZ compressed.
+/// This function reads a file and automatically detects if it's compressed.
 /// The content is then parsed into a GBLN value.
 ///
 /// # Auto-Detection
-/// The function checks for XZ magic bytes (FD 37 7A 58 5A 00) and automatically
-/// decompresses if detected.
+/// The function checks for XZ (FD 37 7A 58 5A 00), zstd (28 B5 2F FD) and
+/// LZ4 frame (04 22 4D 18) magic bytes and decompresses if detected.
+/// Content starting with `GBLB` is decoded as the binary encoding (see
+/// `gbln_config_set_binary()`).
 ///
 /// # Parameters
 /// - path: File path (null-terminated string)
@@ -121,7 +157,7 @@ pub extern "C" fn gbln_read_io(
 ) -> GblnErrorCode {
     // Validate pointers
     if path.is_null() || out_value.is_null() {
-        set_last_error("Null pointer".to_string(), None);
+        set_static_error(GblnErrorCode::ErrorNullPointer, "Null pointer", None);
         return GblnErrorCode::ErrorNullPointer;
     }
 
@@ -129,15 +165,46 @@ pub extern "C" fn gbln_read_io(
     let path_str = unsafe {
         match CStr::from_ptr(path).to_str() {
             Ok(s) => s,
+            Err(_) => {
+                set_static_error(GblnErrorCode::ErrorIo, "Invalid UTF-8 in path", None);
+                return GblnErrorCode::ErrorIo;
+            }
+        }
+    };
+
+    let timer = Timer::start(Op::ReadIo);
+    let code = read_file(path_str, out_value);
+    timer.finish_with(|| file_len(path_str));
+    code
+}
+
+/// Read and parse the file at `path`, detecting codec and encoding
+fn read_file(path_str: &str, out_value: *mut *mut GblnValue) -> GblnErrorCode {
+    // Read from file: the core reader handles plain text
+    let head = file_head(path_str);
+    let result = if codec::sniff(&head).is_none() && !is_binary(&head) {
+        rust_read_io(Path::new(path_str))
+    } else {
+        let bytes = match read_decoded(path_str) {
+            Ok(bytes) => bytes,
             Err(e) => {
-                set_last_error(format!("Invalid UTF-8 in path: {}", e), None);
+                set_last_error(format!("Failed to read {}: {}", path_str, e), None);
+                return GblnErrorCode::ErrorIo;
+            }
+        };
+        if is_binary(&bytes) {
+            return store_binary(&bytes, out_value);
+        }
+        match String::from_utf8(bytes) {
+            Ok(text) => gbln::parse(&text),
+            Err(e) => {
+                set_last_error(format!("Failed to read {}: {}", path_str, e), None);
                 return GblnErrorCode::ErrorIo;
             }
         }
     };
 
-    // Read from file
-    match rust_read_io(Path::new(path_str)) {
+    match result {
         Ok(value) => {
             let boxed = Box::new(GblnValue::new(value));
             unsafe {
@@ -145,25 +212,354 @@ pub extern "C" fn gbln_read_io(
             }
             GblnErrorCode::Ok
         }
+        Err(e) => set_core_error(e),
+    }
+}
+
+/// Stream `value` into `path` with `config`'s layout (or as binary) and codec
+fn write_encoded(value: &GblnValue, path: &str, config: &GblnConfig) -> GblnErrorCode {
+    let result = File::create(path)
+        .and_then(|file| write_stream(file, value.inner(), config))
+        .and_then(|file| file.sync_all());
+    match result {
+        Ok(()) => GblnErrorCode::Ok,
+        Err(e) => {
+            set_last_error(format!("Failed to write {}: {}", path, e), None);
+            GblnErrorCode::ErrorIo
+        }
+    }
+}
+
+/// First bytes of a file, enough to tell its codec (empty if unreadable)
+fn file_head(path: &str) -> Vec<u8> {
+    let mut head = [0u8; 6];
+    let mut n = 0;
+    if let Ok(mut file) = File::open(path) {
+        while n < head.len() {
+            match file.read(&mut head[n..]) {
+                Ok(0) | Err(_) => break,
+                Ok(k) => n += k,
+            }
+        }
+    }
+    head[..n].to_vec()
+}
+
+/// Decompress a whole file
+fn read_decoded(path: &str) -> std::io::Result<Vec<u8>> {
+    let decoder = Decoder::sniff(BufReader::with_capacity(STREAM_CHUNK, File::open(path)?))?;
+    let phase = decoder.compressed().then_some(Phase::Decompress);
+    let mut bytes = Vec::new();
+    Timed::new(decoder, phase).read_to_end(&mut bytes)?;
+    Ok(bytes)
+}
+
+/// Size of the file at `path` (0 if it cannot be read)
+fn file_len(path: &str) -> u64 {
+    std::fs::metadata(path).map_or(0, |m| m.len())
+}
+
+/// View a non-null C path as UTF-8
+pub(crate) fn path_to_str<'a>(path: *const c_char) -> Result<&'a str, GblnErrorCode> {
+    unsafe { CStr::from_ptr(path) }.to_str().map_err(|_| {
+        set_static_error(GblnErrorCode::ErrorIo, "Invalid UTF-8 in path", None);
+        GblnErrorCode::ErrorIo
+    })
+}
+
+/// Read a GBLN I/O file, parsing a large root array across threads
+///
+/// Like `gbln_read_io()`, but content that is a single top-level array is
+/// split at element boundaries and parsed in parallel. Compressed files
+/// are first decompressed into memory, then split the same way; binary
+/// files are decoded on the calling thread.
+///
+/// # Parameters
+/// - path: File path (null-terminated string)
+/// - threads: Worker threads to use (0 = one per available CPU)
+/// - out_value: Pointer to store the parsed value
+///
+/// # Returns
+/// - GBLN_OK on success, with out_value set to parsed value
+/// - GBLN_ERROR_IO on file read failure
+/// - GBLN_ERROR_NULL_POINTER if path or out_value is NULL
+/// - Parse errors on invalid GBLN content
+/// - Error details via gbln_last_error_message()
+///
+/// # Safety
+/// - path must be a valid null-terminated UTF-8 string
+/// - out_value must be a valid pointer to store the result
+/// - Caller must free returned value with gbln_value_free()
+#[no_mangle]
+pub extern "C" fn gbln_read_io_parallel(
+    path: *const c_char,
+    threads: usize,
+    out_value: *mut *mut GblnValue,
+) -> GblnErrorCode {
+    if path.is_null() || out_value.is_null() {
+        set_static_error(GblnErrorCode::ErrorNullPointer, "Null pointer", None);
+        return GblnErrorCode::ErrorNullPointer;
+    }
+
+    let path_str = match path_to_str(path) {
+        Ok(s) => s,
+        Err(code) => return code,
+    };
+
+    let timer = Timer::start(Op::ReadIo);
+    let code = read_file_parallel(path_str, threads, out_value);
+    timer.finish_with(|| file_len(path_str));
+    code
+}
+
+/// Read the file at `path`, parsing a root array on `threads` threads
+fn read_file_parallel(
+    path_str: &str,
+    threads: usize,
+    out_value: *mut *mut GblnValue,
+) -> GblnErrorCode {
+    // Compressed files are decompressed into memory in one pass
+    let bytes = match read_decoded(path_str) {
+        Ok(bytes) => bytes,
+        Err(e) => {
+            set_last_error(format!("Failed to read {}: {}", path_str, e), None);
+            return GblnErrorCode::ErrorIo;
+        }
+    };
+
+    if is_binary(&bytes) {
+        return store_binary(&bytes, out_value);
+    }
+
+    store_result(parse_parallel(&bytes, false, threads), &bytes, out_value)
+}
+
+/// Read an uncompressed GBLN I/O file through a read-only memory mapping
+///
+/// The file is mapped and parsed in place instead of first being copied into
+/// an owned buffer, and its pages are shared with every other process that
+/// maps or reads it. Binary files are decoded straight from the mapping.
+/// Compressed files are read as by `gbln_read_io()`.
+///
+/// For zero-copy access to the strings themselves, see
+/// `gbln_lazy_open_mmap()`.
+///
+/// # Parameters
+/// - path: File path (null-terminated string)
+/// - out_value: Pointer to store the parsed value
+///
+/// # Returns
+/// - GBLN_OK on success, with out_value set to parsed value
+/// - GBLN_ERROR_IO on file open or map failure
+/// - GBLN_ERROR_NULL_POINTER if path or out_value is NULL
+/// - Parse errors on invalid GBLN content
+/// - Error details via gbln_last_error_message()
+///
+/// # Safety
+/// - path must be a valid null-terminated UTF-8 string
+/// - The file must not be truncated or modified while it is being read
+/// - Caller must free returned value with gbln_value_free()
+#[no_mangle]
+pub extern "C" fn gbln_read_io_mmap(
+    path: *const c_char,
+    out_value: *mut *mut GblnValue,
+) -> GblnErrorCode {
+    if path.is_null() || out_value.is_null() {
+        set_static_error(GblnErrorCode::ErrorNullPointer, "Null pointer", None);
+        return GblnErrorCode::ErrorNullPointer;
+    }
+
+    let path_str = match path_to_str(path) {
+        Ok(s) => s,
+        Err(code) => return code,
+    };
+
+    let timer = Timer::start(Op::ReadIo);
+    let code = read_file_mmap(path_str, out_value);
+    timer.finish_with(|| file_len(path_str));
+    code
+}
+
+/// Read the file at `path` through a memory mapping
+fn read_file_mmap(path_str: &str, out_value: *mut *mut GblnValue) -> GblnErrorCode {
+    let mapping = match Mapping::open(Path::new(path_str)) {
+        Ok(mapping) => mapping,
+        Err(e) => {
+            set_last_error(format!("Failed to map {}: {}", path_str, e), None);
+            return GblnErrorCode::ErrorIo;
+        }
+    };
+
+    if codec::sniff(mapping.bytes()).is_some() {
+        drop(mapping);
+        return read_file(path_str, out_value);
+    }
+    if is_binary(mapping.bytes()) {
+        return store_binary(mapping.bytes(), out_value);
+    }
+
+    let result = GblnParser::new().parse_value(mapping.bytes(), false);
+    store_result(result, mapping.bytes(), out_value)
+}
+
+/// Serialise `value` into `out` with `config`'s layout (or as binary) and
+/// compression
+pub(crate) fn write_stream<W: Write>(
+    out: W,
+    value: &gbln::Value,
+    config: &GblnConfig,
+) -> std::io::Result<W> {
+    let compression = Compression::of(config);
+    let encoder = Timed::new(
+        Encoder::new(out, compression)?,
+        compression.map(|_| Phase::Compress),
+    );
+    let mut buffered = BufWriter::with_capacity(STREAM_CHUNK, encoder);
+    if config.binary {
+        write_binary(&mut buffered, value)?;
+    } else {
+        write_value(&mut buffered, value, Style::of(&config.inner))?;
+    }
+    buffered
+        .into_inner()
+        .map_err(|e| e.into_error())?
+        .finish(Encoder::finish)
+}
+
+/// Write a GBLN value to an I/O format file without an intermediate copy
+///
+/// Same file format and compression as `gbln_write_io()`, but the serialiser
+/// writes piece by piece straight into the encoder (or the file), so no
+/// serialised text or compressed buffer for the whole document is ever held
+/// in memory. The text itself is not byte-identical to `gbln_write_io()`'s
+/// default path (object fields are sorted, hints differ); it reads back to
+/// an equal value through `gbln_read_io()`.
+///
+/// # Parameters
+/// - value: GBLN value to write
+/// - path: File path (null-terminated string)
+/// - config: I/O configuration (if NULL, uses default io_format())
+///
+/// # Returns
+/// - GBLN_OK on success
+/// - GBLN_ERROR_IO on file write failure or a key that cannot be written
+/// - GBLN_ERROR_NULL_POINTER if value or path is NULL
+/// - Error details via gbln_last_error_message()
+///
+/// # Safety
+/// - value must be a valid GblnValue pointer
+/// - path must be a valid null-terminated UTF-8 string
+/// - config may be NULL (uses default)
+#[no_mangle]
+pub extern "C" fn gbln_write_io_stream(
+    value: *const GblnValue,
+    path: *const c_char,
+    config: *const GblnConfig,
+) -> GblnErrorCode {
+    if value.is_null() || path.is_null() {
+        set_static_error(GblnErrorCode::ErrorNullPointer, "Null pointer", None);
+        return GblnErrorCode::ErrorNullPointer;
+    }
+
+    let path_str = match path_to_str(path) {
+        Ok(s) => s,
+        Err(code) => return code,
+    };
+
+    let default_config;
+    let config = if config.is_null() {
+        default_config = GblnConfig::new(gbln::GblnConfig::io_format());
+        &default_config
+    } else {
+        unsafe { &*config }
+    };
+
+    let timer = Timer::start(Op::WriteIo);
+    let result = File::create(path_str)
+        .and_then(|file| write_stream(file, unsafe { (*value).inner() }, config))
+        .and_then(|file| file.sync_all());
+    timer.finish_with(|| file_len(path_str));
+    match result {
+        Ok(()) => GblnErrorCode::Ok,
         Err(e) => {
-            let suggestion = e.suggestion.clone();
-            set_last_error(e.to_string(), suggestion);
-
-            // Map error kind
-            use gbln::ErrorKind;
-            match e.kind {
-                ErrorKind::IoError => GblnErrorCode::ErrorIo,
-                ErrorKind::UnexpectedCharacter => GblnErrorCode::ErrorUnexpectedChar,
-                ErrorKind::UnterminatedString => GblnErrorCode::ErrorUnterminatedString,
-                ErrorKind::UnexpectedToken => GblnErrorCode::ErrorUnexpectedToken,
-                ErrorKind::UnexpectedEof => GblnErrorCode::ErrorUnexpectedEof,
-                ErrorKind::InvalidSyntax => GblnErrorCode::ErrorInvalidSyntax,
-                ErrorKind::IntegerOutOfRange => GblnErrorCode::ErrorIntOutOfRange,
-                ErrorKind::StringTooLong => GblnErrorCode::ErrorStringTooLong,
-                ErrorKind::TypeMismatch => GblnErrorCode::ErrorTypeMismatch,
-                ErrorKind::InvalidTypeHint => GblnErrorCode::ErrorInvalidTypeHint,
-                ErrorKind::DuplicateKey => GblnErrorCode::ErrorDuplicateKey,
+            set_last_error(format!("Failed to write {}: {}", path_str, e), None);
+            GblnErrorCode::ErrorIo
+        }
+    }
+}
+
+/// Feed everything `source` yields into `stream`
+fn pump<R: Read>(mut source: R, stream: &mut GblnStream) -> GblnErrorCode {
+    let mut chunk = vec![0u8; STREAM_CHUNK];
+    let mut first = true;
+    loop {
+        let n = match source.read(&mut chunk) {
+            Ok(0) => return stream.finish(),
+            Ok(n) => n,
+            Err(e) if e.kind() == std::io::ErrorKind::Interrupted => continue,
+            Err(e) => {
+                set_last_error(format!("Failed to read input: {}", e), None);
+                return GblnErrorCode::ErrorIo;
             }
+        };
+        if std::mem::take(&mut first) && is_binary(&chunk[..n]) {
+            set_last_error(
+                "Binary GBLN cannot be streamed; use gbln_read_io()".to_string(),
+                None,
+            );
+            return GblnErrorCode::ErrorIo;
+        }
+        let code = stream.feed(&chunk[..n]);
+        if code != GblnErrorCode::Ok {
+            return code;
+        }
+    }
+}
+
+/// Read a GBLN I/O file record by record through a fixed-size window
+///
+/// Compressed files are decompressed on the fly. The decompressed text is
+/// fed to an incremental parser (see `gbln_stream_new()`), which hands each
+/// top-level value, or each element of a root array, to `callback` as soon
+/// as it is complete. Peak memory is one chunk plus the largest record.
+/// Binary files are not streamed; read them with `gbln_read_io()`.
+///
+/// # Parameters
+/// - path: File path (null-terminated string)
+/// - callback: Receives each value (see `GblnStreamCallback`)
+/// - ctx: Opaque pointer passed to every callback invocation
+///
+/// # Returns
+/// - GBLN_OK once the whole file has been delivered
+/// - GBLN_ERROR_IO on file read or decompression failure, or binary content
+/// - The parse error, or the callback's code if it stopped the stream
+/// - Error details via gbln_last_error_message()
+///
+/// # Safety
+/// - path must be a valid null-terminated UTF-8 string
+#[no_mangle]
+pub extern "C" fn gbln_read_io_stream(
+    path: *const c_char,
+    callback: GblnStreamCallback,
+    ctx: *mut c_void,
+) -> GblnErrorCode {
+    if path.is_null() {
+        set_static_error(GblnErrorCode::ErrorNullPointer, "Null pointer", None);
+        return GblnErrorCode::ErrorNullPointer;
+    }
+
+    let path_str = match path_to_str(path) {
+        Ok(s) => s,
+        Err(code) => return code,
+    };
+
+    let opened = File::open(path_str)
+        .and_then(|file| Decoder::sniff(BufReader::with_capacity(STREAM_CHUNK, file)));
+    match opened {
+        Ok(source) => pump(source, &mut GblnStream::new(callback, ctx)),
+        Err(e) => {
+            set_last_error(format!("Failed to read {}: {}", path_str, e), None);
+            GblnErrorCode::ErrorIo
         }
     }
 }
@@ -0,0 +1,135 @@
+// Copyright (c) 2025 Vivian Burkhard Voss
+// SPDX-License-Identifier: Apache-2.0
+
+//! Prepared key handles for repeated object lookups
+//!
+//! `gbln_object_get()` has to measure and validate its C key on every call.
+//! A `GblnKey` does that once, so consumers that look up the same field
+//! names on every record only pay for the map lookup.
+//!
+//! The key's precomputed hash is for `GblnObjectIndex`, whose table uses
+//! the same hash function. A plain object is a `HashMap` with the core's
+//! SipHash state, which offers no way to pass a hash in, so
+//! `gbln_object_get_key()` still hashes the name on each lookup.
+
+use std::ffi::CStr;
+use std::os::raw::c_char;
+use std::ptr;
+
+use crate::error::{set_last_error, set_static_error, GblnErrorCode};
+use crate::hash::hash_bytes;
+use crate::types::GblnValue;
+use gbln::Value;
+
+/// Prepared object key
+///
+/// Holds a validated copy of the key name and its precomputed hash. Create
+/// once with `gbln_key_intern()` and reuse for any number of lookups. The
+/// hash is only used by `gbln_object_index_get()`.
+pub struct GblnKey {
+    name: Box<str>,
+    hash: u64,
+}
+
+impl GblnKey {
+    pub(crate) fn as_str(&self) -> &str {
+        &self.name
+    }
+
+    pub(crate) fn hash(&self) -> u64 {
+        self.hash
+    }
+}
+
+/// Prepare a key handle for repeated lookups
+///
+/// # Returns
+/// - GblnKey pointer on success
+/// - NULL if `name` is NULL or not valid UTF-8
+///
+/// # Safety
+/// - `name` must be a valid null-terminated UTF-8 string
+/// - Caller must free with `gbln_key_free()`
+#[no_mangle]
+pub extern "C" fn gbln_key_intern(name: *const c_char) -> *mut GblnKey {
+    if name.is_null() {
+        set_static_error(
+            GblnErrorCode::ErrorNullPointer,
+            "Null pointer for key",
+            None,
+        );
+        return ptr::null_mut();
+    }
+
+    let name_str = unsafe {
+        match CStr::from_ptr(name).to_str() {
+            Ok(s) => s,
+            Err(e) => {
+                set_last_error(format!("Invalid UTF-8 in key: {}", e), None);
+                return ptr::null_mut();
+            }
+        }
+    };
+
+    Box::into_raw(Box::new(GblnKey {
+        name: name_str.into(),
+        hash: hash_bytes(name_str.as_bytes()),
+    }))
+}
+
+/// Get the length in bytes of a key handle's name
+///
+/// Returns 0 if `key` is NULL.
+#[no_mangle]
+pub extern "C" fn gbln_key_len(key: *const GblnKey) -> usize {
+    if key.is_null() {
+        return 0;
+    }
+
+    unsafe { (*key).as_str().len() }
+}
+
+/// Get field from object using a prepared key
+///
+/// Same result as `gbln_object_get()` without re-scanning or re-validating
+/// the key. The object's map still hashes the name; to skip hashing too,
+/// build a `gbln_object_index_new()` and use `gbln_object_index_get()`.
+///
+/// # Safety
+/// - `value` must be a valid GblnValue pointer
+/// - `key` must be a valid pointer from `gbln_key_intern()`
+/// - Returns NULL if value is not an object or key not found
+/// - Returned pointer is valid as long as the parent value is valid
+#[no_mangle]
+pub extern "C" fn gbln_object_get_key(
+    value: *const GblnValue,
+    key: *const GblnKey,
+) -> *const GblnValue {
+    if value.is_null() || key.is_null() {
+        return ptr::null();
+    }
+
+    let key = unsafe { &*key };
+
+    match unsafe { (*value).inner() } {
+        Value::Object(map) => map
+            .get(key.as_str())
+            .map(|v| v as *const Value as *const GblnValue)
+            .unwrap_or(ptr::null()),
+        _ => ptr::null(),
+    }
+}
+
+/// Free a key handle
+///
+/// # Safety
+/// - `key` must be a valid pointer from `gbln_key_intern()` or NULL
+/// - Must not be called twice on the same pointer
+#[no_mangle]
+pub extern "C" fn gbln_key_free(key: *mut GblnKey) {
+    if !key.is_null() {
+        unsafe {
+            drop(Box::from_raw(key));
+        }
+    }
+}
@@ -0,0 +1,965 @@
+// Copyright (c) 2025 Vivian Burkhard Voss
+// SPDX-License-Identifier: Apache-2.0
+
+//! Lazy documents decoded on demand
+//!
+//! `gbln_lazy_parse()` makes one structural pass over the input (bracket and
+//! parenthesis matching, see [`StructuralIndex`]) and decodes nothing. Nodes
+//! are materialised one container level at a time, the first time a field or
+//! element is looked up; the bytes of subtrees that are never touched are
+//! only ever seen by the index pass.
+//!
+//! Because the index pass does not decode, errors inside untouched subtrees
+//! (bad type hints, out-of-range values) are only reported if they are
+//! accessed.
+//!
+//! Numeric typed arrays (`<f32>[...]`) are decoded in one pass into a packed
+//! buffer of their element type instead of one node per element; element
+//! nodes are only created for the indices that are looked up, and
+//! `gbln_lazy_array_data()` hands out the buffer itself.
+
+use std::cell::{OnceCell, RefCell};
+use std::collections::hash_map::Entry;
+use std::collections::HashMap;
+use std::ffi::{c_void, CStr};
+use std::os::raw::c_char;
+use std::path::Path;
+use std::ptr;
+
+use crate::error::{set_last_error, set_parse_error, set_static_error, GblnErrorCode};
+use crate::io::path_to_str;
+use crate::mmap::Mapping;
+use crate::parser::{
+    infer_scalar, is_word_byte, typed_scalar, GblnParser, ParseError, Scalar, TypeHint,
+};
+use crate::scanner::StructuralIndex;
+use crate::simd::{self, NEWLINE};
+use crate::types::{GblnValue, GblnValueType};
+use gbln::Value;
+
+type Result<T> = std::result::Result<T, ParseError>;
+
+#[derive(Debug, Clone, Copy, PartialEq, Eq)]
+enum NodeKind {
+    Object,
+    /// Top-level `key(...)`: an object with a single field and no braces
+    Field,
+    Array,
+    Scalar,
+}
+
+enum Children {
+    Object(HashMap<String, Box<GblnLazyNode>>),
+    Array(Vec<Box<GblnLazyNode>>),
+    /// Numeric typed array, with the element nodes looked up so far
+    Packed(Packed, RefCell<HashMap<usize, Box<GblnLazyNode>>>),
+}
+
+/// Elements of a numeric typed array, stored contiguously
+enum Packed {
+    I8(Vec<i8>),
+    I16(Vec<i16>),
+    I32(Vec<i32>),
+    I64(Vec<i64>),
+    U8(Vec<u8>),
+    U16(Vec<u16>),
+    U32(Vec<u32>),
+    U64(Vec<u64>),
+    F32(Vec<f32>),
+    F64(Vec<f64>),
+}
+
+impl Packed {
+    /// Empty buffer for elements of `hint`, if it is numeric
+    fn new(hint: TypeHint) -> Option<Packed> {
+        Some(match hint {
+            TypeHint::I8 => Packed::I8(Vec::new()),
+            TypeHint::I16 => Packed::I16(Vec::new()),
+            TypeHint::I32 => Packed::I32(Vec::new()),
+            TypeHint::I64 => Packed::I64(Vec::new()),
+            TypeHint::U8 => Packed::U8(Vec::new()),
+            TypeHint::U16 => Packed::U16(Vec::new()),
+            TypeHint::U32 => Packed::U32(Vec::new()),
+            TypeHint::U64 => Packed::U64(Vec::new()),
+            TypeHint::F32 => Packed::F32(Vec::new()),
+            TypeHint::F64 => Packed::F64(Vec::new()),
+            TypeHint::Str(_) | TypeHint::Bool | TypeHint::Null => return None,
+        })
+    }
+
+    /// Append `scalar`; false if it is not of the element type
+    fn push(&mut self, scalar: Scalar<'_>) -> bool {
+        match (self, scalar) {
+            (Packed::I8(v), Scalar::I8(n)) => v.push(n),
+            (Packed::I16(v), Scalar::I16(n)) => v.push(n),
+            (Packed::I32(v), Scalar::I32(n)) => v.push(n),
+            (Packed::I64(v), Scalar::I64(n)) => v.push(n),
+            (Packed::U8(v), Scalar::U8(n)) => v.push(n),
+            (Packed::U16(v), Scalar::U16(n)) => v.push(n),
+            (Packed::U32(v), Scalar::U32(n)) => v.push(n),
+            (Packed::U64(v), Scalar::U64(n)) => v.push(n),
+            (Packed::F32(v), Scalar::F32(n)) => v.push(n),
+            (Packed::F64(v), Scalar::F64(n)) => v.push(n),
+            _ => return false,
+        }
+        true
+    }
+
+    fn len(&self) -> usize {
+        match self {
+            Packed::I8(v) => v.len(),
+            Packed::I16(v) => v.len(),
+            Packed::I32(v) => v.len(),
+            Packed::I64(v) => v.len(),
+            Packed::U8(v) => v.len(),
+            Packed::U16(v) => v.len(),
+            Packed::U32(v) => v.len(),
+            Packed::U64(v) => v.len(),
+            Packed::F32(v) => v.len(),
+            Packed::F64(v) => v.len(),
+        }
+    }
+
+    /// Element `i` as a value
+    fn value(&self, i: usize) -> Option<Value> {
+        Some(match self {
+            Packed::I8(v) => Value::I8(*v.get(i)?),
+            Packed::I16(v) => Value::I16(*v.get(i)?),
+            Packed::I32(v) => Value::I32(*v.get(i)?),
+            Packed::I64(v) => Value::I64(*v.get(i)?),
+            Packed::U8(v) => Value::U8(*v.get(i)?),
+            Packed::U16(v) => Value::U16(*v.get(i)?),
+            Packed::U32(v) => Value::U32(*v.get(i)?),
+            Packed::U64(v) => Value::U64(*v.get(i)?),
+            Packed::F32(v) => Value::F32(*v.get(i)?),
+            Packed::F64(v) => Value::F64(*v.get(i)?),
+        })
+    }
+
+    /// Element type and address of the first element
+    fn data(&self) -> (GblnValueType, *const c_void) {
+        match self {
+            Packed::I8(v) => (GblnValueType::I8, v.as_ptr().cast()),
+            Packed::I16(v) => (GblnValueType::I16, v.as_ptr().cast()),
+            Packed::I32(v) => (GblnValueType::I32, v.as_ptr().cast()),
+            Packed::I64(v) => (GblnValueType::I64, v.as_ptr().cast()),
+            Packed::U8(v) => (GblnValueType::U8, v.as_ptr().cast()),
+            Packed::U16(v) => (GblnValueType::U16, v.as_ptr().cast()),
+            Packed::U32(v) => (GblnValueType::U32, v.as_ptr().cast()),
+            Packed::U64(v) => (GblnValueType::U64, v.as_ptr().cast()),
+            Packed::F32(v) => (GblnValueType::F32, v.as_ptr().cast()),
+            Packed::F64(v) => (GblnValueType::F64, v.as_ptr().cast()),
+        }
+    }
+}
+
+/// Node of a lazy document
+///
+/// Owned by its document; pointers stay valid until `gbln_lazy_free()`.
+pub struct GblnLazyNode {
+    doc: *const GblnLazyDocument,
+    kind: NodeKind,
+    /// Start of the value text, including any type hint
+    start: usize,
+    /// Offset of the opening `{`, `[`, `(` or of the word
+    open: usize,
+    /// End of the value text (exclusive)
+    end: usize,
+    /// Hint of the enclosing typed array, for its elements
+    hint: Option<TypeHint>,
+    /// Element type hint, for typed arrays
+    element_hint: Option<TypeHint>,
+    children: OnceCell<Children>,
+    value: OnceCell<GblnValue>,
+}
+
+/// Lazily decoded document
+///
+/// Borrows its input buffer, or owns the file mapping it was opened from.
+/// Not thread-safe: a document and its nodes must only be used from one
+/// thread at a time.
+pub struct GblnLazyDocument {
+    input: *const u8,
+    len: usize,
+    /// Mapping `input` points into, for documents opened from a file
+    _mapping: Option<Mapping>,
+    index: StructuralIndex,
+    parser: RefCell<GblnParser>,
+    root: OnceCell<Box<GblnLazyNode>>,
+}
+
+impl GblnLazyDocument {
+    fn bytes(&self) -> &[u8] {
+        if self.len == 0 {
+            return &[];
+        }
+        unsafe { std::slice::from_raw_parts(self.input, self.len) }
+    }
+
+    fn error(code: GblnErrorCode, offset: usize, message: &'static str) -> ParseError {
+        ParseError {
+            code,
+            offset,
+            message,
+        }
+    }
+
+    /// Skip whitespace and `:|` comments
+    fn skip(&self, mut pos: usize) -> usize {
+        let bytes = self.bytes();
+        loop {
+            while pos < bytes.len() && bytes[pos].is_ascii_whitespace() {
+                pos += 1;
+            }
+            if !bytes[pos..].starts_with(b":|") {
+                return pos;
+            }
+            pos = simd::find(bytes, pos, &NEWLINE);
+        }
+    }
+
+    fn word_end(&self, mut pos: usize) -> usize {
+        let bytes = self.bytes();
+        while pos < bytes.len() && is_word_byte(bytes[pos]) {
+            pos += 1;
+        }
+        pos
+    }
+
+    fn close(&self, open: usize) -> usize {
+        self.index
+            .close(open)
+            .expect("structural index out of sync")
+    }
+
+    fn node(
+        &self,
+        kind: NodeKind,
+        start: usize,
+        open: usize,
+        end: usize,
+        hint: Option<TypeHint>,
+    ) -> Box<GblnLazyNode> {
+        Box::new(GblnLazyNode {
+            doc: self,
+            kind,
+            start,
+            open,
+            end,
+            hint,
+            element_hint: None,
+            children: OnceCell::new(),
+            value: OnceCell::new(),
+        })
+    }
+
+    /// Locate the value starting at or after `pos` without decoding it
+    ///
+    /// `hint` is the element hint of an enclosing typed array.
+    fn value_at(
+        &self,
+        pos: usize,
+        hint: Option<TypeHint>,
+        in_array: bool,
+    ) -> Result<Box<GblnLazyNode>> {
+        let bytes = self.bytes();
+        let start = self.skip(pos);
+        let mut open = start;
+        let mut element_hint = None;
+
+        if bytes.get(open) == Some(&b'<') && hint.is_none() {
+            let close = bytes[open..]
+                .iter()
+                .position(|&b| b == b'>')
+                .map(|k| open + k)
+                .ok_or(Self::error(
+                    GblnErrorCode::ErrorUnexpectedToken,
+                    open,
+                    "Expected type hint",
+                ))?;
+            let text = bytes[open + 1..close].trim_ascii();
+            element_hint = Some(TypeHint::from_bytes(text).ok_or(Self::error(
+                GblnErrorCode::ErrorInvalidTypeHint,
+                open + 1,
+                "Unknown type hint",
+            ))?);
+            open = self.skip(close + 1);
+        }
+
+        let (kind, end) = match bytes.get(open) {
+            Some(b'(') => (NodeKind::Scalar, self.close(open) + 1),
+            Some(b'[') => (NodeKind::Array, self.close(open) + 1),
+            Some(b'{') if element_hint.is_none() => (NodeKind::Object, self.close(open) + 1),
+            Some(&b) if in_array && element_hint.is_none() && is_word_byte(b) => {
+                (NodeKind::Scalar, self.word_end(open))
+            }
+            None => {
+                return Err(Self::error(
+                    GblnErrorCode::ErrorUnexpectedEof,
+                    open,
+                    "Unexpected end of input",
+                ))
+            }
+            Some(_) => {
+                return Err(Self::error(
+                    GblnErrorCode::ErrorUnexpectedToken,
+                    open,
+                    "Expected value",
+                ))
+            }
+        };
+
+        let mut node = self.node(kind, start, open, end, hint);
+        if kind == NodeKind::Array {
+            node.element_hint = element_hint;
+        }
+        Ok(node)
+    }
+
+    /// Locate the root value and check that nothing follows it
+    fn root_node(&self) -> Result<Box<GblnLazyNode>> {
+        let bytes = self.bytes();
+        let start = self.skip(0);
+
+        let root = match bytes.get(start) {
+            None => {
+                return Err(Self::error(
+                    GblnErrorCode::ErrorUnexpectedEof,
+                    start,
+                    "Empty input",
+                ))
+            }
+            Some(&b) if is_word_byte(b) => {
+                let value = self.value_at(self.word_end(start), None, false)?;
+                self.node(NodeKind::Field, start, start, value.end, None)
+            }
+            Some(_) => self.value_at(start, None, true)?,
+        };
+
+        let rest = self.skip(root.end);
+        if rest < bytes.len() {
+            return Err(Self::error(
+                GblnErrorCode::ErrorUnexpectedToken,
+                rest,
+                "Unexpected token after value",
+            ));
+        }
+        Ok(root)
+    }
+
+    /// Locate the fields of an object node
+    fn fields(&self, node: &GblnLazyNode) -> Result<HashMap<String, Box<GblnLazyNode>>> {
+        let bytes = self.bytes();
+        let (mut pos, end) = match node.kind {
+            NodeKind::Field => (node.start, node.end),
+            _ => (node.open + 1, node.end - 1),
+        };
+        let mut fields = HashMap::new();
+
+        loop {
+            pos = self.skip(pos);
+            if pos >= end {
+                return Ok(fields);
+            }
+            let key_end = self.word_end(pos);
+            if key_end == pos {
+                return Err(Self::error(
+                    GblnErrorCode::ErrorUnexpectedToken,
+                    pos,
+                    "Expected key in object field",
+                ));
+            }
+            // Input was validated as UTF-8 by gbln_lazy_parse()
+            let key = unsafe { std::str::from_utf8_unchecked(&bytes[pos..key_end]) };
+            let value = self.value_at(key_end, None, false)?;
+            pos = value.end;
+
+            match fields.entry(key.to_string()) {
+                Entry::Occupied(_) => {
+                    return Err(Self::error(
+                        GblnErrorCode::ErrorDuplicateKey,
+                        value.start,
+                        "Duplicate key",
+                    ))
+                }
+                Entry::Vacant(entry) => {
+                    entry.insert(value);
+                }
+            }
+        }
+    }
+
+    /// Locate the elements of an array node
+    fn elements(&self, node: &GblnLazyNode) -> Result<Vec<Box<GblnLazyNode>>> {
+        let end = node.end - 1;
+        let mut pos = node.open + 1;
+        let mut elements = Vec::new();
+
+        loop {
+            pos = self.skip(pos);
+            if pos >= end {
+                return Ok(elements);
+            }
+            let element = self.value_at(pos, node.element_hint, true)?;
+            pos = element.end;
+            elements.push(element);
+        }
+    }
+
+    /// Decode the elements of a numeric typed array into a packed buffer
+    ///
+    /// Returns `None` if the array is not numeric or any element is not a
+    /// plain value of its type; such arrays keep one node per element, so
+    /// that errors are still only reported for the elements accessed.
+    fn packed(&self, node: &GblnLazyNode) -> Option<Packed> {
+        let hint = node.element_hint?;
+        let mut packed = Packed::new(hint)?;
+        let bytes = self.bytes();
+        let end = node.end - 1;
+        let mut pos = node.open + 1;
+
+        loop {
+            pos = self.skip(pos);
+            if pos >= end {
+                return Some(packed);
+            }
+            let text = if bytes[pos] == b'(' {
+                let close = self.close(pos);
+                let content = &bytes[pos + 1..close];
+                pos = close + 1;
+                content
+            } else if is_word_byte(bytes[pos]) {
+                let word_end = self.word_end(pos);
+                let word = &bytes[pos..word_end];
+                pos = word_end;
+                word
+            } else {
+                return None;
+            };
+            if text.contains(&b'\\') {
+                return None;
+            }
+            // Input was validated as UTF-8 by gbln_lazy_parse()
+            let text = unsafe { std::str::from_utf8_unchecked(text) };
+            if !packed.push(typed_scalar(hint, text).ok()?) {
+                return None;
+            }
+        }
+    }
+
+    /// Decode a node's value with the native parser
+    fn decode(&self, node: &GblnLazyNode) -> Result<GblnValue> {
+        let text = &self.bytes()[node.start..node.end];
+        let mut parser = self.parser.borrow_mut();
+        let value = match (node.kind, node.hint) {
+            (NodeKind::Field, _) => parser.parse_value(text, true),
+            (_, Some(hint)) => parser.parse_typed_element_value(text, true, hint),
+            (_, None) => parser.parse_element_value(text, true),
+        };
+        value.map(GblnValue::new).map_err(|e| ParseError {
+            offset: node.start + e.offset,
+            ..e
+        })
+    }
+}
+
+impl GblnLazyNode {
+    fn doc(&self) -> &GblnLazyDocument {
+        unsafe { &*self.doc }
+    }
+
+    fn children(&self) -> Option<&Children> {
+        if let Some(children) = self.children.get() {
+            return Some(children);
+        }
+
+        let doc = self.doc();
+        let children = match self.kind {
+            NodeKind::Object | NodeKind::Field => doc.fields(self).map(Children::Object),
+            NodeKind::Array => match doc.packed(self) {
+                Some(packed) => Ok(Children::Packed(packed, RefCell::default())),
+                None => doc.elements(self).map(Children::Array),
+            },
+            NodeKind::Scalar => return None,
+        };
+
+        match children {
+            Ok(children) => Some(self.children.get_or_init(|| children)),
+            Err(e) => {
+                report(e, self.doc().bytes());
+                None
+            }
+        }
+    }
+
+    /// Node for element `i` of a packed array, created on first access
+    fn packed_element(
+        &self,
+        packed: &Packed,
+        nodes: &RefCell<HashMap<usize, Box<GblnLazyNode>>>,
+        i: usize,
+    ) -> *const GblnLazyNode {
+        let mut nodes = nodes.borrow_mut();
+        if let Some(node) = nodes.get(&i) {
+            return &**node;
+        }
+        let Some(value) = packed.value(i) else {
+            return ptr::null();
+        };
+
+        // Element nodes have no text of their own: the value is already decoded
+        let node = self.doc().node(
+            NodeKind::Scalar,
+            self.open,
+            self.open,
+            self.open,
+            self.element_hint,
+        );
+        let _ = node.value.set(GblnValue::new(value));
+        &**nodes.entry(i).or_insert(node)
+    }
+
+    /// Field `key` of an object node
+    pub(crate) fn field(&self, key: &str) -> Option<&GblnLazyNode> {
+        match self.children() {
+            Some(Children::Object(fields)) => fields.get(key).map(|child| &**child),
+            _ => None,
+        }
+    }
+
+    /// Fields of an object node, in key order
+    pub(crate) fn sorted_fields(&self) -> Vec<(&str, &GblnLazyNode)> {
+        let mut fields: Vec<_> = match self.children() {
+            Some(Children::Object(fields)) => fields
+                .iter()
+                .map(|(key, child)| (key.as_str(), &**child))
+                .collect(),
+            _ => Vec::new(),
+        };
+        fields.sort_unstable_by(|a, b| a.0.cmp(b.0));
+        fields
+    }
+
+    /// Number of elements of an array node (0 for anything else)
+    pub(crate) fn array_len(&self) -> usize {
+        match self.children() {
+            Some(Children::Array(elements)) => elements.len(),
+            Some(Children::Packed(packed, _)) => packed.len(),
+            _ => 0,
+        }
+    }
+
+    /// Element `index` of an array node
+    pub(crate) fn element(&self, index: usize) -> Option<&GblnLazyNode> {
+        match self.children() {
+            Some(Children::Array(elements)) => elements.get(index).map(|child| &**child),
+            Some(Children::Packed(packed, nodes)) => unsafe {
+                self.packed_element(packed, nodes, index).as_ref()
+            },
+            _ => None,
+        }
+    }
+
+    /// String content straight from the input, if the node is a string
+    ///
+    /// Returns `None` for content with escapes, which must be decoded, and for
+    /// anything that is not a valid string.
+    fn borrowed_str(&self) -> Option<&str> {
+        if self.kind != NodeKind::Scalar {
+            return None;
+        }
+
+        let bytes = self.doc().bytes();
+        let text = if bytes[self.open] == b'(' {
+            let content = &bytes[self.open + 1..self.end - 1];
+            if content.contains(&b'\\') {
+                return None;
+            }
+            content
+        } else {
+            &bytes[self.open..self.end]
+        };
+        // Input was validated as UTF-8 by gbln_lazy_parse()
+        let text = unsafe { std::str::from_utf8_unchecked(text) };
+
+        let hint = match self.hint {
+            Some(hint) => Some(hint),
+            None if self.open > self.start => {
+                let hint = &bytes[self.start + 1..self.open];
+                let close = hint.iter().position(|&b| b == b'>')?;
+                Some(TypeHint::from_bytes(hint[..close].trim_ascii())?)
+            }
+            None => None,
+        };
+        let scalar = match hint {
+            Some(hint) => typed_scalar(hint, text).ok()?,
+            None => infer_scalar(text),
+        };
+        match scalar {
+            Scalar::Str(s) => Some(s),
+            _ => None,
+        }
+    }
+
+    fn value(&self) -> Option<&GblnValue> {
+        if let Some(value) = self.value.get() {
+            return Some(value);
+        }
+
+        match self.doc().decode(self) {
+            Ok(value) => Some(self.value.get_or_init(|| value)),
+            Err(e) => {
+                report(e, self.doc().bytes());
+                None
+            }
+        }
+    }
+}
+
+fn report(e: ParseError, input: &[u8]) {
+    set_parse_error(e, Some(input));
+}
+
+/// Index a GBLN buffer for lazy access
+///
+/// Only bracket structure is checked here; values are decoded when accessed.
+///
+/// # Parameters
+/// - input: Pointer to the first byte of the GBLN text
+/// - len: Number of bytes
+/// - trusted: Skip UTF-8 validation (input MUST already be valid UTF-8)
+/// - out_doc: Pointer to store the document
+///
+/// # Returns
+/// - GBLN_OK on success, with `out_doc` set
+/// - Error code on failure, with details via `gbln_last_error_message()`
+///
+/// # Safety
+/// - `input` must point to at least `len` readable bytes that stay valid and
+///   unchanged until `gbln_lazy_free()`
+/// - Caller must free the document with `gbln_lazy_free()`
+#[no_mangle]
+pub extern "C" fn gbln_lazy_parse(
+    input: *const u8,
+    len: usize,
+    trusted: bool,
+    out_doc: *mut *mut GblnLazyDocument,
+) -> GblnErrorCode {
+    if input.is_null() || out_doc.is_null() {
+        set_static_error(GblnErrorCode::ErrorNullPointer, "Null pointer", None);
+        return GblnErrorCode::ErrorNullPointer;
+    }
+
+    open_document(input, len, trusted, None, out_doc)
+}
+
+/// Index `len` bytes at `input` into a new document stored in `out_doc`
+fn open_document(
+    input: *const u8,
+    len: usize,
+    trusted: bool,
+    mapping: Option<Mapping>,
+    out_doc: *mut *mut GblnLazyDocument,
+) -> GblnErrorCode {
+    let bytes = if len == 0 {
+        &[]
+    } else {
+        unsafe { std::slice::from_raw_parts(input, len) }
+    };
+    if !trusted {
+        if let Err(e) = std::str::from_utf8(bytes) {
+            set_last_error(format!("Invalid UTF-8: {}", e), None);
+            return GblnErrorCode::ErrorNullPointer;
+        }
+    }
+
+    let index = match StructuralIndex::build(bytes) {
+        Ok(index) => index,
+        Err(e) => {
+            report(e, bytes);
+            return e.code;
+        }
+    };
+
+    let doc = Box::new(GblnLazyDocument {
+        input,
+        len,
+        _mapping: mapping,
+        index,
+        parser: RefCell::new(GblnParser::new()),
+        root: OnceCell::new(),
+    });
+
+    match doc.root_node() {
+        Ok(root) => {
+            let _ = doc.root.set(root);
+            unsafe {
+                *out_doc = Box::into_raw(doc);
+            }
+            GblnErrorCode::Ok
+        }
+        Err(e) => {
+            report(e, doc.bytes());
+            e.code
+        }
+    }
+}
+
+/// Open a file as a lazy document over a read-only memory mapping
+///
+/// Like `gbln_lazy_parse()` over the whole file, but the document owns the
+/// mapping: nothing is copied up front, only the pages that are navigated
+/// are read, and `gbln_lazy_str()` returns strings pointing straight into
+/// the mapping. The file must hold uncompressed GBLN text.
+///
+/// # Parameters
+/// - path: File path (null-terminated string)
+/// - out_doc: Pointer to store the document
+///
+/// # Returns
+/// - GBLN_OK on success, with `out_doc` set
+/// - GBLN_ERROR_IO if the file cannot be opened or mapped
+/// - Error code on invalid content, with details via `gbln_last_error_message()`
+///
+/// # Safety
+/// - `path` must be a valid null-terminated UTF-8 string
+/// - The file must not be truncated or modified until `gbln_lazy_free()`
+/// - Caller must free the document with `gbln_lazy_free()`
+#[no_mangle]
+pub extern "C" fn gbln_lazy_open_mmap(
+    path: *const c_char,
+    out_doc: *mut *mut GblnLazyDocument,
+) -> GblnErrorCode {
+    if path.is_null() || out_doc.is_null() {
+        set_static_error(GblnErrorCode::ErrorNullPointer, "Null pointer", None);
+        return GblnErrorCode::ErrorNullPointer;
+    }
+
+    let path_str = match path_to_str(path) {
+        Ok(s) => s,
+        Err(code) => return code,
+    };
+
+    let mapping = match Mapping::open(Path::new(path_str)) {
+        Ok(mapping) => mapping,
+        Err(e) => {
+            set_last_error(format!("Failed to map {}: {}", path_str, e), None);
+            return GblnErrorCode::ErrorIo;
+        }
+    };
+
+    // The bytes stay put when the mapping moves into the document
+    let bytes = mapping.bytes();
+    let (input, len) = (bytes.as_ptr(), bytes.len());
+    open_document(input, len, false, Some(mapping), out_doc)
+}
+
+/// Get the root node of a lazy document
+///
+/// Returns NULL if `doc` is NULL.
+#[no_mangle]
+pub extern "C" fn gbln_lazy_root(doc: *const GblnLazyDocument) -> *const GblnLazyNode {
+    if doc.is_null() {
+        return ptr::null();
+    }
+
+    match unsafe { (*doc).root.get() } {
+        Some(root) => &**root,
+        None => ptr::null(),
+    }
+}
+
+/// Get the type of a lazy node
+///
+/// Objects and arrays are typed without decoding; scalars are decoded.
+/// Returns Null if `node` is NULL or its value fails to decode.
+#[no_mangle]
+pub extern "C" fn gbln_lazy_type(node: *const GblnLazyNode) -> GblnValueType {
+    if node.is_null() {
+        return GblnValueType::Null;
+    }
+
+    let node = unsafe { &*node };
+    match node.kind {
+        NodeKind::Object | NodeKind::Field => GblnValueType::Object,
+        NodeKind::Array => GblnValueType::Array,
+        NodeKind::Scalar => match node.value() {
+            Some(value) => GblnValueType::from(value.inner()),
+            None => GblnValueType::Null,
+        },
+    }
+}
+
+/// Get field from a lazy object node
+///
+/// Locates the object's fields on first access; field values themselves stay
+/// undecoded.
+///
+/// # Safety
+/// - `node` must be a valid GblnLazyNode pointer
+/// - `key` must be a valid null-terminated UTF-8 string
+/// - Returns NULL if node is not an object, key not found, or the object is
+///   malformed (details via `gbln_last_error_message()`)
+#[no_mangle]
+pub extern "C" fn gbln_lazy_object_get(
+    node: *const GblnLazyNode,
+    key: *const c_char,
+) -> *const GblnLazyNode {
+    if node.is_null() || key.is_null() {
+        return ptr::null();
+    }
+
+    let key_str = unsafe {
+        match CStr::from_ptr(key).to_str() {
+            Ok(s) => s,
+            Err(_) => return ptr::null(),
+        }
+    };
+
+    unsafe { (*node).field(key_str) }.map_or(ptr::null(), |child| child as *const GblnLazyNode)
+}
+
+/// Get the length of a lazy array node
+///
+/// Returns 0 if node is not an array.
+#[no_mangle]
+pub extern "C" fn gbln_lazy_array_len(node: *const GblnLazyNode) -> usize {
+    if node.is_null() {
+        return 0;
+    }
+
+    unsafe { (*node).array_len() }
+}
+
+/// Get element from a lazy array node
+///
+/// # Safety
+/// - `node` must be a valid GblnLazyNode pointer
+/// - Returns NULL if node is not an array or index out of bounds
+#[no_mangle]
+pub extern "C" fn gbln_lazy_array_get(
+    node: *const GblnLazyNode,
+    index: usize,
+) -> *const GblnLazyNode {
+    if node.is_null() {
+        return ptr::null();
+    }
+
+    unsafe { (*node).element(index) }.map_or(ptr::null(), |child| child as *const GblnLazyNode)
+}
+
+/// Get the packed elements of a numeric typed array node
+///
+/// Typed arrays with a numeric hint (`<f32>[...]`) whose elements are all
+/// plain values are stored as one contiguous buffer of the element type.
+/// This returns that buffer without copying, e.g. as `const float *` for
+/// `out_type` F32.
+///
+/// # Safety
+/// - `node` must be a valid GblnLazyNode pointer
+/// - `out_type` receives the element type (may be NULL)
+/// - `out_len` receives the number of elements (may be NULL)
+/// - Returns NULL if the node is not a packed array (use
+///   `gbln_lazy_array_get()` for those)
+/// - Returned pointer is valid until `gbln_lazy_free()`; must NOT be freed
+#[no_mangle]
+pub extern "C" fn gbln_lazy_array_data(
+    node: *const GblnLazyNode,
+    out_type: *mut GblnValueType,
+    out_len: *mut usize,
+) -> *const c_void {
+    let packed = if node.is_null() {
+        None
+    } else {
+        match unsafe { (*node).children() } {
+            Some(Children::Packed(packed, _)) => Some(packed),
+            _ => None,
+        }
+    };
+
+    unsafe {
+        if !out_type.is_null() {
+            *out_type = packed.map_or(GblnValueType::Null, |p| p.data().0);
+        }
+        if !out_len.is_null() {
+            *out_len = packed.map_or(0, Packed::len);
+        }
+    }
+    packed.map_or(ptr::null(), |p| p.data().1)
+}
+
+/// Decode a lazy node into a regular value
+///
+/// The decoded value is cached in the node, so repeated calls are free. Use
+/// it with every `gbln_value_*` accessor; for objects and arrays the whole
+/// subtree is decoded.
+///
+/// # Safety
+/// - `node` must be a valid GblnLazyNode pointer
+/// - Returns NULL if the value fails to decode (details via
+///   `gbln_last_error_message()`)
+/// - Returned pointer is owned by the document and valid until
+///   `gbln_lazy_free()`; must NOT be freed
+#[no_mangle]
+pub extern "C" fn gbln_lazy_value(node: *const GblnLazyNode) -> *const GblnValue {
+    if node.is_null() {
+        return ptr::null();
+    }
+
+    match unsafe { (*node).value() } {
+        Some(value) => value,
+        None => ptr::null(),
+    }
+}
+
+/// Get borrowed view of a lazy string node
+///
+/// Unescaped strings point straight into the document's input, without
+/// decoding the node; strings with escapes are decoded (and cached) first.
+///
+/// # Safety
+/// - `node` must be a valid GblnLazyNode pointer
+/// - `out_len` receives the length in bytes (may be NULL)
+/// - The returned bytes are UTF-8 and NOT null-terminated; use `out_len`
+/// - Returned pointer is valid until `gbln_lazy_free()`; must NOT be freed
+/// - Returns NULL if the node is not a string
+#[no_mangle]
+pub extern "C" fn gbln_lazy_str(
+    node: *const GblnLazyNode,
+    out_len: *mut usize,
+    ok: *mut bool,
+) -> *const c_char {
+    let view = if node.is_null() {
+        None
+    } else {
+        let node = unsafe { &*node };
+        node.borrowed_str().or_else(|| match node.value()?.inner() {
+            gbln::Value::Str(s) => Some(s.as_str()),
+            _ => None,
+        })
+    };
+
+    unsafe {
+        if !out_len.is_null() {
+            *out_len = view.map_or(0, str::len);
+        }
+        if !ok.is_null() {
+            *ok = view.is_some();
+        }
+    }
+    view.map_or(ptr::null(), |s| s.as_ptr() as *const c_char)
+}
+
+/// Free a lazy document and all of its nodes and decoded values
+///
+/// # Safety
+/// - `doc` must be a valid pointer from `gbln_lazy_parse()`, `gbln_lazy_open_mmap()` or NULL
+/// - Must not be called twice on the same pointer
+#[no_mangle]
+pub extern "C" fn gbln_lazy_free(doc: *mut GblnLazyDocument) {
+    if !doc.is_null() {
+        unsafe {
+            drop(Box::from_raw(doc));
+        }
+    }
+}
@@ -6,17 +6,61 @@ use std::ffi::{CStr, CString};
 use std::os::raw::c_char;
 use std::ptr;
 
+use crate::error::{set_core_error, set_parse_error, set_static_error};
+use crate::parser::ParseError;
+use crate::stats::{Op, Timer};
+
 mod accessors;
+mod arena;
+mod arrays;
+mod batch;
+mod binary;
+mod codec;
+mod compare;
 mod config;
+mod diff;
 mod error;
+mod events;
 mod extensions;
+mod hash;
+mod index;
 mod io;
+mod key;
+mod lazy;
+mod mmap;
+mod parallel;
+mod parser;
+mod path;
+mod scanner;
+mod schema;
+mod shared;
+mod simd;
+mod stats;
+mod stream;
 mod types;
+mod writer;
 
+pub use arena::GblnDocument;
+pub use batch::{GblnBatchOptions, GblnSlice};
+pub use codec::GblnCodec;
 pub use config::GblnConfig;
-pub use error::{get_last_error, set_last_error, GblnErrorCode};
-pub use io::{gbln_read_io, gbln_write_io};
+pub use error::{get_last_error, set_last_error, GblnErrorCode, GblnErrorInfo};
+pub use events::{GblnEventAction, GblnEventHandler, GblnScalar};
+pub use extensions::GblnObjectIter;
+pub use index::GblnObjectIndex;
+pub use io::{
+    gbln_read_io, gbln_read_io_mmap, gbln_read_io_parallel, gbln_read_io_stream, gbln_write_io,
+    gbln_write_io_stream,
+};
+pub use key::GblnKey;
+pub use lazy::{GblnLazyDocument, GblnLazyNode};
+pub use parser::GblnParser;
+pub use path::GblnPath;
+pub use schema::{GblnSchema, GblnSchemaField};
+pub use stats::{GblnOpStats, GblnStats, GBLN_STATS_BUCKETS};
+pub use stream::{GblnStream, GblnStreamCallback};
 pub use types::{GblnValue, GblnValueType};
+pub use writer::GblnWriteCallback;
 
 /// Parse GBLN string into a value
 ///
@@ -34,21 +78,93 @@ pub extern "C" fn gbln_parse(
     out_value: *mut *mut GblnValue,
 ) -> GblnErrorCode {
     if input.is_null() || out_value.is_null() {
-        set_last_error("Null pointer".to_string(), None);
+        set_static_error(GblnErrorCode::ErrorNullPointer, "Null pointer", None);
         return GblnErrorCode::ErrorNullPointer;
     }
 
-    let input_str = unsafe {
-        match CStr::from_ptr(input).to_str() {
-            Ok(s) => s,
-            Err(e) => {
-                set_last_error(format!("Invalid UTF-8: {}", e), None);
-                return GblnErrorCode::ErrorNullPointer;
-            }
-        }
+    let input = unsafe { CStr::from_ptr(input) }.to_bytes();
+    let input_str = match std::str::from_utf8(input) {
+        Ok(s) => s,
+        Err(e) => return utf8_error(e, input),
+    };
+
+    parse_into(input_str, out_value)
+}
+
+/// Parse a length-delimited GBLN buffer into a value
+///
+/// Unlike `gbln_parse()`, the input does not need to be null-terminated,
+/// so payloads can be parsed straight out of network buffers or mapped files.
+///
+/// # Parameters
+/// - input: Pointer to the first byte of the GBLN text
+/// - len: Number of bytes to parse
+/// - trusted: Skip UTF-8 validation (input MUST already be valid UTF-8)
+/// - out_value: Pointer to store the result
+///
+/// # Safety
+/// - `input` must point to at least `len` readable bytes
+/// - If `trusted` is true, the bytes must be valid UTF-8; otherwise behaviour is undefined
+/// - `out_value` must be a valid pointer to store the result
+/// - Caller must free the returned value with `gbln_value_free()`
+///
+/// # Returns
+/// - `GBLN_OK` on success, with `out_value` set to the parsed value
+/// - Error code on failure, with error details available via `gbln_last_error_message()`
+#[no_mangle]
+pub extern "C" fn gbln_parse_n(
+    input: *const u8,
+    len: usize,
+    trusted: bool,
+    out_value: *mut *mut GblnValue,
+) -> GblnErrorCode {
+    if input.is_null() || out_value.is_null() {
+        set_static_error(GblnErrorCode::ErrorNullPointer, "Null pointer", None);
+        return GblnErrorCode::ErrorNullPointer;
+    }
+
+    let input_str = match bytes_to_str(input, len, trusted) {
+        Ok(s) => s,
+        Err(code) => return code,
     };
 
-    match parse(input_str) {
+    parse_into(input_str, out_value)
+}
+
+/// View a length-delimited C buffer as UTF-8, validating unless `trusted`
+///
+/// `input` must be non-null and point to at least `len` readable bytes.
+pub(crate) fn bytes_to_str<'a>(
+    input: *const u8,
+    len: usize,
+    trusted: bool,
+) -> Result<&'a str, GblnErrorCode> {
+    let bytes = unsafe { std::slice::from_raw_parts(input, len) };
+
+    if trusted {
+        return Ok(unsafe { std::str::from_utf8_unchecked(bytes) });
+    }
+
+    std::str::from_utf8(bytes).map_err(|e| utf8_error(e, bytes))
+}
+
+/// Record invalid UTF-8 in `input` at the first bad byte
+fn utf8_error(e: std::str::Utf8Error, input: &[u8]) -> GblnErrorCode {
+    let code = GblnErrorCode::ErrorNullPointer;
+    set_parse_error(
+        ParseError::new(code, e.valid_up_to(), "Invalid UTF-8"),
+        Some(input),
+    );
+    code
+}
+
+/// Parse `input` and store the boxed result in `out_value`
+fn parse_into(input: &str, out_value: *mut *mut GblnValue) -> GblnErrorCode {
+    let timer = Timer::start(Op::Parse);
+    let result = parse(input);
+    timer.finish(input.len());
+
+    match result {
         Ok(value) => {
             let boxed = Box::new(GblnValue::new(value));
             unsafe {
@@ -56,11 +172,7 @@ pub extern "C" fn gbln_parse(
             }
             GblnErrorCode::Ok
         }
-        Err(e) => {
-            let suggestion = e.suggestion.clone();
-            set_last_error(e.to_string(), suggestion);
-            error::map_error_kind(&e.kind)
-        }
+        Err(e) => set_core_error(e),
     }
 }
 
@@ -90,17 +202,23 @@ pub extern "C" fn gbln_value_free(value: *mut GblnValue) {
 #[no_mangle]
 pub extern "C" fn gbln_to_string(value: *const GblnValue) -> *mut c_char {
     if value.is_null() {
-        set_last_error("Null pointer".to_string(), None);
+        set_static_error(GblnErrorCode::ErrorNullPointer, "Null pointer", None);
         return ptr::null_mut();
     }
 
+    let timer = Timer::start(Op::ToString);
     let value = unsafe { (*value).inner() };
     let result = to_string(value);
+    timer.finish(result.len());
 
     match CString::new(result) {
         Ok(s) => s.into_raw(),
         Err(_) => {
-            set_last_error("Failed to create C string".to_string(), None);
+            set_static_error(
+                GblnErrorCode::ErrorUnexpectedChar,
+                "Failed to create C string",
+                None,
+            );
             ptr::null_mut()
         }
     }
@@ -118,17 +236,23 @@ pub extern "C" fn gbln_to_string(value: *const GblnValue) -> *mut c_char {
 #[no_mangle]
 pub extern "C" fn gbln_to_string_pretty(value: *const GblnValue) -> *mut c_char {
     if value.is_null() {
-        set_last_error("Null pointer".to_string(), None);
+        set_static_error(GblnErrorCode::ErrorNullPointer, "Null pointer", None);
         return ptr::null_mut();
     }
 
+    let timer = Timer::start(Op::ToString);
     let value = unsafe { (*value).inner() };
     let result = to_string_pretty(value);
+    timer.finish(result.len());
 
     match CString::new(result) {
         Ok(s) => s.into_raw(),
         Err(_) => {
-            set_last_error("Failed to create C string".to_string(), None);
+            set_static_error(
+                GblnErrorCode::ErrorUnexpectedChar,
+                "Failed to create C string",
+                None,
+            );
             ptr::null_mut()
         }
     }
@@ -155,11 +279,8 @@ pub extern "C" fn gbln_string_free(s: *mut c_char) {
 /// Caller must free with `gbln_string_free()`.
 #[no_mangle]
 pub extern "C" fn gbln_last_error_message() -> *mut c_char {
-    match get_last_error() {
-        Some((msg, _)) => match CString::new(msg) {
-            Ok(s) => s.into_raw(),
-            Err(_) => ptr::null_mut(),
-        },
+    match error::last_error_c_message() {
+        Some(s) => s.into_raw(),
         None => ptr::null_mut(),
     }
 }
@@ -171,12 +292,9 @@ pub extern "C" fn gbln_last_error_message() -> *mut c_char {
 /// Caller must free with `gbln_string_free()`.
 #[no_mangle]
 pub extern "C" fn gbln_last_error_suggestion() -> *mut c_char {
-    match get_last_error() {
-        Some((_, Some(suggestion))) => match CString::new(suggestion) {
-            Ok(s) => s.into_raw(),
-            Err(_) => ptr::null_mut(),
-        },
-        _ => ptr::null_mut(),
+    match error::last_error_c_suggestion() {
+        Some(s) => s.into_raw(),
+        None => ptr::null_mut(),
     }
 }
 
@@ -0,0 +1,101 @@
+// Copyright (c) 2025 Vivian Burkhard Voss
+// SPDX-License-Identifier: Apache-2.0
+
+//! Read-only file mappings
+//!
+//! On unix a file is mapped with `mmap(PROT_READ, MAP_PRIVATE)`, so parsing
+//! reads straight from the page cache and every process mapping the same
+//! file shares its pages. Elsewhere the file is read into an owned buffer.
+//!
+//! The mapping reflects the file as it is on disk: a file that is truncated
+//! or rewritten while mapped may fault or change under the parser.
+
+use std::fs::File;
+use std::io;
+use std::path::Path;
+
+/// Read-only view of a whole file
+pub(crate) struct Mapping {
+    #[cfg(unix)]
+    ptr: *const u8,
+    #[cfg(unix)]
+    len: usize,
+    #[cfg(not(unix))]
+    data: Vec<u8>,
+}
+
+impl Mapping {
+    /// Map `path` read-only
+    #[cfg(unix)]
+    pub(crate) fn open(path: &Path) -> io::Result<Mapping> {
+        use std::os::unix::io::AsRawFd;
+
+        let file = File::open(path)?;
+        let len = usize::try_from(file.metadata()?.len())
+            .map_err(|_| io::Error::new(io::ErrorKind::InvalidData, "File too large to map"))?;
+
+        // Zero-length mappings are rejected by mmap
+        if len == 0 {
+            return Ok(Mapping {
+                ptr: std::ptr::null(),
+                len: 0,
+            });
+        }
+
+        let ptr = unsafe {
+            libc::mmap(
+                std::ptr::null_mut(),
+                len,
+                libc::PROT_READ,
+                libc::MAP_PRIVATE,
+                file.as_raw_fd(),
+                0,
+            )
+        };
+        if ptr == libc::MAP_FAILED {
+            return Err(io::Error::last_os_error());
+        }
+
+        // The mapping outlives the descriptor
+        Ok(Mapping {
+            ptr: ptr as *const u8,
+            len,
+        })
+    }
+
+    /// Read `path` into an owned buffer
+    #[cfg(not(unix))]
+    pub(crate) fn open(path: &Path) -> io::Result<Mapping> {
+        use std::io::Read;
+
+        let mut data = Vec::new();
+        File::open(path)?.read_to_end(&mut data)?;
+        Ok(Mapping { data })
+    }
+
+    /// Mapped bytes
+    #[cfg(unix)]
+    pub(crate) fn bytes(&self) -> &[u8] {
+        if self.len == 0 {
+            return &[];
+        }
+        unsafe { std::slice::from_raw_parts(self.ptr, self.len) }
+    }
+
+    /// Mapped bytes
+    #[cfg(not(unix))]
+    pub(crate) fn bytes(&self) -> &[u8] {
+        &self.data
+    }
+}
+
+#[cfg(unix)]
+impl Drop for Mapping {
+    fn drop(&mut self) {
+        if self.len != 0 {
+            unsafe {
+                libc::munmap(self.ptr as *mut libc::c_void, self.len);
+            }
+        }
+    }
+}
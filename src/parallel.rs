@@ -0,0 +1,155 @@
+// Copyright (c) 2025 Vivian Burkhard Voss
+// SPDX-License-Identifier: Apache-2.0
+
+//! Parallel parsing of one large root array
+//!
+//! Dumps are typically a single `[...]` holding many records. A structural
+//! pre-scan cuts the array into runs of whole elements at roughly equal byte
+//! strides; workers parse the runs independently and the results are joined
+//! in order into one `Value::Array`. Any other input, or one too small to be
+//! worth splitting, is parsed on the calling thread.
+
+use gbln::Value;
+
+use crate::batch::{for_each_parallel, worker_count};
+use crate::error::{set_parse_error, set_static_error, GblnErrorCode};
+use crate::parser::{GblnParser, ParseError};
+use crate::scanner::{is_comment, split_elements};
+use crate::simd::{self, NEWLINE};
+use crate::types::GblnValue;
+
+type Result<T> = std::result::Result<T, ParseError>;
+
+/// Bytes each worker should have before another worker is worth using
+const PARALLEL_MIN_BYTES: usize = 1 << 20;
+
+/// Runs per worker, so that workers finishing early can take another
+const RUNS_PER_THREAD: usize = 4;
+
+/// Offset of the first byte at or after `i` that is not whitespace or comment
+fn skip_blank(bytes: &[u8], mut i: usize) -> usize {
+    loop {
+        while i < bytes.len() && bytes[i].is_ascii_whitespace() {
+            i += 1;
+        }
+        if i < bytes.len() && is_comment(bytes, i) {
+            i = simd::find(bytes, i, &NEWLINE);
+            continue;
+        }
+        return i;
+    }
+}
+
+/// Parse `bytes` into a value, splitting a root array over `threads` threads
+///
+/// `threads` of 0 uses one thread per available CPU.
+pub(crate) fn parse_parallel(bytes: &[u8], trusted: bool, threads: usize) -> Result<Value> {
+    let threads = worker_count(threads, bytes.len(), PARALLEL_MIN_BYTES);
+    let open = skip_blank(bytes, 0);
+    if threads <= 1 || bytes.get(open) != Some(&b'[') {
+        return GblnParser::new().parse_value(bytes, trusted);
+    }
+
+    let stride = bytes.len() / (threads * RUNS_PER_THREAD);
+    let (starts, close) = split_elements(bytes, open, stride)?;
+    let tail = skip_blank(bytes, close + 1);
+    if tail < bytes.len() {
+        return Err(ParseError {
+            code: GblnErrorCode::ErrorUnexpectedToken,
+            offset: tail,
+            message: "Unexpected token after value",
+        });
+    }
+
+    let workers = for_each_parallel(
+        starts.len(),
+        threads,
+        || (GblnParser::new(), Vec::new()),
+        |(parser, runs), k| {
+            let start = starts[k];
+            let end = starts.get(k + 1).copied().unwrap_or(close);
+            let result = parser
+                .parse_elements_value(&bytes[start..end], trusted)
+                .map_err(|e| ParseError {
+                    offset: start + e.offset,
+                    ..e
+                });
+            runs.push((k, result));
+        },
+    );
+
+    let mut runs: Vec<_> = workers.into_iter().flat_map(|(_, runs)| runs).collect();
+    runs.sort_unstable_by_key(|(k, _)| *k);
+    let runs = runs
+        .into_iter()
+        .map(|(_, result)| result)
+        .collect::<Result<Vec<_>>>()?;
+
+    let total: usize = runs.iter().map(Vec::len).sum();
+    let mut runs = runs.into_iter();
+    let mut items = runs.next().unwrap_or_default();
+    items.reserve(total - items.len());
+    for run in runs {
+        items.extend(run);
+    }
+    Ok(Value::Array(items))
+}
+
+/// Store a parse result in `out_value`, or record its error in `input`
+pub(crate) fn store_result(
+    result: Result<Value>,
+    input: &[u8],
+    out_value: *mut *mut GblnValue,
+) -> GblnErrorCode {
+    match result {
+        Ok(value) => {
+            unsafe {
+                *out_value = Box::into_raw(Box::new(GblnValue::new(value)));
+            }
+            GblnErrorCode::Ok
+        }
+        Err(e) => {
+            set_parse_error(e, Some(input));
+            e.code
+        }
+    }
+}
+
+/// Parse a GBLN buffer, splitting a large root array across threads
+///
+/// When the input is a single top-level array, a fast structural pre-scan
+/// locates element boundaries and the elements are parsed in parallel.
+/// Parsing uses the native grammar, so the value is the one
+/// `gbln_parser_parse()` gives; see src/parser.rs for where that differs
+/// from `gbln_parse_n()`.
+///
+/// # Parameters
+/// - input: Pointer to the first byte of the GBLN text
+/// - len: Number of bytes to parse
+/// - trusted: Skip UTF-8 validation (input MUST already be valid UTF-8)
+/// - threads: Worker threads to use (0 = one per available CPU)
+/// - out_value: Pointer to store the result
+///
+/// # Returns
+/// - GBLN_OK on success, with `out_value` set to the parsed value
+/// - Error code on failure, with error details available via `gbln_last_error_message()`
+///
+/// # Safety
+/// - `input` must point to at least `len` readable bytes
+/// - Caller must free the returned value with `gbln_value_free()`
+#[no_mangle]
+pub extern "C" fn gbln_parse_parallel(
+    input: *const u8,
+    len: usize,
+    trusted: bool,
+    threads: usize,
+    out_value: *mut *mut GblnValue,
+) -> GblnErrorCode {
+    if input.is_null() || out_value.is_null() {
+        set_static_error(GblnErrorCode::ErrorNullPointer, "Null pointer", None);
+        return GblnErrorCode::ErrorNullPointer;
+    }
+
+    let bytes = unsafe { std::slice::from_raw_parts(input, len) };
+    store_result(parse_parallel(bytes, trusted, threads), bytes, out_value)
+}
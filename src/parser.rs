@@ -0,0 +1,1081 @@
+// Copyright (c) 2025 Vivian Burkhard Voss
+// SPDX-License-Identifier: Apache-2.0
+
+//! Native GBLN parser with reusable scratch state
+//!
+//! `gbln::parse` starts from scratch on every call. This module implements
+//! the same grammar directly over bytes so that a long-lived `GblnParser`
+//! can keep its scratch buffers (and buffers recycled from earlier values)
+//! between messages.
+//!
+//! The grammar walker reports what it sees to a [`Handler`]; building a
+//! `Value` tree is one handler ([`TreeBuilder`]).
+//!
+//! Every native entry point (parser contexts, streams, events, lazy, batch,
+//! parallel, mmap and schema decoding) uses this grammar, while
+//! `gbln_parse()`, `gbln_parse_n()` and `gbln_read_io()` use `gbln::parse`.
+//! tests/test_differential.c checks that both give equal values and error
+//! codes over a shared corpus. Where they differ:
+//!
+//! - Error messages are static and offsets are byte offsets, not the core's
+//!   formatted messages
+//! - Nesting deeper than [`MAX_DEPTH`] is `ErrorInvalidSyntax`
+
+use std::cell::RefCell;
+use std::collections::hash_map::Entry;
+use std::collections::HashMap;
+use std::os::raw::c_char;
+use std::ptr;
+
+use crate::error::{set_static_error, GblnErrorCode, GblnErrorInfo, PositionedError};
+use crate::scanner::is_comment;
+use crate::simd::{self, CONTENT_STOP, NEWLINE, STRUCTURAL};
+use crate::types::GblnValue;
+use gbln::Value;
+
+/// Maximum nesting depth accepted from untrusted input
+pub(crate) const MAX_DEPTH: usize = 512;
+
+/// Upper bound on pooled buffers kept per kind
+const POOL_LIMIT: usize = 4096;
+
+/// Pooled strings larger than this are returned to the allocator
+const POOL_STRING_CAPACITY: usize = 4096;
+
+// ============================================================================
+// Errors
+// ============================================================================
+
+/// Parse failure with its byte offset in the input
+#[derive(Debug, Clone, Copy)]
+pub(crate) struct ParseError {
+    pub code: GblnErrorCode,
+    pub offset: usize,
+    pub message: &'static str,
+}
+
+impl ParseError {
+    pub(crate) fn new(code: GblnErrorCode, offset: usize, message: &'static str) -> Self {
+        ParseError {
+            code,
+            offset,
+            message,
+        }
+    }
+}
+
+type Result<T> = std::result::Result<T, ParseError>;
+
+// ============================================================================
+// Type Hints and Scalars
+// ============================================================================
+
+/// Parsed `<...>` type hint
+#[derive(Debug, Clone, Copy, PartialEq, Eq)]
+pub(crate) enum TypeHint {
+    I8,
+    I16,
+    I32,
+    I64,
+    U8,
+    U16,
+    U32,
+    U64,
+    F32,
+    F64,
+    Str(usize),
+    Bool,
+    Null,
+}
+
+impl TypeHint {
+    pub(crate) fn from_bytes(hint: &[u8]) -> Option<TypeHint> {
+        Some(match hint {
+            b"i8" => TypeHint::I8,
+            b"i16" => TypeHint::I16,
+            b"i32" => TypeHint::I32,
+            b"i64" => TypeHint::I64,
+            b"u8" => TypeHint::U8,
+            b"u16" => TypeHint::U16,
+            b"u32" => TypeHint::U32,
+            b"u64" => TypeHint::U64,
+            b"f32" => TypeHint::F32,
+            b"f64" => TypeHint::F64,
+            b"b" => TypeHint::Bool,
+            b"n" => TypeHint::Null,
+            [b's', digits @ ..] if !digits.is_empty() => {
+                let max = std::str::from_utf8(digits).ok()?.parse().ok()?;
+                TypeHint::Str(max)
+            }
+            _ => return None,
+        })
+    }
+}
+
+/// Scalar value as reported to a handler
+///
+/// Strings borrow from the input (or the parser's unescape buffer) and are
+/// only valid for the duration of the handler call.
+#[derive(Debug, Clone, Copy, PartialEq)]
+pub(crate) enum Scalar<'s> {
+    I8(i8),
+    I16(i16),
+    I32(i32),
+    I64(i64),
+    U8(u8),
+    U16(u16),
+    U32(u32),
+    U64(u64),
+    F32(f32),
+    F64(f64),
+    Str(&'s str),
+    Bool(bool),
+    Null,
+}
+
+/// Convert `text` according to an explicit type hint
+pub(crate) fn typed_scalar(
+    hint: TypeHint,
+    text: &str,
+) -> std::result::Result<Scalar<'_>, ParseError> {
+    let mismatch = || {
+        ParseError::new(
+            GblnErrorCode::ErrorTypeMismatch,
+            0,
+            "Value does not match type hint",
+        )
+    };
+    let t = text.trim();
+
+    Ok(match hint {
+        TypeHint::I8 => Scalar::I8(t.parse().map_err(|_| mismatch())?),
+        TypeHint::I16 => Scalar::I16(t.parse().map_err(|_| mismatch())?),
+        TypeHint::I32 => Scalar::I32(t.parse().map_err(|_| mismatch())?),
+        TypeHint::I64 => Scalar::I64(t.parse().map_err(|_| mismatch())?),
+        TypeHint::U8 => Scalar::U8(t.parse().map_err(|_| mismatch())?),
+        TypeHint::U16 => Scalar::U16(t.parse().map_err(|_| mismatch())?),
+        TypeHint::U32 => Scalar::U32(t.parse().map_err(|_| mismatch())?),
+        TypeHint::U64 => Scalar::U64(t.parse().map_err(|_| mismatch())?),
+        TypeHint::F32 => Scalar::F32(t.parse().map_err(|_| mismatch())?),
+        TypeHint::F64 => Scalar::F64(t.parse().map_err(|_| mismatch())?),
+        TypeHint::Bool => match t {
+            "t" | "true" => Scalar::Bool(true),
+            "f" | "false" => Scalar::Bool(false),
+            _ => return Err(mismatch()),
+        },
+        TypeHint::Null => match t {
+            "" | "null" => Scalar::Null,
+            _ => return Err(mismatch()),
+        },
+        TypeHint::Str(max) => {
+            // Fast path: byte length bounds character count
+            if text.len() > max && text.chars().count() > max {
+                return Err(ParseError::new(
+                    GblnErrorCode::ErrorStringTooLong,
+                    0,
+                    "String exceeds type hint length",
+                ));
+            }
+            Scalar::Str(text)
+        }
+    })
+}
+
+/// Infer the type of untyped content
+///
+/// Follows `gbln::parse`: `true`/`false`, then `i64`, then `f64` for numbers
+/// written with a decimal point; anything else (including empty content) is
+/// a string.
+pub(crate) fn infer_scalar(text: &str) -> Scalar<'_> {
+    match text {
+        "true" => return Scalar::Bool(true),
+        "false" => return Scalar::Bool(false),
+        _ => {}
+    }
+
+    if let Ok(n) = text.parse::<i64>() {
+        return Scalar::I64(n);
+    }
+    if text.contains('.') {
+        if let Ok(f) = text.parse::<f64>() {
+            return Scalar::F64(f);
+        }
+    }
+
+    Scalar::Str(text)
+}
+
+// ============================================================================
+// Handler
+// ============================================================================
+
+/// What the walker does after `begin_object`, `begin_array` or `key`
+#[derive(Debug, Clone, Copy, PartialEq, Eq)]
+pub(crate) enum Flow {
+    Continue,
+    /// Skip the container (or the field's value) without reporting it
+    Skip,
+}
+
+/// Receives the structure of a document as it is parsed
+pub(crate) trait Handler {
+    fn begin_object(&mut self, offset: usize) -> Result<Flow>;
+    fn key(&mut self, key: &str, offset: usize) -> Result<Flow>;
+    fn end_object(&mut self, offset: usize) -> Result<()>;
+    fn begin_array(&mut self, offset: usize) -> Result<Flow>;
+    fn end_array(&mut self, offset: usize) -> Result<()>;
+    fn scalar(&mut self, value: Scalar<'_>, offset: usize) -> Result<()>;
+}
+
+// ============================================================================
+// Grammar
+// ============================================================================
+
+#[inline]
+fn is_delimiter(b: u8) -> bool {
+    matches!(b, b'{' | b'}' | b'[' | b']' | b'(' | b')' | b'<' | b'>')
+}
+
+#[inline]
+pub(crate) fn is_word_byte(b: u8) -> bool {
+    !is_delimiter(b) && !b.is_ascii_whitespace()
+}
+
+/// Grammar walker over one input buffer
+pub(crate) struct Parser<'a, 's> {
+    input: &'a [u8],
+    pos: usize,
+    trusted: bool,
+    text: &'s mut String,
+}
+
+impl<'a, 's> Parser<'a, 's> {
+    /// Create a parser; `text` is scratch space for unescaping content
+    pub(crate) fn new(input: &'a [u8], trusted: bool, text: &'s mut String) -> Self {
+        Parser {
+            input,
+            pos: 0,
+            trusted,
+            text,
+        }
+    }
+
+    fn error(&self, code: GblnErrorCode, message: &'static str) -> ParseError {
+        ParseError::new(code, self.pos, message)
+    }
+
+    fn utf8<'x>(&self, bytes: &'x [u8], offset: usize) -> Result<&'x str> {
+        if self.trusted {
+            return Ok(unsafe { std::str::from_utf8_unchecked(bytes) });
+        }
+        std::str::from_utf8(bytes).map_err(|_| {
+            ParseError::new(GblnErrorCode::ErrorUnexpectedChar, offset, "Invalid UTF-8")
+        })
+    }
+
+    /// Skip whitespace and `:|` line comments, returning the next byte
+    fn peek(&mut self) -> Option<u8> {
+        loop {
+            while self.pos < self.input.len() && self.input[self.pos].is_ascii_whitespace() {
+                self.pos += 1;
+            }
+            if self.input[self.pos..].starts_with(b":|") {
+                self.pos = simd::find(self.input, self.pos, &NEWLINE);
+                continue;
+            }
+            return self.input.get(self.pos).copied();
+        }
+    }
+
+    fn word(&mut self) -> &'a [u8] {
+        let start = self.pos;
+        while self.pos < self.input.len() && is_word_byte(self.input[self.pos]) {
+            self.pos += 1;
+        }
+        &self.input[start..self.pos]
+    }
+
+    /// Find the end of `(...)` content and move past it
+    ///
+    /// The current byte must be '('. Returns the content's byte range and
+    /// whether it contains escapes.
+    fn content_span(&mut self) -> Result<(usize, usize, bool)> {
+        let start = self.pos + 1;
+        let mut i = start;
+        let mut escaped = false;
+
+        loop {
+            i = simd::find(self.input, i, &CONTENT_STOP);
+            match self.input.get(i) {
+                Some(b')') | None => break,
+                // A backslash needs the byte it escapes
+                Some(_) if i + 1 < self.input.len() => {
+                    escaped = true;
+                    i += 2;
+                }
+                Some(_) => {
+                    i = self.input.len();
+                    break;
+                }
+            }
+        }
+
+        if i >= self.input.len() {
+            self.pos = self.input.len();
+            return Err(self.error(
+                GblnErrorCode::ErrorUnexpectedEof,
+                "Unexpected end of input while reading parenthesized content",
+            ));
+        }
+        self.pos = i + 1;
+        Ok((start, i, escaped))
+    }
+
+    /// Read `(...)` content; the current byte must be '('
+    fn content(&mut self) -> Result<&str> {
+        let (start, i, escaped) = self.content_span()?;
+
+        if !escaped {
+            return self.utf8(&self.input[start..i], start);
+        }
+
+        // Backslash escapes: `\x` stands for `x`
+        let raw = self.utf8(&self.input[start..i], start)?;
+        self.text.clear();
+        let mut chars = raw.chars();
+        while let Some(c) = chars.next() {
+            if c == '\\' {
+                if let Some(next) = chars.next() {
+                    self.text.push(next);
+                }
+            } else {
+                self.text.push(c);
+            }
+        }
+        Ok(self.text.as_str())
+    }
+
+    fn type_hint(&mut self) -> Result<TypeHint> {
+        self.pos += 1;
+        self.peek();
+        let start = self.pos;
+        let hint = self.word();
+
+        if self.peek() != Some(b'>') {
+            return Err(self.error(GblnErrorCode::ErrorUnexpectedToken, "Expected type hint"));
+        }
+        self.pos += 1;
+
+        TypeHint::from_bytes(hint).ok_or(ParseError::new(
+            GblnErrorCode::ErrorInvalidTypeHint,
+            start,
+            "Unknown type hint",
+        ))
+    }
+
+    /// Parse a complete document
+    pub(crate) fn parse_document<H: Handler>(&mut self, handler: &mut H) -> Result<()> {
+        match self.peek() {
+            None => {
+                return Err(self.error(GblnErrorCode::ErrorUnexpectedEof, "Empty input"));
+            }
+            Some(b) if is_word_byte(b) => {
+                // Top-level `key(...)` is an object with a single field
+                let offset = self.pos;
+                if handler.begin_object(offset)? == Flow::Skip {
+                    self.word();
+                    self.skip_value()?;
+                } else {
+                    self.field(handler, 1)?;
+                    handler.end_object(self.pos)?;
+                }
+            }
+            Some(_) => self.element(handler, 1)?,
+        }
+
+        self.end()
+    }
+
+    /// Parse a buffer holding exactly one array element
+    pub(crate) fn parse_element<H: Handler>(&mut self, handler: &mut H) -> Result<()> {
+        self.element(handler, 1)?;
+        self.end()
+    }
+
+    /// Parse a buffer holding a run of root array elements as one array
+    pub(crate) fn parse_elements<H: Handler>(&mut self, handler: &mut H) -> Result<()> {
+        handler.begin_array(self.pos)?;
+        while self.peek().is_some() {
+            self.element(handler, 2)?;
+        }
+        handler.end_array(self.pos)
+    }
+
+    fn end(&mut self) -> Result<()> {
+        if self.peek().is_some() {
+            return Err(self.error(
+                GblnErrorCode::ErrorUnexpectedToken,
+                "Unexpected token after value",
+            ));
+        }
+        Ok(())
+    }
+
+    /// Parse one array element (or top-level value)
+    pub(crate) fn element<H: Handler>(&mut self, handler: &mut H, depth: usize) -> Result<()> {
+        let offset = self.pos;
+        match self.peek() {
+            Some(b'{') => self.object(handler, depth),
+            Some(b'[') => self.array(handler, None, depth),
+            Some(b'<') => self.hinted(handler, depth),
+            Some(b'(') => {
+                let text = self.content()?;
+                handler.scalar(infer_scalar(text), offset)
+            }
+            Some(b) if is_word_byte(b) => {
+                let word = self.word();
+                let text = self.utf8(word, offset)?;
+                handler.scalar(infer_scalar(text), offset)
+            }
+            Some(_) => Err(self.error(
+                GblnErrorCode::ErrorUnexpectedToken,
+                "Expected value in array",
+            )),
+            None => Err(self.error(GblnErrorCode::ErrorUnexpectedEof, "Unexpected end of input")),
+        }
+    }
+
+    fn hinted<H: Handler>(&mut self, handler: &mut H, depth: usize) -> Result<()> {
+        let hint = self.type_hint()?;
+        match self.peek() {
+            Some(b'(') => {
+                let offset = self.pos;
+                let text = self.content()?;
+                let value = typed_scalar(hint, text).map_err(|e| ParseError { offset, ..e })?;
+                handler.scalar(value, offset)
+            }
+            Some(b'[') => self.array(handler, Some(hint), depth),
+            _ => Err(self.error(
+                GblnErrorCode::ErrorUnexpectedToken,
+                "Expected '(' or '[' after type hint",
+            )),
+        }
+    }
+
+    fn field<H: Handler>(&mut self, handler: &mut H, depth: usize) -> Result<()> {
+        let offset = self.pos;
+        let key = self.word();
+        if key.is_empty() {
+            return Err(self.error(
+                GblnErrorCode::ErrorUnexpectedToken,
+                "Expected key in object field",
+            ));
+        }
+        let key = self.utf8(key, offset)?;
+        if handler.key(key, offset)? == Flow::Skip {
+            return self.skip_value();
+        }
+
+        match self.peek() {
+            Some(b'(') => {
+                let offset = self.pos;
+                let text = self.content()?;
+                handler.scalar(infer_scalar(text), offset)
+            }
+            Some(b'<') => self.hinted(handler, depth),
+            Some(b'{') => self.object(handler, depth),
+            Some(b'[') => self.array(handler, None, depth),
+            None => Err(self.error(GblnErrorCode::ErrorUnexpectedEof, "Unexpected end of input")),
+            Some(_) => Err(self.error(
+                GblnErrorCode::ErrorUnexpectedToken,
+                "Expected '(', '<', '{', or '[' after key",
+            )),
+        }
+    }
+
+    fn object<H: Handler>(&mut self, handler: &mut H, depth: usize) -> Result<()> {
+        if depth > MAX_DEPTH {
+            return Err(self.error(GblnErrorCode::ErrorInvalidSyntax, "Nesting too deep"));
+        }
+        if handler.begin_object(self.pos)? == Flow::Skip {
+            return self.skip_container();
+        }
+        self.pos += 1;
+
+        loop {
+            match self.peek() {
+                Some(b'}') => {
+                    handler.end_object(self.pos)?;
+                    self.pos += 1;
+                    return Ok(());
+                }
+                None => {
+                    return Err(self.error(
+                        GblnErrorCode::ErrorUnexpectedEof,
+                        "Unexpected end of input in object",
+                    ))
+                }
+                Some(_) => self.field(handler, depth + 1)?,
+            }
+        }
+    }
+
+    fn array<H: Handler>(
+        &mut self,
+        handler: &mut H,
+        hint: Option<TypeHint>,
+        depth: usize,
+    ) -> Result<()> {
+        if depth > MAX_DEPTH {
+            return Err(self.error(GblnErrorCode::ErrorInvalidSyntax, "Nesting too deep"));
+        }
+        if handler.begin_array(self.pos)? == Flow::Skip {
+            return self.skip_container();
+        }
+        self.pos += 1;
+
+        loop {
+            match (self.peek(), hint) {
+                (Some(b']'), _) => {
+                    handler.end_array(self.pos)?;
+                    self.pos += 1;
+                    return Ok(());
+                }
+                (None, _) => {
+                    return Err(self.error(
+                        GblnErrorCode::ErrorUnexpectedEof,
+                        "Unexpected end of input in array",
+                    ))
+                }
+                (Some(_), None) => self.element(handler, depth + 1)?,
+                (Some(_), Some(hint)) => self.typed_element(handler, hint)?,
+            }
+        }
+    }
+
+    /// Parse one element of a typed array; the next byte must start it
+    fn typed_element<H: Handler>(&mut self, handler: &mut H, hint: TypeHint) -> Result<()> {
+        let offset = self.pos;
+        let text = match self.input.get(self.pos) {
+            Some(b'(') => self.content()?,
+            Some(&b) if is_word_byte(b) => {
+                let word = self.word();
+                self.utf8(word, offset)?
+            }
+            _ => {
+                return Err(self.error(
+                    GblnErrorCode::ErrorUnexpectedToken,
+                    "Expected value in typed array",
+                ))
+            }
+        };
+        let value = typed_scalar(hint, text).map_err(|e| ParseError { offset, ..e })?;
+        handler.scalar(value, offset)
+    }
+
+    /// Parse a buffer holding exactly one element of a typed array
+    pub(crate) fn parse_typed_element<H: Handler>(
+        &mut self,
+        handler: &mut H,
+        hint: TypeHint,
+    ) -> Result<()> {
+        if self.peek().is_none() {
+            return Err(self.error(GblnErrorCode::ErrorUnexpectedEof, "Unexpected end of input"));
+        }
+        self.typed_element(handler, hint)?;
+        self.end()
+    }
+
+    /// Skip a field value: `(...)`, `<hint>(...)`, `<hint>[...]`, `{...}` or `[...]`
+    fn skip_value(&mut self) -> Result<()> {
+        if self.peek() == Some(b'<') {
+            self.type_hint()?;
+        }
+        match self.peek() {
+            Some(b'(') => self.content_span().map(|_| ()),
+            Some(b'{') | Some(b'[') => self.skip_container(),
+            None => Err(self.error(GblnErrorCode::ErrorUnexpectedEof, "Unexpected end of input")),
+            Some(_) => Err(self.error(
+                GblnErrorCode::ErrorUnexpectedToken,
+                "Expected '(', '<', '{', or '[' after key",
+            )),
+        }
+    }
+
+    /// Skip a container by bracket matching, without decoding its contents
+    ///
+    /// The current byte must be '{' or '['.
+    fn skip_container(&mut self) -> Result<()> {
+        let mut depth = 0usize;
+
+        loop {
+            self.pos = simd::find(self.input, self.pos, &STRUCTURAL);
+            match self.input.get(self.pos) {
+                None => break,
+                Some(b'{') | Some(b'[') => depth += 1,
+                Some(b'}') | Some(b']') => {
+                    depth -= 1;
+                    if depth == 0 {
+                        self.pos += 1;
+                        return Ok(());
+                    }
+                }
+                Some(b'(') => {
+                    self.content_span()?;
+                    continue;
+                }
+                Some(b':') if is_comment(self.input, self.pos) => {
+                    self.pos = simd::find(self.input, self.pos, &NEWLINE);
+                    continue;
+                }
+                Some(_) => {}
+            }
+            self.pos += 1;
+        }
+
+        Err(self.error(
+            GblnErrorCode::ErrorUnexpectedEof,
+            "Unexpected end of input in skipped value",
+        ))
+    }
+}
+
+// ============================================================================
+// Tree Builder
+// ============================================================================
+
+/// Buffers recycled from previously parsed values
+#[derive(Default)]
+pub(crate) struct Pools {
+    strings: Vec<String>,
+    arrays: Vec<Vec<Value>>,
+    objects: Vec<HashMap<String, Value>>,
+}
+
+impl Pools {
+    fn string(&mut self, s: &str) -> String {
+        match self.strings.pop() {
+            Some(mut buf) => {
+                buf.push_str(s);
+                buf
+            }
+            None => s.to_string(),
+        }
+    }
+
+    /// Take a value tree apart, keeping its buffers for reuse
+    pub(crate) fn recycle(&mut self, value: Value) {
+        match value {
+            Value::Str(s) => self.recycle_string(s),
+            Value::Array(mut items) => {
+                for item in items.drain(..) {
+                    self.recycle(item);
+                }
+                if self.arrays.len() < POOL_LIMIT {
+                    self.arrays.push(items);
+                }
+            }
+            Value::Object(mut map) => {
+                for (key, item) in map.drain() {
+                    self.recycle_string(key);
+                    self.recycle(item);
+                }
+                if self.objects.len() < POOL_LIMIT {
+                    self.objects.push(map);
+                }
+            }
+            _ => {}
+        }
+    }
+
+    fn recycle_string(&mut self, mut s: String) {
+        if self.strings.len() < POOL_LIMIT && s.capacity() <= POOL_STRING_CAPACITY {
+            s.clear();
+            self.strings.push(s);
+        }
+    }
+}
+
+/// Container under construction
+pub(crate) enum Frame {
+    Object(HashMap<String, Value>, Option<String>),
+    Array(Vec<Value>),
+}
+
+/// Handler that builds a `Value` tree from pooled buffers
+pub(crate) struct TreeBuilder<'p> {
+    pools: &'p mut Pools,
+    stack: Vec<Frame>,
+    root: Option<Value>,
+}
+
+impl<'p> TreeBuilder<'p> {
+    pub(crate) fn new(pools: &'p mut Pools, stack: Vec<Frame>) -> Self {
+        TreeBuilder {
+            pools,
+            stack,
+            root: None,
+        }
+    }
+
+    /// Finish building, returning the root and the (empty) frame stack for reuse
+    pub(crate) fn finish(mut self) -> (Option<Value>, Vec<Frame>) {
+        // Recycle partially built containers left behind by an error
+        while let Some(frame) = self.stack.pop() {
+            match frame {
+                Frame::Object(map, key) => {
+                    if let Some(key) = key {
+                        self.pools.recycle_string(key);
+                    }
+                    self.pools.recycle(Value::Object(map));
+                }
+                Frame::Array(items) => self.pools.recycle(Value::Array(items)),
+            }
+        }
+        (self.root.take(), self.stack)
+    }
+
+    fn push(&mut self, value: Value, offset: usize) -> Result<()> {
+        match self.stack.last_mut() {
+            None => {
+                self.root = Some(value);
+                Ok(())
+            }
+            Some(Frame::Array(items)) => {
+                items.push(value);
+                Ok(())
+            }
+            Some(Frame::Object(map, key)) => {
+                let key = key.take().expect("object value without key");
+                // One hash per field: entry() both checks and inserts
+                match map.entry(key) {
+                    Entry::Occupied(_) => {
+                        self.pools.recycle(value);
+                        Err(ParseError::new(
+                            GblnErrorCode::ErrorDuplicateKey,
+                            offset,
+                            "Duplicate key",
+                        ))
+                    }
+                    Entry::Vacant(entry) => {
+                        entry.insert(value);
+                        Ok(())
+                    }
+                }
+            }
+        }
+    }
+}
+
+impl Handler for TreeBuilder<'_> {
+    fn begin_object(&mut self, _offset: usize) -> Result<Flow> {
+        let map = self.pools.objects.pop().unwrap_or_default();
+        self.stack.push(Frame::Object(map, None));
+        Ok(Flow::Continue)
+    }
+
+    fn key(&mut self, key: &str, _offset: usize) -> Result<Flow> {
+        let key = self.pools.string(key);
+        if let Some(Frame::Object(_, pending)) = self.stack.last_mut() {
+            *pending = Some(key);
+        }
+        Ok(Flow::Continue)
+    }
+
+    fn end_object(&mut self, offset: usize) -> Result<()> {
+        match self.stack.pop() {
+            Some(Frame::Object(map, _)) => self.push(Value::Object(map), offset),
+            _ => unreachable!("unbalanced object"),
+        }
+    }
+
+    fn begin_array(&mut self, _offset: usize) -> Result<Flow> {
+        let items = self.pools.arrays.pop().unwrap_or_default();
+        self.stack.push(Frame::Array(items));
+        Ok(Flow::Continue)
+    }
+
+    fn end_array(&mut self, offset: usize) -> Result<()> {
+        match self.stack.pop() {
+            Some(Frame::Array(items)) => self.push(Value::Array(items), offset),
+            _ => unreachable!("unbalanced array"),
+        }
+    }
+
+    fn scalar(&mut self, value: Scalar<'_>, offset: usize) -> Result<()> {
+        let value = match value {
+            Scalar::I8(n) => Value::I8(n),
+            Scalar::I16(n) => Value::I16(n),
+            Scalar::I32(n) => Value::I32(n),
+            Scalar::I64(n) => Value::I64(n),
+            Scalar::U8(n) => Value::U8(n),
+            Scalar::U16(n) => Value::U16(n),
+            Scalar::U32(n) => Value::U32(n),
+            Scalar::U64(n) => Value::U64(n),
+            Scalar::F32(n) => Value::F32(n),
+            Scalar::F64(n) => Value::F64(n),
+            Scalar::Str(s) => Value::Str(self.pools.string(s)),
+            Scalar::Bool(b) => Value::Bool(b),
+            Scalar::Null => Value::Null,
+        };
+        self.push(value, offset)
+    }
+}
+
+// ============================================================================
+// Reusable Parser Context
+// ============================================================================
+
+/// Reusable parser context
+///
+/// Owns scratch buffers, a pool of buffers recycled from earlier values and
+/// its own error state. A worker that parses similar messages and hands
+/// finished values back with `gbln_parser_recycle()` stops allocating once
+/// the pools are warm.
+pub struct GblnParser {
+    text: String,
+    stack: Vec<Frame>,
+    pools: Pools,
+    /// Error of the last parse, if it failed
+    error: Option<PositionedError>,
+    /// `error` formatted on request, null-terminated
+    error_message: RefCell<String>,
+}
+
+impl GblnParser {
+    pub(crate) fn new() -> Self {
+        GblnParser {
+            text: String::new(),
+            stack: Vec::new(),
+            pools: Pools::default(),
+            error: None,
+            error_message: RefCell::new(String::new()),
+        }
+    }
+
+    /// Parse `input` into a value tree built from pooled buffers
+    pub(crate) fn parse_value(&mut self, input: &[u8], trusted: bool) -> Result<Value> {
+        self.build(input, trusted, |p, b| p.parse_document(b))
+    }
+
+    /// Parse a buffer holding one array element into a value tree
+    pub(crate) fn parse_element_value(&mut self, input: &[u8], trusted: bool) -> Result<Value> {
+        self.build(input, trusted, |p, b| p.parse_element(b))
+    }
+
+    /// Parse a buffer holding a run of root array elements
+    pub(crate) fn parse_elements_value(
+        &mut self,
+        input: &[u8],
+        trusted: bool,
+    ) -> Result<Vec<Value>> {
+        match self.build(input, trusted, |p, b| p.parse_elements(b))? {
+            Value::Array(items) => Ok(items),
+            _ => unreachable!("element run without array"),
+        }
+    }
+
+    /// Parse a buffer holding one element of a typed array
+    pub(crate) fn parse_typed_element_value(
+        &mut self,
+        input: &[u8],
+        trusted: bool,
+        hint: TypeHint,
+    ) -> Result<Value> {
+        self.build(input, trusted, |p, b| p.parse_typed_element(b, hint))
+    }
+
+    fn build(
+        &mut self,
+        input: &[u8],
+        trusted: bool,
+        walk: impl FnOnce(&mut Parser<'_, '_>, &mut TreeBuilder<'_>) -> Result<()>,
+    ) -> Result<Value> {
+        let stack = std::mem::take(&mut self.stack);
+        let mut builder = TreeBuilder::new(&mut self.pools, stack);
+        let result = walk(
+            &mut Parser::new(input, trusted, &mut self.text),
+            &mut builder,
+        );
+        let (root, stack) = builder.finish();
+        self.stack = stack;
+
+        match result {
+            Ok(()) => Ok(root.expect("document without root")),
+            Err(e) => {
+                if let Some(root) = root {
+                    self.pools.recycle(root);
+                }
+                Err(e)
+            }
+        }
+    }
+
+    /// Record an error of parsing `input`; the message is formatted on request
+    pub(crate) fn set_error(&mut self, e: ParseError, input: &[u8]) {
+        self.error = Some(PositionedError::new(e, Some(input)));
+    }
+
+    pub(crate) fn recycle(&mut self, value: Value) {
+        self.pools.recycle(value);
+    }
+}
+
+/// Create a reusable parser context
+///
+/// # Safety
+/// Caller must free with `gbln_parser_free()`
+#[no_mangle]
+pub extern "C" fn gbln_parser_new() -> *mut GblnParser {
+    Box::into_raw(Box::new(GblnParser::new()))
+}
+
+/// Parse a GBLN buffer with a reusable parser context
+///
+/// Errors are recorded in the parser (see `gbln_parser_last_error()`), not in
+/// the thread-local error state, so rejected messages cost no allocation.
+///
+/// # Parameters
+/// - parser: Parser from `gbln_parser_new()`
+/// - input: Pointer to the first byte of the GBLN text
+/// - len: Number of bytes to parse
+/// - trusted: Skip UTF-8 validation (input MUST already be valid UTF-8)
+/// - out_value: Pointer to store the result
+///
+/// # Returns
+/// - GBLN_OK on success, with `out_value` set to the parsed value
+/// - Error code on failure
+///
+/// # Safety
+/// - `input` must point to at least `len` readable bytes
+/// - Caller must free the returned value with `gbln_value_free()` or hand it
+///   back with `gbln_parser_recycle()`
+/// - A parser must not be used from two threads at the same time
+#[no_mangle]
+pub extern "C" fn gbln_parser_parse(
+    parser: *mut GblnParser,
+    input: *const u8,
+    len: usize,
+    trusted: bool,
+    out_value: *mut *mut GblnValue,
+) -> GblnErrorCode {
+    if parser.is_null() || input.is_null() || out_value.is_null() {
+        set_static_error(GblnErrorCode::ErrorNullPointer, "Null pointer", None);
+        return GblnErrorCode::ErrorNullPointer;
+    }
+
+    let parser = unsafe { &mut *parser };
+    let bytes = unsafe { std::slice::from_raw_parts(input, len) };
+
+    match parser.parse_value(bytes, trusted) {
+        Ok(value) => {
+            parser.error = None;
+            unsafe {
+                *out_value = Box::into_raw(Box::new(GblnValue::new(value)));
+            }
+            GblnErrorCode::Ok
+        }
+        Err(e) => {
+            parser.set_error(e, bytes);
+            e.code
+        }
+    }
+}
+
+/// Hand a value back to the parser for buffer reuse
+///
+/// Takes ownership of `value` (like `gbln_value_free()`), keeping its strings,
+/// arrays and objects for later `gbln_parser_parse()` calls.
+///
+/// # Safety
+/// - `value` must be a root value owned by the caller (not a child pointer)
+/// - Must not be used after this call
+#[no_mangle]
+pub extern "C" fn gbln_parser_recycle(parser: *mut GblnParser, value: *mut GblnValue) {
+    if parser.is_null() || value.is_null() {
+        return;
+    }
+
+    let value = unsafe { Box::from_raw(value) }.into_inner();
+    unsafe {
+        (*parser).recycle(value);
+    }
+}
+
+/// Get the last error message of a parser
+///
+/// Returns NULL if the last parse succeeded.
+/// The returned string is owned by the parser and valid until its next use.
+/// Must NOT be freed with `gbln_string_free()`.
+#[no_mangle]
+pub extern "C" fn gbln_parser_last_error(parser: *const GblnParser) -> *const c_char {
+    if parser.is_null() {
+        return ptr::null();
+    }
+
+    let parser = unsafe { &*parser };
+    let Some(error) = parser.error else {
+        return ptr::null();
+    };
+    let mut message = parser.error_message.borrow_mut();
+    message.clear();
+    error.write_message(&mut *message);
+    message.push('\0');
+    message.as_ptr() as *const c_char
+}
+
+/// Get the byte offset of a parser's last error
+///
+/// Returns 0 if the last parse succeeded.
+#[no_mangle]
+pub extern "C" fn gbln_parser_last_error_offset(parser: *const GblnParser) -> usize {
+    if parser.is_null() {
+        return 0;
+    }
+
+    let parser = unsafe { &*parser };
+    parser.error.map_or(0, |error| error.info().offset)
+}
+
+/// Get structured info about a parser's last error, without allocating
+///
+/// # Returns
+/// - true with `out` filled if the last parse failed
+/// - false if it succeeded
+///
+/// # Safety
+/// - `parser` must be a valid pointer from `gbln_parser_new()`
+/// - `out` must be a valid pointer
+#[no_mangle]
+pub extern "C" fn gbln_parser_last_error_info(
+    parser: *const GblnParser,
+    out: *mut GblnErrorInfo,
+) -> bool {
+    if parser.is_null() || out.is_null() {
+        return false;
+    }
+
+    match unsafe { (*parser).error } {
+        Some(error) => {
+            unsafe {
+                *out = error.info();
+            }
+            true
+        }
+        None => false,
+    }
+}
+
+/// Free a parser context and its pooled buffers
+///
+/// # Safety
+/// - `parser` must be a valid pointer from `gbln_parser_new()` or NULL
+/// - Must not be called twice on the same pointer
+#[no_mangle]
+pub extern "C" fn gbln_parser_free(parser: *mut GblnParser) {
+    if !parser.is_null() {
+        unsafe {
+            drop(Box::from_raw(parser));
+        }
+    }
+}
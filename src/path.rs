@@ -0,0 +1,360 @@
+// Copyright (c) 2025 Vivian Burkhard Voss
+// SPDX-License-Identifier: Apache-2.0
+
+//! Precompiled path queries
+//!
+//! A path such as `orders[*].items[0].sku` is parsed once into a `GblnPath`
+//! and then resolved against any number of values in a single call, instead
+//! of one `gbln_object_get()` or `gbln_array_get()` crossing per level.
+//!
+//! Syntax:
+//! - `key` or `.key`: field of an object
+//! - `*` or `.*`: every field of an object, in key order
+//! - `[N]`: element N of an array
+//! - `[*]`: every element of an array
+//!
+//! The empty path matches the value itself. Against a lazy document the
+//! same path only materialises the nodes it passes through.
+
+use std::ffi::CStr;
+use std::os::raw::c_char;
+use std::ptr;
+
+use gbln::Value;
+
+use crate::error::{set_parse_error, set_static_error, GblnErrorCode};
+use crate::lazy::GblnLazyNode;
+use crate::parser::{is_word_byte, ParseError};
+use crate::types::GblnValue;
+
+/// One step of a path
+#[derive(Debug)]
+enum Step {
+    Field(Box<str>),
+    AnyField,
+    Element(usize),
+    AnyElement,
+}
+
+/// Compiled path query
+///
+/// Create with `gbln_path_compile()` and reuse for any number of lookups.
+pub struct GblnPath {
+    steps: Vec<Step>,
+}
+
+fn invalid(offset: usize, message: &'static str) -> ParseError {
+    ParseError {
+        code: GblnErrorCode::ErrorInvalidSyntax,
+        offset,
+        message,
+    }
+}
+
+fn is_key_byte(b: u8) -> bool {
+    is_word_byte(b) && b != b'.'
+}
+
+/// Parse `expr` into steps
+fn compile(expr: &[u8]) -> Result<Vec<Step>, ParseError> {
+    let mut steps = Vec::new();
+    let mut pos = 0;
+
+    while pos < expr.len() {
+        match expr[pos] {
+            b'[' => {
+                let start = pos + 1;
+                let end = start
+                    + expr[start..]
+                        .iter()
+                        .position(|&b| b == b']')
+                        .ok_or(invalid(pos, "Expected ']'"))?;
+                let inner = &expr[start..end];
+                let step = if inner == b"*" {
+                    Step::AnyElement
+                } else if !inner.is_empty() && inner.iter().all(u8::is_ascii_digit) {
+                    let index = std::str::from_utf8(inner)
+                        .ok()
+                        .and_then(|s| s.parse().ok())
+                        .ok_or(invalid(start, "Index out of range"))?;
+                    Step::Element(index)
+                } else {
+                    return Err(invalid(start, "Expected index or '*'"));
+                };
+                steps.push(step);
+                pos = end + 1;
+            }
+            b => {
+                // A key follows '.', which may be left out at the start
+                let start = match b {
+                    b'.' => pos + 1,
+                    _ if pos == 0 => pos,
+                    _ => return Err(invalid(pos, "Expected '.' or '['")),
+                };
+                let len = expr[start..]
+                    .iter()
+                    .position(|&b| !is_key_byte(b))
+                    .unwrap_or(expr.len() - start);
+                let key = &expr[start..start + len];
+                let step = match key {
+                    b"" => return Err(invalid(start, "Expected key")),
+                    b"*" => Step::AnyField,
+                    _ => Step::Field(
+                        std::str::from_utf8(key)
+                            .map_err(|_| invalid(start, "Invalid UTF-8 in key"))?
+                            .into(),
+                    ),
+                };
+                steps.push(step);
+                pos = start + len;
+            }
+        }
+    }
+    Ok(steps)
+}
+
+/// Tree a path can walk
+trait Node: Copy {
+    /// C handle type of a node
+    type Handle;
+
+    fn handle(self) -> *const Self::Handle;
+    fn field(self, key: &str) -> Option<Self>;
+    fn sorted_fields(self) -> Vec<Self>;
+    fn len(self) -> usize;
+    fn element(self, index: usize) -> Option<Self>;
+}
+
+impl<'v> Node for &'v Value {
+    type Handle = GblnValue;
+
+    fn handle(self) -> *const GblnValue {
+        self as *const Value as *const GblnValue
+    }
+
+    fn field(self, key: &str) -> Option<&'v Value> {
+        match self {
+            Value::Object(map) => map.get(key),
+            _ => None,
+        }
+    }
+
+    fn sorted_fields(self) -> Vec<&'v Value> {
+        let Value::Object(map) = self else {
+            return Vec::new();
+        };
+        let mut fields: Vec<_> = map.iter().collect();
+        fields.sort_unstable_by(|a, b| a.0.cmp(b.0));
+        fields.into_iter().map(|(_, value)| value).collect()
+    }
+
+    fn len(self) -> usize {
+        match self {
+            Value::Array(items) => items.len(),
+            _ => 0,
+        }
+    }
+
+    fn element(self, index: usize) -> Option<&'v Value> {
+        match self {
+            Value::Array(items) => items.get(index),
+            _ => None,
+        }
+    }
+}
+
+impl<'d> Node for &'d GblnLazyNode {
+    type Handle = GblnLazyNode;
+
+    fn handle(self) -> *const GblnLazyNode {
+        self
+    }
+
+    fn field(self, key: &str) -> Option<&'d GblnLazyNode> {
+        GblnLazyNode::field(self, key)
+    }
+
+    fn sorted_fields(self) -> Vec<&'d GblnLazyNode> {
+        GblnLazyNode::sorted_fields(self)
+            .into_iter()
+            .map(|(_, node)| node)
+            .collect()
+    }
+
+    fn len(self) -> usize {
+        self.array_len()
+    }
+
+    fn element(self, index: usize) -> Option<&'d GblnLazyNode> {
+        GblnLazyNode::element(self, index)
+    }
+}
+
+/// Call `found` for every match of `steps` below `node` until it returns false
+fn walk<N: Node>(node: N, steps: &[Step], found: &mut impl FnMut(N) -> bool) -> bool {
+    let Some((step, rest)) = steps.split_first() else {
+        return found(node);
+    };
+
+    match step {
+        Step::Field(key) => node.field(key).is_none_or(|child| walk(child, rest, found)),
+        Step::Element(index) => node
+            .element(*index)
+            .is_none_or(|child| walk(child, rest, found)),
+        Step::AnyField => node
+            .sorted_fields()
+            .into_iter()
+            .all(|child| walk(child, rest, found)),
+        Step::AnyElement => (0..node.len())
+            .filter_map(|i| node.element(i))
+            .all(|child| walk(child, rest, found)),
+    }
+}
+
+/// Store matches in `out[..cap]`, returning the total number of matches
+fn collect<N: Node>(root: N, path: &GblnPath, out: *mut *const N::Handle, cap: usize) -> usize {
+    let mut count = 0;
+    walk(root, &path.steps, &mut |node: N| {
+        if count < cap {
+            unsafe {
+                *out.add(count) = node.handle();
+            }
+        }
+        count += 1;
+        true
+    });
+    count
+}
+
+/// Compile a path query
+///
+/// # Returns
+/// - GblnPath pointer on success
+/// - NULL if `expr` is NULL or not a valid path; the position of the error
+///   is available from `gbln_last_error_info()`
+///
+/// # Safety
+/// - `expr` must be a valid null-terminated UTF-8 string
+/// - Caller must free with `gbln_path_free()`
+#[no_mangle]
+pub extern "C" fn gbln_path_compile(expr: *const c_char) -> *mut GblnPath {
+    if expr.is_null() {
+        set_static_error(
+            GblnErrorCode::ErrorNullPointer,
+            "Null pointer for path",
+            None,
+        );
+        return ptr::null_mut();
+    }
+
+    let expr = unsafe { CStr::from_ptr(expr) }.to_bytes();
+    match compile(expr) {
+        Ok(steps) => Box::into_raw(Box::new(GblnPath { steps })),
+        Err(e) => {
+            set_parse_error(e, Some(expr));
+            ptr::null_mut()
+        }
+    }
+}
+
+/// Resolve a path against a value
+///
+/// Stores up to `cap` matches in `out`, in document order (object
+/// wildcards in key order). Call with `cap` 0 to count the matches.
+///
+/// # Parameters
+/// - value: Value to search
+/// - path: Compiled path
+/// - out: Receives pointers to the matching values (may be NULL if `cap` is 0)
+/// - cap: Capacity of `out`
+///
+/// # Returns
+/// - The total number of matches, which may exceed `cap`
+/// - 0 if value or path is NULL
+///
+/// # Safety
+/// - `value` must be a valid GblnValue pointer
+/// - `path` must be a valid pointer from `gbln_path_compile()`
+/// - `out` must point to at least `cap` writable pointers
+/// - Returned pointers are valid as long as `value` is valid
+#[no_mangle]
+pub extern "C" fn gbln_path_eval(
+    value: *const GblnValue,
+    path: *const GblnPath,
+    out: *mut *const GblnValue,
+    cap: usize,
+) -> usize {
+    if value.is_null() || path.is_null() || (out.is_null() && cap != 0) {
+        return 0;
+    }
+
+    collect(unsafe { (*value).inner() }, unsafe { &*path }, out, cap)
+}
+
+/// Get the first match of a path
+///
+/// Stops at the first match, so `orders[*].id` does not visit every order.
+///
+/// # Safety
+/// - `value` must be a valid GblnValue pointer
+/// - `path` must be a valid pointer from `gbln_path_compile()`
+/// - Returns NULL if nothing matches
+/// - Returned pointer is valid as long as `value` is valid
+#[no_mangle]
+pub extern "C" fn gbln_path_get(
+    value: *const GblnValue,
+    path: *const GblnPath,
+) -> *const GblnValue {
+    if value.is_null() || path.is_null() {
+        return ptr::null();
+    }
+
+    let mut first = ptr::null();
+    walk(
+        unsafe { (*value).inner() },
+        unsafe { &(*path).steps },
+        &mut |v| {
+            first = Node::handle(v);
+            false
+        },
+    );
+    first
+}
+
+/// Resolve a path against a lazy node
+///
+/// As `gbln_path_eval()`, but only the nodes along the matching paths are
+/// scanned; other subtrees of the document are never materialised.
+///
+/// # Safety
+/// - `node` must be a valid GblnLazyNode pointer
+/// - `path` must be a valid pointer from `gbln_path_compile()`
+/// - `out` must point to at least `cap` writable pointers
+/// - Returned pointers are valid as long as the document is valid
+#[no_mangle]
+pub extern "C" fn gbln_path_eval_lazy(
+    node: *const GblnLazyNode,
+    path: *const GblnPath,
+    out: *mut *const GblnLazyNode,
+    cap: usize,
+) -> usize {
+    if node.is_null() || path.is_null() || (out.is_null() && cap != 0) {
+        return 0;
+    }
+
+    collect(unsafe { &*node }, unsafe { &*path }, out, cap)
+}
+
+/// Free a compiled path
+///
+/// # Safety
+/// - `path` must be a valid pointer from `gbln_path_compile()` or NULL
+/// - Must not be called twice on the same pointer
+#[no_mangle]
+pub extern "C" fn gbln_path_free(path: *mut GblnPath) {
+    if !path.is_null() {
+        unsafe {
+            drop(Box::from_raw(path));
+        }
+    }
+}
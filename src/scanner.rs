@@ -0,0 +1,433 @@
+// Copyright (c) 2025 Vivian Burkhard Voss
+// SPDX-License-Identifier: Apache-2.0
+
+//! Structural boundary scanner
+//!
+//! Finds where top-level records end without parsing them. The scanner only
+//! tracks nesting depth and whether it is inside `(...)` content, a `<...>`
+//! type hint, a word or a `:|` comment, so it can be fed a buffer in pieces
+//! and resumed exactly where it stopped.
+//!
+//! An input whose first token is `[` is treated as an array of records and
+//! reported element by element. Any other input is a sequence of top-level
+//! values.
+//!
+//! [`StructuralIndex`] is the whole-buffer counterpart: one pass that records
+//! where every bracket and parenthesis closes, for lazy navigation.
+//! [`split_elements`] cuts a root array into runs for parallel parsing.
+
+use crate::error::GblnErrorCode;
+use crate::parser::{is_word_byte, ParseError};
+use crate::simd::{self, CONTENT_STOP, NEWLINE, STRUCTURAL};
+
+type Result<T> = std::result::Result<T, ParseError>;
+
+/// Structural event reported by [`Scanner::next`]
+#[derive(Debug, Clone, Copy, PartialEq, Eq)]
+pub(crate) enum Event {
+    /// Root array opened; its first element starts at this offset
+    Open(usize),
+    /// A record ends at this offset (exclusive)
+    Record(usize),
+    /// Root array closed by the `]` at this offset
+    Close(usize),
+}
+
+#[derive(Debug, Clone, Copy, PartialEq, Eq)]
+enum State {
+    Token,
+    Colon,
+    Word,
+    Hint,
+    Content,
+    Escape,
+    Comment,
+}
+
+#[derive(Debug, Clone, Copy, PartialEq, Eq)]
+enum Mode {
+    /// No significant byte seen yet
+    Undecided,
+    /// Sequence of top-level values
+    Sequence,
+    /// Elements of a root array
+    Elements,
+    /// Root array closed
+    Done,
+}
+
+/// Resumable record boundary scanner
+pub(crate) struct Scanner {
+    depth: usize,
+    state: State,
+    mode: Mode,
+    /// Significant bytes seen since the last record boundary
+    pending: bool,
+}
+
+impl Scanner {
+    pub(crate) fn new() -> Self {
+        Scanner {
+            depth: 0,
+            state: State::Token,
+            mode: Mode::Undecided,
+            pending: false,
+        }
+    }
+
+    /// True if records are elements of a root array
+    pub(crate) fn elements(&self) -> bool {
+        self.mode == Mode::Elements
+    }
+
+    /// True if the input seen so far ends on a record boundary
+    pub(crate) fn is_idle(&self) -> bool {
+        let between = matches!(self.state, State::Token | State::Comment);
+        match self.mode {
+            Mode::Undecided | Mode::Done => between,
+            Mode::Sequence => between && !self.pending && self.depth == 0,
+            Mode::Elements => false,
+        }
+    }
+
+    fn base(&self) -> usize {
+        if self.mode == Mode::Elements {
+            1
+        } else {
+            0
+        }
+    }
+
+    fn record(&mut self, end: usize) -> Result<Option<Event>> {
+        self.pending = false;
+        Ok(Some(Event::Record(end)))
+    }
+
+    /// Scan `bytes` from `*pos` up to and including the next event
+    ///
+    /// Returns `None` once `bytes` is exhausted; scanning continues from the
+    /// same state when more bytes are appended.
+    pub(crate) fn next(&mut self, bytes: &[u8], pos: &mut usize) -> Result<Option<Event>> {
+        while *pos < bytes.len() {
+            let i = *pos;
+            let b = bytes[i];
+
+            match self.state {
+                State::Content => {
+                    if b != b')' && b != b'\\' {
+                        *pos = simd::find(bytes, i, &CONTENT_STOP);
+                        continue;
+                    }
+                    *pos += 1;
+                    match b {
+                        b'\\' => self.state = State::Escape,
+                        b')' => {
+                            self.state = State::Token;
+                            if self.depth == self.base() {
+                                return self.record(i + 1);
+                            }
+                        }
+                        _ => {}
+                    }
+                    continue;
+                }
+                State::Escape => {
+                    *pos += 1;
+                    self.state = State::Content;
+                    continue;
+                }
+                State::Comment => {
+                    if b != b'\n' {
+                        *pos = simd::find(bytes, i, &NEWLINE);
+                        continue;
+                    }
+                    *pos += 1;
+                    self.state = State::Token;
+                    continue;
+                }
+                State::Hint => {
+                    *pos += 1;
+                    if b == b'>' {
+                        self.state = State::Token;
+                    }
+                    continue;
+                }
+                State::Colon => {
+                    if b == b'|' {
+                        *pos += 1;
+                        self.state = State::Comment;
+                        continue;
+                    }
+                    // A lone ':' starts a word
+                    if self.mode == Mode::Done {
+                        return Err(self.unexpected(i - 1));
+                    }
+                    self.settle();
+                    self.pending = true;
+                    self.state = State::Word;
+                    continue;
+                }
+                State::Word => {
+                    if is_word_byte(b) {
+                        *pos += 1;
+                        continue;
+                    }
+                    self.state = State::Token;
+                    if self.mode == Mode::Elements && self.depth == 1 {
+                        return self.record(i);
+                    }
+                    continue;
+                }
+                State::Token => {}
+            }
+
+            if b.is_ascii_whitespace() {
+                *pos += 1;
+                continue;
+            }
+            if b == b':' {
+                *pos += 1;
+                self.state = State::Colon;
+                continue;
+            }
+            if self.mode == Mode::Done {
+                return Err(self.unexpected(i));
+            }
+            if self.mode == Mode::Undecided && b == b'[' {
+                *pos += 1;
+                self.mode = Mode::Elements;
+                self.depth = 1;
+                return Ok(Some(Event::Open(i + 1)));
+            }
+            self.settle();
+
+            *pos += 1;
+            self.pending = true;
+            match b {
+                b'(' => self.state = State::Content,
+                b'<' => self.state = State::Hint,
+                b'{' | b'[' => self.depth += 1,
+                b'}' | b']' => {
+                    if self.depth == self.base() {
+                        if self.mode == Mode::Elements && b == b']' {
+                            self.depth = 0;
+                            self.mode = Mode::Done;
+                            self.pending = false;
+                            return Ok(Some(Event::Close(i)));
+                        }
+                        return Err(self.unexpected(i));
+                    }
+                    self.depth -= 1;
+                    if self.depth == self.base() {
+                        return self.record(i + 1);
+                    }
+                }
+                b')' | b'>' => return Err(self.unexpected(i)),
+                _ => self.state = State::Word,
+            }
+        }
+
+        Ok(None)
+    }
+
+    /// The first significant byte that is not `[` starts a value sequence
+    fn settle(&mut self) {
+        if self.mode == Mode::Undecided {
+            self.mode = Mode::Sequence;
+        }
+    }
+
+    fn unexpected(&self, offset: usize) -> ParseError {
+        ParseError {
+            code: GblnErrorCode::ErrorUnexpectedToken,
+            offset,
+            message: "Unexpected token between records",
+        }
+    }
+}
+
+// ============================================================================
+// Structural Index
+// ============================================================================
+
+/// Matching close offset of every `{`, `[` and `(` in a buffer
+pub(crate) struct StructuralIndex {
+    /// (open, close) offsets, sorted by open
+    spans: Vec<(usize, usize)>,
+}
+
+impl StructuralIndex {
+    /// Index `bytes`, checking only that brackets balance and content closes
+    ///
+    /// Jumps between interesting bytes with [`simd::find`], so long content
+    /// and delimiter-free runs cost one vector compare per 16 or 32 bytes.
+    pub(crate) fn build(bytes: &[u8]) -> Result<Self> {
+        let mut spans: Vec<(usize, usize)> = Vec::new();
+        let mut open: Vec<usize> = Vec::new();
+        let mut i = 0;
+
+        loop {
+            i = simd::find(bytes, i, &STRUCTURAL);
+            if i >= bytes.len() {
+                break;
+            }
+
+            match bytes[i] {
+                b'(' => {
+                    let close = content_end(bytes, i)?;
+                    spans.push((i, close));
+                    i = close + 1;
+                    continue;
+                }
+                b'{' | b'[' => {
+                    open.push(spans.len());
+                    spans.push((i, usize::MAX));
+                }
+                b @ (b'}' | b']') => {
+                    let expected = if b == b'}' { b'{' } else { b'[' };
+                    match open.pop() {
+                        Some(k) if bytes[spans[k].0] == expected => spans[k].1 = i,
+                        _ => {
+                            return Err(ParseError {
+                                code: GblnErrorCode::ErrorUnexpectedToken,
+                                offset: i,
+                                message: "Unbalanced closing bracket",
+                            })
+                        }
+                    }
+                }
+                b')' => {
+                    return Err(ParseError {
+                        code: GblnErrorCode::ErrorUnexpectedToken,
+                        offset: i,
+                        message: "Unbalanced closing parenthesis",
+                    })
+                }
+                _ => {
+                    // ':' starts a comment only at a token start
+                    if is_comment(bytes, i) {
+                        i = simd::find(bytes, i, &NEWLINE);
+                        continue;
+                    }
+                }
+            }
+            i += 1;
+        }
+
+        if let Some(k) = open.pop() {
+            return Err(ParseError {
+                code: GblnErrorCode::ErrorUnexpectedEof,
+                offset: spans[k].0,
+                message: "Unclosed bracket",
+            });
+        }
+
+        Ok(StructuralIndex { spans })
+    }
+
+    /// Offset of the byte closing the bracket or parenthesis at `open`
+    pub(crate) fn close(&self, open: usize) -> Option<usize> {
+        self.spans
+            .binary_search_by_key(&open, |span| span.0)
+            .ok()
+            .map(|k| self.spans[k].1)
+    }
+}
+
+/// Split the root array opened at `open` into runs of whole elements
+///
+/// Returns the offsets where runs start (the first is `open + 1`) and the
+/// offset of the `]` closing the array. A new run starts at the first element
+/// boundary after every `stride` bytes, so the pass keeps only a handful of
+/// offsets however many elements the array holds.
+pub(crate) fn split_elements(
+    bytes: &[u8],
+    open: usize,
+    stride: usize,
+) -> Result<(Vec<usize>, usize)> {
+    let mut starts = vec![open + 1];
+    let mut next = open + 1 + stride;
+    let mut stack: Vec<u8> = vec![b'['];
+    let mut i = open + 1;
+
+    loop {
+        i = simd::find(bytes, i, &STRUCTURAL);
+        let Some(&b) = bytes.get(i) else {
+            return Err(ParseError {
+                code: GblnErrorCode::ErrorUnexpectedEof,
+                offset: open,
+                message: "Unclosed bracket",
+            });
+        };
+
+        match b {
+            b'(' => i = content_end(bytes, i)?,
+            b'{' | b'[' => {
+                stack.push(b);
+                i += 1;
+                continue;
+            }
+            b'}' | b']' => {
+                let expected = if b == b'}' { b'{' } else { b'[' };
+                if stack.pop() != Some(expected) {
+                    return Err(ParseError {
+                        code: GblnErrorCode::ErrorUnexpectedToken,
+                        offset: i,
+                        message: "Unbalanced closing bracket",
+                    });
+                }
+                if stack.is_empty() {
+                    return Ok((starts, i));
+                }
+            }
+            b')' => {
+                return Err(ParseError {
+                    code: GblnErrorCode::ErrorUnexpectedToken,
+                    offset: i,
+                    message: "Unbalanced closing parenthesis",
+                })
+            }
+            _ => {
+                i = if is_comment(bytes, i) {
+                    simd::find(bytes, i, &NEWLINE)
+                } else {
+                    i + 1
+                };
+                continue;
+            }
+        }
+
+        // `i` closes a value; at depth 1 that ends an element
+        i += 1;
+        if stack.len() == 1 && i >= next {
+            starts.push(i);
+            next = i + stride;
+        }
+    }
+}
+
+/// True if a `:|` comment starts at `i`
+#[inline]
+pub(crate) fn is_comment(bytes: &[u8], i: usize) -> bool {
+    bytes[i..].starts_with(b":|") && (i == 0 || !is_word_byte(bytes[i - 1]))
+}
+
+/// Offset of the `)` closing the content opened at `open`
+pub(crate) fn content_end(bytes: &[u8], open: usize) -> Result<usize> {
+    let mut i = open + 1;
+    loop {
+        i = simd::find(bytes, i, &CONTENT_STOP);
+        match bytes.get(i) {
+            Some(b')') => return Ok(i),
+            // A backslash needs the byte it escapes
+            Some(_) if i + 1 < bytes.len() => i += 2,
+            _ => {
+                return Err(ParseError {
+                    code: GblnErrorCode::ErrorUnexpectedEof,
+                    offset: open,
+                    message: "Unexpected end of input while reading parenthesized content",
+                })
+            }
+        }
+    }
+}
@@ -0,0 +1,554 @@
+// Copyright (c) 2025 Vivian Burkhard Voss
+// SPDX-License-Identifier: Apache-2.0
+
+//! Schema-compiled decoding into C structs
+//!
+//! A schema describes a C struct once: for each field its key, type, offset
+//! and size. Decoding then runs the event parser and writes every scalar
+//! straight into the struct's memory, with no `Value` tree in between, and
+//! checks the document's types on the way. Keys the schema does not know are
+//! skipped without being decoded.
+//!
+//! Type rules:
+//! - a value must have the field's type (`<u16>(8080)` for a U16 field)
+//! - un-hinted integers (parsed as I64) fit any integer field whose range
+//!   holds them; un-hinted floats (F64) also fill F32 fields
+//! - Str fields are inline `char[size]` buffers, always null-terminated
+//! - Bool fields are C `bool` (one byte)
+//! - a null value (`()`) leaves the field untouched and counts as missing
+
+use std::ffi::CStr;
+use std::os::raw::c_char;
+use std::ptr;
+
+use crate::error::{set_last_error, set_parse_error, set_static_error, GblnErrorCode};
+use crate::parser::{Flow, Handler, ParseError, Parser, Scalar};
+use crate::types::GblnValueType;
+
+/// Most fields a schema can have
+const MAX_FIELDS: usize = 64;
+
+/// Description of one struct field for `gbln_schema_compile()`
+#[repr(C)]
+#[derive(Debug, Clone, Copy)]
+pub struct GblnSchemaField {
+    /// Object key (null-terminated UTF-8)
+    pub name: *const c_char,
+    /// Scalar type of the field; Object, Array and Null are not allowed
+    pub value_type: GblnValueType,
+    /// Byte offset of the field in the struct (`offsetof`)
+    pub offset: usize,
+    /// Byte size of the field (`sizeof`); for Str the buffer size
+    pub size: usize,
+    /// Fail decoding if the key is missing
+    pub required: bool,
+}
+
+#[derive(Debug)]
+struct Field {
+    name: Box<str>,
+    value_type: GblnValueType,
+    offset: usize,
+    size: usize,
+}
+
+/// Compiled struct layout
+///
+/// Create with `gbln_schema_compile()`; reusable and safe to share between
+/// threads.
+#[derive(Debug)]
+pub struct GblnSchema {
+    fields: Vec<Field>,
+    /// Bit i set if field i is required
+    required: u64,
+    struct_size: usize,
+}
+
+impl GblnSchema {
+    /// Index of the field named `key`, trying `hint` first
+    ///
+    /// Documents usually list fields in schema order, so the field after
+    /// the previous one is checked before scanning.
+    fn find(&self, key: &str, hint: usize) -> Option<usize> {
+        if self.fields.get(hint).is_some_and(|f| &*f.name == key) {
+            return Some(hint);
+        }
+        self.fields.iter().position(|f| &*f.name == key)
+    }
+}
+
+/// Byte size of a field of scalar type `t`, if it is a scalar type
+fn scalar_size(t: GblnValueType) -> Option<usize> {
+    match t {
+        GblnValueType::I8 | GblnValueType::U8 | GblnValueType::Bool => Some(1),
+        GblnValueType::I16 | GblnValueType::U16 => Some(2),
+        GblnValueType::I32 | GblnValueType::U32 | GblnValueType::F32 => Some(4),
+        GblnValueType::I64 | GblnValueType::U64 | GblnValueType::F64 => Some(8),
+        _ => None,
+    }
+}
+
+fn compile(fields: &[GblnSchemaField], struct_size: usize) -> Result<GblnSchema, String> {
+    if fields.len() > MAX_FIELDS {
+        return Err(format!(
+            "Schema has {} fields, at most {} allowed",
+            fields.len(),
+            MAX_FIELDS
+        ));
+    }
+
+    let mut schema = GblnSchema {
+        fields: Vec::with_capacity(fields.len()),
+        required: 0,
+        struct_size,
+    };
+    for (i, f) in fields.iter().enumerate() {
+        if f.name.is_null() {
+            return Err(format!("Field {}: null name", i));
+        }
+        let name = unsafe { CStr::from_ptr(f.name) }
+            .to_str()
+            .map_err(|e| format!("Field {}: invalid UTF-8 in name: {}", i, e))?;
+        if schema.find(name, 0).is_some() {
+            return Err(format!("Field {}: duplicate name {:?}", i, name));
+        }
+
+        let size_ok = match f.value_type {
+            GblnValueType::Str => f.size >= 1,
+            t => scalar_size(t) == Some(f.size),
+        };
+        if !size_ok {
+            return Err(format!(
+                "Field {:?}: size {} does not fit type {:?}",
+                name, f.size, f.value_type
+            ));
+        }
+        if f.offset
+            .checked_add(f.size)
+            .is_none_or(|end| end > struct_size)
+        {
+            return Err(format!("Field {:?}: outside of the struct", name));
+        }
+
+        if f.required {
+            schema.required |= 1 << i;
+        }
+        schema.fields.push(Field {
+            name: name.into(),
+            value_type: f.value_type,
+            offset: f.offset,
+            size: f.size,
+        });
+    }
+    Ok(schema)
+}
+
+fn error(code: GblnErrorCode, offset: usize, message: &'static str) -> ParseError {
+    ParseError {
+        code,
+        offset,
+        message,
+    }
+}
+
+fn mismatch(offset: usize) -> ParseError {
+    error(
+        GblnErrorCode::ErrorTypeMismatch,
+        offset,
+        "Value does not match field type",
+    )
+}
+
+/// Integer value of `value` for a field of type `t`
+fn integer(t: GblnValueType, value: &Scalar<'_>, offset: usize) -> Result<i128, ParseError> {
+    let (own, n) = match *value {
+        Scalar::I8(n) => (GblnValueType::I8, i128::from(n)),
+        Scalar::I16(n) => (GblnValueType::I16, i128::from(n)),
+        Scalar::I32(n) => (GblnValueType::I32, i128::from(n)),
+        // Also the type of un-hinted integers
+        Scalar::I64(n) => return Ok(i128::from(n)),
+        Scalar::U8(n) => (GblnValueType::U8, i128::from(n)),
+        Scalar::U16(n) => (GblnValueType::U16, i128::from(n)),
+        Scalar::U32(n) => (GblnValueType::U32, i128::from(n)),
+        Scalar::U64(n) => (GblnValueType::U64, i128::from(n)),
+        _ => return Err(mismatch(offset)),
+    };
+    if own != t {
+        return Err(mismatch(offset));
+    }
+    Ok(n)
+}
+
+/// Write `value` into field `f` of the struct at `base`
+fn store(f: &Field, base: *mut u8, value: Scalar<'_>, offset: usize) -> Result<(), ParseError> {
+    let dst = unsafe { base.add(f.offset) };
+    let out_of_range = || {
+        error(
+            GblnErrorCode::ErrorIntOutOfRange,
+            offset,
+            "Integer out of range for field",
+        )
+    };
+
+    macro_rules! int {
+        ($t:ty) => {{
+            let n = integer(f.value_type, &value, offset)?;
+            let n = <$t>::try_from(n).map_err(|_| out_of_range())?;
+            unsafe { ptr::write_unaligned(dst as *mut $t, n) }
+        }};
+    }
+
+    match f.value_type {
+        GblnValueType::I8 => int!(i8),
+        GblnValueType::I16 => int!(i16),
+        GblnValueType::I32 => int!(i32),
+        GblnValueType::I64 => int!(i64),
+        GblnValueType::U8 => int!(u8),
+        GblnValueType::U16 => int!(u16),
+        GblnValueType::U32 => int!(u32),
+        GblnValueType::U64 => int!(u64),
+        GblnValueType::F32 => {
+            let x = match value {
+                Scalar::F32(x) => x,
+                Scalar::F64(x) => x as f32,
+                _ => return Err(mismatch(offset)),
+            };
+            unsafe { ptr::write_unaligned(dst as *mut f32, x) }
+        }
+        GblnValueType::F64 => {
+            let Scalar::F64(x) = value else {
+                return Err(mismatch(offset));
+            };
+            unsafe { ptr::write_unaligned(dst as *mut f64, x) }
+        }
+        GblnValueType::Bool => {
+            let Scalar::Bool(b) = value else {
+                return Err(mismatch(offset));
+            };
+            unsafe { *dst = u8::from(b) }
+        }
+        GblnValueType::Str => {
+            let Scalar::Str(s) = value else {
+                return Err(mismatch(offset));
+            };
+            if s.len() >= f.size {
+                return Err(error(
+                    GblnErrorCode::ErrorStringTooLong,
+                    offset,
+                    "String does not fit field",
+                ));
+            }
+            unsafe {
+                ptr::copy_nonoverlapping(s.as_ptr(), dst, s.len());
+                *dst.add(s.len()) = 0;
+            }
+        }
+        _ => unreachable!("rejected by gbln_schema_compile()"),
+    }
+    Ok(())
+}
+
+/// Event handler writing records into caller memory
+struct Decoder<'s> {
+    schema: &'s GblnSchema,
+    out: *mut u8,
+    /// Distance between records (array mode)
+    stride: usize,
+    /// Room for this many records
+    cap: usize,
+    /// Records seen so far, including any beyond `cap`
+    count: usize,
+    /// Depth at which records are objects: 0 for one record, 1 for an array
+    record_depth: usize,
+    depth: usize,
+    /// Struct of the record being decoded
+    base: *mut u8,
+    /// Field whose value comes next
+    field: Option<usize>,
+    /// Bit i set once field i has been stored
+    seen: u64,
+}
+
+impl Decoder<'_> {
+    /// Error for a container where the schema expects something else
+    fn unexpected(&self, offset: usize) -> ParseError {
+        let message = if self.depth < self.record_depth {
+            "Expected an array of records"
+        } else if self.depth == self.record_depth {
+            "Expected an object"
+        } else {
+            "Value does not match field type"
+        };
+        error(GblnErrorCode::ErrorTypeMismatch, offset, message)
+    }
+}
+
+impl Handler for Decoder<'_> {
+    fn begin_object(&mut self, offset: usize) -> Result<Flow, ParseError> {
+        if self.depth != self.record_depth {
+            return Err(self.unexpected(offset));
+        }
+        if self.count >= self.cap {
+            // Only counted
+            self.count += 1;
+            return Ok(Flow::Skip);
+        }
+        self.base = unsafe { self.out.add(self.count * self.stride) };
+        self.field = None;
+        self.seen = 0;
+        self.depth += 1;
+        Ok(Flow::Continue)
+    }
+
+    fn key(&mut self, key: &str, offset: usize) -> Result<Flow, ParseError> {
+        let hint = self.field.map_or(0, |i| i + 1);
+        match self.schema.find(key, hint) {
+            Some(i) if self.seen & (1 << i) != 0 => Err(error(
+                GblnErrorCode::ErrorDuplicateKey,
+                offset,
+                "Duplicate field",
+            )),
+            Some(i) => {
+                self.field = Some(i);
+                Ok(Flow::Continue)
+            }
+            None => Ok(Flow::Skip),
+        }
+    }
+
+    fn end_object(&mut self, offset: usize) -> Result<(), ParseError> {
+        if self.seen & self.schema.required != self.schema.required {
+            return Err(error(
+                GblnErrorCode::ErrorTypeMismatch,
+                offset,
+                "Missing required field",
+            ));
+        }
+        self.depth -= 1;
+        self.count += 1;
+        Ok(())
+    }
+
+    fn begin_array(&mut self, offset: usize) -> Result<Flow, ParseError> {
+        if self.depth != 0 || self.record_depth != 1 {
+            return Err(self.unexpected(offset));
+        }
+        self.depth += 1;
+        Ok(Flow::Continue)
+    }
+
+    fn end_array(&mut self, _offset: usize) -> Result<(), ParseError> {
+        self.depth -= 1;
+        Ok(())
+    }
+
+    fn scalar(&mut self, value: Scalar<'_>, offset: usize) -> Result<(), ParseError> {
+        let Some(i) = self.field.filter(|_| self.depth == self.record_depth + 1) else {
+            return Err(self.unexpected(offset));
+        };
+        if let Scalar::Null = value {
+            return Ok(());
+        }
+        store(&self.schema.fields[i], self.base, value, offset)?;
+        self.seen |= 1 << i;
+        Ok(())
+    }
+}
+
+/// Run `decoder` over `input`, recording any error
+fn run(input: &[u8], decoder: &mut Decoder<'_>) -> GblnErrorCode {
+    let mut text = String::new();
+    match Parser::new(input, false, &mut text).parse_document(decoder) {
+        Ok(()) => GblnErrorCode::Ok,
+        Err(e) => {
+            set_parse_error(e, Some(input));
+            e.code
+        }
+    }
+}
+
+/// Compile a struct layout for decoding
+///
+/// # Parameters
+/// - fields: Field descriptions (see `GblnSchemaField`), at most 64
+/// - count: Number of fields
+/// - struct_size: `sizeof` the struct; every field must lie inside it
+///
+/// # Returns
+/// - GblnSchema pointer on success
+/// - NULL if a field is invalid (bad name, duplicate name, non-scalar
+///   type, size not matching the type, outside the struct)
+///
+/// # Safety
+/// - `fields` must point to `count` valid GblnSchemaField values
+/// - Field names are copied; they need not outlive this call
+/// - Caller must free with `gbln_schema_free()`
+#[no_mangle]
+pub extern "C" fn gbln_schema_compile(
+    fields: *const GblnSchemaField,
+    count: usize,
+    struct_size: usize,
+) -> *mut GblnSchema {
+    if fields.is_null() && count != 0 {
+        set_static_error(GblnErrorCode::ErrorNullPointer, "Null pointer", None);
+        return ptr::null_mut();
+    }
+
+    let fields = if count == 0 {
+        &[][..]
+    } else {
+        unsafe { std::slice::from_raw_parts(fields, count) }
+    };
+    match compile(fields, struct_size) {
+        Ok(schema) => Box::into_raw(Box::new(schema)),
+        Err(msg) => {
+            set_last_error(msg, None);
+            ptr::null_mut()
+        }
+    }
+}
+
+/// Decode a GBLN object straight into a C struct
+///
+/// The document must be an object. Fields named in the schema are written
+/// into `out`; other keys are skipped undecoded. Fields missing from the
+/// document keep their previous contents, so initialise `out` first.
+///
+/// # Returns
+/// - GBLN_OK on success
+/// - GBLN_ERROR_TYPE_MISMATCH if the document is not an object, a value
+///   does not match its field's type or a required field is missing
+/// - GBLN_ERROR_INT_OUT_OF_RANGE if an un-hinted integer does not fit
+/// - GBLN_ERROR_STRING_TOO_LONG if a string does not fit its buffer
+/// - GBLN_ERROR_DUPLICATE_KEY if a schema field appears twice
+/// - Parse error code on invalid input
+/// - GBLN_ERROR_NULL_POINTER if buf, schema or out is NULL
+///
+/// On error, `out` may be partly written; the position of the error is
+/// available from `gbln_last_error_info()`.
+///
+/// # Safety
+/// - `buf` must point to at least `len` readable bytes
+/// - `schema` must be a valid pointer from `gbln_schema_compile()`
+/// - `out` must point to a writable struct of the schema's layout
+#[no_mangle]
+pub extern "C" fn gbln_decode_into(
+    buf: *const u8,
+    len: usize,
+    schema: *const GblnSchema,
+    out: *mut std::ffi::c_void,
+) -> GblnErrorCode {
+    if buf.is_null() || schema.is_null() || out.is_null() {
+        set_static_error(GblnErrorCode::ErrorNullPointer, "Null pointer", None);
+        return GblnErrorCode::ErrorNullPointer;
+    }
+
+    let schema = unsafe { &*schema };
+    let mut decoder = Decoder {
+        schema,
+        out: out as *mut u8,
+        stride: schema.struct_size,
+        cap: 1,
+        count: 0,
+        record_depth: 0,
+        depth: 0,
+        base: ptr::null_mut(),
+        field: None,
+        seen: 0,
+    };
+    run(
+        unsafe { std::slice::from_raw_parts(buf, len) },
+        &mut decoder,
+    )
+}
+
+/// Decode a GBLN array of objects straight into an array of C structs
+///
+/// Element `i` is decoded as by `gbln_decode_into()` into the struct at
+/// `out + i * stride`.
+///
+/// # Parameters
+/// - buf, len: GBLN text
+/// - schema: Layout of one struct
+/// - out: Destination array (may be NULL if `cap` is 0)
+/// - stride: Bytes between structs (0 = the schema's struct size)
+/// - cap: Number of structs `out` has room for
+/// - n: Set to the number of records in the array
+///
+/// # Returns
+/// - GBLN_OK with `*n` records decoded
+/// - GBLN_ERROR_BUFFER_TOO_SMALL if the array has more than `cap` records
+///   (the first `cap` are decoded; `*n` is the required capacity)
+/// - The errors of `gbln_decode_into()`; `*n` is then the number of
+///   records decoded before the failing one
+///
+/// # Safety
+/// - `buf` must point to at least `len` readable bytes
+/// - `schema` must be a valid pointer from `gbln_schema_compile()`
+/// - `out` must point to `cap` writable structs `stride` bytes apart
+#[no_mangle]
+pub extern "C" fn gbln_decode_array_into(
+    buf: *const u8,
+    len: usize,
+    schema: *const GblnSchema,
+    out: *mut std::ffi::c_void,
+    stride: usize,
+    cap: usize,
+    n: *mut usize,
+) -> GblnErrorCode {
+    if buf.is_null() || schema.is_null() || n.is_null() || (out.is_null() && cap != 0) {
+        set_static_error(GblnErrorCode::ErrorNullPointer, "Null pointer", None);
+        return GblnErrorCode::ErrorNullPointer;
+    }
+
+    let schema = unsafe { &*schema };
+    let mut decoder = Decoder {
+        schema,
+        out: out as *mut u8,
+        stride: if stride == 0 {
+            schema.struct_size
+        } else {
+            stride
+        },
+        cap,
+        count: 0,
+        record_depth: 1,
+        depth: 0,
+        base: ptr::null_mut(),
+        field: None,
+        seen: 0,
+    };
+    let code = run(
+        unsafe { std::slice::from_raw_parts(buf, len) },
+        &mut decoder,
+    );
+
+    unsafe {
+        *n = decoder.count;
+    }
+    if code == GblnErrorCode::Ok && decoder.count > cap {
+        set_last_error(
+            format!(
+                "Buffer too small: {} records needed, {} given",
+                decoder.count, cap
+            ),
+            None,
+        );
+        return GblnErrorCode::ErrorBufferTooSmall;
+    }
+    code
+}
+
+/// Free a compiled schema
+///
+/// # Safety
+/// - `schema` must be a valid pointer from `gbln_schema_compile()` or NULL
+/// - Must not be called twice on the same pointer
+#[no_mangle]
+pub extern "C" fn gbln_schema_free(schema: *mut GblnSchema) {
+    if !schema.is_null() {
+        unsafe {
+            drop(Box::from_raw(schema));
+        }
+    }
+}
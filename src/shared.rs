@@ -0,0 +1,90 @@
+// Copyright (c) 2025 Vivian Burkhard Voss
+// SPDX-License-Identifier: Apache-2.0
+
+//! Shared read-only values
+//!
+//! A parsed tree is never modified by the read accessors, so once it is
+//! handed over to `gbln_value_share()` it can be read from any number of
+//! threads without locking. Ownership is an atomic reference count: every
+//! thread holding the value retains it, and the tree is freed when the last
+//! reference is released. A cached document can therefore be replaced by a
+//! new version while readers still finish with the old one.
+//!
+//! A shared value is an ordinary `GblnValue` pointer to the accessors, but
+//! it must be released with `gbln_value_release()`, never freed.
+
+use std::sync::Arc;
+
+use crate::types::GblnValue;
+
+// Readers on several threads only ever see `&Value`
+const _: fn() = || {
+    fn assert_send_sync<T: Send + Sync>() {}
+    assert_send_sync::<GblnValue>();
+};
+
+/// Turn a value into a shared, reference-counted value
+///
+/// Takes ownership of `value` without copying the tree and returns it with
+/// a reference count of 1. The returned pointer works with every function
+/// taking a `const GblnValue*`; child pointers from `gbln_object_get()` or
+/// `gbln_array_get()` stay valid as long as the caller holds a reference.
+///
+/// # Concurrency
+/// - Any number of threads may read a shared value at the same time
+/// - `gbln_value_retain()` and `gbln_value_release()` may be called from
+///   any thread, concurrently with readers
+/// - Nothing may modify a shared value (no `gbln_object_insert()`, etc.)
+///
+/// # Safety
+/// - `value` must be a root value owned by the caller (from `gbln_parse()`
+///   or a builder), not a child pointer or a document's root, or NULL
+/// - `value` must not be used or freed after this call
+///
+/// # Returns
+/// - Shared value, to be released with `gbln_value_release()`
+/// - NULL if `value` is NULL
+#[no_mangle]
+pub extern "C" fn gbln_value_share(value: *mut GblnValue) -> *const GblnValue {
+    if value.is_null() {
+        return std::ptr::null();
+    }
+
+    let value = unsafe { Box::from_raw(value) };
+    Arc::into_raw(Arc::new(*value))
+}
+
+/// Take another reference to a shared value
+///
+/// # Safety
+/// - `shared` must be a live pointer from `gbln_value_share()` or NULL
+///
+/// # Returns
+/// - `shared`, now holding one more reference
+#[no_mangle]
+pub extern "C" fn gbln_value_retain(shared: *const GblnValue) -> *const GblnValue {
+    if !shared.is_null() {
+        unsafe {
+            Arc::increment_strong_count(shared);
+        }
+    }
+    shared
+}
+
+/// Release a reference to a shared value
+///
+/// The tree is freed when the last reference is released; child pointers
+/// obtained through this reference must not be used afterwards.
+///
+/// # Safety
+/// - `shared` must be a live pointer from `gbln_value_share()` or
+///   `gbln_value_retain()`, or NULL
+/// - Each reference must be released exactly once
+#[no_mangle]
+pub extern "C" fn gbln_value_release(shared: *const GblnValue) {
+    if !shared.is_null() {
+        unsafe {
+            Arc::decrement_strong_count(shared);
+        }
+    }
+}
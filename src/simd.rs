@@ -0,0 +1,160 @@
+// Copyright (c) 2025 Vivian Burkhard Voss
+// SPDX-License-Identifier: Apache-2.0
+
+//! Vectorised byte-set search
+//!
+//! The structural passes spend most of their time stepping over bytes that
+//! cannot change their state: the inside of `(...)` content, comment text
+//! and the runs between delimiters. [`find`] classifies 16 or 32 bytes per
+//! step against a small set of interesting bytes and returns the first hit.
+//!
+//! - x86-64: AVX2 when the CPU supports it (detected once), else SSE2
+//! - aarch64: NEON
+//! - anything else: scalar loop
+
+#[cfg(target_arch = "x86_64")]
+use std::sync::atomic::{AtomicU8, Ordering};
+
+/// Bytes that end a `(...)` content run
+pub(crate) const CONTENT_STOP: [u8; 2] = [b')', b'\\'];
+
+/// Bytes that change the structural index state outside content
+pub(crate) const STRUCTURAL: [u8; 7] = [b'{', b'}', b'[', b']', b'(', b')', b':'];
+
+/// End of a `:|` comment
+pub(crate) const NEWLINE: [u8; 1] = [b'\n'];
+
+/// Vector width chosen for this CPU (0 = not yet detected)
+#[cfg(target_arch = "x86_64")]
+static X86_WIDTH: AtomicU8 = AtomicU8::new(0);
+
+/// True if the AVX2 search should be used, detecting the CPU on first use
+#[cfg(target_arch = "x86_64")]
+#[inline]
+fn use_avx2() -> bool {
+    match X86_WIDTH.load(Ordering::Relaxed) {
+        0 => {
+            let width = if is_x86_feature_detected!("avx2") {
+                32
+            } else {
+                16
+            };
+            X86_WIDTH.store(width, Ordering::Relaxed);
+            width == 32
+        }
+        width => width == 32,
+    }
+}
+
+/// Searches shorter than this are not worth a vector setup
+const VECTOR_MIN: usize = 16;
+
+/// Offset of the first byte at or after `from` that is in `set`
+///
+/// Returns `bytes.len()` if there is none, including when `from` is past
+/// the end.
+#[inline]
+pub(crate) fn find<const N: usize>(bytes: &[u8], from: usize, set: &[u8; N]) -> usize {
+    if from >= bytes.len() {
+        return bytes.len();
+    }
+    if bytes.len() - from < VECTOR_MIN {
+        return find_scalar(bytes, from, set);
+    }
+
+    #[cfg(target_arch = "x86_64")]
+    {
+        if use_avx2() {
+            return unsafe { find_avx2(bytes, from, set) };
+        }
+        unsafe { find_sse2(bytes, from, set) }
+    }
+
+    #[cfg(target_arch = "aarch64")]
+    {
+        unsafe { find_neon(bytes, from, set) }
+    }
+
+    #[cfg(not(any(target_arch = "x86_64", target_arch = "aarch64")))]
+    {
+        find_scalar(bytes, from, set)
+    }
+}
+
+#[inline]
+fn find_scalar<const N: usize>(bytes: &[u8], from: usize, set: &[u8; N]) -> usize {
+    let Some(rest) = bytes.get(from..) else {
+        return bytes.len();
+    };
+    rest.iter()
+        .position(|b| set.contains(b))
+        .map_or(bytes.len(), |k| from + k)
+}
+
+#[cfg(target_arch = "x86_64")]
+#[target_feature(enable = "avx2")]
+unsafe fn find_avx2<const N: usize>(bytes: &[u8], mut i: usize, set: &[u8; N]) -> usize {
+    use std::arch::x86_64::*;
+
+    let needles = set.map(|b| _mm256_set1_epi8(b as i8));
+    while i + 32 <= bytes.len() {
+        let chunk = _mm256_loadu_si256(bytes.as_ptr().add(i) as *const __m256i);
+        let mut hits = _mm256_setzero_si256();
+        for needle in &needles {
+            hits = _mm256_or_si256(hits, _mm256_cmpeq_epi8(chunk, *needle));
+        }
+        let mask = _mm256_movemask_epi8(hits) as u32;
+        if mask != 0 {
+            return i + mask.trailing_zeros() as usize;
+        }
+        i += 32;
+    }
+
+    find_sse2(bytes, i, set)
+}
+
+#[cfg(target_arch = "x86_64")]
+#[target_feature(enable = "sse2")]
+unsafe fn find_sse2<const N: usize>(bytes: &[u8], mut i: usize, set: &[u8; N]) -> usize {
+    use std::arch::x86_64::*;
+
+    let needles = set.map(|b| _mm_set1_epi8(b as i8));
+    while i + 16 <= bytes.len() {
+        let chunk = _mm_loadu_si128(bytes.as_ptr().add(i) as *const __m128i);
+        let mut hits = _mm_setzero_si128();
+        for needle in &needles {
+            hits = _mm_or_si128(hits, _mm_cmpeq_epi8(chunk, *needle));
+        }
+        let mask = _mm_movemask_epi8(hits) as u32;
+        if mask != 0 {
+            return i + mask.trailing_zeros() as usize;
+        }
+        i += 16;
+    }
+
+    find_scalar(bytes, i, set)
+}
+
+#[cfg(target_arch = "aarch64")]
+#[target_feature(enable = "neon")]
+unsafe fn find_neon<const N: usize>(bytes: &[u8], mut i: usize, set: &[u8; N]) -> usize {
+    use std::arch::aarch64::*;
+
+    let needles = set.map(|b| vdupq_n_u8(b));
+    while i + 16 <= bytes.len() {
+        let chunk = vld1q_u8(bytes.as_ptr().add(i));
+        let mut hits = vdupq_n_u8(0);
+        for needle in &needles {
+            hits = vorrq_u8(hits, vceqq_u8(chunk, *needle));
+        }
+        // Narrow each byte lane to 4 bits to get a 64-bit mask
+        let narrowed = vshrn_n_u16::<4>(vreinterpretq_u16_u8(hits));
+        let mask = vget_lane_u64::<0>(vreinterpret_u64_u8(narrowed));
+        if mask != 0 {
+            return i + (mask.trailing_zeros() / 4) as usize;
+        }
+        i += 16;
+    }
+
+    find_scalar(bytes, i, set)
+}
@@ -0,0 +1,401 @@
+// Copyright (c) 2025 Vivian Burkhard Voss
+// SPDX-License-Identifier: Apache-2.0
+
+//! Opt-in instrumentation of the FFI layer
+//!
+//! Built with the `stats` feature, the parse, serialise and I/O entry points
+//! count calls, bytes and time, the codecs count time spent compressing, and
+//! the global allocator (see arena.rs) counts allocations. Nothing is recorded until
+//! `gbln_stats_enable()` is called; after that each event is a handful of
+//! relaxed atomic adds into the recording thread's shard. There are 16
+//! cache-line aligned shards, handed to threads round-robin on their first
+//! event: up to 16 recording threads never share a cache line, while more
+//! threads share shards and can contend on them. Without the feature
+//! `enabled()` is constant false and every recording site compiles away.
+
+use std::io::{self, Read, Write};
+use std::time::Instant;
+
+/// Buckets of each latency histogram
+///
+/// Bucket `i` counts calls taking `[2^i, 2^(i+1))` nanoseconds; the last
+/// bucket also counts everything slower.
+pub const GBLN_STATS_BUCKETS: usize = 32;
+
+/// Counters of one instrumented operation
+#[repr(C)]
+#[derive(Debug, Clone, Copy)]
+pub struct GblnOpStats {
+    /// Completed calls, successful or not
+    pub calls: u64,
+    /// Bytes parsed, serialised, read or written
+    pub bytes: u64,
+    /// Total wall time in nanoseconds
+    pub total_ns: u64,
+    /// Latency histogram (see `GBLN_STATS_BUCKETS`)
+    pub histogram: [u64; GBLN_STATS_BUCKETS],
+}
+
+/// Snapshot of all counters
+///
+/// Operations:
+/// - parse: `gbln_parse()`, `gbln_parse_n()`; bytes are input bytes
+/// - to_string: `gbln_to_string()`, `gbln_to_string_pretty()`,
+///   `gbln_to_buffer()`; bytes are output bytes
+/// - read_io: `gbln_read_io()`, `gbln_read_io_parallel()`,
+///   `gbln_read_io_mmap()`; bytes are file bytes
+/// - write_io: `gbln_write_io()`, `gbln_write_io_stream()`; bytes are file
+///   bytes
+///
+/// `compress_ns` and `decompress_ns` are time spent inside a codec,
+/// including the file writes or reads it makes; for write_io and read_io the
+/// rest of `total_ns` is (de)serialisation. Single-threaded XZ writes are
+/// done by the core library and are not split. Allocations count every
+/// allocation made by this library while enabled.
+#[repr(C)]
+#[derive(Debug, Clone, Copy)]
+pub struct GblnStats {
+    pub parse: GblnOpStats,
+    pub to_string: GblnOpStats,
+    pub read_io: GblnOpStats,
+    pub write_io: GblnOpStats,
+    pub compress_ns: u64,
+    pub decompress_ns: u64,
+    pub allocations: u64,
+    pub allocated_bytes: u64,
+}
+
+/// Instrumented operation
+#[derive(Clone, Copy)]
+pub(crate) enum Op {
+    Parse = 0,
+    ToString = 1,
+    ReadIo = 2,
+    WriteIo = 3,
+}
+
+/// Where time inside a codec is accounted
+#[derive(Clone, Copy)]
+pub(crate) enum Phase {
+    Compress,
+    Decompress,
+}
+
+// ============================================================================
+// Storage
+// ============================================================================
+
+#[cfg(feature = "stats")]
+mod shards {
+    use std::cell::Cell;
+    use std::sync::atomic::{AtomicBool, AtomicU64, AtomicUsize, Ordering::Relaxed};
+
+    use super::GBLN_STATS_BUCKETS;
+
+    const OP_COUNTERS: usize = 3 + GBLN_STATS_BUCKETS;
+    pub(super) const COMPRESS: usize = 4 * OP_COUNTERS;
+    pub(super) const DECOMPRESS: usize = COMPRESS + 1;
+    const ALLOCATIONS: usize = COMPRESS + 2;
+    const ALLOCATED_BYTES: usize = COMPRESS + 3;
+    const COUNTERS: usize = COMPRESS + 4;
+
+    /// Fixed so the table needs no allocation (it is used by the allocator)
+    const SHARDS: usize = 16;
+
+    #[repr(align(64))]
+    struct Shard([AtomicU64; COUNTERS]);
+
+    #[allow(clippy::declare_interior_mutable_const)]
+    const ZERO: AtomicU64 = AtomicU64::new(0);
+    #[allow(clippy::declare_interior_mutable_const)]
+    const SHARD: Shard = Shard([ZERO; COUNTERS]);
+
+    static TABLE: [Shard; SHARDS] = [SHARD; SHARDS];
+    pub(super) static ENABLED: AtomicBool = AtomicBool::new(false);
+    static NEXT_SHARD: AtomicUsize = AtomicUsize::new(0);
+
+    thread_local! {
+        // Const-initialised without a destructor, so safe to touch from
+        // inside the allocator
+        static THREAD_SHARD: Cell<usize> = const { Cell::new(usize::MAX) };
+    }
+
+    fn shard() -> &'static Shard {
+        let index = THREAD_SHARD
+            .try_with(|s| {
+                if s.get() == usize::MAX {
+                    s.set(NEXT_SHARD.fetch_add(1, Relaxed) % SHARDS);
+                }
+                s.get()
+            })
+            .unwrap_or(0);
+        &TABLE[index]
+    }
+
+    pub(super) fn add(counter: usize, n: u64) {
+        shard().0[counter].fetch_add(n, Relaxed);
+    }
+
+    pub(super) fn op(op: usize, bytes: u64, ns: u64, bucket: usize) {
+        let counters = &shard().0[op * OP_COUNTERS..];
+        counters[0].fetch_add(1, Relaxed);
+        counters[1].fetch_add(bytes, Relaxed);
+        counters[2].fetch_add(ns, Relaxed);
+        counters[3 + bucket].fetch_add(1, Relaxed);
+    }
+
+    pub(super) fn sum(counter: usize) -> u64 {
+        TABLE.iter().map(|s| s.0[counter].load(Relaxed)).sum()
+    }
+
+    pub(super) fn op_counter(op: usize, field: usize) -> usize {
+        op * OP_COUNTERS + field
+    }
+
+    pub(super) fn reset() {
+        for shard in &TABLE {
+            for counter in &shard.0 {
+                counter.store(0, Relaxed);
+            }
+        }
+    }
+
+    pub(super) fn allocations() -> (u64, u64) {
+        (sum(ALLOCATIONS), sum(ALLOCATED_BYTES))
+    }
+
+    pub(super) fn count_alloc(size: usize) {
+        let counters = &shard().0;
+        counters[ALLOCATIONS].fetch_add(1, Relaxed);
+        counters[ALLOCATED_BYTES].fetch_add(size as u64, Relaxed);
+    }
+}
+
+/// Count an allocation of `size` bytes (called by the global allocator)
+#[inline(always)]
+#[cfg(any(feature = "arena", feature = "stats"))]
+#[cfg_attr(not(feature = "stats"), allow(unused_variables))]
+pub(crate) fn count_alloc(size: usize) {
+    #[cfg(feature = "stats")]
+    if enabled() {
+        shards::count_alloc(size);
+    }
+}
+
+/// Whether recording is on (always false without the `stats` feature)
+#[inline(always)]
+pub(crate) fn enabled() -> bool {
+    #[cfg(feature = "stats")]
+    {
+        shards::ENABLED.load(std::sync::atomic::Ordering::Relaxed)
+    }
+    #[cfg(not(feature = "stats"))]
+    {
+        false
+    }
+}
+
+fn elapsed_ns(start: Instant) -> u64 {
+    u64::try_from(start.elapsed().as_nanos()).unwrap_or(u64::MAX)
+}
+
+// ============================================================================
+// Recording
+// ============================================================================
+
+/// Running measurement of one operation
+pub(crate) struct Timer {
+    op: Op,
+    start: Option<Instant>,
+}
+
+impl Timer {
+    /// Start timing `op` if stats are enabled
+    #[inline(always)]
+    pub(crate) fn start(op: Op) -> Timer {
+        Timer {
+            op,
+            start: enabled().then(Instant::now),
+        }
+    }
+
+    /// Record the call, having processed `bytes`
+    #[inline(always)]
+    pub(crate) fn finish(self, bytes: usize) {
+        self.finish_with(|| bytes as u64)
+    }
+
+    /// Record the call, asking `bytes` for the size only if measured
+    #[inline(always)]
+    pub(crate) fn finish_with(self, bytes: impl FnOnce() -> u64) {
+        if let Some(start) = self.start {
+            let ns = elapsed_ns(start);
+            record(self.op, bytes(), ns);
+        }
+    }
+}
+
+#[cfg_attr(not(feature = "stats"), allow(unused_variables))]
+fn record(op: Op, bytes: u64, ns: u64) {
+    #[cfg(feature = "stats")]
+    {
+        let bucket = (63 - (ns | 1).leading_zeros() as usize).min(GBLN_STATS_BUCKETS - 1);
+        shards::op(op as usize, bytes, ns, bucket);
+    }
+}
+
+#[cfg_attr(not(feature = "stats"), allow(unused_variables))]
+fn record_phase(phase: Phase, ns: u64) {
+    #[cfg(feature = "stats")]
+    shards::add(
+        match phase {
+            Phase::Compress => shards::COMPRESS,
+            Phase::Decompress => shards::DECOMPRESS,
+        },
+        ns,
+    );
+}
+
+/// Reader or writer whose calls are accounted to a codec phase (if any)
+pub(crate) struct Timed<T> {
+    inner: T,
+    phase: Option<Phase>,
+}
+
+impl<T> Timed<T> {
+    pub(crate) fn new(inner: T, phase: Option<Phase>) -> Self {
+        Timed { inner, phase }
+    }
+
+    /// Run `f` on the inner value, accounting its time
+    #[inline(always)]
+    pub(crate) fn time<U>(&mut self, f: impl FnOnce(&mut T) -> U) -> U {
+        let inner = &mut self.inner;
+        measure(self.phase, || f(inner))
+    }
+
+    /// Consume the inner value with `f`, accounting its time
+    pub(crate) fn finish<U>(self, f: impl FnOnce(T) -> U) -> U {
+        let inner = self.inner;
+        measure(self.phase, || f(inner))
+    }
+}
+
+#[inline(always)]
+fn measure<U>(phase: Option<Phase>, f: impl FnOnce() -> U) -> U {
+    match phase {
+        Some(phase) if enabled() => {
+            let start = Instant::now();
+            let result = f();
+            record_phase(phase, elapsed_ns(start));
+            result
+        }
+        _ => f(),
+    }
+}
+
+impl<R: Read> Read for Timed<R> {
+    fn read(&mut self, buf: &mut [u8]) -> io::Result<usize> {
+        self.time(|r| r.read(buf))
+    }
+}
+
+impl<W: Write> Write for Timed<W> {
+    fn write(&mut self, buf: &[u8]) -> io::Result<usize> {
+        self.time(|w| w.write(buf))
+    }
+
+    fn flush(&mut self) -> io::Result<()> {
+        self.time(|w| w.flush())
+    }
+}
+
+// ============================================================================
+// C API
+// ============================================================================
+
+/// Turn stats recording on or off
+///
+/// Counters keep their values while recording is off. Recording costs a few
+/// relaxed atomic adds per call into one of 16 shards; threads beyond the
+/// 16th share shards with earlier ones.
+///
+/// # Returns
+/// - true if this build includes stats (the `stats` feature)
+/// - false otherwise; nothing is ever recorded
+#[no_mangle]
+pub extern "C" fn gbln_stats_enable(enabled: bool) -> bool {
+    #[cfg(feature = "stats")]
+    shards::ENABLED.store(enabled, std::sync::atomic::Ordering::Relaxed);
+    let _ = enabled;
+    cfg!(feature = "stats")
+}
+
+/// Copy the counters of all threads into `out`
+///
+/// # Returns
+/// - true on success
+/// - false if `out` is NULL or the build has no stats (`out` is then zeroed)
+///
+/// # Safety
+/// - `out` must point to a writable GblnStats or be NULL
+#[no_mangle]
+pub extern "C" fn gbln_stats_snapshot(out: *mut GblnStats) -> bool {
+    if out.is_null() {
+        return false;
+    }
+
+    let empty = GblnOpStats {
+        calls: 0,
+        bytes: 0,
+        total_ns: 0,
+        histogram: [0; GBLN_STATS_BUCKETS],
+    };
+    #[cfg_attr(not(feature = "stats"), allow(unused_mut))]
+    let mut stats = GblnStats {
+        parse: empty,
+        to_string: empty,
+        read_io: empty,
+        write_io: empty,
+        compress_ns: 0,
+        decompress_ns: 0,
+        allocations: 0,
+        allocated_bytes: 0,
+    };
+
+    #[cfg(feature = "stats")]
+    {
+        let ops = [
+            (Op::Parse, &mut stats.parse),
+            (Op::ToString, &mut stats.to_string),
+            (Op::ReadIo, &mut stats.read_io),
+            (Op::WriteIo, &mut stats.write_io),
+        ];
+        for (op, out) in ops {
+            let field = |i| shards::sum(shards::op_counter(op as usize, i));
+            out.calls = field(0);
+            out.bytes = field(1);
+            out.total_ns = field(2);
+            for (i, bucket) in out.histogram.iter_mut().enumerate() {
+                *bucket = field(3 + i);
+            }
+        }
+        stats.compress_ns = shards::sum(shards::COMPRESS);
+        stats.decompress_ns = shards::sum(shards::DECOMPRESS);
+        (stats.allocations, stats.allocated_bytes) = shards::allocations();
+    }
+
+    unsafe {
+        *out = stats;
+    }
+    cfg!(feature = "stats")
+}
+
+/// Reset all counters to zero
+///
+/// Calls that are running while this happens may be partly counted.
+#[no_mangle]
+pub extern "C" fn gbln_stats_reset() {
+    #[cfg(feature = "stats")]
+    shards::reset();
+}
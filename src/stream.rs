@@ -0,0 +1,243 @@
+// Copyright (c) 2025 Vivian Burkhard Voss
+// SPDX-License-Identifier: Apache-2.0
+
+//! Push-style incremental parsing
+//!
+//! A `GblnStream` accepts input in chunks of any size and hands each
+//! top-level value to a callback as soon as it is complete. Only the record
+//! currently being received is buffered, so peak memory is bounded by the
+//! largest single record rather than the whole input.
+
+use std::os::raw::c_void;
+
+use crate::error::{set_last_error, set_parse_error, set_static_error, GblnErrorCode};
+use crate::parser::{GblnParser, ParseError};
+use crate::scanner::{Event, Scanner};
+use crate::types::GblnValue;
+
+/// Callback receiving each complete value of a stream
+///
+/// Takes ownership of `value`, which must be freed with `gbln_value_free()`.
+/// Return `GBLN_OK` to continue; any other code stops the stream and is
+/// returned from the `gbln_stream_feed()` call that delivered the value.
+pub type GblnStreamCallback =
+    Option<extern "C" fn(ctx: *mut c_void, value: *mut GblnValue) -> GblnErrorCode>;
+
+/// Incremental parser state
+///
+/// Input is either a sequence of top-level values, each delivered as it
+/// closes, or a single root array (first token `[`), whose elements are
+/// delivered one by one.
+pub struct GblnStream {
+    callback: GblnStreamCallback,
+    ctx: *mut c_void,
+    scanner: Scanner,
+    parser: GblnParser,
+    /// Unconsumed input: the current partial record
+    buf: Vec<u8>,
+    /// Bytes of `buf` already scanned
+    scanned: usize,
+    /// Start of the current record in `buf`
+    record_start: usize,
+    /// Stream offset of `buf[0]`, for error positions
+    offset: usize,
+    /// Sticky error code; the stream is unusable once this is not Ok
+    status: GblnErrorCode,
+}
+
+impl GblnStream {
+    pub(crate) fn new(callback: GblnStreamCallback, ctx: *mut c_void) -> Self {
+        GblnStream {
+            callback,
+            ctx,
+            scanner: Scanner::new(),
+            parser: GblnParser::new(),
+            buf: Vec::new(),
+            scanned: 0,
+            record_start: 0,
+            offset: 0,
+            status: GblnErrorCode::Ok,
+        }
+    }
+
+    pub(crate) fn feed(&mut self, chunk: &[u8]) -> GblnErrorCode {
+        if self.status != GblnErrorCode::Ok {
+            return self.status;
+        }
+        self.buf.extend_from_slice(chunk);
+
+        let mut pos = self.scanned;
+        loop {
+            match self.scanner.next(&self.buf, &mut pos) {
+                Ok(None) => break,
+                Ok(Some(Event::Open(start))) => self.record_start = start,
+                Ok(Some(Event::Close(at))) => self.record_start = at + 1,
+                Ok(Some(Event::Record(end))) => {
+                    let code = self.emit(end);
+                    if code != GblnErrorCode::Ok {
+                        return code;
+                    }
+                }
+                Err(e) => return self.fail(e, 0),
+            }
+        }
+
+        // Drop consumed records; only the partial record stays buffered
+        self.buf.drain(..self.record_start);
+        self.offset += self.record_start;
+        self.scanned = pos - self.record_start;
+        self.record_start = 0;
+        GblnErrorCode::Ok
+    }
+
+    /// Parse `buf[record_start..end]` and hand the value to the callback
+    fn emit(&mut self, end: usize) -> GblnErrorCode {
+        let start = self.record_start;
+        let record = &self.buf[start..end];
+        let result = if self.scanner.elements() {
+            self.parser.parse_element_value(record, false)
+        } else {
+            self.parser.parse_value(record, false)
+        };
+        self.record_start = end;
+
+        let value = match result {
+            Ok(value) => value,
+            Err(e) => return self.fail(e, start),
+        };
+
+        let value = Box::into_raw(Box::new(GblnValue::new(value)));
+        let code = match self.callback {
+            Some(callback) => callback(self.ctx, value),
+            None => {
+                unsafe { drop(Box::from_raw(value)) };
+                GblnErrorCode::Ok
+            }
+        };
+
+        if code != GblnErrorCode::Ok {
+            set_last_error(format!("Stream stopped by callback ({:?})", code), None);
+            self.status = code;
+        }
+        code
+    }
+
+    /// Record a parse error at `base + e.offset` within the buffer
+    fn fail(&mut self, e: ParseError, base: usize) -> GblnErrorCode {
+        let offset = self.offset + base + e.offset;
+        // Earlier input is gone, so the line is unknown
+        set_parse_error(ParseError { offset, ..e }, None);
+        self.status = e.code;
+        e.code
+    }
+
+    pub(crate) fn finish(&mut self) -> GblnErrorCode {
+        if self.status != GblnErrorCode::Ok {
+            return self.status;
+        }
+        if !self.scanner.is_idle() {
+            set_last_error(
+                format!(
+                    "Unexpected end of input in stream at byte {}",
+                    self.offset + self.buf.len()
+                ),
+                None,
+            );
+            self.status = GblnErrorCode::ErrorUnexpectedEof;
+            return self.status;
+        }
+
+        // Ready for a new input
+        self.scanner = Scanner::new();
+        self.buf.clear();
+        self.scanned = 0;
+        self.record_start = 0;
+        self.offset = 0;
+        GblnErrorCode::Ok
+    }
+}
+
+/// Create an incremental parser
+///
+/// # Parameters
+/// - callback: Receives each complete value (may be NULL to discard values)
+/// - ctx: Opaque pointer passed to every callback invocation
+///
+/// # Safety
+/// - Caller must free with `gbln_stream_free()`
+#[no_mangle]
+pub extern "C" fn gbln_stream_new(
+    callback: GblnStreamCallback,
+    ctx: *mut c_void,
+) -> *mut GblnStream {
+    Box::into_raw(Box::new(GblnStream::new(callback, ctx)))
+}
+
+/// Feed the next chunk of input to a stream
+///
+/// Chunks may split the input anywhere, including inside keys, content or
+/// multi-byte UTF-8 sequences. Every value completed by this chunk is
+/// delivered to the callback before the call returns.
+///
+/// # Returns
+/// - GBLN_OK if the chunk was consumed
+/// - Parse error code if a record is invalid (details via `gbln_last_error_message()`)
+/// - The callback's code if the callback stopped the stream
+///
+/// After an error the stream keeps returning the same code; free it.
+///
+/// # Safety
+/// - `stream` must be a valid pointer from `gbln_stream_new()`
+/// - `buf` must point to at least `len` readable bytes
+#[no_mangle]
+pub extern "C" fn gbln_stream_feed(
+    stream: *mut GblnStream,
+    buf: *const u8,
+    len: usize,
+) -> GblnErrorCode {
+    if stream.is_null() || (buf.is_null() && len != 0) {
+        set_static_error(GblnErrorCode::ErrorNullPointer, "Null pointer", None);
+        return GblnErrorCode::ErrorNullPointer;
+    }
+
+    let chunk = if len == 0 {
+        &[][..]
+    } else {
+        unsafe { std::slice::from_raw_parts(buf, len) }
+    };
+    unsafe { (*stream).feed(chunk) }
+}
+
+/// Signal the end of input
+///
+/// # Returns
+/// - GBLN_OK if the input ended on a record boundary; the stream can then be
+///   fed a new input
+/// - GBLN_ERROR_UNEXPECTED_EOF if a record (or the root array) is incomplete
+/// - The sticky error code of a stream that already failed
+///
+/// # Safety
+/// - `stream` must be a valid pointer from `gbln_stream_new()`
+#[no_mangle]
+pub extern "C" fn gbln_stream_finish(stream: *mut GblnStream) -> GblnErrorCode {
+    if stream.is_null() {
+        set_static_error(GblnErrorCode::ErrorNullPointer, "Null pointer", None);
+        return GblnErrorCode::ErrorNullPointer;
+    }
+
+    unsafe { (*stream).finish() }
+}
+
+/// Free a stream and any partially received record
+///
+/// # Safety
+/// - `stream` must be a valid pointer from `gbln_stream_new()` or NULL
+/// - Must not be called twice on the same pointer
+#[no_mangle]
+pub extern "C" fn gbln_stream_free(stream: *mut GblnStream) {
+    if !stream.is_null() {
+        unsafe {
+            drop(Box::from_raw(stream));
+        }
+    }
+}
@@ -24,6 +24,10 @@ impl GblnValue {
         &self.inner
     }
 
+    pub fn inner_mut(&mut self) -> &mut Value {
+        &mut self.inner
+    }
+
     pub fn into_inner(self) -> Value {
         self.inner
     }
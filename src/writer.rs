@@ -0,0 +1,365 @@
+// Copyright (c) 2025 Vivian Burkhard Voss
+// SPDX-License-Identifier: Apache-2.0
+
+//! Streaming serialiser
+//!
+//! Writes a value tree as GBLN text into any `io::Write`, piece by piece, so
+//! output can go straight into a file or a compressor without first being
+//! collected into one `String`.
+//!
+//! This is not `gbln::to_string`, and its text differs from
+//! `gbln_to_string()` and from the core path of `gbln_write_io()`:
+//!
+//! - `I64`, untyped strings and `Bool` are written without a hint
+//! - other numbers carry their type hint (`<u8>(7)`, `<f64>(1.5)`), and
+//!   `Null` is `<n>()`
+//! - strings that would read back as another type get an `<sN>` hint
+//! - object fields are written in key order, so output is deterministic
+//!
+//! The text reads back to an equal value through both `gbln_parse()` and
+//! the native parser. `gbln_to_buffer()`, `gbln_to_writer()`,
+//! `gbln_write_io_stream()` and the non-core paths of `gbln_write_io()`
+//! (other codecs, threaded XZ, binary) use it.
+
+use std::ffi::c_void;
+use std::io::{self, BufWriter, Write};
+use std::os::raw::c_char;
+
+use gbln::Value;
+
+use crate::config::GblnConfig;
+use crate::error::{set_last_error, set_static_error, GblnErrorCode};
+use crate::io::{write_stream, STREAM_CHUNK};
+use crate::parser::{infer_scalar, is_word_byte, Scalar};
+use crate::stats::{Op, Timer};
+use crate::types::GblnValue;
+
+/// Layout of the written text
+#[derive(Debug, Clone, Copy)]
+pub(crate) struct Style {
+    /// One field or element per line
+    pub pretty: bool,
+    /// Spaces per nesting level when `pretty`
+    pub indent: usize,
+}
+
+impl Style {
+    /// MINI GBLN: no whitespace
+    pub(crate) const MINI: Style = Style {
+        pretty: false,
+        indent: 0,
+    };
+
+    /// Layout configured by `config`
+    pub(crate) fn of(config: &gbln::GblnConfig) -> Style {
+        Style {
+            pretty: !config.mini_mode,
+            indent: config.indent,
+        }
+    }
+}
+
+/// Standard `<sN>` widths
+const STR_WIDTHS: [usize; 10] = [2, 4, 8, 16, 32, 64, 128, 256, 512, 1024];
+
+struct Writer<'w, W: Write> {
+    out: &'w mut W,
+    style: Style,
+}
+
+/// Write `value` as GBLN text
+pub(crate) fn write_value<W: Write>(out: &mut W, value: &Value, style: Style) -> io::Result<()> {
+    Writer { out, style }.value(value, 0)
+}
+
+impl<W: Write> Writer<'_, W> {
+    fn newline(&mut self, depth: usize) -> io::Result<()> {
+        if !self.style.pretty {
+            return Ok(());
+        }
+        self.out.write_all(b"\n")?;
+        for _ in 0..depth * self.style.indent {
+            self.out.write_all(b" ")?;
+        }
+        Ok(())
+    }
+
+    fn value(&mut self, value: &Value, depth: usize) -> io::Result<()> {
+        match value {
+            Value::Object(map) => {
+                let mut fields: Vec<_> = map.iter().collect();
+                fields.sort_unstable_by(|a, b| a.0.cmp(b.0));
+
+                self.out.write_all(b"{")?;
+                for (key, value) in fields {
+                    self.newline(depth + 1)?;
+                    self.key(key)?;
+                    self.value(value, depth + 1)?;
+                }
+                if !map.is_empty() {
+                    self.newline(depth)?;
+                }
+                self.out.write_all(b"}")
+            }
+            Value::Array(items) => {
+                self.out.write_all(b"[")?;
+                for item in items {
+                    self.newline(depth + 1)?;
+                    self.value(item, depth + 1)?;
+                }
+                if !items.is_empty() {
+                    self.newline(depth)?;
+                }
+                self.out.write_all(b"]")
+            }
+            Value::I8(n) => write!(self.out, "<i8>({})", n),
+            Value::I16(n) => write!(self.out, "<i16>({})", n),
+            Value::I32(n) => write!(self.out, "<i32>({})", n),
+            Value::I64(n) => write!(self.out, "({})", n),
+            Value::U8(n) => write!(self.out, "<u8>({})", n),
+            Value::U16(n) => write!(self.out, "<u16>({})", n),
+            Value::U32(n) => write!(self.out, "<u32>({})", n),
+            Value::U64(n) => write!(self.out, "<u64>({})", n),
+            Value::F32(n) => write!(self.out, "<f32>({})", n),
+            Value::F64(n) => write!(self.out, "<f64>({})", n),
+            Value::Bool(b) => self.out.write_all(if *b { b"(true)" } else { b"(false)" }),
+            Value::Null => self.out.write_all(b"<n>()"),
+            Value::Str(s) => self.string(s),
+        }
+    }
+
+    fn key(&mut self, key: &str) -> io::Result<()> {
+        if key.is_empty() || key.starts_with(":|") || !key.bytes().all(is_word_byte) {
+            return Err(io::Error::new(
+                io::ErrorKind::InvalidData,
+                format!("Key {:?} cannot be written as GBLN", key),
+            ));
+        }
+        self.out.write_all(key.as_bytes())
+    }
+
+    fn string(&mut self, s: &str) -> io::Result<()> {
+        if !matches!(infer_scalar(s), Scalar::Str(_)) {
+            let chars = s.chars().count();
+            let width = STR_WIDTHS
+                .iter()
+                .copied()
+                .find(|&w| w >= chars)
+                .unwrap_or(chars);
+            write!(self.out, "<s{}>", width)?;
+        }
+
+        self.out.write_all(b"(")?;
+        let bytes = s.as_bytes();
+        let mut start = 0;
+        for (i, &b) in bytes.iter().enumerate() {
+            if b == b')' || b == b'\\' {
+                self.out.write_all(&bytes[start..i])?;
+                self.out.write_all(b"\\")?;
+                start = i;
+            }
+        }
+        self.out.write_all(&bytes[start..])?;
+        self.out.write_all(b")")
+    }
+}
+
+/// Writer into a fixed buffer that keeps counting once the buffer is full
+pub(crate) struct SliceWriter<'b> {
+    pub(crate) buf: &'b mut [u8],
+    pub(crate) len: usize,
+}
+
+impl Write for SliceWriter<'_> {
+    fn write(&mut self, data: &[u8]) -> io::Result<usize> {
+        if let Some(room) = self.buf.get_mut(self.len..) {
+            let n = room.len().min(data.len());
+            room[..n].copy_from_slice(&data[..n]);
+        }
+        self.len += data.len();
+        Ok(data.len())
+    }
+
+    fn flush(&mut self) -> io::Result<()> {
+        Ok(())
+    }
+}
+
+/// Callback receiving each chunk of serialised output
+///
+/// `data` is only valid for the duration of the call. Return `GBLN_OK` to
+/// continue; any other code stops serialisation and is returned from
+/// `gbln_to_writer()`.
+pub type GblnWriteCallback =
+    Option<extern "C" fn(ctx: *mut c_void, data: *const u8, len: usize) -> GblnErrorCode>;
+
+/// Writer handing every chunk to a C callback
+struct CallbackWriter {
+    callback: extern "C" fn(*mut c_void, *const u8, usize) -> GblnErrorCode,
+    ctx: *mut c_void,
+    /// Code returned by the callback that stopped the output
+    status: GblnErrorCode,
+}
+
+impl Write for CallbackWriter {
+    fn write(&mut self, data: &[u8]) -> io::Result<usize> {
+        // Once stopped, later flushes (e.g. on drop) must not call back again
+        if self.status != GblnErrorCode::Ok {
+            return Err(io::Error::other("Aborted by write callback"));
+        }
+        if data.is_empty() {
+            return Ok(0);
+        }
+        let code = (self.callback)(self.ctx, data.as_ptr(), data.len());
+        if code != GblnErrorCode::Ok {
+            self.status = code;
+            return Err(io::Error::other("Aborted by write callback"));
+        }
+        Ok(data.len())
+    }
+
+    fn flush(&mut self) -> io::Result<()> {
+        Ok(())
+    }
+}
+
+/// Error code for a serialiser failure, recording its message
+fn write_error(e: io::Error) -> GblnErrorCode {
+    let code = if e.kind() == io::ErrorKind::InvalidData {
+        GblnErrorCode::ErrorInvalidSyntax
+    } else {
+        GblnErrorCode::ErrorIo
+    };
+    set_last_error(e.to_string(), None);
+    code
+}
+
+/// Serialize GBLN value into a caller-provided buffer
+///
+/// Writes MINI GBLN followed by a terminating NUL straight into `buf`; no
+/// output string is allocated. Each object still allocates a short list of
+/// its fields to write them in key order. Call with `cap` 0 (and `buf`
+/// NULL) to query the size.
+///
+/// The text is NOT byte-identical to `gbln_to_string()`'s: object fields
+/// are written in key order, `I64`, untyped strings and `Bool` have no hint,
+/// `Null` is `<n>()`, and strings that would read back as another type get
+/// an `<sN>` hint. `gbln_parse()` reads it back to an equal value.
+///
+/// # Parameters
+/// - value: GBLN value to serialise
+/// - buf: Destination buffer (may be NULL if `cap` is 0)
+/// - cap: Size of `buf` in bytes
+/// - written: Set to the length of the text, excluding the NUL
+///
+/// # Returns
+/// - GBLN_OK on success
+/// - GBLN_ERROR_BUFFER_TOO_SMALL if `cap` is less than `*written + 1`; the
+///   contents of `buf` are then unspecified
+/// - GBLN_ERROR_INVALID_SYNTAX if an object key cannot be written as GBLN
+/// - GBLN_ERROR_NULL_POINTER if value or written is NULL
+///
+/// # Safety
+/// - `value` must be a valid GblnValue pointer
+/// - `buf` must point to at least `cap` writable bytes
+#[no_mangle]
+pub extern "C" fn gbln_to_buffer(
+    value: *const GblnValue,
+    buf: *mut c_char,
+    cap: usize,
+    written: *mut usize,
+) -> GblnErrorCode {
+    if value.is_null() || written.is_null() || (buf.is_null() && cap != 0) {
+        set_static_error(GblnErrorCode::ErrorNullPointer, "Null pointer", None);
+        return GblnErrorCode::ErrorNullPointer;
+    }
+
+    let buf = if cap == 0 {
+        &mut [][..]
+    } else {
+        unsafe { std::slice::from_raw_parts_mut(buf as *mut u8, cap) }
+    };
+    let timer = Timer::start(Op::ToString);
+    let mut out = SliceWriter { buf, len: 0 };
+    let result = write_value(&mut out, unsafe { (*value).inner() }, Style::MINI);
+    timer.finish(out.len);
+    if let Err(e) = result {
+        return write_error(e);
+    }
+
+    let len = out.len;
+    unsafe {
+        *written = len;
+    }
+    if len >= cap {
+        set_last_error(
+            format!("Buffer too small: {} bytes needed, {} given", len + 1, cap),
+            None,
+        );
+        return GblnErrorCode::ErrorBufferTooSmall;
+    }
+    out.buf[len] = 0;
+    GblnErrorCode::Ok
+}
+
+/// Serialize GBLN value through a write callback
+///
+/// The serialiser hands its output to `write_fn` in chunks of up to 64 KiB
+/// as it goes, so the whole text is never held in memory. With a config the
+/// layout and compression follow it, as for `gbln_write_io_stream()`. The
+/// text matches `gbln_to_buffer()`, not `gbln_to_string()`.
+///
+/// # Parameters
+/// - value: GBLN value to serialise
+/// - write_fn: Receives each chunk (see `GblnWriteCallback`)
+/// - ctx: Passed unchanged to every call of `write_fn`
+/// - config: Output configuration (if NULL, MINI GBLN without compression)
+///
+/// # Returns
+/// - GBLN_OK once all output has been delivered
+/// - The callback's code if it stopped the output
+/// - GBLN_ERROR_INVALID_SYNTAX if an object key cannot be written as GBLN
+/// - GBLN_ERROR_IO if compression fails
+/// - GBLN_ERROR_NULL_POINTER if value or write_fn is NULL
+///
+/// # Safety
+/// - `value` must be a valid GblnValue pointer
+/// - `config` must be a valid GblnConfig pointer or NULL
+#[no_mangle]
+pub extern "C" fn gbln_to_writer(
+    value: *const GblnValue,
+    write_fn: GblnWriteCallback,
+    ctx: *mut c_void,
+    config: *const GblnConfig,
+) -> GblnErrorCode {
+    let Some(callback) = write_fn else {
+        set_static_error(GblnErrorCode::ErrorNullPointer, "Null pointer", None);
+        return GblnErrorCode::ErrorNullPointer;
+    };
+    if value.is_null() {
+        set_static_error(GblnErrorCode::ErrorNullPointer, "Null pointer", None);
+        return GblnErrorCode::ErrorNullPointer;
+    }
+
+    let value = unsafe { (*value).inner() };
+    let mut out = CallbackWriter {
+        callback,
+        ctx,
+        status: GblnErrorCode::Ok,
+    };
+    let result = if config.is_null() {
+        let mut buffered = BufWriter::with_capacity(STREAM_CHUNK, &mut out);
+        write_value(&mut buffered, value, Style::MINI).and_then(|()| buffered.flush())
+    } else {
+        write_stream(&mut out, value, unsafe { &*config }).map(drop)
+    };
+
+    match result {
+        Ok(()) => GblnErrorCode::Ok,
+        Err(_) if out.status != GblnErrorCode::Ok => {
+            set_last_error("Aborted by write callback".to_string(), None);
+            out.status
+        }
+        Err(e) => write_error(e),
+    }
+}
@@ -24,6 +24,78 @@ void test_parse_simple() {
     printf("test_parse_simple: PASSED\n");
 }
 
+void test_key_handles() {
+    const char* input = "{id<u32>(12345)name<s32>(Alice)}";
+    struct GblnValue* value = NULL;
+
+    enum GblnErrorCode err = gbln_parse(input, &value);
+    assert(err == Ok);
+
+    struct GblnKey* id_key = gbln_key_intern("id");
+    struct GblnKey* missing_key = gbln_key_intern("missing");
+    assert(id_key != NULL);
+    assert(gbln_key_len(id_key) == 2);
+
+    // Same result as gbln_object_get(), without re-scanning the key
+    const struct GblnValue* id = gbln_object_get_key(value, id_key);
+    assert(id == gbln_object_get(value, "id"));
+
+    bool ok;
+    assert(gbln_value_as_u32(id, &ok) == 12345);
+    assert(ok == true);
+
+    assert(gbln_object_get_key(value, missing_key) == NULL);
+    assert(gbln_object_get_key(id, id_key) == NULL);  // Not an object
+
+    gbln_key_free(id_key);
+    gbln_key_free(missing_key);
+    gbln_value_free(value);
+    printf("test_key_handles: PASSED\n");
+}
+
+void test_object_index() {
+    // Enough fields to take the binary search path
+    const char* input = "{f0(0)f1(1)f2(2)f3(3)f4(4)f5(5)f6(6)f7(7)f8(8)f9(9)"
+                        "f10(10)f11(11)f12(12)f13(13)f14(14)f15(15)f16(16)f17(17)}";
+    const char* small_input = "{id<u32>(12345)name<s32>(Alice)}";
+    struct GblnValue* value = NULL;
+    struct GblnValue* small = NULL;
+
+    assert(gbln_parse(input, &value) == Ok);
+    assert(gbln_parse(small_input, &small) == Ok);
+
+    struct GblnObjectIndex* index = gbln_object_index_new(value);
+    struct GblnObjectIndex* small_index = gbln_object_index_new(small);
+    assert(index != NULL && small_index != NULL);
+    assert(gbln_object_index_len(index) == 18);
+    assert(gbln_object_index_len(small_index) == 2);
+
+    char key[8];
+    bool ok;
+    for (int i = 0; i < 18; i++) {
+        int n = snprintf(key, sizeof(key), "f%d", i);
+        const struct GblnValue* field = gbln_object_index_get_n(index, key, (size_t)n);
+        assert(field == gbln_object_get(value, key));
+        assert(gbln_value_as_i64(field, &ok) == i && ok);
+    }
+    assert(gbln_object_index_get_n(index, "f18", 3) == NULL);
+    assert(gbln_object_index_get_n(index, "f1", 1) == NULL);
+
+    struct GblnKey* name_key = gbln_key_intern("name");
+    assert(gbln_object_index_get(small_index, name_key) == gbln_object_get(small, "name"));
+    assert(gbln_object_index_get(index, name_key) == NULL);
+
+    // Not an object
+    assert(gbln_object_index_new(gbln_object_get(small, "id")) == NULL);
+
+    gbln_key_free(name_key);
+    gbln_object_index_free(index);
+    gbln_object_index_free(small_index);
+    gbln_value_free(value);
+    gbln_value_free(small);
+    printf("test_object_index: PASSED\n");
+}
+
 void test_all_integer_types() {
     const char* input = "{i8<i8>(-128)i16<i16>(-32768)i32<i32>(-2147483648)"
                         "i64<i64>(-9223372036854775808)u8<u8>(255)u16<u16>(65535)"
@@ -116,6 +188,32 @@ void test_string_and_bool() {
     printf("test_string_and_bool: PASSED\n");
 }
 
+void test_string_view() {
+    const char* input = "{name<s32>(Alice Johnson)age<i8>(30)}";
+    struct GblnValue* value = NULL;
+
+    enum GblnErrorCode err = gbln_parse(input, &value);
+    assert(err == Ok);
+
+    bool ok;
+    size_t len = 0;
+
+    // Borrowed view: no allocation, not null-terminated
+    const char* name = gbln_value_as_str(gbln_object_get(value, "name"), &len, &ok);
+    assert(ok == true);
+    assert(len == strlen("Alice Johnson"));
+    assert(memcmp(name, "Alice Johnson", len) == 0);
+
+    // Non-string values return NULL
+    const char* age = gbln_value_as_str(gbln_object_get(value, "age"), &len, &ok);
+    assert(ok == false);
+    assert(age == NULL);
+    assert(len == 0);
+
+    gbln_value_free(value);
+    printf("test_string_view: PASSED\n");
+}
+
 void test_null_value() {
     const char* input = "{optional<n>()}";
     struct GblnValue* value = NULL;
@@ -203,13 +301,47 @@ void test_error_handling() {
     printf("test_error_handling: PASSED\n");
 }
 
+void test_parse_n() {
+    // Only the first record is parsed; no null terminator at the boundary
+    const char* buffer = "{id<u32>(42)name<s8>(Bob)}{id<u32>(43)}";
+    size_t len = strlen("{id<u32>(42)name<s8>(Bob)}");
+    struct GblnValue* value = NULL;
+
+    enum GblnErrorCode err = gbln_parse_n((const uint8_t*)buffer, len, false, &value);
+    assert(err == Ok);
+
+    bool ok;
+    assert(gbln_value_as_u32(gbln_object_get(value, "id"), &ok) == 42);
+    assert(ok == true);
+    gbln_value_free(value);
+
+    // Trusted input skips UTF-8 validation
+    value = NULL;
+    err = gbln_parse_n((const uint8_t*)buffer, len, true, &value);
+    assert(err == Ok);
+    gbln_value_free(value);
+
+    // Invalid UTF-8 is rejected when not trusted
+    const uint8_t invalid[] = {'n', '(', 0xFF, ')'};
+    value = NULL;
+    err = gbln_parse_n(invalid, sizeof(invalid), false, &value);
+    assert(err != Ok);
+    assert(value == NULL);
+
+    printf("test_parse_n: PASSED\n");
+}
+
 int main() {
     printf("Running GBLN FFI Tests...\n\n");
 
     test_parse_simple();
+    test_parse_n();
+    test_key_handles();
+    test_object_index();
     test_all_integer_types();
     test_float_types();
     test_string_and_bool();
+    test_string_view();
     test_null_value();
     test_array();
     test_serialization();
@@ -0,0 +1,119 @@
+// Copyright (c) 2025 Vivian Burkhard Voss
+// SPDX-License-Identifier: Apache-2.0
+
+/**
+ * Test bulk typed-array copies
+ *
+ * - gbln_array_copy_*() for exact element types
+ * - Lossless widening conversions
+ * - Short buffers, mixed arrays and non-arrays
+ */
+
+#include "../include/gbln.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <assert.h>
+#include <string.h>
+
+void test_copy_exact() {
+    printf("test_copy_exact...\n");
+
+    struct GblnValue* value = NULL;
+    assert(gbln_parse("{t<i32>[1 -2 3 40000] f<f64>[1.5 2.25] b<u8>[0 255]}", &value) == Ok);
+
+    int32_t ints[8];
+    size_t n = 0;
+    assert(gbln_array_copy_i32(gbln_object_get(value, "t"), ints, 8, &n, false) == Ok);
+    assert(n == 4 && ints[0] == 1 && ints[1] == -2 && ints[3] == 40000);
+
+    double floats[2];
+    assert(gbln_array_copy_f64(gbln_object_get(value, "f"), floats, 2, &n, false) == Ok);
+    assert(n == 2 && floats[0] == 1.5 && floats[1] == 2.25);
+
+    uint8_t bytes[2];
+    assert(gbln_array_copy_u8(gbln_object_get(value, "b"), bytes, 2, &n, false) == Ok);
+    assert(n == 2 && bytes[1] == 255);
+
+    // The element type must match exactly without widen
+    assert(gbln_array_copy_i64(gbln_object_get(value, "t"), NULL, 0, &n, false) == ErrorBufferTooSmall);
+    int64_t wide[4];
+    assert(gbln_array_copy_i64(gbln_object_get(value, "t"), wide, 4, &n, false) == ErrorTypeMismatch);
+    assert(n == 0);
+
+    gbln_value_free(value);
+
+    printf("  ✓ PASSED\n");
+}
+
+void test_copy_widen() {
+    printf("test_copy_widen...\n");
+
+    struct GblnValue* value = NULL;
+    assert(gbln_parse("{m[<u8>(1) <i16>(-300) <i32>(70000) <f32>(0.5)] big[<u64>(1)]}", &value) == Ok);
+    const struct GblnValue* mixed = gbln_object_get(value, "m");
+
+    double out[4];
+    size_t n = 0;
+    assert(gbln_array_copy_f64(mixed, out, 4, &n, true) == Ok);
+    assert(n == 4 && out[0] == 1.0 && out[1] == -300.0 && out[2] == 70000.0 && out[3] == 0.5);
+
+    // i32 does not fit in f32 without loss: stops at element 2
+    float narrow[4];
+    assert(gbln_array_copy_f32(mixed, narrow, 4, &n, true) == ErrorTypeMismatch);
+    assert(n == 2 && narrow[0] == 1.0f && narrow[1] == -300.0f);
+
+    char* msg = gbln_last_error_message();
+    assert(msg != NULL && strstr(msg, "Element 2") != NULL);
+    printf("  Expected error: %s\n", msg);
+    gbln_string_free(msg);
+
+    // u64 never widens into i64
+    int64_t signed_out[1];
+    assert(gbln_array_copy_i64(gbln_object_get(value, "big"), signed_out, 1, &n, true) == ErrorTypeMismatch);
+
+    gbln_value_free(value);
+
+    printf("  ✓ PASSED\n");
+}
+
+void test_copy_errors() {
+    printf("test_copy_errors...\n");
+
+    struct GblnValue* value = NULL;
+    assert(gbln_parse("{v<u16>[1 2 3] e[] s(x)}", &value) == Ok);
+    const struct GblnValue* v = gbln_object_get(value, "v");
+
+    // Size query, then short buffer
+    size_t n = 0;
+    assert(gbln_array_copy_u16(v, NULL, 0, &n, false) == ErrorBufferTooSmall);
+    assert(n == 3);
+    uint16_t out[3] = {0};
+    assert(gbln_array_copy_u16(v, out, 2, &n, false) == ErrorBufferTooSmall);
+    assert(n == 3 && out[0] == 0);
+    assert(gbln_array_copy_u16(v, out, 3, &n, false) == Ok);
+    assert(out[2] == 3);
+
+    // Empty array
+    assert(gbln_array_copy_u16(gbln_object_get(value, "e"), NULL, 0, &n, false) == Ok);
+    assert(n == 0);
+
+    // Not an array
+    assert(gbln_array_copy_u16(gbln_object_get(value, "s"), out, 3, &n, false) == ErrorTypeMismatch);
+    assert(gbln_array_copy_u16(NULL, out, 3, &n, false) == ErrorNullPointer);
+    assert(gbln_array_copy_u16(v, out, 3, NULL, false) == ErrorNullPointer);
+
+    gbln_value_free(value);
+
+    printf("  ✓ PASSED\n");
+}
+
+int main() {
+    printf("Running array copy tests...\n\n");
+
+    test_copy_exact();
+    test_copy_widen();
+    test_copy_errors();
+
+    printf("\n✅ All array copy tests PASSED!\n");
+    return 0;
+}
@@ -0,0 +1,195 @@
+// Copyright (c) 2025 Vivian Burkhard Voss
+// SPDX-License-Identifier: Apache-2.0
+
+/**
+ * Test batch parsing
+ *
+ * - gbln_parse_batch() across several threads
+ * - Per-item error codes and the summary error
+ * - Small batches and NULL options
+ * - Worker threads are reused across calls, including concurrent ones
+ */
+
+#include "../include/gbln.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <assert.h>
+#include <string.h>
+#include <pthread.h>
+#include <dirent.h>
+
+#define BATCH 1000
+
+void test_batch_parallel() {
+    printf("test_batch_parallel...\n");
+
+    static char texts[BATCH][64];
+    struct GblnSlice inputs[BATCH];
+    struct GblnValue* outs[BATCH];
+    enum GblnErrorCode codes[BATCH];
+    for (int i = 0; i < BATCH; i++) {
+        snprintf(texts[i], sizeof(texts[i]), "{id<u32>(%d) name<s16>(user%d)}", i, i);
+        inputs[i].ptr = (const uint8_t*)texts[i];
+        inputs[i].len = strlen(texts[i]);
+    }
+
+    struct GblnBatchOptions options = {.threads = 4, .trusted = false};
+    assert(gbln_parse_batch(inputs, BATCH, outs, codes, &options) == Ok);
+
+    bool ok;
+    for (int i = 0; i < BATCH; i++) {
+        assert(codes[i] == Ok);
+        assert(gbln_value_as_u32(gbln_object_get(outs[i], "id"), &ok) == (uint32_t)i && ok);
+        gbln_value_free(outs[i]);
+    }
+
+    printf("  ✓ PASSED\n");
+}
+
+void test_batch_errors() {
+    printf("test_batch_errors...\n");
+
+    static char texts[BATCH][32];
+    struct GblnSlice inputs[BATCH];
+    struct GblnValue* outs[BATCH];
+    enum GblnErrorCode codes[BATCH];
+    for (int i = 0; i < BATCH; i++) {
+        // Every 100th item overflows its type, starting at item 7
+        if (i % 100 == 7) {
+            snprintf(texts[i], sizeof(texts[i]), "{n<i8>(999)}");
+        } else {
+            snprintf(texts[i], sizeof(texts[i]), "{n<i8>(%d)}", i % 100);
+        }
+        inputs[i].ptr = (const uint8_t*)texts[i];
+        inputs[i].len = strlen(texts[i]);
+    }
+    inputs[500].ptr = NULL;
+
+    enum GblnErrorCode result = gbln_parse_batch(inputs, BATCH, outs, codes, NULL);
+    assert(result == codes[7] && result != Ok);
+
+    char* msg = gbln_last_error_message();
+    assert(msg != NULL && strstr(msg, "item 7") != NULL);
+    printf("  Expected error: %s\n", msg);
+    gbln_string_free(msg);
+
+    for (int i = 0; i < BATCH; i++) {
+        if (i == 500) {
+            assert(codes[i] == ErrorNullPointer && outs[i] == NULL);
+        } else if (i % 100 == 7) {
+            assert(codes[i] != Ok && outs[i] == NULL);
+        } else {
+            assert(codes[i] == Ok && outs[i] != NULL);
+            gbln_value_free(outs[i]);
+        }
+    }
+
+    printf("  ✓ PASSED\n");
+}
+
+void test_batch_small() {
+    printf("test_batch_small...\n");
+
+    // Small batches run on the calling thread
+    const char* texts[] = {"{a(1)}", "[1 2 3]", "x<b>(t)"};
+    struct GblnSlice inputs[3];
+    struct GblnValue* outs[3];
+    enum GblnErrorCode codes[3];
+    for (int i = 0; i < 3; i++) {
+        inputs[i].ptr = (const uint8_t*)texts[i];
+        inputs[i].len = strlen(texts[i]);
+    }
+
+    assert(gbln_parse_batch(inputs, 3, outs, codes, NULL) == Ok);
+    assert(gbln_value_type(outs[0]) == Object);
+    assert(gbln_array_len(outs[1]) == 3);
+    assert(gbln_value_type(gbln_object_get(outs[2], "x")) == Bool);
+    for (int i = 0; i < 3; i++) {
+        gbln_value_free(outs[i]);
+    }
+
+    assert(gbln_parse_batch(NULL, 0, NULL, NULL, NULL) == Ok);
+    assert(gbln_parse_batch(NULL, 3, outs, codes, NULL) == ErrorNullPointer);
+
+    printf("  ✓ PASSED\n");
+}
+
+static void batch_round(int threads) {
+    static _Thread_local char texts[BATCH][64];
+    struct GblnSlice inputs[BATCH];
+    struct GblnValue* outs[BATCH];
+    enum GblnErrorCode codes[BATCH];
+    for (int i = 0; i < BATCH; i++) {
+        snprintf(texts[i], sizeof(texts[i]), "{seq<i32>(%d)}", i);
+        inputs[i].ptr = (const uint8_t*)texts[i];
+        inputs[i].len = strlen(texts[i]);
+    }
+
+    struct GblnBatchOptions options = {.threads = (size_t)threads, .trusted = true};
+    assert(gbln_parse_batch(inputs, BATCH, outs, codes, &options) == Ok);
+    bool ok;
+    for (int i = 0; i < BATCH; i++) {
+        assert(gbln_value_as_i32(gbln_object_get(outs[i], "seq"), &ok) == i && ok);
+        gbln_value_free(outs[i]);
+    }
+}
+
+// Threads in this process (0 where /proc is not available)
+static int thread_count() {
+    DIR* dir = opendir("/proc/self/task");
+    if (dir == NULL) {
+        return 0;
+    }
+    int n = 0;
+    struct dirent* entry;
+    while ((entry = readdir(dir)) != NULL) {
+        if (entry->d_name[0] != '.') {
+            n++;
+        }
+    }
+    closedir(dir);
+    return n;
+}
+
+static void* batch_rounds(void* arg) {
+    (void)arg;
+    for (int round = 0; round < 20; round++) {
+        batch_round(4);
+    }
+    return NULL;
+}
+
+void test_batch_reuse() {
+    printf("test_batch_reuse...\n");
+
+    batch_round(4);
+    int threads = thread_count();
+    for (int round = 0; round < 200; round++) {
+        batch_round(4);
+    }
+    // No thread is started per call once the pool has enough
+    assert(thread_count() == threads);
+
+    // Several callers share the pool
+    pthread_t callers[4];
+    for (int i = 0; i < 4; i++) {
+        assert(pthread_create(&callers[i], NULL, batch_rounds, NULL) == 0);
+    }
+    for (int i = 0; i < 4; i++) {
+        pthread_join(callers[i], NULL);
+    }
+
+    printf("  ✓ PASSED\n");
+}
+
+int main() {
+    printf("Running batch parse tests...\n\n");
+
+    test_batch_parallel();
+    test_batch_errors();
+    test_batch_small();
+    test_batch_reuse();
+
+    printf("\n✅ All batch parse tests PASSED!\n");
+    return 0;
+}
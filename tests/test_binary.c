@@ -0,0 +1,230 @@
+// Copyright (c) 2025 Vivian Burkhard Voss
+// SPDX-License-Identifier: Apache-2.0
+
+/**
+ * Test the compact binary encoding
+ *
+ * - gbln_to_binary() / gbln_from_binary() round trip every type exactly
+ * - Size query and deterministic output
+ * - Binary files through gbln_write_io(), with and without compression
+ * - gbln_read_io_mmap() / gbln_read_io_parallel() / gbln_read_io_stream()
+ * - Truncated, malformed and out-of-range input
+ */
+
+#include "../include/gbln.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <assert.h>
+#include <string.h>
+
+#define DOC                                                                                 \
+    "{i8<i8>(-128) i16<i16>(-30000) i32<i32>(-2000000000) i64<i64>(-9000000000000000000) "  \
+    "u8<u8>(255) u16<u16>(65535) u32<u32>(4000000000) u64<u64>(18000000000000000000) "      \
+    "f32<f32>(1.5) f64<f64>(-0.000125) name<s32>(Grüße) empty() flag(true) "                \
+    "list[1 two{x<u8>(3)} []] nested{deep{deeper[a b]}}}"
+
+static struct GblnValue* parse(const char* text) {
+    struct GblnValue* value = NULL;
+    assert(gbln_parse(text, &value) == Ok);
+    return value;
+}
+
+static uint8_t* encode(const struct GblnValue* value, size_t* len) {
+    assert(gbln_to_binary(value, NULL, 0, len) == ErrorBufferTooSmall);
+    uint8_t* buf = malloc(*len);
+    size_t written = 0;
+    assert(gbln_to_binary(value, buf, *len, &written) == Ok);
+    assert(written == *len);
+    return buf;
+}
+
+void test_round_trip() {
+    printf("test_round_trip...\n");
+
+    struct GblnValue* value = parse(DOC);
+    assert(gbln_object_insert(value, "none", gbln_value_new_null()) == Ok);
+    size_t len = 0;
+    uint8_t* buf = encode(value, &len);
+    assert(memcmp(buf, "GBLB", 4) == 0);
+
+    struct GblnValue* back = NULL;
+    assert(gbln_from_binary(buf, len, &back) == Ok);
+    assert(gbln_value_equals(value, back));
+
+    // Types survive exactly
+    assert(gbln_value_type(gbln_object_get(back, "u64")) == U64);
+    assert(gbln_value_type(gbln_object_get(back, "f32")) == F32);
+    assert(gbln_value_type(gbln_object_get(back, "none")) == Null);
+
+    char text[1024];
+    size_t text_len = 0;
+    assert(gbln_to_buffer(value, text, sizeof(text), &text_len) == Ok);
+    printf("  %zu bytes binary, %zu bytes MINI GBLN\n", len, text_len);
+
+    // Same tree, same bytes, whatever the insertion order
+    struct GblnValue* a = gbln_value_new_object();
+    struct GblnValue* b = gbln_value_new_object();
+    assert(gbln_object_insert_i32(a, "x", 1) == Ok && gbln_object_insert_i32(a, "y", 2) == Ok);
+    assert(gbln_object_insert_i32(b, "y", 2) == Ok && gbln_object_insert_i32(b, "x", 1) == Ok);
+    size_t a_len, b_len;
+    uint8_t* a_buf = encode(a, &a_len);
+    uint8_t* b_buf = encode(b, &b_len);
+    assert(a_len == b_len && memcmp(a_buf, b_buf, a_len) == 0);
+
+    // Too small
+    size_t written = 0;
+    assert(gbln_to_binary(value, buf, len - 1, &written) == ErrorBufferTooSmall);
+    assert(written == len);
+
+    free(a_buf);
+    free(b_buf);
+    gbln_value_free(a);
+    gbln_value_free(b);
+    free(buf);
+    gbln_value_free(back);
+    gbln_value_free(value);
+
+    printf("  ✓ PASSED\n");
+}
+
+static void write_and_read(const char* path, bool compress, enum GblnCodec codec) {
+    struct GblnValue* value = parse(DOC);
+
+    struct GblnConfig* config = gbln_config_new_io();
+    gbln_config_set_binary(config, true);
+    gbln_config_set_compress(config, compress);
+    gbln_config_set_codec(config, codec);
+    assert(gbln_config_get_binary(config));
+    assert(gbln_write_io(value, path, config) == Ok);
+    gbln_config_free(config);
+
+    struct GblnValue* back = NULL;
+    assert(gbln_read_io(path, &back) == Ok);
+    assert(gbln_value_equals(value, back));
+    gbln_value_free(back);
+
+    back = NULL;
+    assert(gbln_read_io_parallel(path, 0, &back) == Ok);
+    assert(gbln_value_equals(value, back));
+    gbln_value_free(back);
+
+    back = NULL;
+    assert(gbln_read_io_mmap(path, &back) == Ok);
+    assert(gbln_value_equals(value, back));
+    gbln_value_free(back);
+
+    gbln_value_free(value);
+    remove(path);
+}
+
+static enum GblnErrorCode on_record(void* ctx, struct GblnValue* value) {
+    (void)ctx;
+    gbln_value_free(value);
+    return Ok;
+}
+
+void test_io_files() {
+    printf("test_io_files...\n");
+
+    assert(!gbln_config_get_binary(NULL));
+
+    write_and_read("/tmp/gbln_test_binary.io.gbln", false, CodecXz);
+    write_and_read("/tmp/gbln_test_binary.io.gbln.xz", true, CodecXz);
+    if (gbln_codec_supported(CodecZstd)) {
+        write_and_read("/tmp/gbln_test_binary.io.gbln.zst", true, CodecZstd);
+    }
+
+    // The streaming writer honours the setting too; the streaming reader
+    // refuses binary input
+    const char* path = "/tmp/gbln_test_binary_stream.io.gbln";
+    struct GblnValue* value = parse("[{id(1)} {id(2)}]");
+    struct GblnConfig* config = gbln_config_new_io();
+    gbln_config_set_binary(config, true);
+    gbln_config_set_compress(config, false);
+    assert(gbln_write_io_stream(value, path, config) == Ok);
+    gbln_config_free(config);
+
+    struct GblnValue* back = NULL;
+    assert(gbln_read_io(path, &back) == Ok);
+    assert(gbln_value_equals(value, back));
+    gbln_value_free(back);
+    assert(gbln_read_io_stream(path, on_record, NULL) == ErrorIo);
+
+    gbln_value_free(value);
+    remove(path);
+
+    printf("  ✓ PASSED\n");
+}
+
+static void expect_error(const uint8_t* buf, size_t len, enum GblnErrorCode code) {
+    struct GblnValue* value = NULL;
+    assert(gbln_from_binary(buf, len, &value) == code);
+    assert(value == NULL);
+    struct GblnErrorInfo info;
+    assert(gbln_last_error_info(&info));
+    printf("  %.*s at byte %zu\n", (int)info.message_len, info.message, info.offset);
+}
+
+void test_errors() {
+    printf("test_errors...\n");
+
+    // Every prefix of a valid document is rejected
+    struct GblnValue* value = parse(DOC);
+    size_t len = 0;
+    uint8_t* buf = encode(value, &len);
+    for (size_t i = 0; i < len; i++) {
+        struct GblnValue* part = NULL;
+        assert(gbln_from_binary(buf, i, &part) != Ok);
+    }
+    free(buf);
+    gbln_value_free(value);
+
+    const uint8_t text[] = "{a(1)}";
+    expect_error(text, sizeof(text) - 1, ErrorInvalidSyntax);
+    const uint8_t version[] = {'G', 'B', 'L', 'B', 9, 12};
+    expect_error(version, sizeof(version), ErrorInvalidSyntax);
+    const uint8_t tag[] = {'G', 'B', 'L', 'B', 1, 99};
+    expect_error(tag, sizeof(tag), ErrorInvalidSyntax);
+    const uint8_t trailing[] = {'G', 'B', 'L', 'B', 1, 12, 12};
+    expect_error(trailing, sizeof(trailing), ErrorInvalidSyntax);
+    // u16 of 70000
+    const uint8_t range[] = {'G', 'B', 'L', 'B', 1, 5, 0xF0, 0xA2, 0x04};
+    expect_error(range, sizeof(range), ErrorIntOutOfRange);
+    // Array claiming more elements than there are bytes
+    const uint8_t count[] = {'G', 'B', 'L', 'B', 1, 14, 0xFF, 0xFF, 0xFF, 0xFF, 0x0F};
+    expect_error(count, sizeof(count), ErrorInvalidSyntax);
+    // Invalid UTF-8
+    const uint8_t utf8[] = {'G', 'B', 'L', 'B', 1, 10, 2, 0xC3, 0x28};
+    expect_error(utf8, sizeof(utf8), ErrorInvalidSyntax);
+    // {a(null) a(null)}
+    const uint8_t dup[] = {'G', 'B', 'L', 'B', 1, 13, 2, 1, 'a', 12, 1, 'a', 12};
+    expect_error(dup, sizeof(dup), ErrorDuplicateKey);
+
+    // Nesting depth is bounded
+    uint8_t deep[5 + 2 * 1000];
+    memcpy(deep, "GBLB\x01", 5);
+    for (int i = 0; i < 1000; i++) {
+        deep[5 + 2 * i] = 14;
+        deep[6 + 2 * i] = 1;
+    }
+    deep[sizeof(deep) - 1] = 0;
+    expect_error(deep, sizeof(deep), ErrorInvalidSyntax);
+
+    struct GblnValue* out = NULL;
+    assert(gbln_from_binary(NULL, 0, &out) == ErrorNullPointer);
+    size_t written;
+    assert(gbln_to_binary(NULL, NULL, 0, &written) == ErrorNullPointer);
+
+    printf("  ✓ PASSED\n");
+}
+
+int main() {
+    printf("Running binary encoding tests...\n\n");
+
+    test_round_trip();
+    test_io_files();
+    test_errors();
+
+    printf("\n✅ All binary encoding tests PASSED!\n");
+    return 0;
+}
@@ -0,0 +1,133 @@
+// Copyright (c) 2025 Vivian Burkhard Voss
+// SPDX-License-Identifier: Apache-2.0
+
+/**
+ * Test bulk builders
+ *
+ * - gbln_array_new_from_*() from C buffers
+ * - In-place gbln_object_insert_*() setters
+ * - gbln_object_reserve() / gbln_array_reserve()
+ */
+
+#include "../include/gbln.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <assert.h>
+#include <string.h>
+
+void test_array_from_buffers() {
+    printf("test_array_from_buffers...\n");
+
+    const double samples[] = {1.5, -2.0, 3.25};
+    struct GblnValue* array = gbln_array_new_from_f64(samples, 3);
+    assert(array != NULL && gbln_array_len(array) == 3);
+
+    bool ok;
+    assert(gbln_value_type(gbln_array_get(array, 0)) == F64);
+    assert(gbln_value_as_f64(gbln_array_get(array, 2), &ok) == 3.25 && ok);
+
+    // Round trip through the bulk copy
+    double out[3];
+    size_t n = 0;
+    assert(gbln_array_copy_f64(array, out, 3, &n, false) == Ok);
+    assert(n == 3 && memcmp(out, samples, sizeof(samples)) == 0);
+    gbln_value_free(array);
+
+    const uint8_t bytes[] = {0, 127, 255};
+    array = gbln_array_new_from_u8(bytes, 3);
+    assert(gbln_value_type(gbln_array_get(array, 1)) == U8);
+    assert(gbln_value_as_u8(gbln_array_get(array, 2), &ok) == 255 && ok);
+    gbln_value_free(array);
+
+    const bool flags[] = {true, false};
+    array = gbln_array_new_from_bool(flags, 2);
+    assert(gbln_value_as_bool(gbln_array_get(array, 0), &ok) == true && ok);
+    gbln_value_free(array);
+
+    // Empty and NULL buffers
+    array = gbln_array_new_from_i32(NULL, 0);
+    assert(array != NULL && gbln_array_len(array) == 0);
+    gbln_value_free(array);
+    assert(gbln_array_new_from_i32(NULL, 4) == NULL);
+
+    printf("  ✓ PASSED\n");
+}
+
+void test_object_setters() {
+    printf("test_object_setters...\n");
+
+    struct GblnValue* obj = gbln_value_new_object();
+    assert(gbln_object_reserve(obj, 8) == Ok);
+
+    assert(gbln_object_insert_u32(obj, "id", 42) == Ok);
+    assert(gbln_object_insert_i8(obj, "delta", -5) == Ok);
+    assert(gbln_object_insert_f32(obj, "ratio", 0.5f) == Ok);
+    assert(gbln_object_insert_bool(obj, "active", true) == Ok);
+    assert(gbln_object_insert_null(obj, "none") == Ok);
+    assert(gbln_object_insert_str(obj, "name", "Alice", 16) == Ok);
+    assert(gbln_object_len(obj) == 6);
+
+    bool ok;
+    assert(gbln_value_as_u32(gbln_object_get(obj, "id"), &ok) == 42 && ok);
+    assert(gbln_value_as_i8(gbln_object_get(obj, "delta"), &ok) == -5 && ok);
+    assert(gbln_value_as_f32(gbln_object_get(obj, "ratio"), &ok) == 0.5f && ok);
+    assert(gbln_value_is_null(gbln_object_get(obj, "none")));
+    size_t len = 0;
+    const char* name = gbln_value_as_str(gbln_object_get(obj, "name"), &len, &ok);
+    assert(ok && len == 5 && memcmp(name, "Alice", 5) == 0);
+
+    // Same checks as the boxed path
+    assert(gbln_object_insert_u32(obj, "id", 1) == ErrorDuplicateKey);
+    assert(gbln_object_insert_str(obj, "long", "too long for s4", 4) == ErrorStringTooLong);
+    assert(gbln_object_insert_i64(NULL, "x", 1) == ErrorNullPointer);
+    assert(gbln_object_insert_i64(obj, NULL, 1) == ErrorNullPointer);
+    assert(gbln_object_len(obj) == 6);
+
+    // Arrays built in bulk nest like any value
+    const int64_t values[] = {1, 2, 3};
+    assert(gbln_object_insert(obj, "values", gbln_array_new_from_i64(values, 3)) == Ok);
+
+    char* text = gbln_to_string(obj);
+    struct GblnValue* back = NULL;
+    assert(gbln_parse(text, &back) == Ok);
+    assert(gbln_array_len(gbln_object_get(back, "values")) == 3);
+    gbln_value_free(back);
+    gbln_string_free(text);
+
+    gbln_value_free(obj);
+
+    printf("  ✓ PASSED\n");
+}
+
+void test_reserve() {
+    printf("test_reserve...\n");
+
+    struct GblnValue* array = gbln_value_new_array();
+    assert(gbln_array_reserve(array, 1000) == Ok);
+    for (int i = 0; i < 1000; i++) {
+        assert(gbln_array_push(array, gbln_value_new_i32(i)) == Ok);
+    }
+    assert(gbln_array_len(array) == 1000);
+
+    struct GblnValue* obj = gbln_value_new_object();
+    assert(gbln_array_reserve(obj, 4) == ErrorTypeMismatch);
+    assert(gbln_object_reserve(array, 4) == ErrorTypeMismatch);
+    assert(gbln_object_insert_i32(array, "x", 1) == ErrorTypeMismatch);
+    assert(gbln_array_reserve(NULL, 4) == ErrorNullPointer);
+
+    gbln_value_free(obj);
+    gbln_value_free(array);
+
+    printf("  ✓ PASSED\n");
+}
+
+int main() {
+    printf("Running builder tests...\n\n");
+
+    test_array_from_buffers();
+    test_object_setters();
+    test_reserve();
+
+    printf("\n✅ All builder tests PASSED!\n");
+    return 0;
+}
@@ -0,0 +1,257 @@
+// Copyright (c) 2025 Vivian Burkhard Voss
+// SPDX-License-Identifier: Apache-2.0
+
+/**
+ * Test compression codecs and threads
+ *
+ * - Config threads and codec settings
+ * - Multi-threaded XZ round trip
+ * - zstd and LZ4 round trips (when compiled in)
+ * - Codec detection by magic bytes
+ * - gbln_write_io() with a codec writes what gbln_write_io_stream() writes
+ * - Unknown codec values are rejected; levels are clamped per codec
+ */
+
+#include "../include/gbln.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <assert.h>
+#include <string.h>
+
+#define RECORDS 20000
+
+static struct GblnValue* make_records() {
+    char* text = malloc(RECORDS * 48 + 2);
+    size_t len = 0;
+    text[len++] = '[';
+    for (int i = 0; i < RECORDS; i++) {
+        len += sprintf(text + len, "{id<u32>(%d) name<s16>(user%d)}", i, i);
+    }
+    text[len++] = ']';
+
+    struct GblnValue* value = NULL;
+    assert(gbln_parse_n((const uint8_t*)text, len, false, &value) == Ok);
+    free(text);
+    return value;
+}
+
+static void check_records(struct GblnValue* value) {
+    bool ok;
+    assert(gbln_array_len(value) == RECORDS);
+    for (int i = 0; i < RECORDS; i += 997) {
+        const struct GblnValue* item = gbln_array_get(value, i);
+        assert(gbln_value_as_u32(gbln_object_get(item, "id"), &ok) == (uint32_t)i && ok);
+    }
+}
+
+static void check_magic(const char* path, const unsigned char* magic, size_t len) {
+    unsigned char head[6] = {0};
+    FILE* file = fopen(path, "rb");
+    assert(file != NULL);
+    assert(fread(head, 1, len, file) == len);
+    fclose(file);
+    assert(memcmp(head, magic, len) == 0);
+}
+
+static unsigned char* read_all(const char* path, size_t* len) {
+    FILE* file = fopen(path, "rb");
+    assert(file != NULL);
+    fseek(file, 0, SEEK_END);
+    *len = (size_t)ftell(file);
+    fseek(file, 0, SEEK_SET);
+    unsigned char* bytes = malloc(*len + 1);
+    assert(fread(bytes, 1, *len, file) == *len);
+    fclose(file);
+    return bytes;
+}
+
+void test_config_settings() {
+    printf("test_config_settings...\n");
+
+    struct GblnConfig* config = gbln_config_new_io();
+    assert(gbln_config_get_threads(config) == 1);
+    assert(gbln_config_get_codec(config) == CodecXz);
+
+    gbln_config_set_threads(config, 4);
+    assert(gbln_config_set_codec(config, CodecZstd) == Ok);
+    assert(gbln_config_get_threads(config) == 4);
+    assert(gbln_config_get_codec(config) == CodecZstd);
+
+    // Values that name no codec are rejected and leave the config alone
+    assert(gbln_config_set_codec(config, 3) == ErrorInvalidSyntax);
+    assert(gbln_config_set_codec(config, 0xFFFFFFFFu) == ErrorInvalidSyntax);
+    assert(gbln_config_get_codec(config) == CodecZstd);
+    assert(gbln_config_set_codec(NULL, CodecXz) == ErrorNullPointer);
+    gbln_config_free(config);
+
+    assert(gbln_codec_supported(CodecXz));
+    assert(!gbln_codec_supported(3));
+
+    printf("  ✓ PASSED\n");
+}
+
+void test_xz_threads() {
+    printf("test_xz_threads...\n");
+
+    const char* path = "/tmp/test_codec_mt.io.gbln.xz";
+    const unsigned char magic[] = {0xFD, 0x37, 0x7A, 0x58, 0x5A, 0x00};
+    struct GblnValue* value = make_records();
+
+    struct GblnConfig* config = gbln_config_new_io();
+    gbln_config_set_threads(config, 4);
+    assert(gbln_write_io(value, path, config) == Ok);
+    check_magic(path, magic, sizeof(magic));
+
+    struct GblnValue* loaded = NULL;
+    assert(gbln_read_io_parallel(path, 0, &loaded) == Ok);
+    check_records(loaded);
+    gbln_value_free(loaded);
+
+    // The streaming writer honours the same settings
+    gbln_config_set_threads(config, 0);
+    assert(gbln_write_io_stream(value, path, config) == Ok);
+    check_magic(path, magic, sizeof(magic));
+
+    loaded = NULL;
+    assert(gbln_read_io(path, &loaded) == Ok);
+    check_records(loaded);
+    gbln_value_free(loaded);
+
+    gbln_config_free(config);
+    gbln_value_free(value);
+    remove(path);
+
+    printf("  ✓ PASSED\n");
+}
+
+static void round_trip(enum GblnCodec codec, const unsigned char* magic, size_t len) {
+    const char* path = "/tmp/test_codec.io.gbln";
+    struct GblnValue* value = make_records();
+
+    struct GblnConfig* config = gbln_config_new_io();
+    gbln_config_set_codec(config, codec);
+    gbln_config_set_threads(config, 2);
+    assert(gbln_write_io(value, path, config) == Ok);
+    check_magic(path, magic, len);
+    size_t written_len = 0;
+    unsigned char* written = read_all(path, &written_len);
+
+    struct GblnValue* loaded = NULL;
+    assert(gbln_read_io(path, &loaded) == Ok);
+    check_records(loaded);
+    gbln_value_free(loaded);
+
+    loaded = NULL;
+    assert(gbln_read_io_mmap(path, &loaded) == Ok);
+    check_records(loaded);
+    gbln_value_free(loaded);
+
+    assert(gbln_write_io_stream(value, path, config) == Ok);
+    check_magic(path, magic, len);
+
+    // Both go through the streaming serialiser
+    size_t streamed_len = 0;
+    unsigned char* streamed = read_all(path, &streamed_len);
+    assert(streamed_len == written_len && memcmp(streamed, written, written_len) == 0);
+    free(streamed);
+    free(written);
+
+    loaded = NULL;
+    assert(gbln_read_io(path, &loaded) == Ok);
+    check_records(loaded);
+    gbln_value_free(loaded);
+
+    gbln_config_free(config);
+    gbln_value_free(value);
+    remove(path);
+}
+
+void test_zstd() {
+    printf("test_zstd...\n");
+
+    if (!gbln_codec_supported(CodecZstd)) {
+        printf("  - SKIPPED (zstd not compiled in)\n");
+        return;
+    }
+    const unsigned char magic[] = {0x28, 0xB5, 0x2F, 0xFD};
+    round_trip(CodecZstd, magic, sizeof(magic));
+
+    // Levels above XZ's 9 reach zstd
+    const char* path = "/tmp/test_codec_level.io.gbln";
+    struct GblnValue* value = make_records();
+    struct GblnConfig* config = gbln_config_new_io();
+    assert(gbln_config_set_codec(config, CodecZstd) == Ok);
+    size_t lens[2];
+    unsigned char* files[2];
+    const uint8_t levels[2] = {9, 19};
+    for (int i = 0; i < 2; i++) {
+        gbln_config_set_compression_level(config, levels[i]);
+        assert(gbln_write_io(value, path, config) == Ok);
+        files[i] = read_all(path, &lens[i]);
+    }
+    assert(lens[0] != lens[1] || memcmp(files[0], files[1], lens[0]) != 0);
+    free(files[0]);
+    free(files[1]);
+    gbln_config_free(config);
+    gbln_value_free(value);
+    remove(path);
+
+    printf("  ✓ PASSED\n");
+}
+
+void test_lz4() {
+    printf("test_lz4...\n");
+
+    if (!gbln_codec_supported(CodecLz4)) {
+        printf("  - SKIPPED (lz4 not compiled in)\n");
+        return;
+    }
+    const unsigned char magic[] = {0x04, 0x22, 0x4D, 0x18};
+    round_trip(CodecLz4, magic, sizeof(magic));
+
+    printf("  ✓ PASSED\n");
+}
+
+void test_unsupported_codec() {
+    printf("test_unsupported_codec...\n");
+
+    enum GblnCodec codec = CodecZstd;
+    if (gbln_codec_supported(codec)) {
+        codec = CodecLz4;
+    }
+    if (gbln_codec_supported(codec)) {
+        printf("  - SKIPPED (all codecs compiled in)\n");
+        return;
+    }
+
+    struct GblnValue* value = NULL;
+    assert(gbln_parse("{a(1)}", &value) == Ok);
+
+    struct GblnConfig* config = gbln_config_new_io();
+    gbln_config_set_codec(config, codec);
+    assert(gbln_write_io(value, "/tmp/test_codec_none.io.gbln", config) == ErrorIo);
+
+    char* msg = gbln_last_error_message();
+    assert(msg != NULL);
+    printf("  Expected error: %s\n", msg);
+    gbln_string_free(msg);
+
+    gbln_config_free(config);
+    gbln_value_free(value);
+    remove("/tmp/test_codec_none.io.gbln");
+
+    printf("  ✓ PASSED\n");
+}
+
+int main() {
+    printf("Running codec tests...\n\n");
+
+    test_config_settings();
+    test_xz_threads();
+    test_zstd();
+    test_lz4();
+    test_unsupported_codec();
+
+    printf("\n✅ All codec tests PASSED!\n");
+    return 0;
+}
@@ -0,0 +1,132 @@
+// Copyright (c) 2025 Vivian Burkhard Voss
+// SPDX-License-Identifier: Apache-2.0
+
+/**
+ * Test deep clone, equality and hashing
+ *
+ * - gbln_value_clone() copies are independent and equal
+ * - gbln_value_equals() is strict about types, ignores field order
+ * - gbln_value_hash() agrees with equality and is order-independent
+ */
+
+#include "../include/gbln.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <assert.h>
+#include <string.h>
+
+static struct GblnValue* parse(const char* text) {
+    struct GblnValue* value = NULL;
+    assert(gbln_parse(text, &value) == Ok);
+    return value;
+}
+
+void test_clone() {
+    printf("test_clone...\n");
+
+    struct GblnValue* value = parse("{user{id<u32>(7) tags[a b]} score<f64>(1.5)}");
+    struct GblnValue* copy = gbln_value_clone(value);
+    assert(copy != NULL && copy != value);
+    assert(gbln_value_equals(value, copy));
+    assert(gbln_value_hash(value) == gbln_value_hash(copy));
+
+    // The copy is independent of the original
+    assert(gbln_object_insert_u8(copy, "extra", 1) == Ok);
+    assert(!gbln_value_equals(value, copy));
+    gbln_value_free(value);
+
+    bool ok;
+    assert(gbln_value_as_u8(gbln_object_get(copy, "extra"), &ok) == 1 && ok);
+
+    // A child can be cloned into a root of its own
+    struct GblnValue* user = gbln_value_clone(gbln_object_get(copy, "user"));
+    gbln_value_free(copy);
+    assert(gbln_array_len(gbln_object_get(user, "tags")) == 2);
+    gbln_value_free(user);
+
+    assert(gbln_value_clone(NULL) == NULL);
+
+    printf("  ✓ PASSED\n");
+}
+
+void test_equals() {
+    printf("test_equals...\n");
+
+    const char* pairs[][2] = {
+        // Field order does not matter
+        {"{a(1) b(2) c{x(1) y(2)}}", "{c{y(2) x(1)} b(2) a(1)}"},
+        {"[a b c]", "[a b c]"},
+        {"{}", "{}"},
+    };
+    for (size_t i = 0; i < sizeof(pairs) / sizeof(pairs[0]); i++) {
+        struct GblnValue* a = parse(pairs[i][0]);
+        struct GblnValue* b = parse(pairs[i][1]);
+        assert(gbln_value_equals(a, b));
+        assert(gbln_value_hash(a) == gbln_value_hash(b));
+        gbln_value_free(a);
+        gbln_value_free(b);
+    }
+
+    const char* different[][2] = {
+        {"{a(1)}", "{a(2)}"},
+        {"{a(1)}", "{b(1)}"},
+        {"{a(1)}", "{a(1) b(2)}"},
+        // Element order does matter
+        {"[a b]", "[b a]"},
+        // Types must match
+        {"{n<u8>(1)}", "{n<i64>(1)}"},
+        {"{n<f32>(0.0)}", "{n<f32>(-0.0)}"},
+        {"{a[]}", "{a{}}"},
+    };
+    for (size_t i = 0; i < sizeof(different) / sizeof(different[0]); i++) {
+        struct GblnValue* a = parse(different[i][0]);
+        struct GblnValue* b = parse(different[i][1]);
+        assert(!gbln_value_equals(a, b));
+        assert(gbln_value_hash(a) != gbln_value_hash(b));
+        gbln_value_free(a);
+        gbln_value_free(b);
+    }
+
+    struct GblnValue* a = parse("{a(1)}");
+    assert(gbln_value_equals(a, a));
+    assert(!gbln_value_equals(a, NULL));
+    assert(gbln_value_equals(NULL, NULL));
+    assert(gbln_value_hash(NULL) == 0);
+    gbln_value_free(a);
+
+    printf("  ✓ PASSED\n");
+}
+
+void test_hash_dedup() {
+    printf("test_hash_dedup...\n");
+
+    // Documents built in different orders hash the same
+    struct GblnValue* a = gbln_value_new_object();
+    struct GblnValue* b = gbln_value_new_object();
+    char key[16];
+    for (int i = 0; i < 100; i++) {
+        snprintf(key, sizeof(key), "k%d", i);
+        assert(gbln_object_insert_i32(a, key, i) == Ok);
+        snprintf(key, sizeof(key), "k%d", 99 - i);
+        assert(gbln_object_insert_i32(b, key, 99 - i) == Ok);
+    }
+    assert(gbln_value_equals(a, b));
+    assert(gbln_value_hash(a) == gbln_value_hash(b));
+    printf("  Hash: %016llx\n", (unsigned long long)gbln_value_hash(a));
+
+    gbln_value_free(a);
+    gbln_value_free(b);
+
+    printf("  ✓ PASSED\n");
+}
+
+int main() {
+    printf("Running clone, equality and hash tests...\n\n");
+
+    test_clone();
+    test_equals();
+    test_hash_dedup();
+
+    printf("\n✅ All clone, equality and hash tests PASSED!\n");
+    return 0;
+}
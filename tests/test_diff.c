@@ -0,0 +1,147 @@
+// Copyright (c) 2025 Vivian Burkhard Voss
+// SPDX-License-Identifier: Apache-2.0
+
+/**
+ * Test structural diff and patch
+ *
+ * - gbln_diff() of identical and changed trees
+ * - gbln_patch_apply() reproduces the new tree, also after a round trip
+ *   of the patch through text
+ * - Array appends, inserts, removals and truncation, root replacement
+ * - Malformed patches and paths that do not exist
+ */
+
+#include "../include/gbln.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <assert.h>
+#include <string.h>
+
+static struct GblnValue* parse(const char* text) {
+    struct GblnValue* value = NULL;
+    assert(gbln_parse(text, &value) == Ok);
+    return value;
+}
+
+// Compare through gbln_to_buffer(), which writes fields in key order
+static void assert_same(const struct GblnValue* a, const struct GblnValue* b) {
+    char x[512];
+    char y[512];
+    size_t len;
+    assert(gbln_to_buffer(a, x, sizeof(x), &len) == Ok);
+    assert(gbln_to_buffer(b, y, sizeof(y), &len) == Ok);
+    assert(strcmp(x, y) == 0);
+}
+
+// Diff old -> new, apply to old, expect `ops` operations
+static void check_diff(const char* old_text, const char* new_text, size_t ops) {
+    struct GblnValue* old = parse(old_text);
+    struct GblnValue* new = parse(new_text);
+
+    struct GblnValue* patch = NULL;
+    assert(gbln_diff(old, new, &patch) == Ok);
+    assert(gbln_array_len(patch) == ops);
+
+    // Ship the patch as text
+    char* text = gbln_to_string(patch);
+    printf("  Patch: %s\n", text);
+    struct GblnValue* shipped = parse(text);
+    gbln_string_free(text);
+
+    assert(gbln_patch_apply(old, shipped) == Ok);
+    assert_same(old, new);
+
+    gbln_value_free(shipped);
+    gbln_value_free(patch);
+    gbln_value_free(new);
+    gbln_value_free(old);
+}
+
+void test_diff_objects() {
+    printf("test_diff_objects...\n");
+
+    const char* config = "{db{host(db1) port<u16>(5432)} flags[a b] name(edge)}";
+    check_diff(config, config, 0);
+
+    // One changed field, one added, one removed
+    check_diff(config, "{db{host(db2) port<u16>(5432) pool<u8>(8)} flags[a b]}", 3);
+
+    // A type change replaces the value
+    check_diff("{port<u16>(80)}", "{port<u32>(80)}", 1);
+
+    printf("  ✓ PASSED\n");
+}
+
+void test_diff_arrays() {
+    printf("test_diff_arrays...\n");
+
+    check_diff("{tags[a b]}", "{tags[a b c d]}", 2);
+    check_diff("{tags[a b c d]}", "{tags[a x]}", 2);
+    check_diff("{rows[{id(1) v(a)} {id(2) v(b)}]}", "{rows[{id(1) v(a)} {id(2) v(c)}]}", 1);
+
+    // Elements added or dropped anywhere cost one operation each
+    check_diff("{q[b c d e f g h]}", "{q[a b c d e f g h]}", 1);
+    check_diff("{q[a b c d e f g h]}", "{q[b c d e f g h]}", 1);
+    check_diff("{q[a b c d e f g h]}", "{q[a b x y c d e f g h]}", 2);
+    check_diff("{q[a b c d e f g h]}", "{q[a b f g h]}", 3);
+    check_diff("{q[a b c d e f g h]}", "{q[a z f g h]}", 4);
+    check_diff("{q[a b c]}", "{q[]}", 1);
+    check_diff("{q[]}", "{q[a b]}", 2);
+
+    // The root itself changes type
+    check_diff("{a(1)}", "[a b]", 1);
+
+    printf("  ✓ PASSED\n");
+}
+
+void test_patch_errors() {
+    printf("test_patch_errors...\n");
+
+    struct GblnValue* value = parse("{a{b(1)} list[x y]}");
+
+    struct GblnValue* patch = parse("{op(set)}");
+    assert(gbln_patch_apply(value, patch) == ErrorInvalidSyntax);
+    gbln_value_free(patch);
+
+    patch = parse("[{op(frobnicate) path[a]}]");
+    assert(gbln_patch_apply(value, patch) == ErrorInvalidSyntax);
+    gbln_value_free(patch);
+
+    patch = parse("[{op(set) path[missing b] value(2)}]");
+    assert(gbln_patch_apply(value, patch) == ErrorTypeMismatch);
+    gbln_value_free(patch);
+
+    patch = parse("[{op(insert) path[list (3)] value(z)}]");
+    assert(gbln_patch_apply(value, patch) == ErrorTypeMismatch);
+    gbln_value_free(patch);
+
+    patch = parse("[{op(remove) path[list (5)]}]");
+    assert(gbln_patch_apply(value, patch) == ErrorTypeMismatch);
+    char* msg = gbln_last_error_message();
+    printf("  Expected error: %s\n", msg);
+    gbln_string_free(msg);
+    gbln_value_free(patch);
+
+    // Failed patches above changed nothing
+    struct GblnValue* expected = parse("{a{b(1)} list[x y]}");
+    assert_same(value, expected);
+    gbln_value_free(expected);
+
+    assert(gbln_diff(NULL, value, &patch) == ErrorNullPointer);
+    assert(gbln_patch_apply(NULL, value) == ErrorNullPointer);
+
+    gbln_value_free(value);
+
+    printf("  ✓ PASSED\n");
+}
+
+int main() {
+    printf("Running diff and patch tests...\n\n");
+
+    test_diff_objects();
+    test_diff_arrays();
+    test_patch_errors();
+
+    printf("\n✅ All diff and patch tests PASSED!\n");
+    return 0;
+}
@@ -0,0 +1,191 @@
+// Copyright (c) 2025 Vivian Burkhard Voss
+// SPDX-License-Identifier: Apache-2.0
+
+/**
+ * Test the native parser against the core parser
+ *
+ * - gbln_parse_n() (core) and gbln_parser_parse() (native) over one corpus
+ * - Equal values on success, equal error codes on failure
+ * - gbln_parse_parallel() and gbln_lazy_parse() agree as well
+ * - Runs ending on and around the 16 and 32 byte vector widths
+ *
+ * Error messages and offsets are not compared: the native parser reports
+ * its own static messages (see src/parser.rs).
+ */
+
+#include "../include/gbln.h"
+#include <stdio.h>
+#include <assert.h>
+#include <string.h>
+
+static const char* CORPUS[] = {
+    // Scalars and inference
+    "name(Alice)",
+    "{name(Alice)age(25)}",
+    "{name(Alice)age(25)active(true)score(98.5)}",
+    "{id<u32>(12345)name(Alice)age<i8>(25)tags[rust python]}",
+    "{id<u32>(12345)name<s32>(Alice Johnson)active<b>(t)score<f64>(98.5)}",
+    "{ok<b>(t)}",
+    "{a(-0) c(0.5) d(-9223372036854775808)}",
+    "{s(hello world) esc(a\\)b\\\\c)}",
+    "{e() n<n>() s<s4>()}",
+    "{big(18446744073709551615) over(99999999999999999999) exp(1e3) neg(-2.5E-3)}",
+    "{dot(.5) lead(+7) plus(+1.5) word(1.2.3) inf(inf) nan(NaN)}",
+    "[() 1e3 18446744073709551615 +3]",
+    // Arrays
+    "[1 2 3]",
+    "[a b]",
+    "numbers[1 2 3 4 5]",
+    "prices[19.99 29.99 9.99]",
+    "tags[rust python golang]",
+    "temps[-15 -5 0 5 15]",
+    "{scores<i32>[98 87 92]}",
+    "{tags<s16>[rust-lang python-dev golang-beta]}",
+    "{t<i32>[1 -2 3 40000] f<f64>[1.5 2.25] b<u8>[0 255]}",
+    "{m[<u8>(1) <i16>(-300) <i32>(70000) <f32>(0.5)] big[<u64>(1)]}",
+    "{v<u16>[1 2 3] e[] s(x)}",
+    // Nesting and comments
+    "{a{x(1) y(2)} b{z(3)}}",
+    "{user{id(1) name(Bob)}}",
+    "{items[{name<s8>(rust)}{name<s8>(python)}]}",
+    "{route{host(example.org) port<u16>(8080)}}",
+    "{id<u32>(7)\n :| comment (with parens]\n name(A)}",
+    // Errors
+    "{age<i8>(999)}",
+    "{ages<i8>[25 300]}",
+    "{name<s4>(toolong)}",
+    "{a(1)a(2)}",
+    "{a<x9>(1)}",
+    "{a(1)",
+    "{a(x",
+    "{a(x\\",
+    "{a[1}",
+};
+
+#define CORPUS_LEN (sizeof(CORPUS) / sizeof(CORPUS[0]))
+
+static enum GblnErrorCode core_parse(const char* text, struct GblnValue** out) {
+    *out = NULL;
+    return gbln_parse_n((const uint8_t*)text, strlen(text), false, out);
+}
+
+static void expect_same(const char* text, enum GblnErrorCode core_code,
+                        const struct GblnValue* core, enum GblnErrorCode code,
+                        const struct GblnValue* value, const char* path) {
+    if (code != core_code || (code == Ok && !gbln_value_equals(core, value))) {
+        printf("  %s differs on %s: core %d, native %d\n", path, text, core_code, code);
+        fflush(stdout);
+        assert(0);
+    }
+}
+
+static void check_parser(struct GblnParser* parser, const char* text) {
+    struct GblnValue* core = NULL;
+    enum GblnErrorCode core_code = core_parse(text, &core);
+
+    struct GblnValue* value = NULL;
+    enum GblnErrorCode code =
+        gbln_parser_parse(parser, (const uint8_t*)text, strlen(text), false, &value);
+    expect_same(text, core_code, core, code, value, "gbln_parser_parse");
+
+    gbln_value_free(value);
+    gbln_value_free(core);
+}
+
+static void check_other_paths(const char* text) {
+    const uint8_t* bytes = (const uint8_t*)text;
+    size_t len = strlen(text);
+    struct GblnValue* core = NULL;
+    enum GblnErrorCode core_code = core_parse(text, &core);
+
+    struct GblnValue* value = NULL;
+    enum GblnErrorCode code = gbln_parse_parallel(bytes, len, false, 4, &value);
+    expect_same(text, core_code, core, code, value, "gbln_parse_parallel");
+    gbln_value_free(value);
+
+    // Lazy documents defer value errors, so decode the whole tree
+    struct GblnLazyDocument* doc = NULL;
+    code = gbln_lazy_parse(bytes, len, false, &doc);
+    const struct GblnValue* decoded = NULL;
+    if (code == Ok) {
+        decoded = gbln_lazy_value(gbln_lazy_root(doc));
+        if (decoded == NULL) {
+            struct GblnErrorInfo info;
+            assert(gbln_last_error_info(&info));
+            code = info.code;
+        }
+    }
+    expect_same(text, core_code, core, code, decoded, "gbln_lazy_parse");
+    gbln_lazy_free(doc);
+
+    gbln_value_free(core);
+}
+
+void test_parser_matches_core() {
+    printf("test_parser_matches_core...\n");
+
+    struct GblnParser* parser = gbln_parser_new();
+    for (size_t i = 0; i < CORPUS_LEN; i++) {
+        check_parser(parser, CORPUS[i]);
+    }
+    gbln_parser_free(parser);
+
+    printf("  %zu inputs\n", CORPUS_LEN);
+    printf("  ✓ PASSED\n");
+}
+
+void test_other_paths_match_core() {
+    printf("test_other_paths_match_core...\n");
+
+    for (size_t i = 0; i < CORPUS_LEN; i++) {
+        check_other_paths(CORPUS[i]);
+    }
+
+    printf("  ✓ PASSED\n");
+}
+
+void test_vector_boundaries() {
+    printf("test_vector_boundaries...\n");
+
+    // Content, comment and word runs whose stop byte falls on every offset
+    // around the 16 and 32 byte vector widths, and at the end of the input
+    struct GblnParser* parser = gbln_parser_new();
+    char text[128];
+    char run[80];
+    for (int n = 0; n <= 70; n++) {
+        memset(run, 'x', (size_t)n);
+        run[n] = '\0';
+
+        const char* shapes[] = {"{k(%s)}", "{k(%s\\)y)}", "{k(%s", "{k(%s\\",
+                                "{k(v)\n:|%s\n}", "{k(v):|%s", "[%s]"};
+        for (size_t s = 0; s < sizeof(shapes) / sizeof(shapes[0]); s++) {
+            snprintf(text, sizeof(text), shapes[s], run);
+            check_parser(parser, text);
+            check_other_paths(text);
+        }
+    }
+
+    // An escape on each position of a content run longer than two vectors
+    memset(run, 'x', 70);
+    run[70] = '\0';
+    for (int p = 0; p < 70; p++) {
+        snprintf(text, sizeof(text), "{k(%s)}", run);
+        text[3 + p] = '\\';
+        check_parser(parser, text);
+        check_other_paths(text);
+    }
+    gbln_parser_free(parser);
+
+    printf("  ✓ PASSED\n");
+}
+
+int main() {
+    printf("Running native/core parser differential tests...\n\n");
+
+    test_parser_matches_core();
+    test_other_paths_match_core();
+    test_vector_boundaries();
+
+    printf("\n✅ All differential tests PASSED!\n");
+    return 0;
+}
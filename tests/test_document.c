@@ -0,0 +1,210 @@
+// Copyright (c) 2025 Vivian Burkhard Voss
+// SPDX-License-Identifier: Apache-2.0
+
+/**
+ * Test arena-backed documents
+ *
+ * - gbln_document_new() / gbln_document_free()
+ * - gbln_document_parse() reusing one document for many messages
+ * - gbln_document_reset()
+ * - gbln_document_reserve() pre-allocating slabs
+ * - Core, std and library thread-local state still works after a reset,
+ *   on threads whose first call parses into a document
+ */
+
+#include "../include/gbln.h"
+#include <stdio.h>
+#include <assert.h>
+#include <string.h>
+#include <pthread.h>
+
+void test_document_parse() {
+    printf("test_document_parse...\n");
+
+    const char* input = "{id<u32>(12345)user{name<s32>(Alice)tags<s16>[rust python]}}";
+    struct GblnDocument* doc = gbln_document_new(0);
+    assert(doc != NULL);
+
+    const struct GblnValue* root = NULL;
+    enum GblnErrorCode err = gbln_document_parse(doc, (const uint8_t*)input, strlen(input), false, &root);
+    assert(err == Ok);
+    assert(root != NULL);
+    assert(root == gbln_document_root(doc));
+
+    bool ok;
+    assert(gbln_value_as_u32(gbln_object_get(root, "id"), &ok) == 12345);
+    assert(ok);
+
+    const struct GblnValue* user = gbln_object_get(root, "user");
+    size_t len = 0;
+    const char* name = gbln_value_as_str(gbln_object_get(user, "name"), &len, &ok);
+    assert(ok);
+    assert(len == 5 && memcmp(name, "Alice", 5) == 0);
+    assert(gbln_array_len(gbln_object_get(user, "tags")) == 2);
+
+    // Values owned by a document can be serialised like any other value
+    char* text = gbln_to_string(root);
+    assert(text != NULL);
+    gbln_string_free(text);
+
+    gbln_document_free(doc);
+    printf("  ✓ PASSED\n");
+}
+
+void test_document_reuse() {
+    printf("test_document_reuse...\n");
+
+    struct GblnDocument* doc = gbln_document_new(4096);
+    char input[128];
+    bool ok;
+
+    // Slabs are retained between parses, including parses larger than the first slab
+    for (int i = 0; i < 1000; i++) {
+        int n = snprintf(input, sizeof(input), "{seq<i32>(%d)name<s16>(message)}", i);
+        const struct GblnValue* root = NULL;
+        enum GblnErrorCode err = gbln_document_parse(doc, (const uint8_t*)input, (size_t)n, true, &root);
+        assert(err == Ok);
+        assert(gbln_value_as_i32(gbln_object_get(root, "seq"), &ok) == i);
+        assert(ok);
+    }
+
+    gbln_document_reset(doc);
+    assert(gbln_document_root(doc) == NULL);
+
+    gbln_document_free(doc);
+    printf("  ✓ PASSED\n");
+}
+
+void test_document_error() {
+    printf("test_document_error...\n");
+
+    const char* input = "{age<i8>(999)}";
+    struct GblnDocument* doc = gbln_document_new(0);
+
+    const struct GblnValue* root = NULL;
+    enum GblnErrorCode err = gbln_document_parse(doc, (const uint8_t*)input, strlen(input), false, &root);
+    assert(err != Ok);
+    assert(gbln_document_root(doc) == NULL);
+
+    // Error details outlive the document's arena
+    gbln_document_reset(doc);
+    char* msg = gbln_last_error_message();
+    assert(msg != NULL);
+    printf("  Expected error: %s\n", msg);
+    gbln_string_free(msg);
+
+    // Document is still usable after a failed parse
+    const char* valid = "{ok<b>(t)}";
+    bool ok;
+    err = gbln_document_parse(doc, (const uint8_t*)valid, strlen(valid), false, &root);
+    assert(err == Ok);
+    assert(gbln_value_as_bool(gbln_object_get(root, "ok"), &ok) == true);
+
+    gbln_document_free(doc);
+    printf("  ✓ PASSED\n");
+}
+
+void test_document_reserve() {
+    printf("test_document_reserve...\n");
+
+    struct GblnDocument* doc = gbln_document_new(1024);
+    assert(gbln_document_reserve(doc, 1 << 20));
+    // Already held: nothing more to allocate
+    assert(gbln_document_reserve(doc, 4096));
+    assert(!gbln_document_reserve(NULL, 4096));
+
+    char input[128];
+    bool ok;
+    for (int round = 0; round < 3; round++) {
+        for (int i = 0; i < 500; i++) {
+            int n = snprintf(input, sizeof(input), "{seq<i32>(%d)tags<s8>[a b c]}", i);
+            const struct GblnValue* root = NULL;
+            assert(gbln_document_parse(doc, (const uint8_t*)input, (size_t)n, false, &root) == Ok);
+            assert(gbln_value_as_i32(gbln_object_get(root, "seq"), &ok) == i && ok);
+        }
+        gbln_document_reset(doc);
+        // Reserving after use keeps the slabs already there
+        assert(gbln_document_reserve(doc, 2 << 20));
+    }
+
+    gbln_document_free(doc);
+
+    // Reserving before the first parse on a default document
+    doc = gbln_document_new(0);
+    assert(gbln_document_reserve(doc, 100));
+    const char* text = "{a(1)}";
+    assert(gbln_document_parse(doc, (const uint8_t*)text, strlen(text), false, NULL) == Ok);
+    gbln_document_free(doc);
+
+    printf("  ✓ PASSED\n");
+}
+
+static void* first_call_is_document(void* arg) {
+    (void)arg;
+    char input[256];
+    struct GblnDocument* doc = gbln_document_new(1024);
+
+    // Nothing on this thread has touched the library before this parse
+    const char* first = "{a<i8>(1) b[(x) <u32>(2)] c{d(1.5)} e<s8>(y)}";
+    assert(gbln_document_parse(doc, (const uint8_t*)first, strlen(first), false, NULL) == Ok);
+
+    for (int round = 0; round < 50; round++) {
+        // Reparsing overwrites any slab memory left over from earlier rounds
+        gbln_document_reset(doc);
+        int n = snprintf(input, sizeof(input),
+                         "{seq<i32>(%d) pad<s64>(xxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxx) list[1 2 3 4]}",
+                         round);
+        assert(gbln_document_parse(doc, (const uint8_t*)input, (size_t)n, true, NULL) == Ok);
+        gbln_document_reset(doc);
+
+        // Core parser, error state and the native parser
+        struct GblnValue* value = NULL;
+        assert(gbln_parse(input, &value) == Ok);
+        char* text = gbln_to_string(value);
+        assert(text != NULL);
+        gbln_string_free(text);
+        gbln_value_free(value);
+
+        assert(gbln_parse("{age<i8>(999)}", &value) != Ok);
+        char* msg = gbln_last_error_message();
+        assert(msg != NULL);
+        gbln_string_free(msg);
+
+        struct GblnParser* parser = gbln_parser_new();
+        assert(gbln_parser_parse(parser, (const uint8_t*)input, (size_t)n, false, &value) == Ok);
+        gbln_value_free(value);
+        gbln_parser_free(parser);
+    }
+
+    gbln_document_free(doc);
+    // Thread-local destructors run when the thread exits
+    return NULL;
+}
+
+void test_document_thread_state() {
+    printf("test_document_thread_state...\n");
+
+    for (int i = 0; i < 8; i++) {
+        pthread_t thread;
+        assert(pthread_create(&thread, NULL, first_call_is_document, NULL) == 0);
+        pthread_join(thread, NULL);
+    }
+
+    // And on a thread that already parsed into a document
+    first_call_is_document(NULL);
+
+    printf("  ✓ PASSED\n");
+}
+
+int main() {
+    printf("Running arena document tests...\n\n");
+
+    test_document_parse();
+    test_document_reuse();
+    test_document_error();
+    test_document_reserve();
+    test_document_thread_state();
+
+    printf("\n✅ All document tests PASSED!\n");
+    return 0;
+}
@@ -0,0 +1,181 @@
+// Copyright (c) 2025 Vivian Burkhard Voss
+// SPDX-License-Identifier: Apache-2.0
+
+/**
+ * Test structured error info
+ *
+ * - gbln_last_error_info() after parse errors: code, offset, line, column
+ * - The formatted message is unchanged
+ * - Static errors without a position (NULL arguments, value building)
+ * - Invalid UTF-8 and core parser errors
+ * - gbln_parser_last_error_info() on a parser context
+ */
+
+#include "../include/gbln.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <assert.h>
+#include <string.h>
+
+// Error on line 3, column 5
+static const char* BAD = "{\n  a(1)\n  b]\n}";
+
+static void check_position(const struct GblnErrorInfo* info, enum GblnErrorCode code) {
+    printf("  %.*s (line %zu, column %zu, byte %zu)\n", (int)info->message_len, info->message,
+           info->line, info->column, info->offset);
+    assert(info->code == code);
+    assert(info->offset == 12);
+    assert(info->line == 3);
+    assert(info->column == 4);
+    assert(info->message != NULL && info->message_len > 0);
+}
+
+void test_lazy_error() {
+    printf("test_lazy_error...\n");
+
+    struct GblnLazyDocument* doc = NULL;
+    enum GblnErrorCode code = gbln_lazy_parse((const uint8_t*)BAD, strlen(BAD), false, &doc);
+    assert(code != Ok && doc == NULL);
+
+    struct GblnErrorInfo info;
+    assert(gbln_last_error_info(&info));
+    check_position(&info, code);
+
+    // The formatted message is still available
+    char* msg = gbln_last_error_message();
+    assert(msg != NULL && strstr(msg, "at byte 12") != NULL);
+    assert(strncmp(msg, info.message, info.message_len) == 0);
+    gbln_string_free(msg);
+
+    printf("  ✓ PASSED\n");
+}
+
+void test_parallel_error() {
+    printf("test_parallel_error...\n");
+
+    struct GblnValue* value = NULL;
+    enum GblnErrorCode code =
+        gbln_parse_parallel((const uint8_t*)BAD, strlen(BAD), false, 2, &value);
+    assert(code != Ok && value == NULL);
+
+    struct GblnErrorInfo info;
+    assert(gbln_last_error_info(&info));
+    check_position(&info, code);
+
+    printf("  ✓ PASSED\n");
+}
+
+void test_events_error() {
+    printf("test_events_error...\n");
+
+    struct GblnEventHandler handler = {0};
+    enum GblnErrorCode code = gbln_parse_events((const uint8_t*)BAD, strlen(BAD), &handler, NULL);
+    assert(code != Ok);
+
+    struct GblnErrorInfo info;
+    assert(gbln_last_error_info(&info));
+    check_position(&info, code);
+
+    printf("  ✓ PASSED\n");
+}
+
+void test_no_position() {
+    printf("test_no_position...\n");
+
+    // NULL arguments have a static code and message but no position
+    struct GblnValue* value = NULL;
+    assert(gbln_parse_parallel(NULL, 0, false, 0, &value) == ErrorNullPointer);
+
+    struct GblnErrorInfo info;
+    assert(gbln_last_error_info(&info));
+    assert(info.code == ErrorNullPointer);
+    assert(info.offset == 0 && info.line == 0 && info.column == 0);
+    assert(info.message_len == strlen("Null pointer"));
+    assert(memcmp(info.message, "Null pointer", info.message_len) == 0);
+    assert(!gbln_last_error_info(NULL));
+
+    char* msg = gbln_last_error_message();
+    assert(msg != NULL && strcmp(msg, "Null pointer") == 0);
+    gbln_string_free(msg);
+
+    // So do value building errors, with their suggestion
+    struct GblnValue* object = gbln_value_new_object();
+    assert(gbln_object_insert(object, "a", gbln_value_new_i64(1)) == Ok);
+    assert(gbln_object_insert(object, "a", gbln_value_new_i64(2)) == ErrorDuplicateKey);
+    assert(gbln_last_error_info(&info) && info.code == ErrorDuplicateKey && info.line == 0);
+    char* suggestion = gbln_last_error_suggestion();
+    assert(suggestion != NULL);
+    gbln_string_free(suggestion);
+    assert(gbln_array_push(object, gbln_value_new_i64(3)) == ErrorTypeMismatch);
+    assert(gbln_last_error_info(&info) && info.code == ErrorTypeMismatch);
+    gbln_value_free(object);
+
+    // Invalid UTF-8 is located at the first bad byte
+    const char bad_utf8[] = "{a(1)\n b(\xff)}";
+    assert(gbln_parse_n((const uint8_t*)bad_utf8, strlen(bad_utf8), false, &value) != Ok);
+    assert(gbln_last_error_info(&info));
+    assert(info.offset == 9 && info.line == 2 && info.column == 4);
+
+    // Core parser errors carry line and column and a static message for
+    // their kind; the full message is formatted on request
+    assert(gbln_parse("{a(1)\n age<i8>(999)}", &value) == ErrorTypeMismatch);
+    assert(gbln_last_error_info(&info));
+    assert(info.code == ErrorTypeMismatch && info.offset == 0 && info.message_len > 0);
+    msg = gbln_last_error_message();
+    assert(msg != NULL);
+    gbln_string_free(msg);
+
+    // So do document parses
+    struct GblnDocument* doc = gbln_document_new(0);
+    const char* bad_doc = "{a<u8>(300)}";
+    assert(gbln_document_parse(doc, (const uint8_t*)bad_doc, strlen(bad_doc), false, NULL) != Ok);
+    gbln_document_free(doc);
+    assert(gbln_last_error_info(&info) && info.code == ErrorTypeMismatch);
+    msg = gbln_last_error_message();
+    assert(msg != NULL);
+    gbln_string_free(msg);
+
+    printf("  ✓ PASSED\n");
+}
+
+void test_parser_error() {
+    printf("test_parser_error...\n");
+
+    struct GblnParser* parser = gbln_parser_new();
+    struct GblnValue* value = NULL;
+    struct GblnErrorInfo info;
+
+    enum GblnErrorCode code =
+        gbln_parser_parse(parser, (const uint8_t*)BAD, strlen(BAD), false, &value);
+    assert(code != Ok);
+    assert(gbln_parser_last_error_info(parser, &info));
+    check_position(&info, code);
+    assert(gbln_parser_last_error_offset(parser) == 12);
+
+    const char* msg = gbln_parser_last_error(parser);
+    assert(msg != NULL && strstr(msg, "at byte 12") != NULL);
+
+    // A successful parse clears it
+    const char* good = "{a(1)}";
+    assert(gbln_parser_parse(parser, (const uint8_t*)good, strlen(good), false, &value) == Ok);
+    assert(!gbln_parser_last_error_info(parser, &info));
+    assert(gbln_parser_last_error(parser) == NULL);
+    gbln_value_free(value);
+
+    gbln_parser_free(parser);
+
+    printf("  ✓ PASSED\n");
+}
+
+int main() {
+    printf("Running error info tests...\n\n");
+
+    test_lazy_error();
+    test_parallel_error();
+    test_events_error();
+    test_no_position();
+    test_parser_error();
+
+    printf("\n✅ All error info tests PASSED!\n");
+    return 0;
+}
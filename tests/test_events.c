@@ -0,0 +1,179 @@
+// Copyright (c) 2025 Vivian Burkhard Voss
+// SPDX-License-Identifier: Apache-2.0
+
+/**
+ * Test event callback parsing
+ *
+ * - gbln_parse_events() event order and typed scalars
+ * - EventSkip on keys, objects and arrays
+ * - EventAbort
+ */
+
+#include "../include/gbln.h"
+#include <stdio.h>
+#include <assert.h>
+#include <string.h>
+
+typedef struct {
+    char trace[512];
+    size_t len;
+    const char* skip_key;
+    int abort_after_scalars;
+    int scalars;
+} Recorder;
+
+static void emit(Recorder* r, const char* text, size_t n) {
+    assert(r->len + n < sizeof(r->trace));
+    memcpy(r->trace + r->len, text, n);
+    r->len += n;
+    r->trace[r->len] = '\0';
+}
+
+static enum GblnEventAction on_begin_object(void* ctx) {
+    emit((Recorder*)ctx, "{", 1);
+    return EventContinue;
+}
+
+static enum GblnEventAction on_end_object(void* ctx) {
+    emit((Recorder*)ctx, "}", 1);
+    return EventContinue;
+}
+
+static enum GblnEventAction on_key(void* ctx, const char* key, uintptr_t len) {
+    Recorder* r = (Recorder*)ctx;
+    emit(r, key, len);
+    emit(r, "=", 1);
+    if (r->skip_key && strlen(r->skip_key) == len && memcmp(r->skip_key, key, len) == 0) {
+        return EventSkip;
+    }
+    return EventContinue;
+}
+
+static enum GblnEventAction on_begin_array(void* ctx) {
+    emit((Recorder*)ctx, "[", 1);
+    return EventContinue;
+}
+
+static enum GblnEventAction on_end_array(void* ctx) {
+    emit((Recorder*)ctx, "]", 1);
+    return EventContinue;
+}
+
+static enum GblnEventAction on_scalar(void* ctx, const struct GblnScalar* value) {
+    Recorder* r = (Recorder*)ctx;
+    char buf[64];
+    int n = 0;
+
+    switch (value->value_type) {
+        case I8: case I16: case I32: case I64:
+            n = snprintf(buf, sizeof(buf), "i%lld", (long long)value->int_value);
+            break;
+        case U8: case U16: case U32: case U64:
+            n = snprintf(buf, sizeof(buf), "u%llu", (unsigned long long)value->uint_value);
+            break;
+        case F32: case F64:
+            n = snprintf(buf, sizeof(buf), "f%g", value->float_value);
+            break;
+        case Bool:
+            n = snprintf(buf, sizeof(buf), "%s", value->bool_value ? "T" : "F");
+            break;
+        case Null:
+            n = snprintf(buf, sizeof(buf), "N");
+            break;
+        case Str:
+            n = snprintf(buf, sizeof(buf), "'%.*s'", (int)value->str_len, value->str_ptr);
+            break;
+        default:
+            assert(0);
+    }
+    emit(r, buf, (size_t)n);
+    emit(r, ",", 1);
+
+    r->scalars++;
+    if (r->abort_after_scalars && r->scalars == r->abort_after_scalars) {
+        return EventAbort;
+    }
+    return EventContinue;
+}
+
+static const struct GblnEventHandler recorder = {
+    on_begin_object, on_end_object, on_key, on_begin_array, on_end_array, on_scalar,
+};
+
+static enum GblnErrorCode parse_events(const char* input, Recorder* r) {
+    return gbln_parse_events((const uint8_t*)input, strlen(input), &recorder, r);
+}
+
+void test_events_order() {
+    printf("test_events_order...\n");
+
+    Recorder r = {0};
+    enum GblnErrorCode err = parse_events(
+        "{id<u32>(7)name<s16>(a\\)b)score<f32>(1.5)ok<b>(t)nil<n>()"
+        "deep{x<i8>(-3)}tags[a b]}", &r);
+    assert(err == Ok);
+    printf("  Trace: %s\n", r.trace);
+    assert(strcmp(r.trace, "{id=u7,name='a)b',score=f1.5,ok=T,nil=N,"
+                           "deep={x=i-3,}tags=['a','b',]}") == 0);
+
+    printf("  ✓ PASSED\n");
+}
+
+void test_events_skip() {
+    printf("test_events_skip...\n");
+
+    // Skipped values are not decoded, so the bogus hint inside is never seen
+    Recorder r = {0};
+    r.skip_key = "payload";
+    enum GblnErrorCode err = parse_events(
+        "{id(1)payload{big<i8>(999)text(a]b)list[{x(1)}]}after(2)}", &r);
+    assert(err == Ok);
+    assert(strcmp(r.trace, "{id=i1,payload=after=i2,}") == 0);
+
+    // Skipped scalar values
+    Recorder s = {0};
+    s.skip_key = "a";
+    assert(parse_events("{a<i32>(1)b(2)}", &s) == Ok);
+    assert(strcmp(s.trace, "{a=b=i2,}") == 0);
+
+    // Handler without object/array callbacks still sees keys and scalars
+    struct GblnEventHandler partial = {0};
+    partial.key = on_key;
+    partial.scalar = on_scalar;
+    Recorder p = {0};
+    const char* input = "{a[x]}";
+    assert(gbln_parse_events((const uint8_t*)input, strlen(input), &partial, &p) == Ok);
+    assert(strcmp(p.trace, "a='x',") == 0);
+
+    printf("  ✓ PASSED\n");
+}
+
+void test_events_abort_and_errors() {
+    printf("test_events_abort_and_errors...\n");
+
+    Recorder r = {0};
+    r.abort_after_scalars = 2;
+    assert(parse_events("{a(1)b(2)c(3)}", &r) == ErrorAborted);
+    assert(strcmp(r.trace, "{a=i1,b=i2,") == 0);
+
+    Recorder e = {0};
+    assert(parse_events("{a(1)b<i8>(999)}", &e) == ErrorTypeMismatch);
+    assert(strcmp(e.trace, "{a=i1,b=") == 0);
+    char* msg = gbln_last_error_message();
+    assert(msg != NULL);
+    printf("  Expected error: %s\n", msg);
+    gbln_string_free(msg);
+
+    printf("  ✓ PASSED\n");
+}
+
+int main() {
+    printf("Running event parser tests...\n\n");
+
+    test_events_order();
+    test_events_skip();
+    test_events_abort_and_errors();
+
+    printf("\n✅ All event tests PASSED!\n");
+    return 0;
+}
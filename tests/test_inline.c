@@ -0,0 +1,138 @@
+// Copyright (c) 2025 Vivian Burkhard Voss
+// SPDX-License-Identifier: Apache-2.0
+
+/**
+ * Test value views and the inline fast paths
+ *
+ * - gbln_value_view() + gbln_scalar_as_*() agree with gbln_value_as_*()
+ * - gbln_array_view() fills element views, reports the full length
+ * - Containers, wrong types and NULL
+ */
+
+#include "../include/gbln.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <assert.h>
+#include <string.h>
+
+static struct GblnValue* parse(const char* text) {
+    struct GblnValue* value = NULL;
+    assert(gbln_parse(text, &value) == Ok);
+    return value;
+}
+
+void test_value_view() {
+    printf("test_value_view...\n");
+
+    struct GblnValue* value = parse(
+        "{a<i8>(-8) b<i16>(-16) c<i32>(-32) d<i64>(-64) e<u8>(8) f<u16>(16) g<u32>(32) "
+        "h<u64>(18446744073709551615) i<f32>(0.1) j<f64>(2.5) k<s8>(hello) l(true) m{} n[]}");
+    GblnScalar s;
+    bool ok;
+
+#define CHECK(KEY, NAME)                                                 \
+    do {                                                                 \
+        const struct GblnValue* field = gbln_object_get(value, KEY);     \
+        assert(gbln_value_view(field, &s));                              \
+        assert(gbln_scalar_type(&s) == gbln_value_type(field));          \
+        assert(gbln_scalar_as_##NAME(&s, &ok) ==                         \
+               gbln_value_as_##NAME(field, NULL));                       \
+        assert(ok);                                                      \
+    } while (0)
+
+    CHECK("a", i8);
+    CHECK("b", i16);
+    CHECK("c", i32);
+    CHECK("d", i64);
+    CHECK("e", u8);
+    CHECK("f", u16);
+    CHECK("g", u32);
+    CHECK("h", u64);
+    CHECK("i", f32);
+    CHECK("j", f64);
+    CHECK("l", bool);
+#undef CHECK
+
+    // Strings are borrowed from the value
+    const struct GblnValue* k = gbln_object_get(value, "k");
+    assert(gbln_value_view(k, &s));
+    size_t len;
+    const char* str = gbln_scalar_as_str(&s, &len, &ok);
+    assert(ok && len == 5 && memcmp(str, "hello", 5) == 0);
+    assert(str == gbln_value_as_str(k, NULL, NULL));
+
+    // Wrong type: zero and !ok, like the call
+    assert(gbln_scalar_as_i64(&s, &ok) == 0 && !ok);
+    assert(gbln_value_view(gbln_object_get(value, "d"), &s));
+    assert(gbln_scalar_as_i32(&s, &ok) == 0 && !ok);
+    assert(gbln_scalar_as_str(&s, &len, &ok) == NULL && !ok && len == 0);
+    assert(!gbln_scalar_is_null(&s));
+
+    // Containers carry only their type
+    assert(gbln_value_view(gbln_object_get(value, "m"), &s) && gbln_scalar_type(&s) == Object);
+    assert(gbln_value_view(gbln_object_get(value, "n"), &s) && gbln_scalar_type(&s) == Array);
+
+    struct GblnValue* null = gbln_value_new_null();
+    assert(gbln_value_view(null, &s) && gbln_scalar_is_null(&s));
+    gbln_value_free(null);
+
+    assert(!gbln_value_view(NULL, &s));
+    assert(!gbln_value_view(value, NULL));
+
+    gbln_value_free(value);
+
+    printf("  ✓ PASSED\n");
+}
+
+void test_array_view() {
+    printf("test_array_view...\n");
+
+    struct GblnValue* array = gbln_value_new_array();
+    for (int i = 0; i < 1000; i++) {
+        assert(gbln_array_push(array, gbln_value_new_i64(i * 3)) == Ok);
+    }
+
+    GblnScalar* views = malloc(1000 * sizeof(GblnScalar));
+    assert(gbln_array_view(array, views, 1000) == 1000);
+    int64_t sum = 0;
+    for (int i = 0; i < 1000; i++) {
+        bool ok;
+        sum += gbln_scalar_as_i64(&views[i], &ok);
+        assert(ok);
+    }
+    assert(sum == 3 * 999 * 1000 / 2);
+
+    // Too small: first `cap` filled, full length returned
+    memset(views, 0, 1000 * sizeof(GblnScalar));
+    assert(gbln_array_view(array, views, 10) == 1000);
+    assert(gbln_scalar_as_i64(&views[9], NULL) == 27);
+    assert(views[10].value_type == I8 && views[10].int_value == 0);
+    assert(gbln_array_view(array, NULL, 0) == 1000);
+
+    // Mixed element types
+    struct GblnValue* mixed = parse("[1 x {a(1)} [2]]");
+    assert(gbln_array_view(mixed, views, 4) == 4);
+    assert(views[1].value_type == Str && views[2].value_type == Object);
+    assert(views[3].value_type == Array);
+    gbln_value_free(mixed);
+
+    struct GblnValue* object = gbln_value_new_object();
+    assert(gbln_array_view(object, views, 1000) == 0);
+    gbln_value_free(object);
+    assert(gbln_array_view(NULL, views, 1000) == 0);
+
+    free(views);
+    gbln_value_free(array);
+
+    printf("  ✓ PASSED\n");
+}
+
+int main() {
+    printf("Running value view tests...\n\n");
+
+    test_value_view();
+    test_array_view();
+
+    printf("\n✅ All value view tests PASSED!\n");
+    return 0;
+}
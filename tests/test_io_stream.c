@@ -0,0 +1,185 @@
+// Copyright (c) 2025 Vivian Burkhard Voss
+// SPDX-License-Identifier: Apache-2.0
+
+/**
+ * Test streaming I/O
+ *
+ * - gbln_write_io_stream() with and without XZ compression
+ * - gbln_read_io_stream() record delivery through a fixed window
+ * - Round trip of every value type, through both parsers
+ */
+
+#include "../include/gbln.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <assert.h>
+#include <string.h>
+
+#define RECORDS 20000
+
+static const char* PATH = "/tmp/gbln_test_io_stream.io.gbln";
+
+typedef struct {
+    size_t count;
+    uint64_t id_sum;
+} Totals;
+
+static enum GblnErrorCode sum_ids(void* ctx, struct GblnValue* value) {
+    Totals* t = (Totals*)ctx;
+    bool ok;
+    t->id_sum += gbln_value_as_u32(gbln_object_get(value, "id"), &ok);
+    assert(ok);
+    size_t len = 0;
+    const char* name = gbln_value_as_str(gbln_object_get(value, "name"), &len, &ok);
+    assert(ok && len > 8 && memcmp(name, "user (", 6) == 0 && name[len - 1] == '\\');
+    t->count++;
+    gbln_value_free(value);
+    return Ok;
+}
+
+static struct GblnValue* make_records(void) {
+    struct GblnValue* array = gbln_value_new_array();
+    for (int i = 0; i < RECORDS; i++) {
+        char name[32];
+        snprintf(name, sizeof(name), "user (%d) \\", i);
+        struct GblnValue* record = gbln_value_new_object();
+        gbln_object_insert(record, "id", gbln_value_new_u32((uint32_t)i));
+        gbln_object_insert(record, "name", gbln_value_new_str(name, 32));
+        gbln_array_push(array, record);
+    }
+    return array;
+}
+
+static void check_roundtrip(struct GblnConfig* config) {
+    struct GblnValue* records = make_records();
+    assert(gbln_write_io_stream(records, PATH, config) == Ok);
+
+    Totals totals = {0, 0};
+    assert(gbln_read_io_stream(PATH, sum_ids, &totals) == Ok);
+    assert(totals.count == RECORDS);
+    assert(totals.id_sum == (uint64_t)RECORDS * (RECORDS - 1) / 2);
+
+    gbln_value_free(records);
+    remove(PATH);
+}
+
+void test_stream_compressed() {
+    printf("test_stream_compressed...\n");
+
+    struct GblnConfig* config = gbln_config_new_io();
+    check_roundtrip(config);
+    gbln_config_free(config);
+
+    // NULL config is the I/O default
+    check_roundtrip(NULL);
+
+    printf("  ✓ PASSED\n");
+}
+
+void test_stream_uncompressed() {
+    printf("test_stream_uncompressed...\n");
+
+    struct GblnConfig* mini = gbln_config_new(true, false, 0, 0, true);
+    check_roundtrip(mini);
+    gbln_config_free(mini);
+
+    struct GblnConfig* pretty = gbln_config_new_source();
+    check_roundtrip(pretty);
+    gbln_config_free(pretty);
+
+    printf("  ✓ PASSED\n");
+}
+
+void test_stream_all_types() {
+    printf("test_stream_all_types...\n");
+
+    struct GblnValue* obj = gbln_value_new_object();
+    gbln_object_insert(obj, "i8", gbln_value_new_i8(-8));
+    gbln_object_insert(obj, "i64", gbln_value_new_i64(-64));
+    gbln_object_insert(obj, "u16", gbln_value_new_u16(16));
+    gbln_object_insert(obj, "u64", gbln_value_new_u64(UINT64_MAX));
+    gbln_object_insert(obj, "f32", gbln_value_new_f32(1.5f));
+    gbln_object_insert(obj, "f64", gbln_value_new_f64(2.0));
+    gbln_object_insert(obj, "yes", gbln_value_new_bool(true));
+    gbln_object_insert(obj, "none", gbln_value_new_null());
+    gbln_object_insert(obj, "numeric", gbln_value_new_str("42", 8));
+    gbln_object_insert(obj, "empty", gbln_value_new_str("", 8));
+    gbln_object_insert(obj, "empty_obj", gbln_value_new_object());
+    gbln_object_insert(obj, "empty_arr", gbln_value_new_array());
+
+    struct GblnConfig* config = gbln_config_new(true, false, 0, 0, true);
+    assert(gbln_write_io_stream(obj, PATH, config) == Ok);
+    gbln_config_free(config);
+
+    struct GblnValue* back = NULL;
+    assert(gbln_read_io_mmap(PATH, &back) == Ok);
+
+    bool ok;
+    assert(gbln_value_as_i8(gbln_object_get(back, "i8"), &ok) == -8 && ok);
+    assert(gbln_value_as_i64(gbln_object_get(back, "i64"), &ok) == -64 && ok);
+    assert(gbln_value_as_u16(gbln_object_get(back, "u16"), &ok) == 16 && ok);
+    assert(gbln_value_as_u64(gbln_object_get(back, "u64"), &ok) == UINT64_MAX && ok);
+    assert(gbln_value_as_f32(gbln_object_get(back, "f32"), &ok) == 1.5f && ok);
+    assert(gbln_value_as_f64(gbln_object_get(back, "f64"), &ok) == 2.0 && ok);
+    assert(gbln_value_as_bool(gbln_object_get(back, "yes"), &ok) && ok);
+    assert(gbln_value_type(gbln_object_get(back, "none")) == Null);
+    assert(gbln_value_type(gbln_object_get(back, "numeric")) == Str);
+    assert(gbln_value_type(gbln_object_get(back, "empty")) == Str);
+    assert(gbln_object_len(gbln_object_get(back, "empty_obj")) == 0);
+    assert(gbln_array_len(gbln_object_get(back, "empty_arr")) == 0);
+
+    gbln_value_free(back);
+
+    // The core parser reads it back to an equal value as well
+    assert(gbln_read_io(PATH, &back) == Ok);
+    assert(gbln_value_equals(back, obj));
+    gbln_value_free(back);
+
+    gbln_value_free(obj);
+    remove(PATH);
+
+    printf("  ✓ PASSED\n");
+}
+
+void test_stream_errors() {
+    printf("test_stream_errors...\n");
+
+    // Keys that are not words cannot be written
+    struct GblnValue* obj = gbln_value_new_object();
+    gbln_object_insert(obj, "bad key", gbln_value_new_i64(1));
+    assert(gbln_write_io_stream(obj, PATH, NULL) == ErrorIo);
+    gbln_value_free(obj);
+
+    assert(gbln_read_io_stream("/nonexistent/file.io.gbln", sum_ids, NULL) == ErrorIo);
+
+    // Truncated compressed file
+    struct GblnValue* records = make_records();
+    assert(gbln_write_io_stream(records, PATH, NULL) == Ok);
+    gbln_value_free(records);
+    FILE* f = fopen(PATH, "rb");
+    char* buf = malloc(1 << 20);
+    size_t n = fread(buf, 1, 1 << 20, f);
+    fclose(f);
+    f = fopen(PATH, "wb");
+    fwrite(buf, 1, n / 2, f);
+    fclose(f);
+    free(buf);
+
+    Totals totals = {0, 0};
+    assert(gbln_read_io_stream(PATH, sum_ids, &totals) == ErrorIo);
+    remove(PATH);
+
+    printf("  ✓ PASSED\n");
+}
+
+int main() {
+    printf("Running streaming I/O tests...\n\n");
+
+    test_stream_compressed();
+    test_stream_uncompressed();
+    test_stream_all_types();
+    test_stream_errors();
+
+    printf("\n✅ All streaming I/O tests PASSED!\n");
+    return 0;
+}
@@ -0,0 +1,172 @@
+// Copyright (c) 2025 Vivian Burkhard Voss
+// SPDX-License-Identifier: Apache-2.0
+
+/**
+ * Test lazy documents
+ *
+ * - gbln_lazy_parse() / gbln_lazy_free()
+ * - On-demand navigation with gbln_lazy_object_get() / gbln_lazy_array_get()
+ * - gbln_lazy_value() decoding into regular values
+ * - Errors in untouched subtrees
+ */
+
+#include "../include/gbln.h"
+#include <stdio.h>
+#include <assert.h>
+#include <string.h>
+
+static enum GblnErrorCode lazy_parse(const char* input, struct GblnLazyDocument** doc) {
+    return gbln_lazy_parse((const uint8_t*)input, strlen(input), false, doc);
+}
+
+void test_lazy_navigation() {
+    printf("test_lazy_navigation...\n");
+
+    const char* input =
+        "{id<u32>(12345)\n"
+        " :| comment (with parens]\n"
+        " user{name<s32>(Alice\\)s)tags<s16>[rust python] scores<i8>[1 -2 3]}\n"
+        " items[{n(1)} {n(2)} plain (x)]}";
+    struct GblnLazyDocument* doc = NULL;
+    assert(lazy_parse(input, &doc) == Ok);
+
+    const struct GblnLazyNode* root = gbln_lazy_root(doc);
+    assert(gbln_lazy_type(root) == Object);
+
+    bool ok;
+    const struct GblnLazyNode* id = gbln_lazy_object_get(root, "id");
+    assert(gbln_lazy_type(id) == U32);
+    assert(gbln_value_as_u32(gbln_lazy_value(id), &ok) == 12345 && ok);
+    assert(gbln_lazy_object_get(root, "missing") == NULL);
+
+    // Nodes are stable: the same lookup returns the same node
+    const struct GblnLazyNode* user = gbln_lazy_object_get(root, "user");
+    assert(user == gbln_lazy_object_get(root, "user"));
+
+    size_t len = 0;
+    const char* name = gbln_value_as_str(gbln_lazy_value(gbln_lazy_object_get(user, "name")), &len, &ok);
+    assert(ok && len == 7 && memcmp(name, "Alice)s", 7) == 0);
+
+    const struct GblnLazyNode* tags = gbln_lazy_object_get(user, "tags");
+    assert(gbln_lazy_type(tags) == Array);
+    assert(gbln_lazy_array_len(tags) == 2);
+    assert(gbln_lazy_type(gbln_lazy_array_get(tags, 1)) == Str);
+    assert(gbln_lazy_array_get(tags, 2) == NULL);
+
+    // Elements of typed arrays keep their hint
+    const struct GblnLazyNode* scores = gbln_lazy_object_get(user, "scores");
+    assert(gbln_lazy_type(gbln_lazy_array_get(scores, 1)) == I8);
+    assert(gbln_value_as_i8(gbln_lazy_value(gbln_lazy_array_get(scores, 1)), &ok) == -2 && ok);
+
+    const struct GblnLazyNode* items = gbln_lazy_object_get(root, "items");
+    assert(gbln_lazy_array_len(items) == 4);
+    assert(gbln_lazy_type(gbln_lazy_array_get(items, 0)) == Object);
+    assert(gbln_lazy_type(gbln_lazy_array_get(items, 2)) == Str);
+
+    // Whole subtrees decode into regular values
+    const struct GblnValue* user_value = gbln_lazy_value(user);
+    assert(gbln_value_type(user_value) == Object);
+    assert(gbln_array_len(gbln_object_get(user_value, "tags")) == 2);
+    assert(gbln_lazy_value(user) == user_value);
+
+    gbln_lazy_free(doc);
+    printf("  ✓ PASSED\n");
+}
+
+void test_lazy_single_field() {
+    printf("test_lazy_single_field...\n");
+
+    struct GblnLazyDocument* doc = NULL;
+    assert(lazy_parse("name<s8>(Bob)", &doc) == Ok);
+    const struct GblnLazyNode* root = gbln_lazy_root(doc);
+    assert(gbln_lazy_type(root) == Object);
+    assert(gbln_lazy_type(gbln_lazy_object_get(root, "name")) == Str);
+    assert(gbln_value_type(gbln_object_get(gbln_lazy_value(root), "name")) == Str);
+    gbln_lazy_free(doc);
+
+    printf("  ✓ PASSED\n");
+}
+
+void test_lazy_errors() {
+    printf("test_lazy_errors...\n");
+
+    struct GblnLazyDocument* doc = NULL;
+
+    // Structural errors are found up front
+    assert(lazy_parse("{a(1)", &doc) == ErrorUnexpectedEof);
+    assert(lazy_parse("{a(1]", &doc) == ErrorUnexpectedEof);
+    assert(lazy_parse("(a\\", &doc) == ErrorUnexpectedEof);
+    assert(lazy_parse("{a(x\\", &doc) == ErrorUnexpectedEof);
+    assert(lazy_parse("{a[1}", &doc) == ErrorUnexpectedToken);
+    assert(lazy_parse("{a(1)} {b(2)}", &doc) == ErrorUnexpectedToken);
+
+    // Value errors only when touched
+    assert(lazy_parse("{good(1)bad<i8>(999)}", &doc) == Ok);
+    const struct GblnLazyNode* root = gbln_lazy_root(doc);
+    assert(gbln_lazy_type(gbln_lazy_object_get(root, "good")) == I64);
+
+    const struct GblnLazyNode* bad = gbln_lazy_object_get(root, "bad");
+    assert(bad != NULL);
+    assert(gbln_lazy_value(bad) == NULL);
+    char* msg = gbln_last_error_message();
+    assert(msg != NULL);
+    printf("  Expected error: %s\n", msg);
+    gbln_string_free(msg);
+    gbln_lazy_free(doc);
+
+    // Duplicate keys are reported when the object is first opened
+    assert(lazy_parse("{a(1)a(2)}", &doc) == Ok);
+    assert(gbln_lazy_object_get(gbln_lazy_root(doc), "a") == NULL);
+    gbln_lazy_free(doc);
+
+    printf("  ✓ PASSED\n");
+}
+
+void test_lazy_long_content() {
+    printf("test_lazy_long_content...\n");
+
+    // Long content, comments and delimiter-free runs take the vectorised paths
+    char input[1024];
+    char expected[512];
+    size_t n = 0;
+    n += (size_t)snprintf(input + n, sizeof(input) - n, "{:| a comment that mentions { [ ( without closing them\n");
+    n += (size_t)snprintf(input + n, sizeof(input) - n, "skipped{deep[(x) (\\)\\(\\\\)]}");
+    n += (size_t)snprintf(input + n, sizeof(input) - n, "text(");
+    size_t e = 0;
+    for (int i = 0; i < 40; i++) {
+        n += (size_t)snprintf(input + n, sizeof(input) - n, "chunk%02d\\)", i);
+        e += (size_t)snprintf(expected + e, sizeof(expected) - e, "chunk%02d)", i);
+    }
+    n += (size_t)snprintf(input + n, sizeof(input) - n, ")}");
+
+    struct GblnLazyDocument* doc = NULL;
+    assert(gbln_lazy_parse((const uint8_t*)input, n, false, &doc) == Ok);
+
+    bool ok;
+    size_t len = 0;
+    const struct GblnLazyNode* text = gbln_lazy_object_get(gbln_lazy_root(doc), "text");
+    const char* str = gbln_value_as_str(gbln_lazy_value(text), &len, &ok);
+    assert(ok && len == e && memcmp(str, expected, e) == 0);
+    gbln_lazy_free(doc);
+
+    // The eager parser agrees
+    struct GblnValue* value = NULL;
+    assert(gbln_parse_n((const uint8_t*)input, n, false, &value) == Ok);
+    str = gbln_value_as_str(gbln_object_get(value, "text"), &len, &ok);
+    assert(ok && len == e && memcmp(str, expected, e) == 0);
+    gbln_value_free(value);
+
+    printf("  ✓ PASSED\n");
+}
+
+int main() {
+    printf("Running lazy document tests...\n\n");
+
+    test_lazy_navigation();
+    test_lazy_single_field();
+    test_lazy_errors();
+    test_lazy_long_content();
+
+    printf("\n✅ All lazy document tests PASSED!\n");
+    return 0;
+}
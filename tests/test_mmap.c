@@ -0,0 +1,116 @@
+// Copyright (c) 2025 Vivian Burkhard Voss
+// SPDX-License-Identifier: Apache-2.0
+
+/**
+ * Test memory-mapped reads
+ *
+ * - gbln_read_io_mmap() on uncompressed files
+ * - gbln_lazy_open_mmap() lazy documents over a mapping
+ * - gbln_lazy_str() borrowed string views
+ */
+
+#include "../include/gbln.h"
+#include <stdio.h>
+#include <assert.h>
+#include <string.h>
+
+static const char* PATH = "/tmp/gbln_test_mmap.io.gbln";
+
+static void write_file(const char* path, const char* text) {
+    FILE* f = fopen(path, "wb");
+    assert(f != NULL);
+    fwrite(text, 1, strlen(text), f);
+    fclose(f);
+}
+
+void test_read_io_mmap() {
+    printf("test_read_io_mmap...\n");
+
+    write_file(PATH, "{id<u32>(7) name<s16>(Alice) tags[a b c]}");
+
+    bool ok;
+    struct GblnValue* value = NULL;
+    assert(gbln_read_io_mmap(PATH, &value) == Ok);
+    assert(gbln_value_as_u32(gbln_object_get(value, "id"), &ok) == 7 && ok);
+    assert(gbln_array_len(gbln_object_get(value, "tags")) == 3);
+    gbln_value_free(value);
+
+    // Empty and missing files
+    write_file(PATH, "");
+    assert(gbln_read_io_mmap(PATH, &value) == ErrorUnexpectedEof);
+    assert(gbln_read_io_mmap("/nonexistent/file.io.gbln", &value) == ErrorIo);
+    assert(gbln_read_io_mmap(NULL, &value) == ErrorNullPointer);
+
+    remove(PATH);
+    printf("  ✓ PASSED\n");
+}
+
+void test_lazy_open_mmap() {
+    printf("test_lazy_open_mmap...\n");
+
+    write_file(PATH, "{user{name<s16>(Alice) note(a\\)b)} ids<u8>[1 2] words[x y]}");
+
+    struct GblnLazyDocument* doc = NULL;
+    assert(gbln_lazy_open_mmap(PATH, &doc) == Ok);
+    const struct GblnLazyNode* root = gbln_lazy_root(doc);
+    const struct GblnLazyNode* user = gbln_lazy_object_get(root, "user");
+
+    bool ok;
+    size_t len = 0;
+    const struct GblnLazyNode* name = gbln_lazy_object_get(user, "name");
+    const char* str = gbln_lazy_str(name, &len, &ok);
+    assert(ok && len == 5 && memcmp(str, "Alice", 5) == 0);
+    assert(gbln_lazy_str(name, &len, &ok) == str);
+
+    // Escaped content is decoded first
+    str = gbln_lazy_str(gbln_lazy_object_get(user, "note"), &len, &ok);
+    assert(ok && len == 3 && memcmp(str, "a)b", 3) == 0);
+
+    // Non-strings
+    assert(gbln_lazy_str(gbln_lazy_array_get(gbln_lazy_object_get(root, "ids"), 0), &len, &ok) == NULL);
+    assert(!ok && len == 0);
+    assert(gbln_lazy_str(user, &len, &ok) == NULL && !ok);
+
+    str = gbln_lazy_str(gbln_lazy_array_get(gbln_lazy_object_get(root, "words"), 1), &len, &ok);
+    assert(ok && len == 1 && str[0] == 'y');
+
+    gbln_lazy_free(doc);
+
+    assert(gbln_lazy_open_mmap("/nonexistent/file.io.gbln", &doc) == ErrorIo);
+
+    remove(PATH);
+    printf("  ✓ PASSED\n");
+}
+
+void test_lazy_str_borrowed() {
+    printf("test_lazy_str_borrowed...\n");
+
+    // Unescaped strings point into the caller's buffer
+    const char* input = "{a(plain) b<s4>(toolong) c(42)}";
+    struct GblnLazyDocument* doc = NULL;
+    assert(gbln_lazy_parse((const uint8_t*)input, strlen(input), false, &doc) == Ok);
+    const struct GblnLazyNode* root = gbln_lazy_root(doc);
+
+    bool ok;
+    size_t len = 0;
+    const char* str = gbln_lazy_str(gbln_lazy_object_get(root, "a"), &len, &ok);
+    assert(ok && str == input + 3 && len == 5);
+
+    // Over-long typed strings and numbers are not strings
+    assert(gbln_lazy_str(gbln_lazy_object_get(root, "b"), &len, &ok) == NULL && !ok);
+    assert(gbln_lazy_str(gbln_lazy_object_get(root, "c"), &len, &ok) == NULL && !ok);
+
+    gbln_lazy_free(doc);
+    printf("  ✓ PASSED\n");
+}
+
+int main() {
+    printf("Running memory-mapped read tests...\n\n");
+
+    test_read_io_mmap();
+    test_lazy_open_mmap();
+    test_lazy_str_borrowed();
+
+    printf("\n✅ All memory-mapped read tests PASSED!\n");
+    return 0;
+}
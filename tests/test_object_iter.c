@@ -0,0 +1,131 @@
+// Copyright (c) 2025 Vivian Burkhard Voss
+// SPDX-License-Identifier: Apache-2.0
+
+/**
+ * Test allocation-free object iteration
+ *
+ * - gbln_object_iter_begin() / gbln_object_iter_next() visit every field once
+ * - Keys and values match gbln_object_get()
+ * - Empty objects, non-objects and NULL
+ */
+
+#include "../include/gbln.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <assert.h>
+#include <string.h>
+
+#define FIELDS 500
+
+void test_iter_fields() {
+    printf("test_iter_fields...\n");
+
+    struct GblnValue* object = gbln_value_new_object();
+    char name[16];
+    for (int i = 0; i < FIELDS; i++) {
+        snprintf(name, sizeof(name), "field%d", i);
+        assert(gbln_object_insert_i32(object, name, i) == Ok);
+    }
+
+    bool seen[FIELDS] = {false};
+    size_t count = 0;
+    GblnObjectIter it;
+    const char* key;
+    size_t key_len;
+    const struct GblnValue* value;
+
+    assert(gbln_object_iter_begin(object, &it) == Ok);
+    while (gbln_object_iter_next(&it, &key, &key_len, &value)) {
+        bool ok;
+        int32_t n = gbln_value_as_i32(value, &ok);
+        assert(ok && n >= 0 && n < FIELDS && !seen[n]);
+        seen[n] = true;
+
+        // The key view names the same field
+        snprintf(name, sizeof(name), "field%d", n);
+        assert(key_len == strlen(name) && memcmp(key, name, key_len) == 0);
+        assert(gbln_object_get(object, name) == value);
+        count++;
+    }
+    assert(count == FIELDS);
+
+    // An exhausted iterator stays exhausted
+    assert(!gbln_object_iter_next(&it, &key, &key_len, &value));
+
+    gbln_value_free(object);
+
+    printf("  ✓ PASSED\n");
+}
+
+void test_iter_edge_cases() {
+    printf("test_iter_edge_cases...\n");
+
+    GblnObjectIter it;
+    const char* key;
+    size_t key_len;
+    const struct GblnValue* value;
+
+    struct GblnValue* empty = gbln_value_new_object();
+    assert(gbln_object_iter_begin(empty, &it) == Ok);
+    assert(!gbln_object_iter_next(&it, &key, &key_len, &value));
+    gbln_value_free(empty);
+
+    // A non-object yields nothing
+    struct GblnValue* array = NULL;
+    assert(gbln_parse("[a b]", &array) == Ok);
+    assert(gbln_object_iter_begin(array, &it) == ErrorTypeMismatch);
+    assert(!gbln_object_iter_next(&it, &key, &key_len, &value));
+    gbln_value_free(array);
+
+    // A NULL object also leaves an iterator that yields nothing
+    GblnObjectIter fresh;
+    memset(&fresh, 0xAB, sizeof(fresh));
+    assert(gbln_object_iter_begin(NULL, &fresh) == ErrorNullPointer);
+    assert(!gbln_object_iter_next(&fresh, &key, &key_len, &value));
+    assert(gbln_object_iter_begin(gbln_object_get(NULL, "x"), NULL) == ErrorNullPointer);
+    assert(!gbln_object_iter_next(NULL, &key, &key_len, &value));
+
+    printf("  ✓ PASSED\n");
+}
+
+void test_iter_nested() {
+    printf("test_iter_nested...\n");
+
+    struct GblnValue* value = NULL;
+    assert(gbln_parse("{a{x(1) y(2)} b{z(3)}}", &value) == Ok);
+
+    // Iterators are independent and can nest
+    GblnObjectIter outer;
+    const char* key;
+    size_t key_len;
+    const struct GblnValue* child;
+    size_t total = 0;
+
+    assert(gbln_object_iter_begin(value, &outer) == Ok);
+    while (gbln_object_iter_next(&outer, &key, &key_len, &child)) {
+        GblnObjectIter inner;
+        const char* inner_key;
+        size_t inner_len;
+        const struct GblnValue* leaf;
+        assert(gbln_object_iter_begin(child, &inner) == Ok);
+        while (gbln_object_iter_next(&inner, &inner_key, &inner_len, &leaf)) {
+            total++;
+        }
+    }
+    assert(total == 3);
+
+    gbln_value_free(value);
+
+    printf("  ✓ PASSED\n");
+}
+
+int main() {
+    printf("Running object iterator tests...\n\n");
+
+    test_iter_fields();
+    test_iter_edge_cases();
+    test_iter_nested();
+
+    printf("\n✅ All object iterator tests PASSED!\n");
+    return 0;
+}
@@ -0,0 +1,124 @@
+// Copyright (c) 2025 Vivian Burkhard Voss
+// SPDX-License-Identifier: Apache-2.0
+
+/**
+ * Test packed typed arrays in lazy documents
+ *
+ * - Numeric typed arrays stored as one contiguous buffer
+ * - gbln_lazy_array_data() zero-copy access
+ * - Element access, values and serialisation stay unchanged
+ * - Arrays that cannot be packed
+ */
+
+#include "../include/gbln.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <assert.h>
+#include <string.h>
+
+static enum GblnErrorCode lazy_parse(const char* input, struct GblnLazyDocument** doc) {
+    return gbln_lazy_parse((const uint8_t*)input, strlen(input), false, doc);
+}
+
+void test_packed_data() {
+    printf("test_packed_data...\n");
+
+    struct GblnLazyDocument* doc = NULL;
+    assert(lazy_parse("{s<f32>[1.5 (2.25) -3] n<u16>[1 2 65535] e<i64>[]}", &doc) == Ok);
+    const struct GblnLazyNode* root = gbln_lazy_root(doc);
+
+    enum GblnValueType type;
+    size_t len = 0;
+    const float* s = gbln_lazy_array_data(gbln_lazy_object_get(root, "s"), &type, &len);
+    assert(s != NULL && type == F32 && len == 3);
+    assert(s[0] == 1.5f && s[1] == 2.25f && s[2] == -3.0f);
+
+    const uint16_t* n = gbln_lazy_array_data(gbln_lazy_object_get(root, "n"), &type, &len);
+    assert(n != NULL && type == U16 && len == 3 && n[2] == 65535);
+
+    // Empty typed arrays are packed too
+    assert(gbln_lazy_array_data(gbln_lazy_object_get(root, "e"), &type, &len) != NULL);
+    assert(type == I64 && len == 0);
+
+    // The buffer is stable
+    assert(gbln_lazy_array_data(gbln_lazy_object_get(root, "s"), NULL, NULL) == s);
+
+    gbln_lazy_free(doc);
+
+    printf("  ✓ PASSED\n");
+}
+
+void test_packed_elements() {
+    printf("test_packed_elements...\n");
+
+    struct GblnLazyDocument* doc = NULL;
+    assert(lazy_parse("{v<i32>[10 -20 30]}", &doc) == Ok);
+    const struct GblnLazyNode* v = gbln_lazy_object_get(gbln_lazy_root(doc), "v");
+
+    bool ok;
+    assert(gbln_lazy_type(v) == Array);
+    assert(gbln_lazy_array_len(v) == 3);
+    const struct GblnLazyNode* second = gbln_lazy_array_get(v, 1);
+    assert(gbln_lazy_type(second) == I32);
+    assert(gbln_value_as_i32(gbln_lazy_value(second), &ok) == -20 && ok);
+    assert(gbln_lazy_array_get(v, 1) == second);
+    assert(gbln_lazy_array_get(v, 3) == NULL);
+
+    size_t len = 0;
+    assert(gbln_lazy_str(second, &len, &ok) == NULL && !ok);
+
+    // The whole array still decodes and serialises as before
+    const struct GblnValue* value = gbln_lazy_value(v);
+    assert(gbln_array_len(value) == 3);
+    char* text = gbln_to_string(value);
+    struct GblnValue* back = NULL;
+    assert(gbln_parse(text, &back) == Ok);
+    assert(gbln_value_as_i32(gbln_array_get(back, 2), &ok) == 30 && ok);
+    gbln_value_free(back);
+    gbln_string_free(text);
+
+    gbln_lazy_free(doc);
+
+    printf("  ✓ PASSED\n");
+}
+
+void test_not_packed() {
+    printf("test_not_packed...\n");
+
+    struct GblnLazyDocument* doc = NULL;
+    assert(lazy_parse("{t<s8>[a b] m[1 2] bad<u8>[1 300 3]}", &doc) == Ok);
+    const struct GblnLazyNode* root = gbln_lazy_root(doc);
+
+    // String and untyped arrays keep one node per element
+    assert(gbln_lazy_array_data(gbln_lazy_object_get(root, "t"), NULL, NULL) == NULL);
+    assert(gbln_lazy_array_data(gbln_lazy_object_get(root, "m"), NULL, NULL) == NULL);
+    assert(gbln_lazy_array_len(gbln_lazy_object_get(root, "m")) == 2);
+
+    // An element that does not decode is only reported when accessed
+    enum GblnValueType type;
+    size_t len = 7;
+    const struct GblnLazyNode* bad = gbln_lazy_object_get(root, "bad");
+    assert(gbln_lazy_array_data(bad, &type, &len) == NULL);
+    assert(type == Null && len == 0);
+
+    bool ok;
+    assert(gbln_value_as_u8(gbln_lazy_value(gbln_lazy_array_get(bad, 2)), &ok) == 3 && ok);
+    assert(gbln_lazy_value(gbln_lazy_array_get(bad, 1)) == NULL);
+
+    assert(gbln_lazy_array_data(NULL, &type, &len) == NULL);
+
+    gbln_lazy_free(doc);
+
+    printf("  ✓ PASSED\n");
+}
+
+int main() {
+    printf("Running packed array tests...\n\n");
+
+    test_packed_data();
+    test_packed_elements();
+    test_not_packed();
+
+    printf("\n✅ All packed array tests PASSED!\n");
+    return 0;
+}
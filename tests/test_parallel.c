@@ -0,0 +1,175 @@
+// Copyright (c) 2025 Vivian Burkhard Voss
+// SPDX-License-Identifier: Apache-2.0
+
+/**
+ * Test parallel parsing of large root arrays
+ *
+ * - gbln_parse_parallel() agrees with gbln_parse_n()
+ * - Errors inside a run report absolute byte offsets
+ * - Fallback for small and non-array inputs
+ * - gbln_read_io_parallel()
+ */
+
+#include "../include/gbln.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <assert.h>
+#include <string.h>
+
+#define RECORDS 60000
+
+// Build a root array large enough to be split across threads
+static char* make_array(size_t* len) {
+    size_t cap = (size_t)RECORDS * 96;
+    char* buf = malloc(cap);
+    size_t n = 0;
+    n += (size_t)snprintf(buf + n, cap - n, ":| header comment [ {\n[\n");
+    for (int i = 0; i < RECORDS; i++) {
+        switch (i % 4) {
+        case 0:
+            n += (size_t)snprintf(buf + n, cap - n, "{id<u32>(%d) name<s32>(user\\)%d) tags<s8>[a b]}\n", i, i);
+            break;
+        case 1:
+            n += (size_t)snprintf(buf + n, cap - n, "[%d (x) {k(v)}]", i);
+            break;
+        case 2:
+            n += (size_t)snprintf(buf + n, cap - n, "<u32>(%d) :| ) ] }\n", i);
+            break;
+        default:
+            n += (size_t)snprintf(buf + n, cap - n, "word%d ", i);
+            break;
+        }
+    }
+    n += (size_t)snprintf(buf + n, cap - n, "]\n:| trailer\n");
+    *len = n;
+    return buf;
+}
+
+void test_parallel_matches_sequential() {
+    printf("test_parallel_matches_sequential...\n");
+
+    size_t len;
+    char* buf = make_array(&len);
+
+    struct GblnValue* sequential = NULL;
+    struct GblnValue* parallel = NULL;
+    assert(gbln_parse_n((const uint8_t*)buf, len, false, &sequential) == Ok);
+    assert(gbln_parse_parallel((const uint8_t*)buf, len, false, 4, &parallel) == Ok);
+
+    assert(gbln_array_len(parallel) == RECORDS);
+    char* a = gbln_to_string(sequential);
+    char* b = gbln_to_string(parallel);
+    assert(strcmp(a, b) == 0);
+    gbln_string_free(a);
+    gbln_string_free(b);
+
+    bool ok;
+    const struct GblnValue* last = gbln_array_get(parallel, RECORDS - 4);
+    assert(gbln_value_as_u32(gbln_object_get(last, "id"), &ok) == RECORDS - 4 && ok);
+    assert(gbln_value_as_u32(gbln_array_get(parallel, 2), &ok) == 2 && ok);
+
+    gbln_value_free(sequential);
+    gbln_value_free(parallel);
+    free(buf);
+    printf("  ✓ PASSED\n");
+}
+
+void test_parallel_errors() {
+    printf("test_parallel_errors...\n");
+
+    size_t len;
+    char* buf = make_array(&len);
+    struct GblnValue* value = NULL;
+
+    // Value error deep inside the array: offset is absolute
+    char* bad = strstr(buf + len / 2, "<u32>(");
+    assert(bad != NULL);
+    memcpy(bad, "<u8>(9", 6);
+    assert(gbln_parse_parallel((const uint8_t*)buf, len, false, 4, &value) == ErrorTypeMismatch);
+    char* msg = gbln_last_error_message();
+    char expected[64];
+    snprintf(expected, sizeof(expected), "at byte %zu", (size_t)(bad - buf) + 4);
+    printf("  Expected error: %s\n", msg);
+    assert(strstr(msg, expected) != NULL);
+    gbln_string_free(msg);
+    memcpy(bad, "<u32>(", 6);
+
+    // Structural errors are found by the pre-scan
+    buf[len - 13] = ')';
+    assert(gbln_parse_parallel((const uint8_t*)buf, len, false, 4, &value) == ErrorUnexpectedToken);
+    buf[len - 13] = ']';
+
+    // Trailing garbage after the root array
+    buf[len - 12] = 'x';
+    assert(gbln_parse_parallel((const uint8_t*)buf, len, false, 4, &value) == ErrorUnexpectedToken);
+
+    free(buf);
+    printf("  ✓ PASSED\n");
+}
+
+void test_parallel_fallback() {
+    printf("test_parallel_fallback...\n");
+
+    bool ok;
+    struct GblnValue* value = NULL;
+    const char* small = "[1 2 3]";
+    assert(gbln_parse_parallel((const uint8_t*)small, strlen(small), false, 0, &value) == Ok);
+    assert(gbln_array_len(value) == 3);
+    gbln_value_free(value);
+
+    const char* object = "{a<i8>(1)}";
+    assert(gbln_parse_parallel((const uint8_t*)object, strlen(object), false, 0, &value) == Ok);
+    assert(gbln_value_as_i8(gbln_object_get(value, "a"), &ok) == 1 && ok);
+    gbln_value_free(value);
+
+    assert(gbln_parse_parallel(NULL, 0, false, 0, &value) == ErrorNullPointer);
+
+    printf("  ✓ PASSED\n");
+}
+
+void test_read_io_parallel() {
+    printf("test_read_io_parallel...\n");
+
+    size_t len;
+    char* buf = make_array(&len);
+    const char* path = "/tmp/gbln_test_parallel.io.gbln";
+    FILE* f = fopen(path, "wb");
+    assert(f != NULL);
+    fwrite(buf, 1, len, f);
+    fclose(f);
+
+    struct GblnValue* value = NULL;
+    assert(gbln_read_io_parallel(path, 0, &value) == Ok);
+    assert(gbln_array_len(value) == RECORDS);
+    gbln_value_free(value);
+    remove(path);
+
+    // The default snapshot format is decompressed, then split the same way
+    const char* xz_path = "/tmp/gbln_test_parallel.io.gbln.xz";
+    struct GblnValue* source = NULL;
+    assert(gbln_parse_n((const uint8_t*)buf, len, false, &source) == Ok);
+    assert(gbln_write_io(source, xz_path, NULL) == Ok);
+    value = NULL;
+    assert(gbln_read_io_parallel(xz_path, 4, &value) == Ok);
+    assert(gbln_value_equals(value, source));
+    gbln_value_free(value);
+    gbln_value_free(source);
+    remove(xz_path);
+
+    assert(gbln_read_io_parallel("/nonexistent/file.io.gbln", 0, &value) == ErrorIo);
+
+    free(buf);
+    printf("  ✓ PASSED\n");
+}
+
+int main() {
+    printf("Running parallel parse tests...\n\n");
+
+    test_parallel_matches_sequential();
+    test_parallel_errors();
+    test_parallel_fallback();
+    test_read_io_parallel();
+
+    printf("\n✅ All parallel parse tests PASSED!\n");
+    return 0;
+}
@@ -0,0 +1,150 @@
+// Copyright (c) 2025 Vivian Burkhard Voss
+// SPDX-License-Identifier: Apache-2.0
+
+/**
+ * Test reusable parser contexts
+ *
+ * - gbln_parser_new() / gbln_parser_free()
+ * - gbln_parser_parse() over many messages
+ * - gbln_parser_recycle() buffer reuse
+ * - Parser-owned error state
+ */
+
+#include "../include/gbln.h"
+#include <stdio.h>
+#include <assert.h>
+#include <string.h>
+
+static enum GblnErrorCode parse_with(struct GblnParser* parser, const char* input, struct GblnValue** out) {
+    return gbln_parser_parse(parser, (const uint8_t*)input, strlen(input), false, out);
+}
+
+void test_parser_types() {
+    printf("test_parser_types...\n");
+
+    struct GblnParser* parser = gbln_parser_new();
+    struct GblnValue* value = NULL;
+    bool ok;
+
+    enum GblnErrorCode err = parse_with(parser,
+        "{id<u32>(12345)name<s32>(Alice Johnson)active<b>(t)score<f64>(98.5)"
+        "small<i8>(-128)empty<n>()tags<s16>[rust python]nested{deep<u64>(18446744073709551615)}}",
+        &value);
+    assert(err == Ok);
+    assert(gbln_parser_last_error(parser) == NULL);
+
+    assert(gbln_value_as_u32(gbln_object_get(value, "id"), &ok) == 12345 && ok);
+    assert(gbln_value_as_i8(gbln_object_get(value, "small"), &ok) == -128 && ok);
+    assert(gbln_value_as_bool(gbln_object_get(value, "active"), &ok) == true && ok);
+    assert(gbln_value_as_f64(gbln_object_get(value, "score"), &ok) == 98.5 && ok);
+    assert(gbln_value_is_null(gbln_object_get(value, "empty")));
+
+    size_t len = 0;
+    const char* name = gbln_value_as_str(gbln_object_get(value, "name"), &len, &ok);
+    assert(ok && len == 13 && memcmp(name, "Alice Johnson", len) == 0);
+
+    const struct GblnValue* tags = gbln_object_get(value, "tags");
+    assert(gbln_array_len(tags) == 2);
+    const char* tag = gbln_value_as_str(gbln_array_get(tags, 1), &len, &ok);
+    assert(ok && len == 6 && memcmp(tag, "python", len) == 0);
+
+    const struct GblnValue* nested = gbln_object_get(value, "nested");
+    assert(gbln_value_as_u64(gbln_object_get(nested, "deep"), &ok) == 18446744073709551615ULL && ok);
+
+    gbln_value_free(value);
+    gbln_parser_free(parser);
+    printf("  ✓ PASSED\n");
+}
+
+void test_parser_inference() {
+    printf("test_parser_inference...\n");
+
+    struct GblnParser* parser = gbln_parser_new();
+    struct GblnValue* value = NULL;
+    bool ok;
+
+    // Single top-level field becomes an object, as with gbln_parse()
+    assert(parse_with(parser, "name(Alice)", &value) == Ok);
+    assert(gbln_value_type(gbln_object_get(value, "name")) == Str);
+    gbln_value_free(value);
+
+    assert(parse_with(parser, "{age(25)active(true)score(98.5)temps[-15 0 15]}", &value) == Ok);
+    assert(gbln_value_as_i64(gbln_object_get(value, "age"), &ok) == 25 && ok);
+    assert(gbln_value_as_bool(gbln_object_get(value, "active"), &ok) == true && ok);
+    assert(gbln_value_type(gbln_object_get(value, "score")) == F64);
+    const struct GblnValue* temps = gbln_object_get(value, "temps");
+    assert(gbln_array_len(temps) == 3);
+    assert(gbln_value_as_i64(gbln_array_get(temps, 0), &ok) == -15 && ok);
+    gbln_value_free(value);
+
+    // Arrays of objects
+    assert(parse_with(parser, "{items[{name<s8>(rust)}{name<s8>(python)}]}", &value) == Ok);
+    assert(gbln_array_len(gbln_object_get(value, "items")) == 2);
+    gbln_value_free(value);
+
+    gbln_parser_free(parser);
+    printf("  ✓ PASSED\n");
+}
+
+void test_parser_reuse() {
+    printf("test_parser_reuse...\n");
+
+    struct GblnParser* parser = gbln_parser_new();
+    char input[128];
+    bool ok;
+
+    // Recycled values feed the parser's buffer pools
+    for (int i = 0; i < 1000; i++) {
+        snprintf(input, sizeof(input), "{seq<i32>(%d)name<s16>(message)tags[a b c]}", i);
+        struct GblnValue* value = NULL;
+        assert(parse_with(parser, input, &value) == Ok);
+        assert(gbln_value_as_i32(gbln_object_get(value, "seq"), &ok) == i && ok);
+        assert(gbln_array_len(gbln_object_get(value, "tags")) == 3);
+        gbln_parser_recycle(parser, value);
+    }
+
+    gbln_parser_free(parser);
+    printf("  ✓ PASSED\n");
+}
+
+void test_parser_errors() {
+    printf("test_parser_errors...\n");
+
+    struct GblnParser* parser = gbln_parser_new();
+    struct GblnValue* value = NULL;
+
+    assert(parse_with(parser, "{age<i8>(999)}", &value) == ErrorTypeMismatch);
+    const char* msg = gbln_parser_last_error(parser);
+    assert(msg != NULL);
+    printf("  Expected error: %s\n", msg);
+    assert(gbln_parser_last_error_offset(parser) == 8);
+
+    assert(parse_with(parser, "{name<s4>(toolong)}", &value) == ErrorStringTooLong);
+    assert(parse_with(parser, "{a(1)a(2)}", &value) == ErrorDuplicateKey);
+    assert(parse_with(parser, "{a<x9>(1)}", &value) == ErrorInvalidTypeHint);
+    assert(parse_with(parser, "{a(1)", &value) == ErrorUnexpectedEof);
+    assert(parse_with(parser, "{a(unterminated}", &value) == ErrorUnexpectedEof);
+    // Input ending in an escape
+    assert(parse_with(parser, "a(x\\", &value) == ErrorUnexpectedEof);
+    assert(parse_with(parser, "{a(x\\", &value) == ErrorUnexpectedEof);
+
+    // Parser recovers after errors
+    assert(parse_with(parser, "{ok<b>(t)}", &value) == Ok);
+    assert(gbln_parser_last_error(parser) == NULL);
+    gbln_value_free(value);
+
+    gbln_parser_free(parser);
+    printf("  ✓ PASSED\n");
+}
+
+int main() {
+    printf("Running parser context tests...\n\n");
+
+    test_parser_types();
+    test_parser_inference();
+    test_parser_reuse();
+    test_parser_errors();
+
+    printf("\n✅ All parser tests PASSED!\n");
+    return 0;
+}
@@ -0,0 +1,134 @@
+// Copyright (c) 2025 Vivian Burkhard Voss
+// SPDX-License-Identifier: Apache-2.0
+
+/**
+ * Test precompiled path queries
+ *
+ * - gbln_path_compile() syntax and errors
+ * - gbln_path_eval() / gbln_path_get() with indices and wildcards
+ * - gbln_path_eval_lazy() on a lazy document
+ */
+
+#include "../include/gbln.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <assert.h>
+#include <string.h>
+
+static const char* ORDERS =
+    "{orders["
+    "{id<u32>(1) items[{sku(A1) qty<u8>(2)} {sku(B2) qty<u8>(1)}]}"
+    "{id<u32>(2) items[{sku(C3) qty<u8>(5)}]}"
+    "{id<u32>(3) items[]}"
+    "] meta{owner(shop) region(eu)}}";
+
+static void check_str(const struct GblnValue* value, const char* expected) {
+    bool ok;
+    char* s = gbln_value_as_string(value, &ok);
+    assert(ok && strcmp(s, expected) == 0);
+    gbln_string_free(s);
+}
+
+void test_path_eval() {
+    printf("test_path_eval...\n");
+
+    struct GblnValue* value = NULL;
+    assert(gbln_parse(ORDERS, &value) == Ok);
+
+    // Wildcard over orders, first item of each
+    struct GblnPath* path = gbln_path_compile("orders[*].items[0].sku");
+    assert(path != NULL);
+    assert(gbln_path_eval(value, path, NULL, 0) == 2);
+
+    const struct GblnValue* found[4];
+    assert(gbln_path_eval(value, path, found, 4) == 2);
+    check_str(found[0], "A1");
+    check_str(found[1], "C3");
+    gbln_path_free(path);
+
+    // Every sku; `cap` limits what is stored, not the count
+    path = gbln_path_compile("orders[*].items[*].sku");
+    assert(gbln_path_eval(value, path, found, 2) == 3);
+    check_str(found[0], "A1");
+    check_str(found[1], "B2");
+    gbln_path_free(path);
+
+    // Object wildcard yields fields in key order
+    path = gbln_path_compile("meta.*");
+    assert(gbln_path_eval(value, path, found, 4) == 2);
+    check_str(found[0], "shop");
+    check_str(found[1], "eu");
+    gbln_path_free(path);
+
+    // Single lookups
+    path = gbln_path_compile(".orders[1].id");
+    bool ok;
+    assert(gbln_value_as_u32(gbln_path_get(value, path), &ok) == 2 && ok);
+    gbln_path_free(path);
+
+    path = gbln_path_compile("orders[9].id");
+    assert(gbln_path_get(value, path) == NULL);
+    assert(gbln_path_eval(value, path, found, 4) == 0);
+    gbln_path_free(path);
+
+    // The empty path is the value itself
+    path = gbln_path_compile("");
+    assert(gbln_path_get(value, path) == value);
+    gbln_path_free(path);
+
+    gbln_value_free(value);
+
+    printf("  ✓ PASSED\n");
+}
+
+void test_path_errors() {
+    printf("test_path_errors...\n");
+
+    const char* bad[] = {"orders[", "orders[x]", "orders[]", "a..b", "a.", "orders[0]id"};
+    for (size_t i = 0; i < sizeof(bad) / sizeof(bad[0]); i++) {
+        assert(gbln_path_compile(bad[i]) == NULL);
+        struct GblnErrorInfo info;
+        assert(gbln_last_error_info(&info));
+        assert(info.code == ErrorInvalidSyntax);
+        printf("  %-12s %.*s at byte %zu\n", bad[i], (int)info.message_len, info.message,
+               info.offset);
+    }
+    assert(gbln_path_compile(NULL) == NULL);
+
+    assert(gbln_path_eval(NULL, NULL, NULL, 0) == 0);
+    assert(gbln_path_get(NULL, NULL) == NULL);
+    gbln_path_free(NULL);
+
+    printf("  ✓ PASSED\n");
+}
+
+void test_path_lazy() {
+    printf("test_path_lazy...\n");
+
+    struct GblnLazyDocument* doc = NULL;
+    assert(gbln_lazy_parse((const uint8_t*)ORDERS, strlen(ORDERS), false, &doc) == Ok);
+
+    struct GblnPath* path = gbln_path_compile("orders[*].items[*].qty");
+    const struct GblnLazyNode* found[4];
+    assert(gbln_path_eval_lazy(gbln_lazy_root(doc), path, found, 4) == 3);
+
+    bool ok;
+    assert(gbln_value_as_u8(gbln_lazy_value(found[0]), &ok) == 2 && ok);
+    assert(gbln_value_as_u8(gbln_lazy_value(found[2]), &ok) == 5 && ok);
+    gbln_path_free(path);
+
+    gbln_lazy_free(doc);
+
+    printf("  ✓ PASSED\n");
+}
+
+int main() {
+    printf("Running path query tests...\n\n");
+
+    test_path_eval();
+    test_path_errors();
+    test_path_lazy();
+
+    printf("\n✅ All path query tests PASSED!\n");
+    return 0;
+}
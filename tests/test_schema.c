@@ -0,0 +1,201 @@
+// Copyright (c) 2025 Vivian Burkhard Voss
+// SPDX-License-Identifier: Apache-2.0
+
+/**
+ * Test schema-compiled decoding into C structs
+ *
+ * - gbln_schema_compile() validation
+ * - gbln_decode_into() with typed, un-hinted, unknown and missing fields
+ * - Type, range, length and required-field errors
+ * - gbln_decode_array_into() into a struct array
+ */
+
+#include "../include/gbln.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <assert.h>
+#include <string.h>
+#include <stddef.h>
+
+typedef struct {
+    uint32_t id;
+    char name[16];
+    uint16_t port;
+    int64_t offset;
+    double score;
+    bool active;
+} Record;
+
+static struct GblnSchema* record_schema() {
+    GblnSchemaField fields[] = {
+        {"id", U32, offsetof(Record, id), sizeof(uint32_t), true},
+        {"name", Str, offsetof(Record, name), sizeof(((Record*)0)->name), true},
+        {"port", U16, offsetof(Record, port), sizeof(uint16_t), false},
+        {"offset", I64, offsetof(Record, offset), sizeof(int64_t), false},
+        {"score", F64, offsetof(Record, score), sizeof(double), false},
+        {"active", Bool, offsetof(Record, active), sizeof(bool), false},
+    };
+    struct GblnSchema* schema =
+        gbln_schema_compile(fields, sizeof(fields) / sizeof(fields[0]), sizeof(Record));
+    assert(schema != NULL);
+    return schema;
+}
+
+static enum GblnErrorCode decode(struct GblnSchema* schema, const char* text, Record* out) {
+    memset(out, 0, sizeof(*out));
+    return gbln_decode_into((const uint8_t*)text, strlen(text), schema, out);
+}
+
+void test_schema_compile() {
+    printf("test_schema_compile...\n");
+
+    struct GblnSchema* schema = record_schema();
+    gbln_schema_free(schema);
+
+    // Size does not match the type
+    GblnSchemaField bad_size[] = {{"id", U32, 0, 8, false}};
+    assert(gbln_schema_compile(bad_size, 1, 16) == NULL);
+
+    // Outside of the struct
+    GblnSchemaField outside[] = {{"id", U32, 14, 4, false}};
+    assert(gbln_schema_compile(outside, 1, 16) == NULL);
+
+    // Not a scalar type
+    GblnSchemaField nested[] = {{"child", Object, 0, 8, false}};
+    assert(gbln_schema_compile(nested, 1, 16) == NULL);
+
+    // Duplicate name
+    GblnSchemaField twice[] = {{"id", U32, 0, 4, false}, {"id", U32, 4, 4, false}};
+    assert(gbln_schema_compile(twice, 2, 16) == NULL);
+
+    char* msg = gbln_last_error_message();
+    printf("  Expected error: %s\n", msg);
+    gbln_string_free(msg);
+
+    gbln_schema_free(NULL);
+
+    printf("  ✓ PASSED\n");
+}
+
+void test_decode_record() {
+    printf("test_decode_record...\n");
+
+    struct GblnSchema* schema = record_schema();
+    Record r;
+
+    assert(decode(schema,
+                  "{id<u32>(7) name<s16>(Alice) port<u16>(8080) offset(-12) score<f64>(2.5) "
+                  "active(true) ignored{deep[1 2 3]}}",
+                  &r) == Ok);
+    assert(r.id == 7);
+    assert(strcmp(r.name, "Alice") == 0);
+    assert(r.port == 8080);
+    assert(r.offset == -12);
+    assert(r.score == 2.5);
+    assert(r.active);
+
+    // Fields in another order; un-hinted integers fit smaller fields; optional
+    // fields may be missing or null
+    assert(decode(schema, "{port(443) name(Bob) id(9) score<n>()}", &r) == Ok);
+    assert(r.id == 9 && r.port == 443 && strcmp(r.name, "Bob") == 0);
+    assert(r.score == 0.0 && !r.active);
+
+    gbln_schema_free(schema);
+
+    printf("  ✓ PASSED\n");
+}
+
+static void expect_error(struct GblnSchema* schema, const char* text, enum GblnErrorCode code) {
+    Record r;
+    assert(decode(schema, text, &r) == code);
+    struct GblnErrorInfo info;
+    assert(gbln_last_error_info(&info));
+    printf("  %-36s %.*s at byte %zu\n", text, (int)info.message_len, info.message, info.offset);
+}
+
+void test_decode_errors() {
+    printf("test_decode_errors...\n");
+
+    struct GblnSchema* schema = record_schema();
+
+    // Hinted type must match
+    expect_error(schema, "{id<u64>(7) name(A)}", ErrorTypeMismatch);
+    expect_error(schema, "{id(7) name{first(A)}}", ErrorTypeMismatch);
+    // Range and length
+    expect_error(schema, "{id(7) name(A) port(70000)}", ErrorIntOutOfRange);
+    expect_error(schema, "{id(-1) name(A)}", ErrorIntOutOfRange);
+    expect_error(schema, "{id(7) name(abcdefghijklmnopq)}", ErrorStringTooLong);
+    // Required, duplicate, wrong root
+    expect_error(schema, "{id(7)}", ErrorTypeMismatch);
+    expect_error(schema, "{id(7) name(A) id(8)}", ErrorDuplicateKey);
+    expect_error(schema, "[{id(7) name(A)}]", ErrorTypeMismatch);
+    // Input ending in an escape
+    expect_error(schema, "{id(7) name(A\\", ErrorUnexpectedEof);
+
+    Record r;
+    assert(gbln_decode_into(NULL, 0, schema, &r) == ErrorNullPointer);
+
+    gbln_schema_free(schema);
+
+    printf("  ✓ PASSED\n");
+}
+
+void test_decode_array() {
+    printf("test_decode_array...\n");
+
+    struct GblnSchema* schema = record_schema();
+
+    char text[4096];
+    size_t len = 0;
+    text[len++] = '[';
+    for (int i = 0; i < 50; i++) {
+        len += sprintf(text + len, "{id<u32>(%d) name(user%d) active(%s)}", i, i,
+                       i % 2 ? "true" : "false");
+    }
+    text[len++] = ']';
+
+    Record records[50];
+    size_t n = 0;
+    assert(gbln_decode_array_into((const uint8_t*)text, len, schema, records, 0, 50, &n) == Ok);
+    assert(n == 50);
+    for (int i = 0; i < 50; i++) {
+        char name[16];
+        snprintf(name, sizeof(name), "user%d", i);
+        assert(records[i].id == (uint32_t)i);
+        assert(strcmp(records[i].name, name) == 0);
+        assert(records[i].active == (i % 2 == 1));
+    }
+
+    // Too small: first `cap` decoded, `n` is the full count
+    memset(records, 0, sizeof(records));
+    assert(gbln_decode_array_into((const uint8_t*)text, len, schema, records, 0, 10, &n) ==
+           ErrorBufferTooSmall);
+    assert(n == 50 && records[9].id == 9 && records[10].id == 0);
+
+    // Size query
+    assert(gbln_decode_array_into((const uint8_t*)text, len, schema, NULL, 0, 0, &n) ==
+           ErrorBufferTooSmall);
+    assert(n == 50);
+
+    // A bad record stops decoding; `n` counts the good ones before it
+    const char* bad = "[{id(1) name(a)} {id(2) name(b)} {id(x) name(c)}]";
+    assert(gbln_decode_array_into((const uint8_t*)bad, strlen(bad), schema, records, 0, 50, &n) ==
+           ErrorTypeMismatch);
+    assert(n == 2);
+
+    gbln_schema_free(schema);
+
+    printf("  ✓ PASSED\n");
+}
+
+int main() {
+    printf("Running schema decode tests...\n\n");
+
+    test_schema_compile();
+    test_decode_record();
+    test_decode_errors();
+    test_decode_array();
+
+    printf("\n✅ All schema decode tests PASSED!\n");
+    return 0;
+}
@@ -0,0 +1,130 @@
+// Copyright (c) 2025 Vivian Burkhard Voss
+// SPDX-License-Identifier: Apache-2.0
+
+/**
+ * Test shared reference-counted values
+ *
+ * - gbln_value_share() / gbln_value_retain() / gbln_value_release()
+ * - Child pointers while a reference is held
+ * - Concurrent readers while the current version is swapped
+ */
+
+#include "../include/gbln.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <assert.h>
+#include <string.h>
+#include <pthread.h>
+
+#define READERS 8
+#define READS 2000
+#define VERSIONS 50
+
+void test_share_basic() {
+    printf("test_share_basic...\n");
+
+    struct GblnValue* value = NULL;
+    assert(gbln_parse("{route{host(example.org) port<u16>(8080)}}", &value) == Ok);
+
+    const struct GblnValue* shared = gbln_value_share(value);
+    assert(shared != NULL);
+
+    const struct GblnValue* second = gbln_value_retain(shared);
+    assert(second == shared);
+
+    // Dropping one reference keeps the tree alive
+    const struct GblnValue* route = gbln_object_get(shared, "route");
+    gbln_value_release(shared);
+
+    bool ok;
+    assert(gbln_value_as_u16(gbln_object_get(route, "port"), &ok) == 8080 && ok);
+    char* text = gbln_to_string(second);
+    assert(text != NULL);
+    gbln_string_free(text);
+
+    gbln_value_release(second);
+
+    // NULL is ignored
+    assert(gbln_value_share(NULL) == NULL);
+    assert(gbln_value_retain(NULL) == NULL);
+    gbln_value_release(NULL);
+
+    printf("  ✓ PASSED\n");
+}
+
+typedef struct {
+    pthread_mutex_t lock;
+    const struct GblnValue* current;
+} Cache;
+
+static const struct GblnValue* make_version(uint32_t version) {
+    char text[64];
+    snprintf(text, sizeof(text), "{version<u32>(%u) items[a b c]}", version);
+    struct GblnValue* value = NULL;
+    assert(gbln_parse(text, &value) == Ok);
+    return gbln_value_share(value);
+}
+
+static const struct GblnValue* cache_get(Cache* cache) {
+    pthread_mutex_lock(&cache->lock);
+    const struct GblnValue* value = gbln_value_retain(cache->current);
+    pthread_mutex_unlock(&cache->lock);
+    return value;
+}
+
+static void* reader(void* arg) {
+    Cache* cache = (Cache*)arg;
+    uint32_t last = 0;
+    for (int i = 0; i < READS; i++) {
+        const struct GblnValue* doc = cache_get(cache);
+        bool ok;
+        uint32_t version = gbln_value_as_u32(gbln_object_get(doc, "version"), &ok);
+        assert(ok && version >= last);
+        assert(gbln_array_len(gbln_object_get(doc, "items")) == 3);
+        last = version;
+        gbln_value_release(doc);
+    }
+    return NULL;
+}
+
+void test_share_threads() {
+    printf("test_share_threads...\n");
+
+    Cache cache;
+    pthread_mutex_init(&cache.lock, NULL);
+    cache.current = make_version(0);
+
+    pthread_t threads[READERS];
+    for (int i = 0; i < READERS; i++) {
+        assert(pthread_create(&threads[i], NULL, reader, &cache) == 0);
+    }
+
+    // Swap in new versions while readers hold the old ones
+    for (uint32_t v = 1; v <= VERSIONS; v++) {
+        const struct GblnValue* next = make_version(v);
+        pthread_mutex_lock(&cache.lock);
+        const struct GblnValue* old = cache.current;
+        cache.current = next;
+        pthread_mutex_unlock(&cache.lock);
+        gbln_value_release(old);
+    }
+
+    for (int i = 0; i < READERS; i++) {
+        pthread_join(threads[i], NULL);
+    }
+
+    gbln_value_release(cache.current);
+    pthread_mutex_destroy(&cache.lock);
+
+    printf("  ✓ PASSED\n");
+}
+
+int main() {
+    printf("Running shared value tests...\n\n");
+
+    test_share_basic();
+    test_share_threads();
+
+    printf("\n✅ All shared value tests PASSED!\n");
+    return 0;
+}
@@ -0,0 +1,200 @@
+// Copyright (c) 2025 Vivian Burkhard Voss
+// SPDX-License-Identifier: Apache-2.0
+
+/**
+ * Test opt-in stats
+ *
+ * - Nothing is recorded until gbln_stats_enable()
+ * - Call counts, bytes, histograms and allocations for parse and to_string
+ * - Compression and decompression time of write_io / read_io
+ * - Counters from many threads add up
+ *
+ * Requires the `stats` feature; without it only the stub behaviour is
+ * checked.
+ */
+
+#include "../include/gbln.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <assert.h>
+#include <string.h>
+#include <pthread.h>
+
+#define DOC "{user{id<u32>(7) name<s32>(Alice) tags[a b c]} score<f64>(1.5)}"
+
+static uint64_t histogram_total(const GblnOpStats* op) {
+    uint64_t total = 0;
+    for (int i = 0; i < GBLN_STATS_BUCKETS; i++) {
+        total += op->histogram[i];
+    }
+    return total;
+}
+
+static void parse_and_free(const char* text) {
+    struct GblnValue* value = NULL;
+    assert(gbln_parse(text, &value) == Ok);
+    gbln_value_free(value);
+}
+
+void test_disabled() {
+    printf("test_disabled...\n");
+
+    GblnStats stats;
+    gbln_stats_reset();
+    parse_and_free(DOC);
+    gbln_stats_snapshot(&stats);
+    assert(stats.parse.calls == 0);
+    assert(stats.allocations == 0);
+
+    assert(!gbln_stats_snapshot(NULL));
+
+    printf("  ✓ PASSED\n");
+}
+
+void test_parse_and_serialise() {
+    printf("test_parse_and_serialise...\n");
+
+    gbln_stats_reset();
+    for (int i = 0; i < 100; i++) {
+        parse_and_free(DOC);
+    }
+    struct GblnValue* value = NULL;
+    assert(gbln_parse_n((const uint8_t*)DOC, strlen(DOC), false, &value) == Ok);
+    char* text = gbln_to_string(value);
+    char buf[256];
+    size_t written;
+    assert(gbln_to_buffer(value, buf, sizeof(buf), &written) == Ok);
+
+    GblnStats stats;
+    assert(gbln_stats_snapshot(&stats));
+    assert(stats.parse.calls == 101);
+    assert(stats.parse.bytes == 101 * strlen(DOC));
+    assert(stats.parse.total_ns > 0);
+    assert(histogram_total(&stats.parse) == stats.parse.calls);
+    assert(stats.to_string.calls == 2);
+    assert(stats.to_string.bytes == strlen(text) + written);
+    assert(stats.read_io.calls == 0 && stats.write_io.calls == 0);
+    assert(stats.allocations > 0 && stats.allocated_bytes > 0);
+    printf("  parse: %llu calls, %llu ns, %llu allocations\n",
+           (unsigned long long)stats.parse.calls, (unsigned long long)stats.parse.total_ns,
+           (unsigned long long)stats.allocations);
+
+    gbln_string_free(text);
+    gbln_value_free(value);
+
+    // Reset clears everything
+    gbln_stats_reset();
+    assert(gbln_stats_snapshot(&stats));
+    assert(stats.parse.calls == 0 && stats.to_string.calls == 0 && stats.allocations == 0);
+
+    printf("  ✓ PASSED\n");
+}
+
+void test_io_split() {
+    printf("test_io_split...\n");
+
+    const char* path = "/tmp/gbln_test_stats.io.gbln.xz";
+    struct GblnValue* value = NULL;
+    assert(gbln_parse(DOC, &value) == Ok);
+
+    // Multi-threaded XZ is compressed by this library, so it is split
+    struct GblnConfig* config = gbln_config_new_io();
+    gbln_config_set_threads(config, 2);
+    gbln_stats_reset();
+    assert(gbln_write_io(value, path, config) == Ok);
+    gbln_config_free(config);
+
+    struct GblnValue* back = NULL;
+    assert(gbln_read_io(path, &back) == Ok);
+    gbln_value_free(back);
+
+    FILE* f = fopen(path, "rb");
+    fseek(f, 0, SEEK_END);
+    uint64_t size = (uint64_t)ftell(f);
+    fclose(f);
+
+    GblnStats stats;
+    assert(gbln_stats_snapshot(&stats));
+    assert(stats.write_io.calls == 1 && stats.write_io.bytes == size);
+    assert(stats.read_io.calls == 1 && stats.read_io.bytes == size);
+    assert(stats.compress_ns > 0 && stats.compress_ns <= stats.write_io.total_ns);
+    assert(stats.decompress_ns > 0 && stats.decompress_ns <= stats.read_io.total_ns);
+    printf("  write_io: %llu ns (%llu compressing), read_io: %llu ns (%llu decompressing)\n",
+           (unsigned long long)stats.write_io.total_ns, (unsigned long long)stats.compress_ns,
+           (unsigned long long)stats.read_io.total_ns, (unsigned long long)stats.decompress_ns);
+
+    gbln_value_free(value);
+    remove(path);
+
+    printf("  ✓ PASSED\n");
+}
+
+#define THREADS 8
+#define PARSES 500
+
+static void* parse_worker(void* arg) {
+    (void)arg;
+    for (int i = 0; i < PARSES; i++) {
+        parse_and_free(DOC);
+    }
+    return NULL;
+}
+
+void test_threads() {
+    printf("test_threads...\n");
+
+    gbln_stats_reset();
+    pthread_t threads[THREADS];
+    for (int i = 0; i < THREADS; i++) {
+        assert(pthread_create(&threads[i], NULL, parse_worker, NULL) == 0);
+    }
+    for (int i = 0; i < THREADS; i++) {
+        pthread_join(threads[i], NULL);
+    }
+
+    GblnStats stats;
+    assert(gbln_stats_snapshot(&stats));
+    assert(stats.parse.calls == THREADS * PARSES);
+    assert(histogram_total(&stats.parse) == THREADS * PARSES);
+
+    printf("  ✓ PASSED\n");
+}
+
+void test_pause() {
+    printf("test_pause...\n");
+
+    gbln_stats_reset();
+    parse_and_free(DOC);
+    assert(gbln_stats_enable(false));
+    parse_and_free(DOC);
+
+    // Counters are kept while paused
+    GblnStats stats;
+    assert(gbln_stats_snapshot(&stats));
+    assert(stats.parse.calls == 1);
+
+    printf("  ✓ PASSED\n");
+}
+
+int main() {
+    printf("Running stats tests...\n\n");
+
+    test_disabled();
+    if (!gbln_stats_enable(true)) {
+        GblnStats stats;
+        memset(&stats, 0xFF, sizeof(stats));
+        assert(!gbln_stats_snapshot(&stats));
+        assert(stats.parse.calls == 0 && stats.allocations == 0);
+        printf("\n(stats feature not compiled in; skipping)\n");
+        printf("\n✅ All stats tests PASSED!\n");
+        return 0;
+    }
+
+    test_parse_and_serialise();
+    test_io_split();
+    test_threads();
+    test_pause();
+
+    printf("\n✅ All stats tests PASSED!\n");
+    return 0;
+}
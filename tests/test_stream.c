@@ -0,0 +1,181 @@
+// Copyright (c) 2025 Vivian Burkhard Voss
+// SPDX-License-Identifier: Apache-2.0
+
+/**
+ * Test incremental stream parsing
+ *
+ * - gbln_stream_new() / gbln_stream_free()
+ * - gbln_stream_feed() with arbitrary chunk boundaries
+ * - Root array element streaming
+ * - Callback stop and error handling
+ */
+
+#include "../include/gbln.h"
+#include <stdio.h>
+#include <assert.h>
+#include <string.h>
+
+#define MAX_VALUES 16
+
+typedef struct {
+    struct GblnValue* values[MAX_VALUES];
+    size_t count;
+    size_t stop_after;
+} Collector;
+
+static enum GblnErrorCode collect(void* ctx, struct GblnValue* value) {
+    Collector* c = (Collector*)ctx;
+    assert(c->count < MAX_VALUES);
+    c->values[c->count++] = value;
+    if (c->stop_after && c->count == c->stop_after) {
+        return ErrorInvalidSyntax;
+    }
+    return Ok;
+}
+
+static void collector_clear(Collector* c) {
+    for (size_t i = 0; i < c->count; i++) {
+        gbln_value_free(c->values[i]);
+    }
+    c->count = 0;
+}
+
+// Feed `input` in chunks of `chunk` bytes
+static enum GblnErrorCode feed_chunked(struct GblnStream* stream, const char* input, size_t chunk) {
+    size_t len = strlen(input);
+    for (size_t pos = 0; pos < len; pos += chunk) {
+        size_t n = len - pos < chunk ? len - pos : chunk;
+        enum GblnErrorCode err = gbln_stream_feed(stream, (const uint8_t*)input + pos, n);
+        if (err != Ok) {
+            return err;
+        }
+    }
+    return gbln_stream_finish(stream);
+}
+
+void test_stream_sequence() {
+    printf("test_stream_sequence...\n");
+
+    const char* input = "{id<i32>(1)name<s16>(a\\)b)}\n"
+                        ":| comment between records\n"
+                        "{id<i32>(2)tags[x y]}\n"
+                        "count<u8>(3)";
+    bool ok;
+
+    // Every chunk size must produce the same records, including one byte at a time
+    for (size_t chunk = 1; chunk <= strlen(input); chunk++) {
+        Collector c = {0};
+        struct GblnStream* stream = gbln_stream_new(collect, &c);
+        assert(feed_chunked(stream, input, chunk) == Ok);
+        assert(c.count == 3);
+
+        assert(gbln_value_as_i32(gbln_object_get(c.values[0], "id"), &ok) == 1 && ok);
+        size_t len = 0;
+        const char* name = gbln_value_as_str(gbln_object_get(c.values[0], "name"), &len, &ok);
+        assert(ok && len == 3 && memcmp(name, "a)b", 3) == 0);
+        assert(gbln_array_len(gbln_object_get(c.values[1], "tags")) == 2);
+        assert(gbln_value_as_u8(gbln_object_get(c.values[2], "count"), &ok) == 3 && ok);
+
+        collector_clear(&c);
+        gbln_stream_free(stream);
+    }
+
+    printf("  ✓ PASSED\n");
+}
+
+void test_stream_root_array() {
+    printf("test_stream_root_array...\n");
+
+    const char* input = "[{a(1)} {a(2)} plain <i32>(5) <u8>[1 2] (z)]\n";
+    Collector c = {0};
+    bool ok;
+
+    struct GblnStream* stream = gbln_stream_new(collect, &c);
+    assert(feed_chunked(stream, input, 7) == Ok);
+    assert(c.count == 6);
+
+    assert(gbln_value_as_i64(gbln_object_get(c.values[1], "a"), &ok) == 2 && ok);
+    assert(gbln_value_type(c.values[2]) == Str);
+    assert(gbln_value_as_i32(c.values[3], &ok) == 5 && ok);
+    assert(gbln_array_len(c.values[4]) == 2);
+    assert(gbln_value_type(c.values[5]) == Str);
+    collector_clear(&c);
+
+    // A finished stream accepts a new input
+    assert(feed_chunked(stream, "{again<b>(t)}", 3) == Ok);
+    assert(c.count == 1);
+    collector_clear(&c);
+
+    gbln_stream_free(stream);
+    printf("  ✓ PASSED\n");
+}
+
+void test_stream_stop() {
+    printf("test_stream_stop...\n");
+
+    Collector c = {0};
+    c.stop_after = 1;
+
+    struct GblnStream* stream = gbln_stream_new(collect, &c);
+    const char* input = "{a(1)}{a(2)}{a(3)}";
+    assert(gbln_stream_feed(stream, (const uint8_t*)input, strlen(input)) == ErrorInvalidSyntax);
+    assert(c.count == 1);
+
+    // Stopped streams stay stopped
+    assert(gbln_stream_feed(stream, (const uint8_t*)"{b(1)}", 6) == ErrorInvalidSyntax);
+    assert(gbln_stream_finish(stream) == ErrorInvalidSyntax);
+    assert(c.count == 1);
+
+    collector_clear(&c);
+    gbln_stream_free(stream);
+    printf("  ✓ PASSED\n");
+}
+
+void test_stream_errors() {
+    printf("test_stream_errors...\n");
+
+    Collector c = {0};
+    struct GblnStream* stream = gbln_stream_new(collect, &c);
+
+    // Invalid record: records before it are still delivered
+    assert(feed_chunked(stream, "{a(1)}{a<i8>(999)}", 4) == ErrorTypeMismatch);
+    assert(c.count == 1);
+    char* msg = gbln_last_error_message();
+    assert(msg != NULL);
+    printf("  Expected error: %s\n", msg);
+    gbln_string_free(msg);
+    collector_clear(&c);
+    gbln_stream_free(stream);
+
+    stream = gbln_stream_new(collect, &c);
+    assert(feed_chunked(stream, "{a(1)} }", 2) == ErrorUnexpectedToken);
+    collector_clear(&c);
+    gbln_stream_free(stream);
+
+    // Incomplete input is only an error at finish
+    stream = gbln_stream_new(collect, &c);
+    assert(gbln_stream_feed(stream, (const uint8_t*)"{a(1)", 5) == Ok);
+    assert(c.count == 0);
+    assert(gbln_stream_finish(stream) == ErrorUnexpectedEof);
+    gbln_stream_free(stream);
+
+    stream = gbln_stream_new(collect, &c);
+    assert(feed_chunked(stream, "[(1) (2)", 3) == ErrorUnexpectedEof);
+    assert(c.count == 2);
+    collector_clear(&c);
+    gbln_stream_free(stream);
+
+    printf("  ✓ PASSED\n");
+}
+
+int main() {
+    printf("Running stream parser tests...\n\n");
+
+    test_stream_sequence();
+    test_stream_root_array();
+    test_stream_stop();
+    test_stream_errors();
+
+    printf("\n✅ All stream tests PASSED!\n");
+    return 0;
+}
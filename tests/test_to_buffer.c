@@ -0,0 +1,227 @@
+// Copyright (c) 2025 Vivian Burkhard Voss
+// SPDX-License-Identifier: Apache-2.0
+
+/**
+ * Test serialisation into caller memory
+ *
+ * - gbln_to_buffer() into a fixed buffer, size queries, short buffers
+ * - Every value type reads back equal through gbln_parse()
+ * - gbln_to_writer() chunked output, config and abort
+ */
+
+#include "../include/gbln.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <assert.h>
+#include <string.h>
+
+typedef struct {
+    char* data;
+    size_t len;
+    size_t cap;
+    int calls;
+    int stop_after;
+} Sink;
+
+static enum GblnErrorCode collect(void* ctx, const uint8_t* data, uintptr_t len) {
+    Sink* sink = (Sink*)ctx;
+    sink->calls++;
+    if (sink->stop_after && sink->calls > sink->stop_after) {
+        return ErrorAborted;
+    }
+    if (sink->len + len > sink->cap) {
+        sink->cap = (sink->len + len) * 2;
+        sink->data = realloc(sink->data, sink->cap);
+    }
+    memcpy(sink->data + sink->len, data, len);
+    sink->len += len;
+    return Ok;
+}
+
+void test_buffer_round_trip() {
+    printf("test_buffer_round_trip...\n");
+
+    struct GblnValue* value = NULL;
+    assert(gbln_parse("{id<u32>(7) name<s16>(Alice) tags[a b] note<s8>(42)}", &value) == Ok);
+
+    char buf[256];
+    size_t written = 0;
+    assert(gbln_to_buffer(value, buf, sizeof(buf), &written) == Ok);
+    assert(written == strlen(buf));
+    printf("  Output: %s\n", buf);
+
+    struct GblnValue* back = NULL;
+    bool ok;
+    assert(gbln_parse(buf, &back) == Ok);
+    assert(gbln_value_as_u32(gbln_object_get(back, "id"), &ok) == 7 && ok);
+    assert(gbln_array_len(gbln_object_get(back, "tags")) == 2);
+
+    // A string that looks like a number stays a string
+    char* note = gbln_value_as_string(gbln_object_get(back, "note"), &ok);
+    assert(ok && strcmp(note, "42") == 0);
+    gbln_string_free(note);
+
+    gbln_value_free(back);
+    gbln_value_free(value);
+
+    printf("  ✓ PASSED\n");
+}
+
+void test_buffer_all_types() {
+    printf("test_buffer_all_types...\n");
+
+    struct GblnValue* obj = gbln_value_new_object();
+    gbln_object_insert(obj, "i8", gbln_value_new_i8(-8));
+    gbln_object_insert(obj, "i64", gbln_value_new_i64(-64));
+    gbln_object_insert(obj, "u32", gbln_value_new_u32(32));
+    gbln_object_insert(obj, "u64", gbln_value_new_u64(UINT64_MAX));
+    gbln_object_insert(obj, "f32", gbln_value_new_f32(0.25f));
+    gbln_object_insert(obj, "f64", gbln_value_new_f64(2.0));
+    gbln_object_insert(obj, "no", gbln_value_new_bool(false));
+    gbln_object_insert(obj, "none", gbln_value_new_null());
+    gbln_object_insert(obj, "word", gbln_value_new_str("true", 8));
+    gbln_object_insert(obj, "empty", gbln_value_new_str("", 8));
+    gbln_object_insert(obj, "escaped", gbln_value_new_str("a)b\\", 8));
+    struct GblnValue* list = gbln_value_new_array();
+    gbln_array_push(list, gbln_value_new_i64(1));
+    gbln_array_push(list, gbln_value_new_object());
+    gbln_object_insert(obj, "list", list);
+
+    char buf[512];
+    size_t written = 0;
+    assert(gbln_to_buffer(obj, buf, sizeof(buf), &written) == Ok);
+    printf("  Output: %s\n", buf);
+
+    // Core and native parsers both read back an equal value
+    struct GblnValue* back = NULL;
+    assert(gbln_parse(buf, &back) == Ok);
+    assert(gbln_value_equals(back, obj));
+    gbln_value_free(back);
+
+    struct GblnParser* parser = gbln_parser_new();
+    assert(gbln_parser_parse(parser, (const uint8_t*)buf, written, false, &back) == Ok);
+    assert(gbln_value_equals(back, obj));
+    gbln_value_free(back);
+    gbln_parser_free(parser);
+
+    gbln_value_free(obj);
+
+    printf("  ✓ PASSED\n");
+}
+
+void test_buffer_too_small() {
+    printf("test_buffer_too_small...\n");
+
+    struct GblnValue* value = NULL;
+    assert(gbln_parse("{a(1) b(2) c(3)}", &value) == Ok);
+
+    // Size query
+    size_t needed = 0;
+    assert(gbln_to_buffer(value, NULL, 0, &needed) == ErrorBufferTooSmall);
+    assert(needed > 0);
+
+    // One byte short: no room for the NUL
+    char* buf = malloc(needed + 1);
+    size_t written = 0;
+    assert(gbln_to_buffer(value, buf, needed, &written) == ErrorBufferTooSmall);
+    assert(written == needed);
+
+    assert(gbln_to_buffer(value, buf, needed + 1, &written) == Ok);
+    assert(written == needed && buf[needed] == '\0');
+
+    assert(gbln_to_buffer(NULL, buf, needed + 1, &written) == ErrorNullPointer);
+    assert(gbln_to_buffer(value, buf, needed + 1, NULL) == ErrorNullPointer);
+    assert(gbln_to_buffer(value, NULL, 16, &written) == ErrorNullPointer);
+
+    free(buf);
+    gbln_value_free(value);
+
+    printf("  ✓ PASSED\n");
+}
+
+void test_writer_chunks() {
+    printf("test_writer_chunks...\n");
+
+    // Large enough to need several chunks
+    size_t cap = 40 * 10000 + 2;
+    char* text = malloc(cap);
+    size_t len = 0;
+    text[len++] = '[';
+    for (int i = 0; i < 10000; i++) {
+        len += sprintf(text + len, "{id<u32>(%d) name<s16>(user%d)}", i, i);
+    }
+    text[len++] = ']';
+
+    struct GblnValue* value = NULL;
+    assert(gbln_parse_n((const uint8_t*)text, len, false, &value) == Ok);
+    free(text);
+
+    Sink sink = {0};
+    assert(gbln_to_writer(value, collect, &sink, NULL) == Ok);
+    assert(sink.calls > 1);
+
+    // Same bytes as the buffer path
+    size_t needed = 0;
+    gbln_to_buffer(value, NULL, 0, &needed);
+    char* buf = malloc(needed + 1);
+    assert(gbln_to_buffer(value, buf, needed + 1, &needed) == Ok);
+    assert(sink.len == needed && memcmp(sink.data, buf, needed) == 0);
+    free(buf);
+
+    struct GblnValue* back = NULL;
+    assert(gbln_parse_n((const uint8_t*)sink.data, sink.len, false, &back) == Ok);
+    assert(gbln_array_len(back) == 10000);
+    gbln_value_free(back);
+    free(sink.data);
+
+    // Stop after the first chunk
+    Sink stop = {.stop_after = 1};
+    assert(gbln_to_writer(value, collect, &stop, NULL) == ErrorAborted);
+    assert(stop.calls == 2);
+    free(stop.data);
+
+    gbln_value_free(value);
+
+    printf("  ✓ PASSED\n");
+}
+
+void test_writer_config() {
+    printf("test_writer_config...\n");
+
+    struct GblnValue* value = NULL;
+    assert(gbln_parse("{user{id(1) name(Bob)}}", &value) == Ok);
+
+    // Pretty layout
+    struct GblnConfig* config = gbln_config_new_source();
+    Sink sink = {0};
+    assert(gbln_to_writer(value, collect, &sink, config) == Ok);
+    assert(memchr(sink.data, '\n', sink.len) != NULL);
+    free(sink.data);
+    gbln_config_free(config);
+
+    // Compressed output starts with the XZ magic
+    config = gbln_config_new_io();
+    Sink xz = {0};
+    assert(gbln_to_writer(value, collect, &xz, config) == Ok);
+    assert(xz.len >= 6 && memcmp(xz.data, "\xFD" "7zXZ\0", 6) == 0);
+    free(xz.data);
+    gbln_config_free(config);
+
+    assert(gbln_to_writer(value, NULL, NULL, NULL) == ErrorNullPointer);
+    gbln_value_free(value);
+
+    printf("  ✓ PASSED\n");
+}
+
+int main() {
+    printf("Running buffer serialisation tests...\n\n");
+
+    test_buffer_round_trip();
+    test_buffer_all_types();
+    test_buffer_too_small();
+    test_writer_chunks();
+    test_writer_config();
+
+    printf("\n✅ All buffer serialisation tests PASSED!\n");
+    return 0;
+}